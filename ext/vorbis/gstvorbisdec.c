@@ -162,12 +162,104 @@ vorbis_dec_stop (GstAudioDecoder * dec)
   return TRUE;
 }
 
+#ifndef TREMOR
+static gboolean
+vorbis_dec_structure_accepts_channels (const GstStructure * s, gint channels)
+{
+  GstStructure *tmp;
+  gboolean res;
+
+  tmp = gst_structure_new ("audio/x-raw", "channels", G_TYPE_INT, channels,
+      NULL);
+  res = gst_structure_can_intersect (s, tmp);
+  gst_structure_free (tmp);
+
+  return res;
+}
+
+/* Look at what downstream prefers. Non-interleaved output lets us copy each
+ * channel in one go, a downmix to mono at decode time avoids doing it again
+ * later on. We only downmix when downstream can't take all channels. */
+static void
+vorbis_dec_choose_output (GstVorbisDec * vd, GstAudioLayout * layout,
+    gboolean * downmix)
+{
+  GstCaps *filter, *peercaps;
+  GstStructure *s = NULL;
+  const gchar *str;
+  guint i, n;
+
+  *layout = GST_AUDIO_LAYOUT_INTERLEAVED;
+  *downmix = FALSE;
+
+  filter = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_VORBIS_AUDIO_FORMAT_STR,
+      "rate", G_TYPE_INT, vd->vi.rate, NULL);
+  peercaps = gst_pad_peer_query_caps (GST_AUDIO_DECODER_SRC_PAD (vd), filter);
+  gst_caps_unref (filter);
+
+  if (peercaps == NULL)
+    return;
+
+  if (gst_caps_is_empty (peercaps) || gst_caps_is_any (peercaps))
+    goto done;
+
+  n = gst_caps_get_size (peercaps);
+  for (i = 0; i < n; i++) {
+    const GstStructure *ps = gst_caps_get_structure (peercaps, i);
+
+    if (vorbis_dec_structure_accepts_channels (ps, vd->vi.channels)) {
+      s = gst_structure_copy (ps);
+      break;
+    }
+  }
+  if (s == NULL && vd->vi.channels > 1) {
+    for (i = 0; i < n; i++) {
+      const GstStructure *ps = gst_caps_get_structure (peercaps, i);
+
+      if (vorbis_dec_structure_accepts_channels (ps, 1)) {
+        s = gst_structure_copy (ps);
+        *downmix = TRUE;
+        break;
+      }
+    }
+  }
+  if (s == NULL)
+    goto done;
+
+  /* take the first layout downstream lists, interleaved if it doesn't care */
+  if (gst_structure_has_field (s, "layout")) {
+    gst_structure_fixate_field (s, "layout");
+    str = gst_structure_get_string (s, "layout");
+    if (g_strcmp0 (str, "non-interleaved") == 0)
+      *layout = GST_AUDIO_LAYOUT_NON_INTERLEAVED;
+  }
+  gst_structure_free (s);
+
+  GST_DEBUG_OBJECT (vd, "using %s layout%s",
+      *layout == GST_AUDIO_LAYOUT_INTERLEAVED ? "interleaved" :
+      "non-interleaved", *downmix ? ", downmixing to mono" : "");
+
+done:
+  gst_caps_unref (peercaps);
+}
+#endif
+
 static GstFlowReturn
 vorbis_handle_identification_packet (GstVorbisDec * vd)
 {
   GstAudioInfo info;
+  GstAudioLayout layout = GST_AUDIO_LAYOUT_INTERLEAVED;
+  gboolean downmix = FALSE;
+  gint channels = vd->vi.channels;
+
+#ifndef TREMOR
+  vorbis_dec_choose_output (vd, &layout, &downmix);
+  if (downmix)
+    channels = 1;
+#endif
 
-  switch (vd->vi.channels) {
+  switch (channels) {
     case 1:
     case 2:
     case 3:
@@ -179,9 +271,9 @@ vorbis_handle_identification_packet (GstVorbisDec * vd)
     {
       const GstAudioChannelPosition *pos;
 
-      pos = gst_vorbis_default_channel_positions[vd->vi.channels - 1];
+      pos = gst_vorbis_default_channel_positions[channels - 1];
       gst_audio_info_set_format (&info, GST_VORBIS_AUDIO_FORMAT, vd->vi.rate,
-          vd->vi.channels, pos);
+          channels, pos);
       break;
     }
     default:{
@@ -193,17 +285,19 @@ vorbis_handle_identification_packet (GstVorbisDec * vd)
       for (i = 0; i < max_pos; i++)
         position[i] = GST_AUDIO_CHANNEL_POSITION_NONE;
       gst_audio_info_set_format (&info, GST_VORBIS_AUDIO_FORMAT, vd->vi.rate,
-          vd->vi.channels, position);
+          channels, position);
       break;
     }
   }
+  info.layout = layout;
 
   gst_audio_decoder_set_output_format (GST_AUDIO_DECODER (vd), &info);
 
   vd->info = info;
   /* select a copy_samples function, this way we can have specialized versions
    * for mono/stereo and avoid the depth switch in tremor case */
-  vd->copy_samples = gst_vorbis_get_copy_sample_func (info.channels);
+  vd->copy_samples = gst_vorbis_get_copy_sample_func (vd->vi.channels,
+      layout, downmix);
 
   return GST_FLOW_OK;
 }
@@ -497,9 +591,10 @@ vorbis_handle_data_packet (GstVorbisDec * vd, ogg_packet * packet,
         vd->info.channels, gst_vorbis_channel_positions[vd->info.channels - 1],
         gst_vorbis_default_channel_positions[vd->info.channels - 1]);
 #else
-  /* copy samples in buffer */
+  /* copy samples in buffer, this takes the channels of the stream as we might
+   * be downmixing */
   vd->copy_samples ((vorbis_sample_t *) map.data, pcm,
-      sample_count, vd->info.channels);
+      sample_count, vd->vi.channels);
 #endif
 
   GST_LOG_OBJECT (vd, "have output size of %" G_GSIZE_FORMAT, size);
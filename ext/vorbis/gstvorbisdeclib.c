@@ -44,33 +44,18 @@ static void
 copy_samples_s (vorbis_sample_t * out, vorbis_sample_t ** in, guint samples,
     gint channels)
 {
-#ifdef GST_VORBIS_DEC_SEQUENTIAL
-  memcpy (out, in[0], samples * sizeof (float));
-  out += samples;
-  memcpy (out, in[1], samples * sizeof (float));
-#else
   gint j;
 
   for (j = 0; j < samples; j++) {
     *out++ = in[0][j];
     *out++ = in[1][j];
   }
-#endif
 }
 
 static void
 copy_samples (vorbis_sample_t * out, vorbis_sample_t ** in, guint samples,
     gint channels)
 {
-#ifdef GST_VORBIS_DEC_SEQUENTIAL
-  gint i;
-
-  for (i = 0; i < channels; i++) {
-    memcpy (out, in[gst_vorbis_reorder_map[channels - 1][i]],
-        samples * sizeof (float));
-    out += samples;
-  }
-#else
   gint i, j;
 
   for (j = 0; j < samples; j++) {
@@ -78,40 +63,97 @@ copy_samples (vorbis_sample_t * out, vorbis_sample_t ** in, guint samples,
       *out++ = in[gst_vorbis_reorder_map[channels - 1][i]][j];
     }
   }
-#endif
 }
 
 static void
 copy_samples_no_reorder (vorbis_sample_t * out, vorbis_sample_t ** in,
     guint samples, gint channels)
 {
-#ifdef GST_VORBIS_DEC_SEQUENTIAL
+  gint i, j;
+
+  for (j = 0; j < samples; j++) {
+    for (i = 0; i < channels; i++) {
+      *out++ = in[i][j];
+    }
+  }
+}
+
+/* non-interleaved output, the planes are stored one after the other so
+ * this is a plain memcpy per channel */
+static void
+copy_samples_planar (vorbis_sample_t * out, vorbis_sample_t ** in,
+    guint samples, gint channels)
+{
+  gint i;
+
+  for (i = 0; i < channels; i++) {
+    memcpy (out, in[gst_vorbis_reorder_map[channels - 1][i]],
+        samples * sizeof (float));
+    out += samples;
+  }
+}
+
+static void
+copy_samples_planar_no_reorder (vorbis_sample_t * out, vorbis_sample_t ** in,
+    guint samples, gint channels)
+{
   gint i;
 
   for (i = 0; i < channels; i++) {
     memcpy (out, in[i], samples * sizeof (float));
     out += samples;
   }
-#else
-  gint i, j;
+}
 
-  for (j = 0; j < samples; j++) {
-    for (i = 0; i < channels; i++) {
-      *out++ = in[i][j];
-    }
+/* average all channels into one, the LFE channel is left out of the mix. In
+ * the vorbis channel order it is always the last one of the 5.1, 6.1 and 7.1
+ * mappings */
+static void
+downmix_samples_m (vorbis_sample_t * out, vorbis_sample_t ** in,
+    guint samples, gint channels)
+{
+  gint i, j, mixed;
+  gfloat scale;
+
+  if (channels >= 6 && channels <= 8)
+    mixed = channels - 1;
+  else
+    mixed = channels;
+  scale = 1.0f / mixed;
+
+  for (j = 0; j < samples; j++)
+    out[j] = in[0][j];
+  for (i = 1; i < mixed; i++) {
+    const vorbis_sample_t *src = in[i];
+
+    for (j = 0; j < samples; j++)
+      out[j] += src[j];
   }
-#endif
+  for (j = 0; j < samples; j++)
+    out[j] *= scale;
 }
 
 CopySampleFunc
-gst_vorbis_get_copy_sample_func (gint channels)
+gst_vorbis_get_copy_sample_func (gint channels, GstAudioLayout layout,
+    gboolean downmix)
 {
   CopySampleFunc f = NULL;
 
+  /* mono output is the same in both layouts */
+  if (channels == 1)
+    return copy_samples_m;
+  if (downmix)
+    return downmix_samples_m;
+
+  if (layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED) {
+    if (channels <= 8)
+      f = copy_samples_planar;
+    else
+      f = copy_samples_planar_no_reorder;
+    return f;
+  }
+
   switch (channels) {
-    case 1:
-      f = copy_samples_m;
-      break;
     case 2:
       f = copy_samples_s;
       break;
@@ -203,10 +245,15 @@ copy_samples_16 (vorbis_sample_t * _out, vorbis_sample_t ** _in, guint samples,
 }
 
 CopySampleFunc
-gst_vorbis_get_copy_sample_func (gint channels)
+gst_vorbis_get_copy_sample_func (gint channels, GstAudioLayout layout,
+    gboolean downmix)
 {
   CopySampleFunc f = NULL;
 
+  /* the integer decoder only produces interleaved output */
+  g_return_val_if_fail (layout == GST_AUDIO_LAYOUT_INTERLEAVED, NULL);
+  g_return_val_if_fail (!downmix, NULL);
+
   switch (channels) {
     case 1:
       f = copy_samples_16_m;
@@ -39,7 +39,8 @@
     GST_STATIC_CAPS ("audio/x-raw, "  \
         "format = (string)" GST_VORBIS_AUDIO_FORMAT_STR ", "     \
         "rate = (int) [ 1, MAX ], "   \
-        "channels = (int) [ 1, 256 ]")
+        "channels = (int) [ 1, 256 ], " \
+        "layout = (string) { interleaved, non-interleaved }")
 
 #define GST_VORBIS_DEC_DEFAULT_SAMPLE_WIDTH           (32)
 
@@ -188,6 +189,7 @@ gst_ogg_packet_from_wrapper (ogg_packet_wrapper * packet)
 typedef void (*CopySampleFunc)(vorbis_sample_t *out, vorbis_sample_t **in,
                            guint samples, gint channels);
 
-CopySampleFunc gst_vorbis_get_copy_sample_func (gint channels);
+CopySampleFunc gst_vorbis_get_copy_sample_func (gint channels,
+    GstAudioLayout layout, gboolean downmix);
 
 #endif /* __GST_VORBIS_DEC_LIB_H__ */
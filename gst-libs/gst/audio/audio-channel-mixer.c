@@ -54,8 +54,8 @@ ensure_debug_category (void)
 
 #define PRECISION_INT 10
 
-typedef void (*MixerFunc) (GstAudioChannelMixer * mix, const gpointer src,
-    gpointer dst, gint samples);
+typedef void (*MixerFunc) (GstAudioChannelMixer * mix, const gpointer src[],
+    gpointer dst[], gint samples);
 
 struct _GstAudioChannelMixer
 {
@@ -710,101 +710,91 @@ gst_audio_channel_mixer_setup_matrix (GstAudioChannelMixer * mix)
 #endif
 }
 
-static void
-gst_audio_channel_mixer_mix_int16 (GstAudioChannelMixer * mix,
-    const gint16 * in_data, gint16 * out_data, gint samples)
-{
-  gint in, out, n;
-  gint32 res;
-  gint inchannels, outchannels;
-
-  inchannels = mix->in_channels;
-  outchannels = mix->out_channels;
-
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * mix->matrix_int[in][out];
-
-      /* remove factor from int matrix */
-      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
-      out_data[n * outchannels + out] = CLAMP (res, G_MININT16, G_MAXINT16);
-    }
-  }
+/* set up a pointer to the first sample of every channel and the distance
+ * between the samples of a channel for interleaved and non-interleaved
+ * layouts */
+#define SETUP_CHANNELS(type,ptrs,data,channels,stride,non_interleaved) \
+G_STMT_START {                                                          \
+  gint _c;                                                              \
+  if (non_interleaved) {                                                \
+    for (_c = 0; _c < channels; _c++)                                   \
+      ptrs[_c] = (type *) data[_c];                                     \
+    stride = 1;                                                         \
+  } else {                                                              \
+    for (_c = 0; _c < channels; _c++)                                   \
+      ptrs[_c] = (type *) data[0] + _c;                                 \
+    stride = channels;                                                  \
+  }                                                                     \
+} G_STMT_END
+
+#define DEFINE_INTEGER_MIX_FUNC(bits,resbits)                                   \
+static void                                                                     \
+gst_audio_channel_mixer_mix_int##bits (GstAudioChannelMixer * mix,              \
+    const gpointer in_data[], gpointer out_data[], gint samples)                \
+{                                                                               \
+  gint in, out, n, in_stride, out_stride;                                       \
+  gint##resbits res;                                                            \
+  gint inchannels, outchannels;                                                 \
+  const gint##bits *ip[64];                                                     \
+  gint##bits *op[64];                                                           \
+                                                                                \
+  inchannels = mix->in_channels;                                                \
+  outchannels = mix->out_channels;                                              \
+                                                                                \
+  SETUP_CHANNELS (const gint##bits, ip, in_data, inchannels, in_stride,         \
+      mix->flags & GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_IN);           \
+  SETUP_CHANNELS (gint##bits, op, out_data, outchannels, out_stride,            \
+      mix->flags & GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_OUT);          \
+                                                                                \
+  for (n = 0; n < samples; n++) {                                               \
+    for (out = 0; out < outchannels; out++) {                                   \
+      /* convert */                                                             \
+      res = 0;                                                                  \
+      for (in = 0; in < inchannels; in++)                                       \
+        res += ip[in][n * in_stride] * (gint##resbits) mix->matrix_int[in][out];\
+                                                                                \
+      /* remove factor from int matrix */                                       \
+      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;                \
+      op[out][n * out_stride] = CLAMP (res, G_MININT##bits, G_MAXINT##bits);    \
+    }                                                                           \
+  }                                                                             \
 }
 
-static void
-gst_audio_channel_mixer_mix_int32 (GstAudioChannelMixer * mix,
-    const gint32 * in_data, gint32 * out_data, gint samples)
-{
-  gint in, out, n;
-  gint64 res;
-  gint inchannels, outchannels;
-
-  inchannels = mix->in_channels;
-  outchannels = mix->out_channels;
-
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * (gint64) mix->matrix_int[in][out];
-
-      /* remove factor from int matrix */
-      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
-      out_data[n * outchannels + out] = CLAMP (res, G_MININT32, G_MAXINT32);
-    }
-  }
+#define DEFINE_FLOAT_MIX_FUNC(type,name)                                        \
+static void                                                                     \
+gst_audio_channel_mixer_mix_##name (GstAudioChannelMixer * mix,                 \
+    const gpointer in_data[], gpointer out_data[], gint samples)                \
+{                                                                               \
+  gint in, out, n, in_stride, out_stride;                                       \
+  type res;                                                                     \
+  gint inchannels, outchannels;                                                 \
+  const type *ip[64];                                                           \
+  type *op[64];                                                                 \
+                                                                                \
+  inchannels = mix->in_channels;                                                \
+  outchannels = mix->out_channels;                                              \
+                                                                                \
+  SETUP_CHANNELS (const type, ip, in_data, inchannels, in_stride,               \
+      mix->flags & GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_IN);           \
+  SETUP_CHANNELS (type, op, out_data, outchannels, out_stride,                  \
+      mix->flags & GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_OUT);          \
+                                                                                \
+  for (n = 0; n < samples; n++) {                                               \
+    for (out = 0; out < outchannels; out++) {                                   \
+      /* convert */                                                             \
+      res = 0.0;                                                                \
+      for (in = 0; in < inchannels; in++)                                       \
+        res += ip[in][n * in_stride] * mix->matrix[in][out];                    \
+                                                                                \
+      op[out][n * out_stride] = res;                                            \
+    }                                                                           \
+  }                                                                             \
 }
 
-static void
-gst_audio_channel_mixer_mix_float (GstAudioChannelMixer * mix,
-    const gfloat * in_data, gfloat * out_data, gint samples)
-{
-  gint in, out, n;
-  gfloat res;
-  gint inchannels, outchannels;
-
-  inchannels = mix->in_channels;
-  outchannels = mix->out_channels;
-
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0.0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * mix->matrix[in][out];
-
-      out_data[n * outchannels + out] = res;
-    }
-  }
-}
-
-static void
-gst_audio_channel_mixer_mix_double (GstAudioChannelMixer * mix,
-    const gdouble * in_data, gdouble * out_data, gint samples)
-{
-  gint in, out, n;
-  gdouble res;
-  gint inchannels, outchannels;
-
-  inchannels = mix->in_channels;
-  outchannels = mix->out_channels;
-
-  for (n = 0; n < samples; n++) {
-    for (out = 0; out < outchannels; out++) {
-      /* convert */
-      res = 0.0;
-      for (in = 0; in < inchannels; in++)
-        res += in_data[n * inchannels + in] * mix->matrix[in][out];
-
-      out_data[n * outchannels + out] = res;
-    }
-  }
-}
+DEFINE_INTEGER_MIX_FUNC (16, 32);
+DEFINE_INTEGER_MIX_FUNC (32, 64);
+DEFINE_FLOAT_MIX_FUNC (gfloat, float);
+DEFINE_FLOAT_MIX_FUNC (gdouble, double);
 
 /**
  * gst_audio_channel_mixer_new: (skip):
@@ -923,5 +913,5 @@ gst_audio_channel_mixer_samples (GstAudioChannelMixer * mix,
   g_return_if_fail (mix != NULL);
   g_return_if_fail (mix->matrix != NULL);
 
-  mix->func (mix, in[0], out[0], samples);
+  mix->func (mix, in, out, samples);
 }
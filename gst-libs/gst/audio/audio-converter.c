@@ -94,6 +94,9 @@ typedef gboolean (*AudioConvertSamplesFunc) (GstAudioConverter * convert,
  *  interleave
  *  deinterleave
  *  resample
+ *
+ * All steps work on the layout of the input. When the output has a different
+ * layout, the samples are (de)interleaved right before packing.
  */
 struct _GstAudioConverter
 {
@@ -139,6 +142,9 @@ struct _GstAudioConverter
   GstAudioQuantize *quant;
   AudioChain *quant_chain;
 
+  /* change layout */
+  AudioChain *change_layout_chain;
+
   /* pack */
   gboolean out_default;
   AudioChain *pack_chain;
@@ -564,6 +570,89 @@ do_quantize (AudioChain * chain, gpointer user_data)
   return TRUE;
 }
 
+#define DEFINE_INTERLEAVE_FUNCS(type,bits)                             \
+static void                                                             \
+interleave_##bits (type * out, const gpointer in[], gint channels,      \
+    gsize samples)                                                      \
+{                                                                       \
+  gint c;                                                               \
+  gsize n;                                                              \
+                                                                        \
+  for (c = 0; c < channels; c++) {                                      \
+    const type *i = in[c];                                              \
+    type *o = out + c;                                                  \
+    for (n = 0; n < samples; n++)                                       \
+      o[n * channels] = i[n];                                           \
+  }                                                                     \
+}                                                                       \
+                                                                        \
+static void                                                             \
+deinterleave_##bits (gpointer out[], const type * in, gint channels,    \
+    gsize samples)                                                      \
+{                                                                       \
+  gint c;                                                               \
+  gsize n;                                                              \
+                                                                        \
+  for (c = 0; c < channels; c++) {                                      \
+    const type *i = in + c;                                             \
+    type *o = out[c];                                                   \
+    for (n = 0; n < samples; n++)                                       \
+      o[n] = i[n * channels];                                           \
+  }                                                                     \
+}
+
+DEFINE_INTERLEAVE_FUNCS (guint16, 16);
+DEFINE_INTERLEAVE_FUNCS (guint32, 32);
+DEFINE_INTERLEAVE_FUNCS (guint64, 64);
+
+static gboolean
+do_change_layout (AudioChain * chain, gpointer user_data)
+{
+  GstAudioConverter *convert = user_data;
+  gsize num_samples;
+  gpointer *in, *out;
+  gint channels = convert->out.channels;
+
+  in = audio_chain_get_samples (chain->prev, &num_samples);
+  out = audio_chain_alloc_samples (chain, num_samples);
+  GST_LOG ("change layout %p, %p %" G_GSIZE_FORMAT, in, out, num_samples);
+
+  if (convert->out.layout == GST_AUDIO_LAYOUT_INTERLEAVED) {
+    switch (chain->finfo->width) {
+      case 16:
+        interleave_16 (out[0], in, channels, num_samples);
+        break;
+      case 32:
+        interleave_32 (out[0], in, channels, num_samples);
+        break;
+      case 64:
+        interleave_64 (out[0], in, channels, num_samples);
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  } else {
+    switch (chain->finfo->width) {
+      case 16:
+        deinterleave_16 (out, in[0], channels, num_samples);
+        break;
+      case 32:
+        deinterleave_32 (out, in[0], channels, num_samples);
+        break;
+      case 64:
+        deinterleave_64 (out, in[0], channels, num_samples);
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  }
+  audio_chain_set_samples (chain, out, num_samples);
+
+  return TRUE;
+}
+
 static gboolean
 is_intermediate_format (GstAudioFormat format)
 {
@@ -643,6 +732,9 @@ chain_mix (GstAudioConverter * convert, AudioChain * prev)
   flags |=
       GST_AUDIO_INFO_IS_UNPOSITIONED (out) ?
       GST_AUDIO_CHANNEL_MIXER_FLAGS_UNPOSITIONED_OUT : 0;
+  if (convert->current_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+    flags |= GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_IN |
+        GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_OUT;
 
   convert->current_channels = out->channels;
 
@@ -732,6 +824,7 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
   gboolean in_int, out_int;
   GstAudioDitherMethod dither;
   GstAudioNoiseShapingMethod ns;
+  GstAudioQuantizeFlags flags;
 
   dither = GET_OPT_DITHER_METHOD (convert);
   ns = GET_OPT_NOISE_SHAPING_METHOD (convert);
@@ -765,8 +858,11 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
   if (out_int && out_depth < 32
       && convert->current_format == GST_AUDIO_FORMAT_S32) {
     GST_INFO ("quantize to %d bits, dither %d, ns %d", out_depth, dither, ns);
+    flags = 0;
+    if (convert->current_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+      flags |= GST_AUDIO_QUANTIZE_FLAG_NON_INTERLEAVED;
     convert->quant =
-        gst_audio_quantize_new (dither, ns, 0, convert->current_format,
+        gst_audio_quantize_new (dither, ns, flags, convert->current_format,
         out->channels, 1U << (32 - out_depth));
 
     prev = convert->quant_chain = audio_chain_new (prev, convert);
@@ -777,6 +873,23 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
   return prev;
 }
 
+static AudioChain *
+chain_change_layout (GstAudioConverter * convert, AudioChain * prev)
+{
+  GstAudioInfo *out = &convert->out;
+
+  if (convert->current_layout != out->layout) {
+    GST_INFO ("change layout %d to %d", convert->current_layout, out->layout);
+    convert->current_layout = out->layout;
+
+    prev = convert->change_layout_chain = audio_chain_new (prev, convert);
+    prev->allow_ip = FALSE;
+    prev->pass_alloc = FALSE;
+    audio_chain_set_make_func (prev, do_change_layout, convert, NULL);
+  }
+  return prev;
+}
+
 static AudioChain *
 chain_pack (GstAudioConverter * convert, AudioChain * prev)
 {
@@ -919,8 +1032,6 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
 
   g_return_val_if_fail (in_info != NULL, FALSE);
   g_return_val_if_fail (out_info != NULL, FALSE);
-  g_return_val_if_fail (in_info->layout == GST_AUDIO_LAYOUT_INTERLEAVED, FALSE);
-  g_return_val_if_fail (in_info->layout == out_info->layout, FALSE);
 
   if ((GST_AUDIO_INFO_CHANNELS (in_info) != GST_AUDIO_INFO_CHANNELS (out_info))
       && (GST_AUDIO_INFO_IS_UNPOSITIONED (in_info)
@@ -952,14 +1063,16 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
   prev = chain_convert_out (convert, prev);
   /* step 6, optional quantize */
   prev = chain_quantize (convert, prev);
-  /* step 7, pack */
+  /* step 7, optional change of layout */
+  prev = chain_change_layout (convert, prev);
+  /* step 8, pack */
   convert->pack_chain = chain_pack (convert, prev);
 
   convert->convert = converter_generic;
 
   /* optimize */
   if (out_info->finfo->format == in_info->finfo->format
-      && convert->mix_passthrough) {
+      && out_info->layout == in_info->layout && convert->mix_passthrough) {
     if (convert->resampler == NULL) {
       GST_INFO
           ("same formats, no resampler and passthrough mixing -> passthrough");
@@ -1007,6 +1120,8 @@ gst_audio_converter_free (GstAudioConverter * convert)
     audio_chain_free (convert->convert_out_chain);
   if (convert->quant_chain)
     audio_chain_free (convert->quant_chain);
+  if (convert->change_layout_chain)
+    audio_chain_free (convert->change_layout_chain);
   if (convert->quant)
     gst_audio_quantize_free (convert->quant);
   if (convert->mix)
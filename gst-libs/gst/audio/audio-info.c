@@ -524,3 +524,40 @@ gst_audio_info_is_equal (const GstAudioInfo * info, const GstAudioInfo * other)
 
   return TRUE;
 }
+
+/**
+ * gst_audio_info_fill_planes:
+ * @info: a #GstAudioInfo
+ * @data: the memory with the samples
+ * @frames: the number of frames in @data
+ * @planes: (out caller-allocates) (array): location for the plane pointers
+ *
+ * Fill @planes with pointers to the samples in @data as expected by
+ * gst_audio_converter_samples(). For interleaved audio this is @data itself,
+ * for non-interleaved audio @data contains the channels of @frames samples
+ * one after the other and @planes receives a pointer for each of them.
+ *
+ * @planes needs room for GST_AUDIO_INFO_CHANNELS() pointers when the layout of
+ * @info is non-interleaved and for one pointer otherwise.
+ *
+ * Since: 1.10
+ */
+void
+gst_audio_info_fill_planes (const GstAudioInfo * info, gpointer data,
+    gsize frames, gpointer planes[])
+{
+  gint i;
+
+  g_return_if_fail (info != NULL);
+  g_return_if_fail (planes != NULL);
+
+  if (GST_AUDIO_INFO_LAYOUT (info) == GST_AUDIO_LAYOUT_NON_INTERLEAVED) {
+    gsize plane_size = frames * (GST_AUDIO_INFO_BPF (info) /
+        GST_AUDIO_INFO_CHANNELS (info));
+
+    for (i = 0; i < GST_AUDIO_INFO_CHANNELS (info); i++)
+      planes[i] = (guint8 *) data + i * plane_size;
+  } else {
+    planes[0] = data;
+  }
+}
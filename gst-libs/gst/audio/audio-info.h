@@ -131,6 +131,9 @@ gboolean       gst_audio_info_convert     (const GstAudioInfo * info,
 gboolean       gst_audio_info_is_equal    (const GstAudioInfo *info,
                                            const GstAudioInfo *other);
 
+void           gst_audio_info_fill_planes (const GstAudioInfo *info, gpointer data,
+                                           gsize frames, gpointer planes[]);
+
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstAudioInfo, gst_audio_info_free)
 #endif
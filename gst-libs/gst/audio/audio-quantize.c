@@ -51,6 +51,9 @@ struct _GstAudioQuantize
 
   /* last random number generated per channel for hifreq TPDF dither */
   gpointer last_random;
+  /* state of the random number generators, one per generated number */
+  guint random_size;
+  gpointer random_buf;
   /* contains the past quantization errors, error[channels][count] */
   guint error_size;
   gpointer error_buf;
@@ -60,17 +63,18 @@ struct _GstAudioQuantize
   /* noise shaping coefficients */
   gpointer coeffs;
   gint n_coeffs;
+  /* filtered error per channel of the current frame */
+  gpointer ns_acc;
 
   QuantizeFunc quantize;
 };
 
-#define ADDSS(res,val) \
-        if (val > 0 && res > 0 && G_MAXINT32 - res <= val){             \
-          res = G_MAXINT32;                                             \
-        } else if (val < 0 && res < 0 && G_MININT32 - res >= val){      \
-          res = G_MININT32;                                             \
-        } else                                                          \
-          res += val;
+/* saturating add, written without branches so that loops using it can be
+ * vectorised */
+#define ADDSS(res,val) G_STMT_START {                                   \
+          gint64 _t = (gint64) (res) + (val);                           \
+          res = (gint32) CLAMP (_t, G_MININT32, G_MAXINT32);            \
+        } G_STMT_END
 
 static void
 gst_audio_quantize_quantize_memcpy (GstAudioQuantize * quant,
@@ -89,27 +93,49 @@ gst_audio_quantize_quantize_int_none_none (GstAudioQuantize * quant,
       samples * quant->stride);
 }
 
-/* This is the base function, implementing a linear congruential generator
- * and returning a pseudo random number between 0 and 2^32 - 1.
- */
-static inline guint32
-gst_fast_random_uint32 (void)
+/* Seed for random lane @lane. The index is hashed so that neighbouring lanes,
+ * which are used for neighbouring samples, produce uncorrelated sequences. */
+static guint32
+random_seed (guint32 lane)
 {
-  static guint32 state = 0xdeadbeef;
-  return (state = state * 1103515245 + 12345);
+  guint32 h = lane * 0x9e3779b9 + 0xdeadbeef;
+
+  h ^= h >> 16;
+  h *= 0x85ebca6b;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35;
+  h ^= h >> 16;
+
+  return h;
 }
 
-static inline gint32
-gst_fast_random_int32 (void)
+/* Advance @len independent linear congruential generators, one for each
+ * generated random number, and return their state. All lanes are updated in
+ * one vectorised pass instead of serially stepping a single generator. */
+static const guint32 *
+setup_random_buf (GstAudioQuantize * quant, gint len)
 {
-  return (gint32) gst_fast_random_uint32 ();
+  guint32 *r;
+  gint i;
+
+  if (quant->random_size < len) {
+    quant->random_buf = g_realloc (quant->random_buf, len * sizeof (guint32));
+    r = quant->random_buf;
+    for (i = quant->random_size; i < len; i++)
+      r[i] = random_seed (i);
+    quant->random_size = len;
+  }
+  r = quant->random_buf;
+  audio_orc_update_rand (r, len);
+
+  return r;
 }
 
-/* Assuming dither == 2^n,
- * returns one of 2^(n+1) possible random values:
+/* Assuming dither == 2^n, maps the top n+1 bits of a random number to
+ * one of 2^(n+1) possible random values:
  * -dither <= retval < dither */
-#define RANDOM_INT_DITHER(dither)                                       \
-  (- dither + (gst_fast_random_int32 () & ((dither << 1) - 1)))
+#define RANDOM_INT_DITHER(r,dither,shift)                               \
+  (- (dither) + (gint32) ((r) >> (31 - (shift))))
 
 static void
 setup_dither_buf (GstAudioQuantize * quant, gint samples)
@@ -120,6 +146,7 @@ setup_dither_buf (GstAudioQuantize * quant, gint samples)
   guint shift = quant->shift;
   guint32 bias;
   gint32 dither, *d;
+  const guint32 *r;
 
   if (quant->dither_size < len) {
     quant->dither_size = len;
@@ -140,26 +167,35 @@ setup_dither_buf (GstAudioQuantize * quant, gint samples)
 
     case GST_AUDIO_DITHER_RPDF:
       dither = 1 << (shift);
+      r = setup_random_buf (quant, len);
       for (i = 0; i < len; i++)
-        d[i] = bias + RANDOM_INT_DITHER (dither);
+        d[i] = bias + RANDOM_INT_DITHER (r[i], dither, shift);
       break;
 
     case GST_AUDIO_DITHER_TPDF:
       dither = 1 << (shift - 1);
+      r = setup_random_buf (quant, 2 * len);
       for (i = 0; i < len; i++)
-        d[i] = bias + RANDOM_INT_DITHER (dither) + RANDOM_INT_DITHER (dither);
+        d[i] = bias + RANDOM_INT_DITHER (r[i], dither, shift - 1) +
+            RANDOM_INT_DITHER (r[len + i], dither, shift - 1);
       break;
 
     case GST_AUDIO_DITHER_TPDF_HF:
     {
-      gint32 tmp, *last_random = quant->last_random;
+      gint32 *last_random = quant->last_random;
 
       dither = 1 << (shift - 1);
-      for (i = 0; i < len; i++) {
-        tmp = RANDOM_INT_DITHER (dither);
-        d[i] = bias + tmp - last_random[i % stride];
-        last_random[i % stride] = tmp;
-      }
+      r = setup_random_buf (quant, len);
+      /* the first frame uses the random values of the previous call */
+      for (i = 0; i < MIN (stride, len); i++)
+        d[i] = bias + RANDOM_INT_DITHER (r[i], dither, shift - 1) -
+            last_random[i];
+      for (; i < len; i++)
+        d[i] = bias + RANDOM_INT_DITHER (r[i], dither, shift - 1) -
+            RANDOM_INT_DITHER (r[i - stride], dither, shift - 1);
+      for (i = 0; i < MIN (stride, len); i++)
+        last_random[i] =
+            RANDOM_INT_DITHER (r[len - stride + i], dither, shift - 1);
       break;
     }
   }
@@ -194,7 +230,7 @@ gst_audio_quantize_quantize_int_dither_feedback (GstAudioQuantize * quant,
     const gpointer src, gpointer dst, gint samples)
 {
   guint32 mask;
-  gint i, len, stride;
+  gint i, j, len, stride;
   const gint32 *s = src;
   gint32 *dith, *d = dst, v, o, *e, err;
 
@@ -207,18 +243,25 @@ gst_audio_quantize_quantize_int_dither_feedback (GstAudioQuantize * quant,
   e = quant->error_buf;
   mask = ~quant->mask;
 
-  for (i = 0; i < len; i++) {
-    o = v = s[i];
-    /* add dither */
-    err = dith[i];
-    /* remove error */
-    err -= e[i];
-    ADDSS (v, err);
-    v &= mask;
-    /* store new error */
-    e[i + stride] = e[i] + (v - o);
-    /* store result */
-    d[i] = v;
+  /* process frame by frame, the channels within a frame don't depend on
+   * each other */
+  for (i = 0; i < len; i += stride) {
+    const gint32 *ep = &e[i];
+    gint32 *en = &e[i + stride];
+
+    for (j = 0; j < stride; j++) {
+      o = v = s[i + j];
+      /* add dither */
+      err = dith[i + j];
+      /* remove error */
+      err -= ep[j];
+      ADDSS (v, err);
+      v &= mask;
+      /* store new error */
+      en[j] = ep[j] + (v - o);
+      /* store result */
+      d[i + j] = v;
+    }
   }
   memmove (e, &e[len], sizeof (gint32) * stride);
 }
@@ -236,7 +279,7 @@ gst_audio_quantize_quantize_int_dither_noise_shape (GstAudioQuantize * quant,
   guint32 mask;
   gint i, j, k, len, stride, nc;
   const gint32 *s = src;
-  gint32 *c, *dith, *d = dst, v, o, *e, err;
+  gint32 *c, *dith, *d = dst, v, o, *e, *en, *acc, err;
 
   nc = quant->n_coeffs;
 
@@ -250,24 +293,40 @@ gst_audio_quantize_quantize_int_dither_noise_shape (GstAudioQuantize * quant,
   c = quant->coeffs;
   mask = ~quant->mask;
 
-  for (i = 0; i < len; i++) {
-    v = s[i];
-    /* combine and remove error */
-    err = 0;
-    for (j = 0, k = i; j < nc; j++, k += stride)
-      err -= e[k] * c[j];
-    err = (err + SROUND) >> (SREDUCE);
-    ADDSS (v, err);
-    o = v;
-    /* add dither */
-    err = dith[i];
-    ADDSS (v, err);
-    /* quantize */
-    v &= mask;
-    /* store new error with reduced precision */
-    e[k] = (v - o + RROUND) >> REDUCE;
-    /* store result */
-    d[i] = v;
+  acc = quant->ns_acc;
+
+  /* process frame by frame. The error filter is evaluated one coefficient
+   * at a time for all channels of the frame, which are independent of each
+   * other, instead of running the whole filter per sample. */
+  for (i = 0; i < len; i += stride) {
+    for (k = 0; k < stride; k++)
+      acc[k] = 0;
+
+    for (j = 0; j < nc; j++) {
+      const gint32 *ep = &e[i + j * stride];
+      gint32 cj = c[j];
+
+      for (k = 0; k < stride; k++)
+        acc[k] -= ep[k] * cj;
+    }
+
+    en = &e[i + nc * stride];
+    for (k = 0; k < stride; k++) {
+      v = s[i + k];
+      /* combine and remove error */
+      err = (acc[k] + SROUND) >> (SREDUCE);
+      ADDSS (v, err);
+      o = v;
+      /* add dither */
+      err = dith[i + k];
+      ADDSS (v, err);
+      /* quantize */
+      v &= mask;
+      /* store new error with reduced precision */
+      en[k] = (v - o + RROUND) >> REDUCE;
+      /* store result */
+      d[i + k] = v;
+    }
   }
   memmove (e, &e[len], sizeof (gint32) * stride * nc);
 }
@@ -359,6 +418,7 @@ gst_audio_quantize_setup_noise_shaping (GstAudioQuantize * quant)
     q = quant->coeffs = g_new0 (gint32, n_coeffs);
     for (i = 0; i < n_coeffs; i++)
       q[i] = floor (coeffs[i] * (1 << SHIFT) + 0.5);
+    quant->ns_acc = g_new0 (gint32, quant->stride);
   }
   return;
 }
@@ -479,6 +539,8 @@ gst_audio_quantize_free (GstAudioQuantize * quant)
   g_free (quant->coeffs);
   g_free (quant->last_random);
   g_free (quant->dither_buf);
+  g_free (quant->random_buf);
+  g_free (quant->ns_acc);
 
   g_slice_free (GstAudioQuantize, quant);
 }
@@ -34,6 +34,7 @@
 
 #include <gst/audio/audio.h>
 #include "gstaudiobasesink.h"
+#include "gstaudioutilsprivate.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_audio_base_sink_debug);
 #define GST_CAT_DEFAULT gst_audio_base_sink_debug
@@ -74,6 +75,40 @@ struct _GstAudioBaseSinkPrivate
   GstAudioBaseSinkCustomSlavingCallback custom_slaving_callback;
   gpointer custom_slaving_cb_data;
   GDestroyNotify custom_slaving_cb_notify;
+
+  /* resampler used for resample slaving, with the current output rate and
+   * the integral term of the drift controller */
+  GstAudioResampler *resampler;
+  gint resample_out_rate;
+  gdouble drift_integral;
+  gpointer resample_buf;
+  gsize resample_buf_size;
+
+  /* statistics, with LOCK */
+  GstClockTime stats_interval;
+  guint64 resyncs;
+  /* last time we posted statistics, streaming thread only */
+  gint64 last_stats_post;
+
+  /* adaptive latency, with LOCK. adaptive_segs is the number of ringbuffer
+   * segments we currently report as latency and write ahead of the device */
+  gboolean adaptive_latency;
+  gint adaptive_segs;
+  /* if we and upstream are live, from the last latency query */
+  gboolean live;
+  /* streaming thread only: the smallest distance between the write position
+   * and the device seen in the current window, in samples, the number of
+   * samples in the window and the pipeline latency the segments were last
+   * changed for */
+  gint64 adaptive_min_headroom;
+  guint64 adaptive_window;
+  gboolean adaptive_pending;
+  GstClockTime adaptive_latency_time;
+  /* streaming thread only: samples we still have to move the write position
+   * by after a latency change and samples written since we last dropped one
+   * to get there */
+  gint64 adaptive_offset;
+  guint64 adaptive_compress_acc;
 };
 
 /* BaseAudioSink signals and args */
@@ -104,6 +139,39 @@ enum
  * fix itself, or is a permanent offset */
 #define DEFAULT_DISCONT_WAIT        (1 * GST_SECOND)
 
+/* don't collect statistics by default */
+#define DEFAULT_STATS_INTERVAL      0
+
+#define DEFAULT_ADAPTIVE_LATENCY    FALSE
+
+/* in adaptive latency mode we start with this many segments and never go
+ * below it */
+#define ADAPTIVE_MIN_SEGMENTS       2
+/* segments to add after an underrun */
+#define ADAPTIVE_GROW_SEGMENTS      2
+/* a segment is removed when the write position stayed at least this many
+ * segments ahead of the device during a whole window */
+#define ADAPTIVE_SHRINK_HEADROOM    2
+/* length of the observation window in seconds */
+#define ADAPTIVE_WINDOW             2
+/* after the latency went down, drop one sample every this many samples until
+ * we reach the new write position. The ringbuffer drops the nearest sample,
+ * so this must be rare to stay inaudible. */
+#define ADAPTIVE_COMPRESS_INTERVAL  2000
+
+/* resample slaving runs the resampler at RESAMPLE_RATE_DENOM input rate, the
+ * output rate is adjusted around it, which gives a 10ppm resolution */
+#define RESAMPLE_RATE_DENOM         100000
+#define RESAMPLE_QUALITY            GST_AUDIO_RESAMPLER_QUALITY_DEFAULT
+/* gains of the PI controller that turns the distance between where the master
+ * clock wants the samples and where they are written in the ringbuffer, in
+ * seconds, into a rate correction. These give a slightly overdamped loop with
+ * a time constant of about 20 seconds. */
+#define RESAMPLE_KP                 0.05
+#define RESAMPLE_KI                 0.0005
+/* never correct the rate by more than 0.5% */
+#define RESAMPLE_MAX_CORRECTION     0.005
+
 enum
 {
   PROP_0,
@@ -116,6 +184,9 @@ enum
   PROP_ALIGNMENT_THRESHOLD,
   PROP_DRIFT_TOLERANCE,
   PROP_DISCONT_WAIT,
+  PROP_STATS,
+  PROP_STATS_INTERVAL,
+  PROP_ADAPTIVE_LATENCY,
 
   PROP_LAST
 };
@@ -166,6 +237,9 @@ static gboolean gst_audio_base_sink_query (GstElement * element, GstQuery *
 
 static GstClock *gst_audio_base_sink_provide_clock (GstElement * elem);
 static inline void gst_audio_base_sink_reset_sync (GstAudioBaseSink * sink);
+static void gst_audio_base_sink_free_resampler (GstAudioBaseSink * sink);
+static void gst_audio_base_sink_set_adaptive_latency (GstAudioBaseSink * sink,
+    gboolean enabled);
 static GstClockTime gst_audio_base_sink_get_time (GstClock * clock,
     GstAudioBaseSink * sink);
 static void gst_audio_base_sink_callback (GstAudioRingBuffer * rbuf,
@@ -272,6 +346,62 @@ gst_audio_base_sink_class_init (GstAudioBaseSinkClass * klass)
           G_MAXUINT64 - 1, DEFAULT_DISCONT_WAIT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSink:stats:
+   *
+   * Statistics collected by the sink while #GstAudioBaseSink:stats-interval
+   * is non-zero. Contains the fields described in
+   * gst_audio_ring_buffer_get_stats() and:
+   *
+   * "resyncs" G_TYPE_UINT64: the number of times the sink had to resync
+   *   because the timestamps drifted more than
+   *   #GstAudioBaseSink:alignment-threshold from the previous samples.
+   *
+   * Since: 1.10
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Underrun, fill level and timing statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioBaseSink:stats-interval:
+   *
+   * Interval in nanoseconds at which the sink posts its
+   * #GstAudioBaseSink:stats as a "GstAudioBaseSinkStats" element message.
+   * 0 disables the collection of statistics.
+   *
+   * Since: 1.10
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint64 ("stats-interval", "Statistics Interval",
+          "Interval in nanoseconds between statistics messages "
+          "(0 = collect no statistics)", 0, G_MAXUINT64,
+          DEFAULT_STATS_INTERVAL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioBaseSink:adaptive-latency:
+   *
+   * When live, only use as much of the ringbuffer configured with
+   * #GstAudioBaseSink:buffer-time as needed to avoid underruns. The sink
+   * starts with a small latency, adds segments when it underruns and removes
+   * them again when the samples arrive well ahead of the device for a while.
+   * The sink never writes further ahead of the device than the segments in
+   * use. A latency message is posted for every change. Once the pipeline
+   * latency is updated, a higher latency moves the samples to the new
+   * position at once, as the device ran out of samples already. For a lower
+   * latency, one sample in 2000 is dropped until the samples are written at
+   * the new position, or the clock slaving resampler moves them there when
+   * #GstAudioBaseSink:slave-method is %GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE.
+   *
+   * Since: 1.10
+   */
+  g_object_class_install_property (gobject_class, PROP_ADAPTIVE_LATENCY,
+      g_param_spec_boolean ("adaptive-latency", "Adaptive Latency",
+          "Adapt the latency to the observed underruns and jitter when live",
+          DEFAULT_ADAPTIVE_LATENCY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_sink_change_state);
   gstelement_class->provide_clock =
@@ -309,6 +439,11 @@ gst_audio_base_sink_init (GstAudioBaseSink * audiobasesink)
   audiobasesink->latency_time = DEFAULT_LATENCY_TIME;
   audiobasesink->priv->slave_method = DEFAULT_SLAVE_METHOD;
   audiobasesink->priv->drift_tolerance = DEFAULT_DRIFT_TOLERANCE;
+  audiobasesink->priv->stats_interval = DEFAULT_STATS_INTERVAL;
+  audiobasesink->priv->last_stats_post = -1;
+  audiobasesink->priv->adaptive_latency = DEFAULT_ADAPTIVE_LATENCY;
+  audiobasesink->priv->adaptive_min_headroom = G_MAXINT64;
+  audiobasesink->priv->adaptive_latency_time = GST_CLOCK_TIME_NONE;
   audiobasesink->priv->alignment_threshold = DEFAULT_ALIGNMENT_THRESHOLD;
   audiobasesink->priv->discont_wait = DEFAULT_DISCONT_WAIT;
   audiobasesink->priv->custom_slaving_callback = NULL;
@@ -351,6 +486,8 @@ gst_audio_base_sink_dispose (GObject * object)
     sink->ringbuffer = NULL;
   }
 
+  gst_audio_base_sink_free_resampler (sink);
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -460,6 +597,7 @@ gst_audio_base_sink_query (GstElement * element, GstQuery * query)
         /* we and upstream are both live, adjust the min_latency */
         if (live && us_live) {
           GstAudioRingBufferSpec *spec;
+          gint seglatency;
 
           GST_OBJECT_LOCK (basesink);
           if (!basesink->ringbuffer || !basesink->ringbuffer->spec.info.rate) {
@@ -473,9 +611,16 @@ gst_audio_base_sink_query (GstElement * element, GstQuery * query)
           spec = &basesink->ringbuffer->spec;
 
           basesink->priv->us_latency = min_l;
+          basesink->priv->live = TRUE;
+
+          /* in adaptive mode we only use part of the ringbuffer */
+          seglatency = spec->seglatency;
+          if (basesink->priv->adaptive_latency
+              && basesink->priv->adaptive_segs > 0)
+            seglatency -= spec->segtotal - basesink->priv->adaptive_segs;
 
           base_latency =
-              gst_util_uint64_scale_int (spec->seglatency * spec->segsize,
+              gst_util_uint64_scale_int (seglatency * spec->segsize,
               GST_SECOND, spec->info.rate * spec->info.bpf);
           GST_OBJECT_UNLOCK (basesink);
 
@@ -496,6 +641,9 @@ gst_audio_base_sink_query (GstElement * element, GstQuery * query)
         } else {
           GST_DEBUG_OBJECT (basesink,
               "peer or we are not live, don't care about latency");
+          GST_OBJECT_LOCK (basesink);
+          basesink->priv->live = FALSE;
+          GST_OBJECT_UNLOCK (basesink);
           min_latency = min_l;
           max_latency = max_l;
         }
@@ -845,6 +993,49 @@ gst_audio_base_sink_get_discont_wait (GstAudioBaseSink * sink)
   return result;
 }
 
+static GstStructure *
+gst_audio_base_sink_get_stats (GstAudioBaseSink * sink)
+{
+  GstStructure *s;
+
+  GST_OBJECT_LOCK (sink);
+  if (sink->ringbuffer) {
+    s = gst_audio_ring_buffer_get_stats (sink->ringbuffer);
+    gst_structure_set_name (s, "GstAudioBaseSinkStats");
+  } else {
+    s = gst_structure_new_empty ("GstAudioBaseSinkStats");
+  }
+  gst_structure_set (s, "resyncs", G_TYPE_UINT64, sink->priv->resyncs, NULL);
+  GST_OBJECT_UNLOCK (sink);
+
+  return s;
+}
+
+/* post the statistics when stats-interval passed since we last did */
+static void
+gst_audio_base_sink_post_stats (GstAudioBaseSink * sink)
+{
+  GstClockTime interval;
+  gint64 now;
+
+  GST_OBJECT_LOCK (sink);
+  interval = sink->priv->stats_interval;
+  GST_OBJECT_UNLOCK (sink);
+
+  if (G_LIKELY (interval == 0))
+    return;
+
+  now = g_get_monotonic_time ();
+  if (sink->priv->last_stats_post != -1 &&
+      (now - sink->priv->last_stats_post) * GST_USECOND < interval)
+    return;
+  sink->priv->last_stats_post = now;
+
+  gst_element_post_message (GST_ELEMENT_CAST (sink),
+      gst_message_new_element (GST_OBJECT_CAST (sink),
+          gst_audio_base_sink_get_stats (sink)));
+}
+
 static void
 gst_audio_base_sink_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
@@ -879,6 +1070,18 @@ gst_audio_base_sink_set_property (GObject * object, guint prop_id,
     case PROP_DISCONT_WAIT:
       gst_audio_base_sink_set_discont_wait (sink, g_value_get_uint64 (value));
       break;
+    case PROP_STATS_INTERVAL:
+      GST_OBJECT_LOCK (sink);
+      sink->priv->stats_interval = g_value_get_uint64 (value);
+      if (sink->ringbuffer)
+        gst_audio_ring_buffer_set_stats_enabled (sink->ringbuffer,
+            sink->priv->stats_interval > 0);
+      GST_OBJECT_UNLOCK (sink);
+      break;
+    case PROP_ADAPTIVE_LATENCY:
+      gst_audio_base_sink_set_adaptive_latency (sink,
+          g_value_get_boolean (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -919,6 +1122,19 @@ gst_audio_base_sink_get_property (GObject * object, guint prop_id,
     case PROP_DISCONT_WAIT:
       g_value_set_uint64 (value, gst_audio_base_sink_get_discont_wait (sink));
       break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_audio_base_sink_get_stats (sink));
+      break;
+    case PROP_STATS_INTERVAL:
+      GST_OBJECT_LOCK (sink);
+      g_value_set_uint64 (value, sink->priv->stats_interval);
+      GST_OBJECT_UNLOCK (sink);
+      break;
+    case PROP_ADAPTIVE_LATENCY:
+      GST_OBJECT_LOCK (sink);
+      g_value_set_boolean (value, sink->priv->adaptive_latency);
+      GST_OBJECT_UNLOCK (sink);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -960,6 +1176,9 @@ gst_audio_base_sink_setcaps (GstBaseSink * bsink, GstCaps * caps)
   gst_audio_ring_buffer_activate (sink->ringbuffer, FALSE);
   gst_audio_ring_buffer_release (sink->ringbuffer);
 
+  /* the resampler is created again for the new format when needed */
+  gst_audio_base_sink_free_resampler (sink);
+
   GST_DEBUG_OBJECT (sink, "parse caps");
 
   spec->buffer_time = sink->buffer_time;
@@ -983,6 +1202,14 @@ gst_audio_base_sink_setcaps (GstBaseSink * bsink, GstCaps * caps)
   /* We need to resync since the ringbuffer restarted */
   gst_audio_base_sink_reset_sync (sink);
 
+  /* start adapting from the smallest latency again */
+  GST_OBJECT_LOCK (sink);
+  if (sink->priv->adaptive_latency)
+    sink->priv->adaptive_segs = MIN (ADAPTIVE_MIN_SEGMENTS, spec->segtotal);
+  else
+    sink->priv->adaptive_segs = spec->segtotal;
+  GST_OBJECT_UNLOCK (sink);
+
   gst_audio_base_sink_custom_cb_report_discont (sink,
       GST_AUDIO_BASE_SINK_DISCONT_REASON_NEW_CAPS);
 
@@ -1066,6 +1293,233 @@ gst_audio_base_sink_reset_sync (GstAudioBaseSink * sink)
   sink->priv->discont_time = -1;
   sink->priv->avg_skew = -1;
   sink->priv->last_align = 0;
+  sink->priv->drift_integral = 0.0;
+  if (sink->priv->resampler)
+    gst_audio_resampler_reset (sink->priv->resampler);
+  sink->priv->adaptive_min_headroom = G_MAXINT64;
+  sink->priv->adaptive_window = 0;
+  sink->priv->adaptive_pending = FALSE;
+  sink->priv->adaptive_latency_time = GST_CLOCK_TIME_NONE;
+  sink->priv->adaptive_offset = 0;
+  sink->priv->adaptive_compress_acc = 0;
+}
+
+static void
+gst_audio_base_sink_set_adaptive_latency (GstAudioBaseSink * sink,
+    gboolean enabled)
+{
+  gboolean changed;
+
+  GST_OBJECT_LOCK (sink);
+  changed = (sink->priv->adaptive_latency != enabled);
+  sink->priv->adaptive_latency = enabled;
+  /* keep the current latency, we'll shrink from there when enabled */
+  if (sink->ringbuffer && sink->ringbuffer->spec.segtotal > 0)
+    sink->priv->adaptive_segs = sink->ringbuffer->spec.segtotal;
+  /* and allow writing to the whole ringbuffer again */
+  if (sink->ringbuffer)
+    __gst_audio_ring_buffer_set_write_segments (sink->ringbuffer, 0);
+  GST_OBJECT_UNLOCK (sink);
+
+  if (changed && !enabled)
+    gst_element_post_message (GST_ELEMENT_CAST (sink),
+        gst_message_new_latency (GST_OBJECT_CAST (sink)));
+}
+
+/* called from the streaming thread right before we write @samples samples at
+ * @sample_offset. Measures how far ahead of the device we write and changes
+ * the number of segments we use for latency when needed. */
+static void
+gst_audio_base_sink_adapt_latency (GstAudioBaseSink * sink,
+    guint64 sample_offset, guint samples)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  GstAudioRingBuffer *ringbuf = sink->ringbuffer;
+  gint segdone, segs, new_segs, sps;
+  gint64 headroom;
+
+  /* the device did not start yet, nothing to measure */
+  if (g_atomic_int_get (&ringbuf->state) != GST_AUDIO_RING_BUFFER_STATE_STARTED)
+    return;
+
+  /* wait until the pipeline picked up the last change, or give up waiting
+   * after a window when the pipeline latency is not ours to change */
+  if (priv->adaptive_pending) {
+    priv->adaptive_window += samples;
+    if (priv->adaptive_window <
+        (guint64) ADAPTIVE_WINDOW * ringbuf->spec.info.rate)
+      return;
+    priv->adaptive_pending = FALSE;
+    priv->adaptive_window = 0;
+  }
+
+  sps = ringbuf->samples_per_seg;
+  segdone = g_atomic_int_get (&ringbuf->segdone) - ringbuf->segbase;
+  headroom = (gint64) sample_offset - (gint64) segdone * sps;
+
+  GST_OBJECT_LOCK (sink);
+  segs = new_segs = priv->adaptive_segs;
+
+  if (headroom < 0) {
+    /* we are too late for the device, grow quickly */
+    new_segs = MIN (segs + ADAPTIVE_GROW_SEGMENTS, ringbuf->spec.segtotal);
+    priv->adaptive_min_headroom = G_MAXINT64;
+    priv->adaptive_window = 0;
+  } else {
+    priv->adaptive_min_headroom = MIN (priv->adaptive_min_headroom, headroom);
+    priv->adaptive_window += samples;
+
+    if (priv->adaptive_window >=
+        (guint64) ADAPTIVE_WINDOW * ringbuf->spec.info.rate) {
+      /* we had spare room during the whole window, give back a segment */
+      if (priv->adaptive_min_headroom >=
+          (gint64) ADAPTIVE_SHRINK_HEADROOM * sps)
+        new_segs = MAX (segs - 1, ADAPTIVE_MIN_SEGMENTS);
+      priv->adaptive_min_headroom = G_MAXINT64;
+      priv->adaptive_window = 0;
+    }
+  }
+  priv->adaptive_segs = new_segs;
+  GST_OBJECT_UNLOCK (sink);
+
+  if (new_segs == segs)
+    return;
+
+  GST_DEBUG_OBJECT (sink, "headroom %" G_GINT64_FORMAT " samples, "
+      "latency segments %d -> %d", headroom, segs, new_segs);
+
+  priv->adaptive_pending = TRUE;
+  priv->adaptive_window = 0;
+  gst_element_post_message (GST_ELEMENT_CAST (sink),
+      gst_message_new_latency (GST_OBJECT_CAST (sink)));
+}
+
+static void
+gst_audio_base_sink_free_resampler (GstAudioBaseSink * sink)
+{
+  if (sink->priv->resampler) {
+    gst_audio_resampler_free (sink->priv->resampler);
+    sink->priv->resampler = NULL;
+  }
+  g_free (sink->priv->resample_buf);
+  sink->priv->resample_buf = NULL;
+  sink->priv->resample_buf_size = 0;
+  sink->priv->drift_integral = 0.0;
+}
+
+/* create a variable rate resampler for the negotiated format, returns FALSE
+ * when the format can't be resampled */
+static gboolean
+gst_audio_base_sink_ensure_resampler (GstAudioBaseSink * sink)
+{
+  GstAudioRingBufferSpec *spec = &sink->ringbuffer->spec;
+  GstAudioFormat format;
+  GstStructure *options;
+
+  if (G_LIKELY (sink->priv->resampler))
+    return TRUE;
+
+  if (spec->type != GST_AUDIO_RING_BUFFER_FORMAT_TYPE_RAW)
+    return FALSE;
+
+  format = GST_AUDIO_INFO_FORMAT (&spec->info);
+  if (format != GST_AUDIO_FORMAT_S16 && format != GST_AUDIO_FORMAT_S32 &&
+      format != GST_AUDIO_FORMAT_F32 && format != GST_AUDIO_FORMAT_F64)
+    return FALSE;
+
+  /* the rate changes all the time, make sure we get interpolated filter
+   * tables instead of recalculating a full table on each update */
+  options = gst_structure_new_empty ("GstAudioResampler.options");
+  gst_audio_resampler_options_set_quality (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      RESAMPLE_QUALITY, RESAMPLE_RATE_DENOM, RESAMPLE_RATE_DENOM, options);
+  gst_structure_set (options, GST_AUDIO_RESAMPLER_OPT_FILTER_MODE,
+      GST_TYPE_AUDIO_RESAMPLER_FILTER_MODE,
+      GST_AUDIO_RESAMPLER_FILTER_MODE_INTERPOLATED, NULL);
+
+  sink->priv->resampler =
+      gst_audio_resampler_new (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      GST_AUDIO_RESAMPLER_FLAG_VARIABLE_RATE, format,
+      GST_AUDIO_INFO_CHANNELS (&spec->info), RESAMPLE_RATE_DENOM,
+      RESAMPLE_RATE_DENOM, options);
+  gst_structure_free (options);
+
+  if (sink->priv->resampler == NULL)
+    return FALSE;
+
+  sink->priv->resample_out_rate = RESAMPLE_RATE_DENOM;
+  sink->priv->drift_integral = 0.0;
+
+  GST_DEBUG_OBJECT (sink, "created resampler for resample slaving");
+
+  return TRUE;
+}
+
+/* feed the distance in samples between where the master clock wants the
+ * next buffer and where it will be written to the drift controller and
+ * update the resampler rate */
+static void
+gst_audio_base_sink_update_drift (GstAudioBaseSink * sink, gint64 error,
+    guint samples)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  gdouble rate, err, max_integral, ratio;
+  gint out_rate;
+
+  rate = GST_AUDIO_INFO_RATE (&sink->ringbuffer->spec.info);
+
+  /* the samples still in the resampler history will be written before the
+   * new ones */
+  error -= gst_audio_resampler_get_max_latency (priv->resampler);
+  err = error / rate;
+
+  max_integral = RESAMPLE_MAX_CORRECTION / RESAMPLE_KI;
+  priv->drift_integral = CLAMP (priv->drift_integral + err * samples / rate,
+      -max_integral, max_integral);
+
+  /* when the master wants the samples later than we write them, we need to
+   * produce more samples and the other way around */
+  ratio = 1.0 + RESAMPLE_KP * err + RESAMPLE_KI * priv->drift_integral;
+  ratio = CLAMP (ratio, 1.0 - RESAMPLE_MAX_CORRECTION,
+      1.0 + RESAMPLE_MAX_CORRECTION);
+
+  out_rate = (gint) (RESAMPLE_RATE_DENOM * ratio + 0.5);
+
+  GST_LOG_OBJECT (sink, "error %" G_GINT64_FORMAT " samples, integral %f, "
+      "ratio %f", error, priv->drift_integral, ratio);
+
+  if (out_rate != priv->resample_out_rate) {
+    gst_audio_resampler_update (priv->resampler, RESAMPLE_RATE_DENOM,
+        out_rate, NULL);
+    priv->resample_out_rate = out_rate;
+  }
+}
+
+/* resample @samples frames from @data, @data is updated to point to the
+ * resampled frames. Returns the number of resampled frames */
+static guint
+gst_audio_base_sink_resample (GstAudioBaseSink * sink, guint8 ** data,
+    guint samples)
+{
+  GstAudioBaseSinkPrivate *priv = sink->priv;
+  gpointer in[1], out[1];
+  gsize out_samples, size;
+
+  out_samples = gst_audio_resampler_get_out_frames (priv->resampler, samples);
+  size = out_samples * GST_AUDIO_INFO_BPF (&sink->ringbuffer->spec.info);
+
+  if (size > priv->resample_buf_size) {
+    priv->resample_buf = g_realloc (priv->resample_buf, size);
+    priv->resample_buf_size = size;
+  }
+
+  in[0] = *data;
+  out[0] = priv->resample_buf;
+  gst_audio_resampler_resample (priv->resampler, in, samples, out,
+      out_samples);
+
+  *data = priv->resample_buf;
+
+  return out_samples;
 }
 
 static void
@@ -1370,7 +1824,10 @@ gst_audio_base_sink_custom_slaving (GstAudioBaseSink * sink,
 }
 
 /* algorithm to calculate sample positions that will result in resampling to
- * match the clock rate of the master */
+ * match the clock rate of the master. When the format can be resampled, these
+ * positions are the target for the drift controller that drives the
+ * resampler, see gst_audio_base_sink_update_drift(). Otherwise the
+ * ringbuffer stretches the samples to fit between the positions. */
 static void
 gst_audio_base_sink_resample_slaving (GstAudioBaseSink * sink,
     GstClockTime render_start, GstClockTime render_stop,
@@ -1807,6 +2264,10 @@ gst_audio_base_sink_get_alignment (GstAudioBaseSink * sink,
         sample_offset > sink->next_sample ? "+" : "-", GST_TIME_ARGS (diff_s));
     align = 0;
 
+    GST_OBJECT_LOCK (sink);
+    sink->priv->resyncs++;
+    GST_OBJECT_UNLOCK (sink);
+
     gst_audio_base_sink_custom_cb_report_discont (sink,
         GST_AUDIO_BASE_SINK_DISCONT_REASON_ALIGNMENT);
   }
@@ -1825,6 +2286,7 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   gint64 diff, align;
   guint64 ctime, cstop;
   gsize offset;
+  guint8 *data;
   GstMapInfo info;
   gsize size;
   guint samples, written;
@@ -1833,7 +2295,9 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   gint out_samples;
   GstClockTime base_time, render_delay, latency;
   GstClock *clock;
-  gboolean sync, slaved, align_next;
+  gboolean sync, slaved, align_next, resampling = FALSE, aligned = FALSE;
+  gboolean adapt = FALSE;
+  gint64 shift = 0;
   GstFlowReturn ret;
   GstSegment clip_seg;
   gint64 time_offset;
@@ -1853,6 +2317,7 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
    * latency. */
   GST_OBJECT_LOCK (sink);
   base_time = GST_ELEMENT_CAST (sink)->base_time;
+  adapt = sink->priv->adaptive_latency && sink->priv->live;
   if (G_UNLIKELY (sink->priv->sync_latency)) {
     ret = gst_audio_base_sink_sync_latency (bsink, GST_MINI_OBJECT_CAST (buf));
     GST_OBJECT_UNLOCK (sink);
@@ -1947,6 +2412,20 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   render_delay = gst_base_sink_get_render_delay (bsink);
   sync_offset = ts_offset - render_delay + latency;
 
+  /* when the pipeline latency changed after we adapted ours, remember how
+   * far we have to move the write position to get to the new latency */
+  if (G_UNLIKELY (sink->priv->adaptive_latency_time != latency)) {
+    if (adapt && sink->priv->adaptive_latency_time != GST_CLOCK_TIME_NONE)
+      sink->priv->adaptive_offset +=
+          (gint64) gst_util_uint64_scale_int (latency, rate, GST_SECOND) -
+          (gint64) gst_util_uint64_scale_int (sink->priv->adaptive_latency_time,
+          rate, GST_SECOND);
+    sink->priv->adaptive_latency_time = latency;
+    sink->priv->adaptive_pending = FALSE;
+    sink->priv->adaptive_min_headroom = G_MAXINT64;
+    sink->priv->adaptive_window = 0;
+  }
+
   GST_DEBUG_OBJECT (sink,
       "sync-offset %" GST_STIME_FORMAT ", render-delay %" GST_TIME_FORMAT
       ", ts-offset %" GST_STIME_FORMAT, GST_STIME_ARGS (sync_offset),
@@ -2045,6 +2524,13 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
     /* handle clock slaving */
     gst_audio_base_sink_handle_slaving (sink, render_start, render_stop,
         &render_start, &render_stop);
+
+    /* resample ourselves to track the master clock instead of letting the
+     * ringbuffer stretch the samples */
+    resampling =
+        sink->priv->slave_method == GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE &&
+        bsink->segment.rate == 1.0 &&
+        gst_audio_base_sink_ensure_resampler (sink);
   } else {
     /* no slaving needed but we need to adapt to the clock calibration
      * parameters */
@@ -2056,6 +2542,8 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
       "final timestamps: start %" GST_TIME_FORMAT " - stop %" GST_TIME_FORMAT,
       GST_TIME_ARGS (render_start), GST_TIME_ARGS (render_stop));
 
+  adapt = adapt && bsink->segment.rate == 1.0;
+
   /* bring to position in the ringbuffer */
   time_offset = GST_AUDIO_CLOCK_CAST (sink->provided_clock)->time_offset;
 
@@ -2127,12 +2615,56 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
     goto no_align;
   }
 
+  /* after a latency change we keep aligning to the previous samples, see
+   * below for how we get to the new position. When resampling and the
+   * latency went down, the new position shows up as alignment error and the
+   * drift controller resamples towards it instead, by at most
+   * RESAMPLE_MAX_CORRECTION. */
+  if (G_UNLIKELY (sink->priv->adaptive_offset != 0) &&
+      (!resampling || sink->priv->adaptive_offset > 0) &&
+      bsink->segment.rate == 1.0 &&
+      (gint64) render_start > sink->priv->adaptive_offset) {
+    shift = sink->priv->adaptive_offset;
+    render_start -= shift;
+    render_stop -= shift;
+    sample_offset -= shift;
+  }
+
   align = gst_audio_base_sink_get_alignment (sink, sample_offset);
   sink->priv->last_align = align;
 
+  if (G_UNLIKELY (resampling)) {
+    /* render right after the previous samples and let the drift controller
+     * pull us towards the position the master clock wants, unless we had to
+     * resync */
+    aligned = (align != 0 || sample_offset == sink->next_sample);
+    if (aligned)
+      gst_audio_base_sink_update_drift (sink, -align, samples);
+  }
+
   /* apply alignment */
   render_start += align;
 
+  if (G_UNLIKELY (shift != 0)) {
+    if (render_start == sink->next_sample && shift < 0) {
+      gint64 step;
+
+      /* compress the samples a little to get closer to the new position */
+      sink->priv->adaptive_compress_acc += samples;
+      step = sink->priv->adaptive_compress_acc / ADAPTIVE_COMPRESS_INTERVAL;
+      sink->priv->adaptive_compress_acc %= ADAPTIVE_COMPRESS_INTERVAL;
+      step = MIN (step, -shift);
+      render_stop -= step;
+      shift += step;
+    } else {
+      /* the latency went up because we were too late for the device, or we
+       * had to resync, go to the new position at once */
+      render_start += shift;
+      render_stop += shift;
+      shift = 0;
+    }
+  }
+
   /* only align stop if we are not slaved to resample */
   if (G_UNLIKELY (slaved
           && sink->priv->slave_method == GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE)) {
@@ -2142,6 +2674,22 @@ gst_audio_base_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   render_stop += align;
 
 no_align:
+  /* what is left to move after this buffer, a resync gets us to the new
+   * position immediately */
+  sink->priv->adaptive_offset = shift;
+
+  gst_buffer_map (buf, &info, GST_MAP_READ);
+  data = info.data + offset;
+
+  if (G_UNLIKELY (resampling)) {
+    /* we start from a new position, forget the old samples */
+    if (!aligned)
+      gst_audio_resampler_reset (sink->priv->resampler);
+
+    samples = gst_audio_base_sink_resample (sink, &data, samples);
+    render_stop = render_start + samples;
+  }
+
   /* number of target samples is difference between start and stop */
   out_samples = render_stop - render_start;
 
@@ -2154,14 +2702,28 @@ no_align:
   GST_DEBUG_OBJECT (sink, "rendering at %" G_GUINT64_FORMAT " %d/%d",
       sample_offset, samples, out_samples);
 
+  if (G_UNLIKELY (adapt)) {
+    gint segs, sps = ringbuf->samples_per_seg;
+
+    gst_audio_base_sink_adapt_latency (sink, sample_offset, samples);
+
+    /* don't write further ahead of the device than the latency we use, plus
+     * what we still have to compress */
+    GST_OBJECT_LOCK (sink);
+    segs = sink->priv->adaptive_segs + 1;
+    GST_OBJECT_UNLOCK (sink);
+    if (shift < 0)
+      segs += (-shift + sps - 1) / sps;
+    __gst_audio_ring_buffer_set_write_segments (ringbuf, segs);
+  }
+
   /* we need to accumulate over different runs for when we get interrupted */
   accum = 0;
   align_next = TRUE;
-  gst_buffer_map (buf, &info, GST_MAP_READ);
   do {
     written =
         gst_audio_ring_buffer_commit (ringbuf, &sample_offset,
-        info.data + offset, samples, out_samples, &accum);
+        data, samples, out_samples, &accum);
 
     GST_DEBUG_OBJECT (sink, "wrote %u of %u", written, samples);
     /* if we wrote all, we're done */
@@ -2185,7 +2747,7 @@ no_align:
       break;
 
     samples -= written;
-    offset += written * bpf;
+    data += written * bpf;
   } while (TRUE);
   gst_buffer_unmap (buf, &info);
 
@@ -2204,6 +2766,8 @@ no_align:
     gst_audio_base_sink_force_start (sink);
   }
 
+  gst_audio_base_sink_post_stats (sink);
+
   ret = GST_FLOW_OK;
 
 done:
@@ -2425,6 +2989,8 @@ gst_audio_base_sink_change_state (GstElement * element,
 
       GST_OBJECT_LOCK (sink);
       sink->ringbuffer = rb;
+      gst_audio_ring_buffer_set_stats_enabled (rb,
+          sink->priv->stats_interval > 0);
       GST_OBJECT_UNLOCK (sink);
 
       if (!gst_audio_ring_buffer_open_device (sink->ringbuffer)) {
@@ -2505,6 +3071,7 @@ gst_audio_base_sink_change_state (GstElement * element,
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_audio_ring_buffer_activate (sink->ringbuffer, FALSE);
       gst_audio_ring_buffer_release (sink->ringbuffer);
+      gst_audio_base_sink_free_resampler (sink);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       /* we release again here because the acquire happens when setting the
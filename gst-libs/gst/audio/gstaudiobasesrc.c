@@ -74,6 +74,12 @@ struct _GstAudioBaseSrcPrivate
 {
   /* the clock slaving algorithm in use */
   GstAudioBaseSrcSlaveMethod slave_method;
+
+  /* statistics, with LOCK */
+  GstClockTime stats_interval;
+  guint64 dropped;
+  /* last time we posted statistics, streaming thread only */
+  gint64 last_stats_post;
 };
 
 /* BaseAudioSrc signals and args */
@@ -90,6 +96,7 @@ enum
 #define DEFAULT_ACTUAL_LATENCY_TIME    -1
 #define DEFAULT_PROVIDE_CLOCK   TRUE
 #define DEFAULT_SLAVE_METHOD    GST_AUDIO_BASE_SRC_SLAVE_SKEW
+#define DEFAULT_STATS_INTERVAL  0
 
 enum
 {
@@ -100,6 +107,8 @@ enum
   PROP_ACTUAL_LATENCY_TIME,
   PROP_PROVIDE_CLOCK,
   PROP_SLAVE_METHOD,
+  PROP_STATS,
+  PROP_STATS_INTERVAL,
   PROP_LAST
 };
 
@@ -215,6 +224,38 @@ gst_audio_base_src_class_init (GstAudioBaseSrcClass * klass)
           GST_TYPE_AUDIO_BASE_SRC_SLAVE_METHOD, DEFAULT_SLAVE_METHOD,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSrc:stats:
+   *
+   * Statistics collected by the source while #GstAudioBaseSrc:stats-interval
+   * is non-zero. Contains the fields described in
+   * gst_audio_ring_buffer_get_stats() and:
+   *
+   * "dropped" G_TYPE_UINT64: the number of samples that were lost because
+   *   they were not read in time.
+   *
+   * Since: 1.10
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Overrun, fill level and timing statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioBaseSrc:stats-interval:
+   *
+   * Interval in nanoseconds at which the source posts its
+   * #GstAudioBaseSrc:stats as a "GstAudioBaseSrcStats" element message.
+   * 0 disables the collection of statistics.
+   *
+   * Since: 1.10
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS_INTERVAL,
+      g_param_spec_uint64 ("stats-interval", "Statistics Interval",
+          "Interval in nanoseconds between statistics messages "
+          "(0 = collect no statistics)", 0, G_MAXUINT64,
+          DEFAULT_STATS_INTERVAL, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_src_change_state);
   gstelement_class->provide_clock =
@@ -248,6 +289,8 @@ gst_audio_base_src_init (GstAudioBaseSrc * audiobasesrc)
   else
     GST_OBJECT_FLAG_UNSET (audiobasesrc, GST_ELEMENT_FLAG_PROVIDE_CLOCK);
   audiobasesrc->priv->slave_method = DEFAULT_SLAVE_METHOD;
+  audiobasesrc->priv->stats_interval = DEFAULT_STATS_INTERVAL;
+  audiobasesrc->priv->last_stats_post = -1;
   /* reset blocksize we use latency time to calculate a more useful
    * value based on negotiated format. */
   GST_BASE_SRC (audiobasesrc)->blocksize = 0;
@@ -440,6 +483,49 @@ gst_audio_base_src_get_slave_method (GstAudioBaseSrc * src)
   return result;
 }
 
+static GstStructure *
+gst_audio_base_src_get_stats (GstAudioBaseSrc * src)
+{
+  GstStructure *s;
+
+  GST_OBJECT_LOCK (src);
+  if (src->ringbuffer) {
+    s = gst_audio_ring_buffer_get_stats (src->ringbuffer);
+    gst_structure_set_name (s, "GstAudioBaseSrcStats");
+  } else {
+    s = gst_structure_new_empty ("GstAudioBaseSrcStats");
+  }
+  gst_structure_set (s, "dropped", G_TYPE_UINT64, src->priv->dropped, NULL);
+  GST_OBJECT_UNLOCK (src);
+
+  return s;
+}
+
+/* post the statistics when stats-interval passed since we last did */
+static void
+gst_audio_base_src_post_stats (GstAudioBaseSrc * src)
+{
+  GstClockTime interval;
+  gint64 now;
+
+  GST_OBJECT_LOCK (src);
+  interval = src->priv->stats_interval;
+  GST_OBJECT_UNLOCK (src);
+
+  if (G_LIKELY (interval == 0))
+    return;
+
+  now = g_get_monotonic_time ();
+  if (src->priv->last_stats_post != -1 &&
+      (now - src->priv->last_stats_post) * GST_USECOND < interval)
+    return;
+  src->priv->last_stats_post = now;
+
+  gst_element_post_message (GST_ELEMENT_CAST (src),
+      gst_message_new_element (GST_OBJECT_CAST (src),
+          gst_audio_base_src_get_stats (src)));
+}
+
 static void
 gst_audio_base_src_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
@@ -461,6 +547,14 @@ gst_audio_base_src_set_property (GObject * object, guint prop_id,
     case PROP_SLAVE_METHOD:
       gst_audio_base_src_set_slave_method (src, g_value_get_enum (value));
       break;
+    case PROP_STATS_INTERVAL:
+      GST_OBJECT_LOCK (src);
+      src->priv->stats_interval = g_value_get_uint64 (value);
+      if (src->ringbuffer)
+        gst_audio_ring_buffer_set_stats_enabled (src->ringbuffer,
+            src->priv->stats_interval > 0);
+      GST_OBJECT_UNLOCK (src);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -504,6 +598,14 @@ gst_audio_base_src_get_property (GObject * object, guint prop_id,
     case PROP_SLAVE_METHOD:
       g_value_set_enum (value, gst_audio_base_src_get_slave_method (src));
       break;
+    case PROP_STATS:
+      g_value_take_boxed (value, gst_audio_base_src_get_stats (src));
+      break;
+    case PROP_STATS_INTERVAL:
+      GST_OBJECT_LOCK (src);
+      g_value_set_uint64 (value, src->priv->stats_interval);
+      GST_OBJECT_UNLOCK (src);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -868,6 +970,10 @@ gst_audio_base_src_create (GstBaseSrc * bsrc, guint64 offset, guint length,
             "downstream can't keep up and is consuming samples too slowly.",
             sample - src->next_sample));
     GST_BUFFER_FLAG_SET (buf, GST_BUFFER_FLAG_DISCONT);
+
+    GST_OBJECT_LOCK (src);
+    src->priv->dropped += sample - src->next_sample;
+    GST_OBJECT_UNLOCK (src);
   }
 
   src->next_sample = sample + samples;
@@ -1060,6 +1166,8 @@ no_sync:
   GST_LOG_OBJECT (src, "Pushed buffer timestamp %" GST_TIME_FORMAT,
       GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buf)));
 
+  gst_audio_base_src_post_stats (src);
+
   return GST_FLOW_OK;
 
   /* ERRORS */
@@ -1141,6 +1249,8 @@ gst_audio_base_src_change_state (GstElement * element,
 
       GST_OBJECT_LOCK (src);
       src->ringbuffer = rb;
+      gst_audio_ring_buffer_set_stats_enabled (rb,
+          src->priv->stats_interval > 0);
       GST_OBJECT_UNLOCK (src);
 
       if (!gst_audio_ring_buffer_open_device (src->ringbuffer)) {
@@ -895,6 +895,61 @@ gst_audio_decoder_setup (GstAudioDecoder * dec)
   dec->priv->agg = ! !res;
 }
 
+/* gst_audio_buffer_clip() trims bytes from the start and end of the buffer,
+ * which only works for interleaved samples. For non-interleaved buffers let it
+ * work out the new metadata and then copy what is left of each plane */
+static GstBuffer *
+gst_audio_decoder_clip_non_interleaved (GstAudioDecoder * dec, GstBuffer * buf)
+{
+  GstAudioInfo *info = &dec->priv->ctx.info;
+  GstBuffer *clipped, *ret;
+  GstMapInfo inmap, outmap;
+  gsize bps, in_frames, out_frames, trim = 0;
+  gint i;
+
+  clipped = gst_audio_buffer_clip (gst_buffer_ref (buf), &dec->output_segment,
+      info->rate, info->bpf);
+  if (clipped == NULL || gst_buffer_get_size (clipped) ==
+      gst_buffer_get_size (buf)) {
+    /* nothing trimmed, at most the metadata changed */
+    gst_buffer_unref (buf);
+    return clipped;
+  }
+
+  bps = info->bpf / info->channels;
+  in_frames = gst_buffer_get_size (buf) / info->bpf;
+  out_frames = gst_buffer_get_size (clipped) / info->bpf;
+
+  if (dec->output_segment.format == GST_FORMAT_TIME)
+    trim = gst_util_uint64_scale (GST_BUFFER_TIMESTAMP (clipped) -
+        GST_BUFFER_TIMESTAMP (buf), info->rate, GST_SECOND);
+  else
+    trim = GST_BUFFER_OFFSET (clipped) - GST_BUFFER_OFFSET (buf);
+  trim = MIN (trim, in_frames - out_frames);
+
+  GST_LOG_OBJECT (dec, "trimming %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT
+      " frames per plane, keeping %" G_GSIZE_FORMAT, trim, in_frames,
+      out_frames);
+
+  ret = gst_audio_decoder_allocate_output_buffer (dec, out_frames * info->bpf);
+  gst_buffer_copy_into (ret, clipped, GST_BUFFER_COPY_FLAGS |
+      GST_BUFFER_COPY_TIMESTAMPS | GST_BUFFER_COPY_META, 0, -1);
+
+  gst_buffer_map (buf, &inmap, GST_MAP_READ);
+  gst_buffer_map (ret, &outmap, GST_MAP_WRITE);
+  for (i = 0; i < info->channels; i++) {
+    memcpy (outmap.data + i * out_frames * bps,
+        inmap.data + (i * in_frames + trim) * bps, out_frames * bps);
+  }
+  gst_buffer_unmap (ret, &outmap);
+  gst_buffer_unmap (buf, &inmap);
+
+  gst_buffer_unref (clipped);
+  gst_buffer_unref (buf);
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_audio_decoder_push_forward (GstAudioDecoder * dec, GstBuffer * buf)
 {
@@ -925,8 +980,11 @@ gst_audio_decoder_push_forward (GstAudioDecoder * dec, GstBuffer * buf)
       GST_TIME_ARGS (GST_BUFFER_DURATION (buf)));
 
   /* clip buffer */
-  buf = gst_audio_buffer_clip (buf, &dec->output_segment, ctx->info.rate,
-      ctx->info.bpf);
+  if (GST_AUDIO_INFO_LAYOUT (&ctx->info) == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+    buf = gst_audio_decoder_clip_non_interleaved (dec, buf);
+  else
+    buf = gst_audio_buffer_clip (buf, &dec->output_segment, ctx->info.rate,
+        ctx->info.bpf);
   if (G_UNLIKELY (!buf)) {
     GST_DEBUG_OBJECT (dec, "no data after clipping to segment");
     /* only check and return EOS if upstream still
@@ -1005,7 +1063,11 @@ gst_audio_decoder_output (GstAudioDecoder * dec, GstBuffer * buf)
 
 again:
   inbuf = NULL;
-  if (priv->agg && dec->priv->latency > 0) {
+  /* fragments are assembled by appending bytes, which would mix up the
+   * planes of non-interleaved buffers */
+  if (priv->agg && dec->priv->latency > 0 &&
+      GST_AUDIO_INFO_LAYOUT (&priv->ctx.info) ==
+      GST_AUDIO_LAYOUT_INTERLEAVED) {
     gint av;
     gboolean assemble = FALSE;
     const GstClockTimeDiff tol = 10 * GST_MSECOND;
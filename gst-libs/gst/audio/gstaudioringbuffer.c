@@ -41,10 +41,43 @@
 
 #include <gst/audio/audio.h>
 #include "gstaudioringbuffer.h"
+#include "gstaudioutilsprivate.h"
 
 GST_DEBUG_CATEGORY_STATIC (gst_audio_ring_buffer_debug);
 #define GST_CAT_DEFAULT gst_audio_ring_buffer_debug
 
+#define GST_AUDIO_RING_BUFFER_GET_PRIVATE(obj)  \
+   (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_AUDIO_RING_BUFFER, GstAudioRingBufferPrivate))
+
+/* fill level histogram, in steps of 10% of the ringbuffer */
+#define STATS_FILL_BINS         10
+/* interval between device callbacks, bin 0 is below 250us, bin n counts
+ * intervals between 125us * 2^n and 125us * 2^(n+1), the last bin everything
+ * above 256ms */
+#define STATS_INTERVAL_BINS     12
+#define STATS_INTERVAL_UNIT     125
+
+struct _GstAudioRingBufferPrivate
+{
+  /* ATOMIC */
+  gint stats_enabled;
+  /* ATOMIC, how many segments ahead of the device we may write, 0 for all of
+   * them */
+  gint write_segs;
+
+  /* statistics, protected with stats_lock */
+  GMutex stats_lock;
+  guint64 underruns;
+  guint64 overruns;
+  guint64 fill_hist[STATS_FILL_BINS];
+  guint64 interval_hist[STATS_INTERVAL_BINS];
+  gint64 last_advance;          /* monotonic time in microseconds */
+  GstClockTime interval_max;
+  guint64 blocked_count;
+  GstClockTime blocked_time;
+  GstClockTime blocked_max;
+};
+
 static void gst_audio_ring_buffer_dispose (GObject * object);
 static void gst_audio_ring_buffer_finalize (GObject * object);
 
@@ -69,6 +102,8 @@ gst_audio_ring_buffer_class_init (GstAudioRingBufferClass * klass)
   GST_DEBUG_CATEGORY_INIT (gst_audio_ring_buffer_debug, "ringbuffer", 0,
       "ringbuffer class");
 
+  g_type_class_add_private (klass, sizeof (GstAudioRingBufferPrivate));
+
   gobject_class->dispose = gst_audio_ring_buffer_dispose;
   gobject_class->finalize = gst_audio_ring_buffer_finalize;
 
@@ -88,6 +123,10 @@ gst_audio_ring_buffer_init (GstAudioRingBuffer * ringbuffer)
   ringbuffer->flushing = TRUE;
   ringbuffer->segbase = 0;
   ringbuffer->segdone = 0;
+
+  ringbuffer->priv = GST_AUDIO_RING_BUFFER_GET_PRIVATE (ringbuffer);
+  g_mutex_init (&ringbuffer->priv->stats_lock);
+  ringbuffer->priv->last_advance = -1;
 }
 
 static void
@@ -108,6 +147,7 @@ gst_audio_ring_buffer_finalize (GObject * object)
 
   g_cond_clear (&ringbuffer->cond);
   g_free (ringbuffer->empty_seg);
+  g_mutex_clear (&ringbuffer->priv->stats_lock);
 
   G_OBJECT_CLASS (gst_audio_ring_buffer_parent_class)->finalize (G_OBJECT
       (ringbuffer));
@@ -697,6 +737,7 @@ gst_audio_ring_buffer_release (GstAudioRingBuffer * buf)
     goto release_failed;
 
   g_atomic_int_set (&buf->segdone, 0);
+  g_atomic_int_set (&buf->priv->write_segs, 0);
   buf->segbase = 0;
   g_free (buf->empty_seg);
   buf->empty_seg = NULL;
@@ -941,6 +982,11 @@ gst_audio_ring_buffer_start (GstAudioRingBuffer * buf)
     GST_DEBUG_OBJECT (buf, "resuming");
   }
 
+  /* don't count the time we were stopped or paused as a callback interval */
+  g_mutex_lock (&buf->priv->stats_lock);
+  buf->priv->last_advance = -1;
+  g_mutex_unlock (&buf->priv->stats_lock);
+
   rclass = GST_AUDIO_RING_BUFFER_GET_CLASS (buf);
   if (resume) {
     if (G_LIKELY (rclass->resume))
@@ -1274,6 +1320,32 @@ gst_audio_ring_buffer_clear_all (GstAudioRingBuffer * buf)
     rclass->clear_all (buf);
 }
 
+#define STATS_ENABLED(buf) \
+    G_UNLIKELY (g_atomic_int_get (&(buf)->priv->stats_enabled))
+
+/* record how many segments are filled when the writer or reader gets to
+ * process a segment */
+static void
+stats_add_fill (GstAudioRingBuffer * buf, gint filled)
+{
+  GstAudioRingBufferPrivate *priv = buf->priv;
+  gint bin;
+
+  bin = CLAMP (filled * STATS_FILL_BINS / buf->spec.segtotal, 0,
+      STATS_FILL_BINS - 1);
+
+  g_mutex_lock (&priv->stats_lock);
+  priv->fill_hist[bin]++;
+  g_mutex_unlock (&priv->stats_lock);
+}
+
+static void
+stats_add_xrun (GstAudioRingBuffer * buf, guint64 * counter)
+{
+  g_mutex_lock (&buf->priv->stats_lock);
+  (*counter)++;
+  g_mutex_unlock (&buf->priv->stats_lock);
+}
 
 static gboolean
 wait_segment (GstAudioRingBuffer * buf)
@@ -1309,9 +1381,27 @@ wait_segment (GstAudioRingBuffer * buf)
 
   if (G_LIKELY (wait)) {
     if (g_atomic_int_compare_and_exchange (&buf->waiting, 0, 1)) {
+      gint64 start = 0;
+
+      if (STATS_ENABLED (buf))
+        start = g_get_monotonic_time ();
+
       GST_DEBUG_OBJECT (buf, "waiting..");
       GST_AUDIO_RING_BUFFER_WAIT (buf);
 
+      if (start != 0) {
+        GstAudioRingBufferPrivate *priv = buf->priv;
+        GstClockTime blocked;
+
+        blocked = (g_get_monotonic_time () - start) * GST_USECOND;
+
+        g_mutex_lock (&priv->stats_lock);
+        priv->blocked_count++;
+        priv->blocked_time += blocked;
+        priv->blocked_max = MAX (priv->blocked_max, blocked);
+        g_mutex_unlock (&priv->stats_lock);
+      }
+
       if (G_UNLIKELY (buf->flushing))
         goto flushing;
 
@@ -1459,7 +1549,7 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
     guint8 * data, gint in_samples, gint out_samples, gint * accum)
 {
   gint segdone;
-  gint segsize, segtotal, channels, bps, bpf, sps;
+  gint segsize, segtotal, writable, channels, bps, bpf, sps;
   guint8 *dest, *data_end;
   gint writeseg, sampleoff;
   gint *toprocess;
@@ -1480,6 +1570,10 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
   bps = bpf / channels;
   sps = buf->samples_per_seg;
 
+  writable = g_atomic_int_get (&buf->priv->write_segs);
+  if (writable <= 0 || writable > segtotal)
+    writable = segtotal;
+
   reverse = out_samples < 0;
   out_samples = ABS (out_samples);
 
@@ -1525,13 +1619,17 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
       /* segment too far ahead, writer too slow, we need to drop, hopefully UNLIKELY */
       if (G_UNLIKELY (diff < 0)) {
         /* we need to drop one segment at a time, pretend we wrote a segment. */
+        if (STATS_ENABLED (buf))
+          stats_add_xrun (buf, &buf->priv->underruns);
         skip = TRUE;
         break;
       }
 
       /* write segment is within writable range, we can break the loop and
        * start writing the data. */
-      if (diff < segtotal) {
+      if (diff < writable) {
+        if (STATS_ENABLED (buf))
+          stats_add_fill (buf, diff);
         skip = FALSE;
         break;
       }
@@ -1742,6 +1840,8 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
       /* segment too far ahead, reader too slow */
       if (G_UNLIKELY (diff >= segtotal)) {
         /* pretend we read an empty segment. */
+        if (STATS_ENABLED (buf))
+          stats_add_xrun (buf, &buf->priv->overruns);
         sampleslen = MIN (sps, to_read);
         memcpy (data, buf->empty_seg, sampleslen * bpf);
         goto next;
@@ -1749,8 +1849,11 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
 
       /* read segment is within readable range, we can break the loop and
        * start reading the data. */
-      if (diff > 0)
+      if (diff > 0) {
+        if (STATS_ENABLED (buf))
+          stats_add_fill (buf, diff);
         break;
+      }
 
       /* else we need to wait for the segment to become readable. */
       if (!wait_segment (buf))
@@ -1872,6 +1975,26 @@ gst_audio_ring_buffer_advance (GstAudioRingBuffer * buf, guint advance)
 {
   g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
 
+  if (STATS_ENABLED (buf)) {
+    GstAudioRingBufferPrivate *priv = buf->priv;
+    gint64 now = g_get_monotonic_time ();
+
+    g_mutex_lock (&priv->stats_lock);
+    if (priv->last_advance != -1) {
+      gint64 interval = now - priv->last_advance;
+      gint bin = 0;
+
+      while (bin < STATS_INTERVAL_BINS - 1 &&
+          interval >= (STATS_INTERVAL_UNIT << (bin + 1)))
+        bin++;
+
+      priv->interval_hist[bin]++;
+      priv->interval_max = MAX (priv->interval_max, interval * GST_USECOND);
+    }
+    priv->last_advance = now;
+    g_mutex_unlock (&priv->stats_lock);
+  }
+
   /* update counter */
   g_atomic_int_add (&buf->segdone, advance);
 
@@ -2048,3 +2171,177 @@ not_acquired:
     goto done;
   }
 }
+
+/**
+ * gst_audio_ring_buffer_set_stats_enabled:
+ * @buf: the #GstAudioRingBuffer
+ * @enabled: %TRUE to collect statistics
+ *
+ * Enable or disable the collection of statistics about underruns, overruns,
+ * fill level and device timing in @buf. Collecting statistics adds some
+ * locking and clock reads to the processing of every segment, so it is
+ * disabled by default.
+ *
+ * MT safe.
+ *
+ * Since: 1.10
+ */
+void
+gst_audio_ring_buffer_set_stats_enabled (GstAudioRingBuffer * buf,
+    gboolean enabled)
+{
+  g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
+
+  GST_DEBUG_OBJECT (buf, "stats enabled: %d", enabled);
+  g_atomic_int_set (&buf->priv->stats_enabled, enabled);
+}
+
+/**
+ * gst_audio_ring_buffer_get_stats_enabled:
+ * @buf: the #GstAudioRingBuffer
+ *
+ * Check if @buf collects statistics.
+ *
+ * Returns: %TRUE when statistics are collected.
+ *
+ * MT safe.
+ *
+ * Since: 1.10
+ */
+gboolean
+gst_audio_ring_buffer_get_stats_enabled (GstAudioRingBuffer * buf)
+{
+  g_return_val_if_fail (GST_IS_AUDIO_RING_BUFFER (buf), FALSE);
+
+  return g_atomic_int_get (&buf->priv->stats_enabled);
+}
+
+/* limit the default commit to write at most @segs segments ahead of the
+ * device, 0 allows writing to the whole ringbuffer again. The ringbuffer
+ * layout doesn't change so this can be done at any time, writers that are too
+ * far ahead simply wait for the device. */
+void
+__gst_audio_ring_buffer_set_write_segments (GstAudioRingBuffer * buf,
+    gint segs)
+{
+  g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
+
+  if (g_atomic_int_get (&buf->priv->write_segs) != segs) {
+    GST_DEBUG_OBJECT (buf, "write segments: %d", segs);
+    g_atomic_int_set (&buf->priv->write_segs, segs);
+  }
+}
+
+static void
+stats_set_histogram (GstStructure * s, const gchar * field,
+    const guint64 * hist, guint n_bins)
+{
+  GValue array = G_VALUE_INIT, val = G_VALUE_INIT;
+  guint i;
+
+  g_value_init (&array, GST_TYPE_ARRAY);
+  g_value_init (&val, G_TYPE_UINT64);
+
+  for (i = 0; i < n_bins; i++) {
+    g_value_set_uint64 (&val, hist[i]);
+    gst_value_array_append_value (&array, &val);
+  }
+  gst_structure_take_value (s, field, &array);
+  g_value_unset (&val);
+}
+
+/**
+ * gst_audio_ring_buffer_get_stats:
+ * @buf: the #GstAudioRingBuffer
+ *
+ * Get the statistics collected by @buf since they were enabled or last
+ * reset with gst_audio_ring_buffer_reset_stats(). The structure contains:
+ *
+ * "underruns" G_TYPE_UINT64: segments that the writer could not fill in time
+ *   and that were played by the device without the data.
+ *
+ * "overruns" G_TYPE_UINT64: segments that were overwritten by the device
+ *   before the reader could read them.
+ *
+ * "fill-histogram" GST_TYPE_ARRAY: 10 G_TYPE_UINT64 bins counting how full the
+ *   ringbuffer was, in steps of 10%, each time a segment was written or read.
+ *
+ * "callback-histogram" GST_TYPE_ARRAY: 12 G_TYPE_UINT64 bins counting the
+ *   intervals between consecutive gst_audio_ring_buffer_advance() calls of
+ *   the device. The first bin counts intervals below 250 microseconds, each
+ *   next bin covers twice the range of the previous one and the last bin
+ *   counts everything above 256 milliseconds.
+ *
+ * "callback-interval-max" G_TYPE_UINT64: the longest interval between
+ *   device callbacks, in nanoseconds.
+ *
+ * "blocked-count" G_TYPE_UINT64: the number of times gst_audio_ring_buffer_commit()
+ *   or gst_audio_ring_buffer_read() had to wait for the device.
+ *
+ * "blocked-time" G_TYPE_UINT64: the total time spent waiting, in nanoseconds.
+ *
+ * "blocked-max" G_TYPE_UINT64: the longest wait, in nanoseconds.
+ *
+ * Returns: (transfer full): a #GstStructure with the statistics.
+ *
+ * MT safe.
+ *
+ * Since: 1.10
+ */
+GstStructure *
+gst_audio_ring_buffer_get_stats (GstAudioRingBuffer * buf)
+{
+  GstAudioRingBufferPrivate *priv;
+  GstStructure *s;
+
+  g_return_val_if_fail (GST_IS_AUDIO_RING_BUFFER (buf), NULL);
+
+  priv = buf->priv;
+
+  g_mutex_lock (&priv->stats_lock);
+  s = gst_structure_new ("GstAudioRingBufferStats",
+      "underruns", G_TYPE_UINT64, priv->underruns,
+      "overruns", G_TYPE_UINT64, priv->overruns,
+      "callback-interval-max", G_TYPE_UINT64, priv->interval_max,
+      "blocked-count", G_TYPE_UINT64, priv->blocked_count,
+      "blocked-time", G_TYPE_UINT64, priv->blocked_time,
+      "blocked-max", G_TYPE_UINT64, priv->blocked_max, NULL);
+  stats_set_histogram (s, "fill-histogram", priv->fill_hist, STATS_FILL_BINS);
+  stats_set_histogram (s, "callback-histogram", priv->interval_hist,
+      STATS_INTERVAL_BINS);
+  g_mutex_unlock (&priv->stats_lock);
+
+  return s;
+}
+
+/**
+ * gst_audio_ring_buffer_reset_stats:
+ * @buf: the #GstAudioRingBuffer
+ *
+ * Clear all statistics collected by @buf.
+ *
+ * MT safe.
+ *
+ * Since: 1.10
+ */
+void
+gst_audio_ring_buffer_reset_stats (GstAudioRingBuffer * buf)
+{
+  GstAudioRingBufferPrivate *priv;
+
+  g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
+
+  priv = buf->priv;
+
+  g_mutex_lock (&priv->stats_lock);
+  priv->underruns = 0;
+  priv->overruns = 0;
+  memset (priv->fill_hist, 0, sizeof (priv->fill_hist));
+  memset (priv->interval_hist, 0, sizeof (priv->interval_hist));
+  priv->last_advance = -1;
+  priv->interval_max = 0;
+  priv->blocked_count = 0;
+  priv->blocked_time = 0;
+  priv->blocked_max = 0;
+  g_mutex_unlock (&priv->stats_lock);
+}
@@ -39,6 +39,7 @@ G_BEGIN_DECLS
 
 typedef struct _GstAudioRingBuffer GstAudioRingBuffer;
 typedef struct _GstAudioRingBufferClass GstAudioRingBufferClass;
+typedef struct _GstAudioRingBufferPrivate GstAudioRingBufferPrivate;
 typedef struct _GstAudioRingBufferSpec GstAudioRingBufferSpec;
 
 /**
@@ -205,8 +206,10 @@ struct _GstAudioRingBuffer {
   gint                        may_start;
   gboolean                    active;
 
+  GstAudioRingBufferPrivate  *priv;
+
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING];
+  gpointer _gst_reserved[GST_PADDING - 1];
 };
 
 /**
@@ -333,6 +336,12 @@ void            gst_audio_ring_buffer_advance         (GstAudioRingBuffer *buf,
 
 void            gst_audio_ring_buffer_may_start       (GstAudioRingBuffer *buf, gboolean allowed);
 
+/* statistics */
+void            gst_audio_ring_buffer_set_stats_enabled (GstAudioRingBuffer *buf, gboolean enabled);
+gboolean        gst_audio_ring_buffer_get_stats_enabled (GstAudioRingBuffer *buf);
+GstStructure *  gst_audio_ring_buffer_get_stats       (GstAudioRingBuffer *buf);
+void            gst_audio_ring_buffer_reset_stats     (GstAudioRingBuffer *buf);
+
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstAudioRingBuffer, gst_object_unref)
 #endif
@@ -36,6 +36,11 @@ GstCaps *__gst_audio_element_proxy_getcaps (GstElement * element, GstPad * sinkp
                                             GstPad * srcpad, GstCaps * initial_caps,
                                             GstCaps * filter);
 
+/* Ringbuffer utility functions */
+G_GNUC_INTERNAL
+void __gst_audio_ring_buffer_set_write_segments (GstAudioRingBuffer * buf,
+                                                 gint segs);
+
 G_END_DECLS
 
 #endif
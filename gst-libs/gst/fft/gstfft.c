@@ -31,6 +31,7 @@
 #include <glib.h>
 
 #include "gstfft.h"
+#include "gstfftprivate.h"
 #include "kiss_fft_s16.h"
 
 /**
@@ -55,3 +56,67 @@ gst_fft_next_fast_length (gint n)
   /* The real FFT needs an even length so calculate that */
   return 2 * kiss_fft_s16_next_fast_size (half);
 }
+
+/* Cache of FFT plans, computing the factors and twiddles is the expensive
+ * part of creating an FFT instance and they only depend on the type, length
+ * and direction of the transform. */
+static GMutex plans_lock;
+static GHashTable *plans = NULL;
+
+static guint
+plan_hash (gconstpointer key)
+{
+  const GstFFTPlan *plan = key;
+
+  return (plan->len << 3) ^ (plan->type << 1) ^ (plan->inverse ? 1 : 0);
+}
+
+static gboolean
+plan_equal (gconstpointer a, gconstpointer b)
+{
+  const GstFFTPlan *pa = a, *pb = b;
+
+  return pa->type == pb->type && pa->len == pb->len &&
+      pa->inverse == pb->inverse;
+}
+
+GstFFTPlan *
+_gst_fft_plan_ref (GstFFTPlanType type, gint len, gboolean inverse,
+    GstFFTPlanAllocFunc alloc_func)
+{
+  GstFFTPlan key, *plan;
+
+  key.type = type;
+  key.len = len;
+  key.inverse = ! !inverse;
+
+  g_mutex_lock (&plans_lock);
+  if (plans == NULL)
+    plans = g_hash_table_new (plan_hash, plan_equal);
+
+  plan = g_hash_table_lookup (plans, &key);
+  if (plan == NULL) {
+    plan = g_slice_new (GstFFTPlan);
+    *plan = key;
+    plan->refcount = 0;
+    plan->cfg = alloc_func (len, inverse);
+    g_assert (plan->cfg);
+    g_hash_table_add (plans, plan);
+  }
+  plan->refcount++;
+  g_mutex_unlock (&plans_lock);
+
+  return plan;
+}
+
+void
+_gst_fft_plan_unref (GstFFTPlan * plan)
+{
+  g_mutex_lock (&plans_lock);
+  if (--plan->refcount == 0) {
+    g_hash_table_remove (plans, plan);
+    g_free (plan->cfg);
+    g_slice_free (GstFFTPlan, plan);
+  }
+  g_mutex_unlock (&plans_lock);
+}
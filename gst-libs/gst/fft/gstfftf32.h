@@ -56,6 +56,11 @@ void          gst_fft_f32_fft           (GstFFTF32 *self, const gfloat *timedata
 void          gst_fft_f32_inverse_fft   (GstFFTF32 *self, const GstFFTF32Complex *freqdata,
                                          gfloat *timedata);
 
+void          gst_fft_f32_fft_batch     (GstFFTF32 *self, const gfloat *timedata,
+                                         GstFFTF32Complex *freqdata, gint count);
+void          gst_fft_f32_inverse_fft_batch (GstFFTF32 *self, const GstFFTF32Complex *freqdata,
+                                         gfloat *timedata, gint count);
+
 void          gst_fft_f32_window        (GstFFTF32 *self, gfloat *timedata, GstFFTWindow window);
 
 G_END_DECLS
@@ -56,6 +56,11 @@ void            gst_fft_f64_fft         (GstFFTF64 *self, const gdouble *timedat
 void            gst_fft_f64_inverse_fft (GstFFTF64 *self, const GstFFTF64Complex *freqdata,
                                          gdouble *timedata);
 
+void            gst_fft_f64_fft_batch   (GstFFTF64 *self, const gdouble *timedata,
+                                         GstFFTF64Complex *freqdata, gint count);
+void            gst_fft_f64_inverse_fft_batch (GstFFTF64 *self, const GstFFTF64Complex *freqdata,
+                                         gdouble *timedata, gint count);
+
 void            gst_fft_f64_window      (GstFFTF64 *self, gdouble *timedata, GstFFTWindow window);
 
 G_END_DECLS
@@ -0,0 +1,59 @@
+/* GStreamer
+ * Copyright (C) <2016> The GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_FFT_PRIVATE_H__
+#define __GST_FFT_PRIVATE_H__
+
+#include <glib.h>
+
+G_BEGIN_DECLS
+
+typedef enum
+{
+  GST_FFT_PLAN_S16,
+  GST_FFT_PLAN_S32,
+  GST_FFT_PLAN_F32,
+  GST_FFT_PLAN_F64
+} GstFFTPlanType;
+
+typedef gpointer (*GstFFTPlanAllocFunc) (gint len, gboolean inverse);
+
+/* A read-only kiss_fftr configuration (factors and twiddles) that is shared
+ * between all FFT instances of the same type, length and direction. */
+typedef struct
+{
+  GstFFTPlanType type;
+  gint len;
+  gboolean inverse;
+
+  gint refcount;
+  gpointer cfg;
+} GstFFTPlan;
+
+G_GNUC_INTERNAL
+GstFFTPlan *  _gst_fft_plan_ref     (GstFFTPlanType type, gint len,
+                                     gboolean inverse,
+                                     GstFFTPlanAllocFunc alloc_func);
+
+G_GNUC_INTERNAL
+void          _gst_fft_plan_unref   (GstFFTPlan * plan);
+
+G_END_DECLS
+
+#endif /* __GST_FFT_PRIVATE_H__ */
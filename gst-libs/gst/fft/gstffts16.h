@@ -56,6 +56,11 @@ void            gst_fft_s16_fft         (GstFFTS16 *self, const gint16 *timedata
 void            gst_fft_s16_inverse_fft (GstFFTS16 *self, const GstFFTS16Complex *freqdata,
                                          gint16 *timedata);
 
+void            gst_fft_s16_fft_batch   (GstFFTS16 *self, const gint16 *timedata,
+                                         GstFFTS16Complex *freqdata, gint count);
+void            gst_fft_s16_inverse_fft_batch (GstFFTS16 *self, const GstFFTS16Complex *freqdata,
+                                         gint16 *timedata, gint count);
+
 void            gst_fft_s16_window      (GstFFTS16 *self, gint16 *timedata, GstFFTWindow window);
 
 G_END_DECLS
@@ -27,6 +27,7 @@
 #include "_kiss_fft_guts_s32.h"
 #include "kiss_fftr_s32.h"
 #include "gstfft.h"
+#include "gstfftprivate.h"
 #include "gstffts32.h"
 
 /**
@@ -65,8 +66,15 @@ struct _GstFFTS32
   void *cfg;
   gboolean inverse;
   gint len;
+  GstFFTPlan *plan;
 };
 
+static gpointer
+gst_fft_s32_plan_alloc (gint len, gboolean inverse)
+{
+  return kiss_fftr_s32_alloc (len, (inverse) ? 1 : 0, NULL, NULL);
+}
+
 /**
  * gst_fft_s32_new: (skip)
  * @len: Length of the FFT in the time domain
@@ -85,20 +93,28 @@ GstFFTS32 *
 gst_fft_s32_new (gint len, gboolean inverse)
 {
   GstFFTS32 *self;
+  GstFFTPlan *plan;
   gsize subsize = 0, memneeded;
 
   g_return_val_if_fail (len > 0, NULL);
   g_return_val_if_fail (len % 2 == 0, NULL);
 
-  kiss_fftr_s32_alloc (len, (inverse) ? 1 : 0, NULL, &subsize);
+  /* factors and twiddles are shared by all instances with the same
+   * parameters, only the scratch memory is allocated per instance */
+  plan = _gst_fft_plan_ref (GST_FFT_PLAN_S32, len, inverse,
+      gst_fft_s32_plan_alloc);
+
+  kiss_fftr_s32_clone (plan->cfg, NULL, &subsize);
   memneeded = ALIGN_STRUCT (sizeof (GstFFTS32)) + subsize;
 
   self = (GstFFTS32 *) g_malloc0 (memneeded);
 
   self->cfg = (((guint8 *) self) + ALIGN_STRUCT (sizeof (GstFFTS32)));
-  self->cfg = kiss_fftr_s32_alloc (len, (inverse) ? 1 : 0, self->cfg, &subsize);
+  self->cfg = kiss_fftr_s32_clone (plan->cfg, self->cfg, &subsize);
   g_assert (self->cfg);
 
+  self->plan = plan;
+
   self->inverse = inverse;
   self->len = len;
 
@@ -158,6 +174,81 @@ gst_fft_s32_inverse_fft (GstFFTS32 * self, const GstFFTS32Complex * freqdata,
   kiss_fftri_s32 (self->cfg, (kiss_fft_s32_cpx *) freqdata, timedata);
 }
 
+/**
+ * gst_fft_s32_fft_batch:
+ * @self: #GstFFTS32 instance for this call
+ * @timedata: Buffer of the samples in the time domain
+ * @freqdata: Target buffer for the samples in the frequency domain
+ * @count: Number of transforms
+ *
+ * This performs the FFT on @count consecutive blocks of samples in
+ * @timedata, for example several channels or frames, and puts the results
+ * as consecutive blocks in @freqdata.
+ *
+ * @timedata must have @count times as many samples as specified with the @len
+ * parameter while allocating the #GstFFTS32 instance with gst_fft_s32_new().
+ *
+ * @freqdata must be large enough to hold @count times @len/2 + 1
+ * #GstFFTS32Complex frequency domain samples.
+ *
+ * Since: 1.10
+ */
+void
+gst_fft_s32_fft_batch (GstFFTS32 * self, const gint32 * timedata,
+    GstFFTS32Complex * freqdata, gint count)
+{
+  gint i, freqlen;
+
+  g_return_if_fail (self);
+  g_return_if_fail (!self->inverse);
+  g_return_if_fail (timedata || count == 0);
+  g_return_if_fail (freqdata || count == 0);
+
+  freqlen = self->len / 2 + 1;
+
+  for (i = 0; i < count; i++)
+    kiss_fftr_s32 (self->cfg, timedata + i * self->len,
+        (kiss_fft_s32_cpx *) freqdata + i * freqlen);
+}
+
+/**
+ * gst_fft_s32_inverse_fft_batch:
+ * @self: #GstFFTS32 instance for this call
+ * @freqdata: Buffer of the samples in the frequency domain
+ * @timedata: Target buffer for the samples in the time domain
+ * @count: Number of transforms
+ *
+ * This performs the inverse FFT on @count consecutive blocks of samples in
+ * @freqdata and puts the results as consecutive blocks in @timedata.
+ *
+ * @freqdata must have @count times @len/2 + 1 samples, where @len is the
+ * parameter specified while allocating the #GstFFTS32 instance with
+ * gst_fft_s32_new().
+ *
+ * @timedata must be large enough to hold @count times @len time domain
+ * samples.
+ *
+ * Since: 1.10
+ */
+void
+gst_fft_s32_inverse_fft_batch (GstFFTS32 * self,
+    const GstFFTS32Complex * freqdata, gint32 * timedata, gint count)
+{
+  gint i, freqlen;
+
+  g_return_if_fail (self);
+  g_return_if_fail (self->inverse);
+  g_return_if_fail (timedata || count == 0);
+  g_return_if_fail (freqdata || count == 0);
+
+  freqlen = self->len / 2 + 1;
+
+  for (i = 0; i < count; i++)
+    kiss_fftri_s32 (self->cfg,
+        (const kiss_fft_s32_cpx *) freqdata + i * freqlen,
+        timedata + i * self->len);
+}
+
 /**
  * gst_fft_s32_free:
  * @self: #GstFFTS32 instance for this call
@@ -168,6 +259,10 @@ gst_fft_s32_inverse_fft (GstFFTS32 * self, const GstFFTS32Complex * freqdata,
 void
 gst_fft_s32_free (GstFFTS32 * self)
 {
+  if (self == NULL)
+    return;
+
+  _gst_fft_plan_unref (self->plan);
   g_free (self);
 }
 
@@ -56,6 +56,11 @@ void            gst_fft_s32_fft         (GstFFTS32 *self, const gint32 *timedata
 void            gst_fft_s32_inverse_fft (GstFFTS32 *self, const GstFFTS32Complex *freqdata,
                                          gint32 *timedata);
 
+void            gst_fft_s32_fft_batch   (GstFFTS32 *self, const gint32 *timedata,
+                                         GstFFTS32Complex *freqdata, gint count);
+void            gst_fft_s32_inverse_fft_batch (GstFFTS32 *self, const GstFFTS32Complex *freqdata,
+                                         gint32 *timedata, gint count);
+
 void            gst_fft_s32_window      (GstFFTS32 *self, gint32 *timedata, GstFFTWindow window);
 
 G_END_DECLS
@@ -72,6 +72,34 @@ kiss_fftr_f32_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
   return st;
 }
 
+kiss_fftr_f32_cfg
+kiss_fftr_f32_clone (kiss_fftr_f32_cfg shared, void *mem, size_t * lenmem)
+{
+  kiss_fftr_f32_cfg st = NULL;
+  size_t memneeded;
+
+  memneeded = ALIGN_STRUCT (sizeof (struct kiss_fftr_f32_state))
+      + sizeof (kiss_fft_f32_cpx) * shared->substate->nfft;
+
+  if (lenmem == NULL) {
+    st = (kiss_fftr_f32_cfg) KISS_FFT_F32_MALLOC (memneeded);
+  } else {
+    if (*lenmem >= memneeded)
+      st = (kiss_fftr_f32_cfg) mem;
+    *lenmem = memneeded;
+  }
+  if (!st)
+    return NULL;
+
+  /* only the scratch buffer is private, factors and twiddles are shared */
+  st->substate = shared->substate;
+  st->tmpbuf = (kiss_fft_f32_cpx *) (((char *) st) +
+      ALIGN_STRUCT (sizeof (struct kiss_fftr_f32_state)));
+  st->super_twiddles = shared->super_twiddles;
+
+  return st;
+}
+
 void
 kiss_fftr_f32 (kiss_fftr_f32_cfg st, const kiss_fft_f32_scalar * timedata,
     kiss_fft_f32_cpx * freqdata)
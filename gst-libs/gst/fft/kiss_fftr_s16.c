@@ -73,6 +73,34 @@ kiss_fftr_s16_alloc (int nfft, int inverse_fft, void *mem, size_t * lenmem)
   return st;
 }
 
+kiss_fftr_s16_cfg
+kiss_fftr_s16_clone (kiss_fftr_s16_cfg shared, void *mem, size_t * lenmem)
+{
+  kiss_fftr_s16_cfg st = NULL;
+  size_t memneeded;
+
+  memneeded = ALIGN_STRUCT (sizeof (struct kiss_fftr_s16_state))
+      + sizeof (kiss_fft_s16_cpx) * shared->substate->nfft;
+
+  if (lenmem == NULL) {
+    st = (kiss_fftr_s16_cfg) KISS_FFT_S16_MALLOC (memneeded);
+  } else {
+    if (*lenmem >= memneeded)
+      st = (kiss_fftr_s16_cfg) mem;
+    *lenmem = memneeded;
+  }
+  if (!st)
+    return NULL;
+
+  /* only the scratch buffer is private, factors and twiddles are shared */
+  st->substate = shared->substate;
+  st->tmpbuf = (kiss_fft_s16_cpx *) (((char *) st) +
+      ALIGN_STRUCT (sizeof (struct kiss_fftr_s16_state)));
+  st->super_twiddles = shared->super_twiddles;
+
+  return st;
+}
+
 void
 kiss_fftr_s16 (kiss_fftr_s16_cfg st, const kiss_fft_s16_scalar * timedata,
     kiss_fft_s16_cpx * freqdata)
@@ -26,6 +26,14 @@ kiss_fftr_s16_cfg kiss_fftr_s16_alloc(int nfft,int inverse_fft,void * mem, size_
 */
 
 
+G_GNUC_INTERNAL kiss_fftr_s16_cfg kiss_fftr_s16_clone(kiss_fftr_s16_cfg shared,void * mem, size_t * lenmem);
+/*
+ creates a configuration that shares the read-only factors and twiddles of
+ shared but has its own scratch buffer, shared must stay alive as long as
+ the clone is used
+*/
+
+
 void kiss_fftr_s16(kiss_fftr_s16_cfg cfg,const kiss_fft_s16_scalar *timedata,kiss_fft_s16_cpx *freqdata);
 /*
  input timedata has nfft scalar points
@@ -138,52 +138,62 @@ struct _GstAudioVisualizerPrivate
 
 /* shading functions */
 
-/* we're only supporting GST_VIDEO_FORMAT_xRGB right now) */
-#if G_BYTE_ORDER == G_LITTLE_ENDIAN
-
-#define SHADE(_d, _s, _i, _r, _g, _b)                     \
-G_STMT_START {                                            \
-    _d[_i * 4 + 0] = (_s[_i * 4 + 0] > _b) ? _s[_i * 4 + 0] - _b : 0; \
-    _d[_i * 4 + 1] = (_s[_i * 4 + 1] > _g) ? _s[_i * 4 + 1] - _g : 0; \
-    _d[_i * 4 + 2] = (_s[_i * 4 + 2] > _r) ? _s[_i * 4 + 2] - _r : 0; \
-    _d[_i * 4 + 3] = 0;                                       \
-} G_STMT_END
-
-#else /* G_BYTE_ORDER == G_LITTLE_ENDIAN */
-
-#define SHADE(_d, _s, _i, _r, _g, _b)                     \
-G_STMT_START {                                            \
-    _d[_i * 4 + 0] = 0;                                       \
-    _d[_i * 4 + 1] = (_s[_i * 4 + 1] > _r) ? _s[_i * 4 + 1] - _r : 0; \
-    _d[_i * 4 + 2] = (_s[_i * 4 + 2] > _g) ? _s[_i * 4 + 2] - _g : 0; \
-    _d[_i * 4 + 3] = (_s[_i * 4 + 3] > _b) ? _s[_i * 4 + 3] - _b : 0; \
-} G_STMT_END
+/* We're only supporting 32bpp packed formats with the pixel stored as a
+ * native-endian 0x00RRGGBB word (xRGB on big endian, BGRx on little endian),
+ * so each pixel can be handled as one 32-bit lane.
+ *
+ * shade_line() subtracts @shade from every byte of the pixel with unsigned
+ * saturation, without branches. The top byte of the shade is 0xff, which
+ * always clears the x channel. Each pixel is independent of its neighbours,
+ * so the compiler can vectorise the loop into whole-register operations. */
+#define SHADE_HIGH_BITS 0x80808080
+#define SHADE_LOW_BITS  0x7f7f7f7f
+
+static inline guint32
+shade_pixel (guint32 s, guint32 shade)
+{
+  guint32 d, borrow;
 
-#endif
+  /* per byte difference, borrows don't cross byte boundaries */
+  d = ((s | SHADE_HIGH_BITS) - (shade & SHADE_LOW_BITS)) ^
+      ((s ^ ~shade) & SHADE_HIGH_BITS);
+  /* top bit of each byte is set where s < shade */
+  borrow = ((~s & shade) | (~(s ^ shade) & d)) & SHADE_HIGH_BITS;
+
+  return d & ~((borrow >> 7) * 0xff);
+}
 
 static void
-shader_fade (GstAudioVisualizer * scope, const GstVideoFrame * sframe,
-    GstVideoFrame * dframe)
+shade_line (guint32 * d, const guint32 * s, guint32 shade, gint width)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
+  gint i;
+
+  for (i = 0; i < width; i++)
+    d[i] = shade_pixel (s[i], shade);
+}
 
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
+#define SHADER_SETUP(scope, sframe, dframe)                      \
+  guint32 shade = 0xff000000 |                                   \
+      ((scope)->priv->shade_amount & 0x00ffffff);                 \
+  guint8 *s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);            \
+  guint8 *d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);            \
+  gint ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);            \
+  gint ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);            \
+  gint width = GST_VIDEO_FRAME_WIDTH (sframe);                   \
+  gint height = GST_VIDEO_FRAME_HEIGHT (sframe)
 
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+#define SHADE_LINE(_d, _s, _off, _w) \
+  shade_line ((guint32 *) (_d) + (_off), (const guint32 *) (_s), shade, _w)
+
+static void
+shader_fade (GstAudioVisualizer * scope, const GstVideoFrame * sframe,
+    GstVideoFrame * dframe)
+{
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   for (j = 0; j < height; j++) {
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     s += ss;
     d += ds;
   }
@@ -193,26 +203,12 @@ static void
 shader_fade_and_move_up (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   for (j = 1; j < height; j++) {
     s += ss;
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     d += ds;
   }
 }
@@ -221,26 +217,12 @@ static void
 shader_fade_and_move_down (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   for (j = 1; j < height; j++) {
     d += ds;
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     s += ss;
   }
 }
@@ -249,29 +231,12 @@ static void
 shader_fade_and_move_left (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
-
-  width -= 1;
-  s += 4;
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   /* move to the left */
   for (j = 0; j < height; j++) {
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, (guint32 *) s + 1, 0, width - 1);
     d += ds;
     s += ss;
   }
@@ -281,29 +246,12 @@ static void
 shader_fade_and_move_right (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
-
-  width -= 1;
-  d += 4;
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   /* move to the right */
   for (j = 0; j < height; j++) {
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 1, width - 1);
     d += ds;
     s += ss;
   }
@@ -313,35 +261,19 @@ static void
 shader_fade_and_move_horiz_out (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   /* move upper half up */
   for (j = 0; j < height / 2; j++) {
     s += ss;
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     d += ds;
   }
   /* move lower half down */
   for (j = 0; j < height / 2; j++) {
     d += ds;
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     s += ss;
   }
 }
@@ -350,35 +282,19 @@ static void
 shader_fade_and_move_horiz_in (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *d;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+  gint j;
+  SHADER_SETUP (scope, sframe, dframe);
 
   /* move upper half down */
   for (j = 0; j < height / 2; j++) {
     d += ds;
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     s += ss;
   }
   /* move lower half up */
   for (j = 0; j < height / 2; j++) {
     s += ss;
-    for (i = 0; i < width; i++) {
-      SHADE (d, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 0, width);
     d += ds;
   }
 }
@@ -387,32 +303,15 @@ static void
 shader_fade_and_move_vert_out (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *s1, *d, *d1;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+  gint j, half;
+  SHADER_SETUP (scope, sframe, dframe);
 
+  half = width / 2;
   for (j = 0; j < height; j++) {
     /* move left half to the left */
-    s1 = s + 1;
-    for (i = 0; i < width / 2; i++) {
-      SHADE (d, s1, i, r, g, b);
-    }
+    SHADE_LINE (d, (guint32 *) s + 1, 0, half);
     /* move right half to the right */
-    d1 = d + 1;
-    for (; i < width - 1; i++) {
-      SHADE (d1, s, i, r, g, b);
-    }
+    SHADE_LINE (d, (guint32 *) s + half, half + 1, width - 1 - half);
     s += ss;
     d += ds;
   }
@@ -422,32 +321,15 @@ static void
 shader_fade_and_move_vert_in (GstAudioVisualizer * scope,
     const GstVideoFrame * sframe, GstVideoFrame * dframe)
 {
-  guint i, j;
-  guint r = (scope->priv->shade_amount >> 16) & 0xff;
-  guint g = (scope->priv->shade_amount >> 8) & 0xff;
-  guint b = (scope->priv->shade_amount >> 0) & 0xff;
-  guint8 *s, *s1, *d, *d1;
-  gint ss, ds, width, height;
-
-  s = GST_VIDEO_FRAME_PLANE_DATA (sframe, 0);
-  ss = GST_VIDEO_FRAME_PLANE_STRIDE (sframe, 0);
-  d = GST_VIDEO_FRAME_PLANE_DATA (dframe, 0);
-  ds = GST_VIDEO_FRAME_PLANE_STRIDE (dframe, 0);
-
-  width = GST_VIDEO_FRAME_WIDTH (sframe);
-  height = GST_VIDEO_FRAME_HEIGHT (sframe);
+  gint j, half;
+  SHADER_SETUP (scope, sframe, dframe);
 
+  half = width / 2;
   for (j = 0; j < height; j++) {
     /* move left half to the right */
-    d1 = d + 1;
-    for (i = 0; i < width / 2; i++) {
-      SHADE (d1, s, i, r, g, b);
-    }
+    SHADE_LINE (d, s, 1, half);
     /* move right half to the left */
-    s1 = s + 1;
-    for (; i < width - 1; i++) {
-      SHADE (d, s1, i, r, g, b);
-    }
+    SHADE_LINE (d, (guint32 *) s + half + 1, half, width - 1 - half);
     s += ss;
     d += ds;
   }
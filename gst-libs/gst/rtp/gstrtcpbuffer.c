@@ -356,7 +356,9 @@ gst_rtcp_buffer_unmap (GstRTCPBuffer * rtcp)
 guint
 gst_rtcp_buffer_get_packet_count (GstRTCPBuffer * rtcp)
 {
-  GstRTCPPacket packet;
+  guint8 *data;
+  gsize size;
+  guint offset, len;
   guint count;
 
   g_return_val_if_fail (rtcp != NULL, 0);
@@ -364,11 +366,28 @@ gst_rtcp_buffer_get_packet_count (GstRTCPBuffer * rtcp)
   g_return_val_if_fail (rtcp != NULL, 0);
   g_return_val_if_fail (rtcp->map.flags & GST_MAP_READ, 0);
 
+  data = rtcp->map.data;
+  size = rtcp->map.size;
+
+  /* walk the packet headers with the same checks as read_packet_header() and
+   * gst_rtcp_packet_move_to_next() but without filling a packet each time */
   count = 0;
-  if (gst_rtcp_buffer_get_first_packet (rtcp, &packet)) {
-    do {
-      count++;
-    } while (gst_rtcp_packet_move_to_next (&packet));
+  offset = 0;
+  while (offset + 4 <= size) {
+    if ((data[offset] & 0xc0) != (GST_RTCP_VERSION << 6))
+      break;
+
+    len = (((data[offset + 2] << 8) | data[offset + 3]) << 2) + 4;
+    if (offset + len > size)
+      break;
+
+    count++;
+
+    /* a packet with padding must be the last one */
+    if (data[offset] & 0x20)
+      break;
+
+    offset += len;
   }
 
   return count;
@@ -500,6 +519,9 @@ end:
  * Add a new packet of @type to @rtcp. @packet will point to the newly created 
  * packet.
  *
+ * The packet is placed right after the data added so far, the existing
+ * packets in @rtcp are not parsed again to find the end.
+ *
  * Returns: %TRUE if the packet could be created. This function returns %FALSE
  * if the max mtu is exceeded for the buffer.
  */
@@ -518,9 +540,12 @@ gst_rtcp_buffer_add_packet (GstRTCPBuffer * rtcp, GstRTCPType type,
   g_return_val_if_fail (packet != NULL, FALSE);
   g_return_val_if_fail (rtcp->map.flags & GST_MAP_WRITE, FALSE);
 
-  /* find free space */
-  if (gst_rtcp_buffer_get_first_packet (rtcp, packet))
-    while (gst_rtcp_packet_move_to_next (packet));
+  /* find free space. All functions that add data keep the size of the map at
+   * the end of the last packet, so we can append there without walking all
+   * the packets of the compound packet. */
+  packet->rtcp = rtcp;
+  packet->offset = rtcp->map.size;
+  packet->type = GST_RTCP_TYPE_INVALID;
 
   maxsize = rtcp->map.maxsize;
 
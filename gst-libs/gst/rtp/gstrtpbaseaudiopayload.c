@@ -235,10 +235,7 @@ gst_rtp_base_audio_payload_set_property (GObject * object,
 
   switch (prop_id) {
     case PROP_BUFFER_LIST:
-#if 0
       payload->priv->buffer_list = g_value_get_boolean (value);
-#endif
-      payload->priv->buffer_list = FALSE;
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
@@ -404,8 +401,9 @@ gst_rtp_base_audio_payload_set_meta (GstRTPBaseAudioPayload * payload,
   basepayload = GST_RTP_BASE_PAYLOAD_CAST (payload);
   priv = payload->priv;
 
-  /* set payload type */
-  gst_rtp_buffer_map (buffer, GST_MAP_WRITE, &rtp);
+  /* set payload type, only the header is needed for that */
+  gst_rtp_buffer_map (buffer,
+      GST_MAP_WRITE | GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp);
   gst_rtp_buffer_set_payload_type (&rtp, basepayload->pt);
   /* set marker bit for disconts */
   if (priv->discont) {
@@ -451,9 +449,7 @@ gst_rtp_base_audio_payload_push (GstRTPBaseAudioPayload * baseaudiopayload,
 {
   GstRTPBasePayload *basepayload;
   GstBuffer *outbuf;
-  guint8 *payload;
   GstFlowReturn ret;
-  GstRTPBuffer rtp = { NULL };
 
   basepayload = GST_RTP_BASE_PAYLOAD (baseaudiopayload);
 
@@ -461,13 +457,12 @@ gst_rtp_base_audio_payload_push (GstRTPBaseAudioPayload * baseaudiopayload,
       payload_len, GST_TIME_ARGS (timestamp));
 
   /* create buffer to hold the payload */
-  outbuf = gst_rtp_buffer_new_allocate (payload_len, 0, 0);
+  outbuf = gst_rtp_base_payload_allocate_output_buffer (basepayload,
+      payload_len, 0, 0);
 
-  /* copy payload */
-  gst_rtp_buffer_map (outbuf, GST_MAP_WRITE, &rtp);
-  payload = gst_rtp_buffer_get_payload (&rtp);
-  memcpy (payload, data, payload_len);
-  gst_rtp_buffer_unmap (&rtp);
+  /* copy payload, it lives in the last memory after the header */
+  gst_buffer_fill (outbuf, gst_buffer_get_size (outbuf) - payload_len, data,
+      payload_len);
 
   /* set metadata */
   gst_rtp_base_audio_payload_set_meta (baseaudiopayload, outbuf, payload_len,
@@ -508,61 +503,88 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
   return TRUE;
 }
 
-static GstFlowReturn
-gst_rtp_base_audio_payload_push_buffer (GstRTPBaseAudioPayload *
-    baseaudiopayload, GstBuffer * buffer, GstClockTime timestamp)
+/* create an RTP packet with @paybuf as the payload. The header is taken from
+ * the pool of the base payloader and the memory of @paybuf is appended as is,
+ * the audio data is not copied. Takes ownership of @paybuf. */
+static GstBuffer *
+gst_rtp_base_audio_payload_create_packet (GstRTPBaseAudioPayload *
+    baseaudiopayload, GstBuffer * paybuf, GstClockTime timestamp)
 {
-  GstRTPBasePayload *basepayload;
-  GstRTPBaseAudioPayloadPrivate *priv;
   GstBuffer *outbuf;
+  CopyMetaData data;
   guint payload_len;
-  GstFlowReturn ret;
 
-  priv = baseaudiopayload->priv;
-  basepayload = GST_RTP_BASE_PAYLOAD (baseaudiopayload);
+  payload_len = gst_buffer_get_size (paybuf);
 
-  payload_len = gst_buffer_get_size (buffer);
-
-  GST_DEBUG_OBJECT (baseaudiopayload, "Pushing %d bytes ts %" GST_TIME_FORMAT,
+  GST_DEBUG_OBJECT (baseaudiopayload, "Packet of %d bytes ts %" GST_TIME_FORMAT,
       payload_len, GST_TIME_ARGS (timestamp));
 
   /* create just the RTP header buffer */
-  outbuf = gst_rtp_buffer_new_allocate (0, 0, 0);
+  outbuf =
+      gst_rtp_base_payload_allocate_output_buffer (GST_RTP_BASE_PAYLOAD_CAST
+      (baseaudiopayload), 0, 0, 0);
 
   /* set metadata */
   gst_rtp_base_audio_payload_set_meta (baseaudiopayload, outbuf, payload_len,
       timestamp);
 
-  if (priv->buffer_list) {
-    GstBufferList *list;
-    guint i, len;
+  /* copy payload */
+  data.pay = baseaudiopayload;
+  data.outbuf = outbuf;
+  gst_buffer_foreach_meta (paybuf, foreach_metadata, &data);
 
-    list = gst_buffer_list_new ();
-    len = gst_buffer_list_length (list);
+  return gst_buffer_append (outbuf, paybuf);
+}
 
-    for (i = 0; i < len; i++) {
-      /* FIXME */
-      g_warning ("bufferlist not implemented");
-      gst_buffer_list_add (list, outbuf);
-      gst_buffer_list_add (list, buffer);
-    }
+static GstFlowReturn
+gst_rtp_base_audio_payload_push_buffer (GstRTPBaseAudioPayload *
+    baseaudiopayload, GstBuffer * buffer, GstClockTime timestamp)
+{
+  GstBuffer *outbuf;
 
-    GST_DEBUG_OBJECT (baseaudiopayload, "Pushing list %p", list);
-    ret = gst_rtp_base_payload_push_list (basepayload, list);
-  } else {
-    CopyMetaData data;
+  outbuf = gst_rtp_base_audio_payload_create_packet (baseaudiopayload, buffer,
+      timestamp);
+
+  GST_DEBUG_OBJECT (baseaudiopayload, "Pushing buffer %p", outbuf);
+  return gst_rtp_base_payload_push (GST_RTP_BASE_PAYLOAD (baseaudiopayload),
+      outbuf);
+}
+
+/* take @payload_len bytes out of the adapter and make an RTP packet of them.
+ * When @timestamp is -1, it is calculated from the adapter. */
+static GstBuffer *
+gst_rtp_base_audio_payload_take_packet (GstRTPBaseAudioPayload *
+    baseaudiopayload, guint payload_len, GstClockTime timestamp)
+{
+  GstRTPBaseAudioPayloadPrivate *priv;
+  GstAdapter *adapter;
+  GstBuffer *paybuf;
+  guint64 distance;
+
+  priv = baseaudiopayload->priv;
+  adapter = priv->adapter;
 
-    /* copy payload */
-    data.pay = baseaudiopayload;
-    data.outbuf = outbuf;
-    gst_buffer_foreach_meta (buffer, foreach_metadata, &data);
-    outbuf = gst_buffer_append (outbuf, buffer);
+  if (timestamp == -1) {
+    /* calculate the timestamp */
+    timestamp = gst_adapter_prev_pts (adapter, &distance);
 
-    GST_DEBUG_OBJECT (baseaudiopayload, "Pushing buffer %p", outbuf);
-    ret = gst_rtp_base_payload_push (basepayload, outbuf);
+    GST_LOG_OBJECT (baseaudiopayload,
+        "last timestamp %" GST_TIME_FORMAT ", distance %" G_GUINT64_FORMAT,
+        GST_TIME_ARGS (timestamp), distance);
+
+    if (GST_CLOCK_TIME_IS_VALID (timestamp) && distance > 0) {
+      /* convert the number of bytes since the last timestamp to time and add to
+       * the last seen timestamp */
+      timestamp += priv->bytes_to_time (baseaudiopayload, distance);
+    }
   }
 
-  return ret;
+  /* this shares the memory of the input buffers, when the data spans several
+   * of them the result has several memories instead of a merged copy */
+  paybuf = gst_adapter_take_buffer_fast (adapter, payload_len);
+
+  return gst_rtp_base_audio_payload_create_packet (baseaudiopayload, paybuf,
+      timestamp);
 }
 
 /**
@@ -584,17 +606,10 @@ GstFlowReturn
 gst_rtp_base_audio_payload_flush (GstRTPBaseAudioPayload * baseaudiopayload,
     guint payload_len, GstClockTime timestamp)
 {
-  GstRTPBasePayload *basepayload;
-  GstRTPBaseAudioPayloadPrivate *priv;
   GstBuffer *outbuf;
-  GstFlowReturn ret;
   GstAdapter *adapter;
-  guint64 distance;
-
-  priv = baseaudiopayload->priv;
-  adapter = priv->adapter;
 
-  basepayload = GST_RTP_BASE_PAYLOAD (baseaudiopayload);
+  adapter = baseaudiopayload->priv->adapter;
 
   if (payload_len == -1)
     payload_len = gst_adapter_available (adapter);
@@ -603,56 +618,12 @@ gst_rtp_base_audio_payload_flush (GstRTPBaseAudioPayload * baseaudiopayload,
   if (payload_len == 0)
     return GST_FLOW_OK;
 
-  if (timestamp == -1) {
-    /* calculate the timestamp */
-    timestamp = gst_adapter_prev_pts (adapter, &distance);
+  outbuf = gst_rtp_base_audio_payload_take_packet (baseaudiopayload,
+      payload_len, timestamp);
 
-    GST_LOG_OBJECT (baseaudiopayload,
-        "last timestamp %" GST_TIME_FORMAT ", distance %" G_GUINT64_FORMAT,
-        GST_TIME_ARGS (timestamp), distance);
-
-    if (GST_CLOCK_TIME_IS_VALID (timestamp) && distance > 0) {
-      /* convert the number of bytes since the last timestamp to time and add to
-       * the last seen timestamp */
-      timestamp += priv->bytes_to_time (baseaudiopayload, distance);
-    }
-  }
-
-  GST_DEBUG_OBJECT (baseaudiopayload, "Pushing %d bytes ts %" GST_TIME_FORMAT,
-      payload_len, GST_TIME_ARGS (timestamp));
-
-  if (priv->buffer_list && gst_adapter_available_fast (adapter) >= payload_len) {
-    GstBuffer *buffer;
-    /* we can quickly take a buffer out of the adapter without having to copy
-     * anything. */
-    buffer = gst_adapter_take_buffer (adapter, payload_len);
-
-    ret =
-        gst_rtp_base_audio_payload_push_buffer (baseaudiopayload, buffer,
-        timestamp);
-  } else {
-    GstBuffer *paybuf;
-    CopyMetaData data;
-
-
-    /* create buffer to hold the payload */
-    outbuf = gst_rtp_buffer_new_allocate (0, 0, 0);
-
-    paybuf = gst_adapter_take_buffer_fast (adapter, payload_len);
-
-    data.pay = baseaudiopayload;
-    data.outbuf = outbuf;
-    gst_buffer_foreach_meta (paybuf, foreach_metadata, &data);
-    outbuf = gst_buffer_append (outbuf, paybuf);
-
-    /* set metadata */
-    gst_rtp_base_audio_payload_set_meta (baseaudiopayload, outbuf, payload_len,
-        timestamp);
-
-    ret = gst_rtp_base_payload_push (basepayload, outbuf);
-  }
-
-  return ret;
+  GST_DEBUG_OBJECT (baseaudiopayload, "Pushing buffer %p", outbuf);
+  return gst_rtp_base_payload_push (GST_RTP_BASE_PAYLOAD (baseaudiopayload),
+      outbuf);
 }
 
 #define ALIGN_DOWN(val,len) ((val) - ((val) % (len)))
@@ -843,6 +814,7 @@ gst_rtp_base_audio_payload_handle_buffer (GstRTPBasePayload *
   guint size;
   gboolean discont;
   GstClockTime timestamp;
+  GstBufferList *list = NULL;
 
   ret = GST_FLOW_OK;
 
@@ -905,7 +877,16 @@ gst_rtp_base_audio_payload_handle_buffer (GstRTPBasePayload *
     /* If buffer fits on an RTP packet, let's just push it through
      * this will check against max_ptime and max_mtu */
     GST_DEBUG_OBJECT (payload, "Fast packet push");
-    ret = gst_rtp_base_audio_payload_push_buffer (payload, buffer, timestamp);
+    if (priv->buffer_list) {
+      list = gst_buffer_list_new_sized (1);
+      gst_buffer_list_add (list,
+          gst_rtp_base_audio_payload_create_packet (payload, buffer,
+              timestamp));
+      ret = gst_rtp_base_payload_push_list (basepayload, list);
+    } else {
+      ret = gst_rtp_base_audio_payload_push_buffer (payload, buffer,
+          timestamp);
+    }
   } else {
     /* push the buffer in the adapter */
     gst_adapter_push (priv->adapter, buffer);
@@ -913,8 +894,11 @@ gst_rtp_base_audio_payload_handle_buffer (GstRTPBasePayload *
 
     GST_DEBUG_OBJECT (payload, "available now %u", available);
 
+    /* collect all packets of this buffer in one list */
+    if (priv->buffer_list && available >= min_payload_len)
+      list = gst_buffer_list_new_sized (available / max_payload_len + 1);
+
     /* as long as we have full frames */
-    /* TODO: Use buffer lists here */
     while (available >= min_payload_len) {
       /* get multiple of alignment */
       payload_len = MIN (max_payload_len, available);
@@ -922,11 +906,22 @@ gst_rtp_base_audio_payload_handle_buffer (GstRTPBasePayload *
 
       /* and flush out the bytes from the adapter, automatically set the
        * timestamp. */
-      ret = gst_rtp_base_audio_payload_flush (payload, payload_len, -1);
+      if (list) {
+        gst_buffer_list_add (list,
+            gst_rtp_base_audio_payload_take_packet (payload, payload_len, -1));
+      } else {
+        ret = gst_rtp_base_audio_payload_flush (payload, payload_len, -1);
+      }
 
       available -= payload_len;
       GST_DEBUG_OBJECT (payload, "available after push %u", available);
     }
+
+    if (list) {
+      GST_DEBUG_OBJECT (payload, "Pushing list of %u packets",
+          gst_buffer_list_length (list));
+      ret = gst_rtp_base_payload_push_list (basepayload, list);
+    }
   }
   return ret;
 
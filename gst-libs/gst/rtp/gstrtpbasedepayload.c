@@ -346,6 +346,63 @@ caps_not_changed:
   }
 }
 
+/* Check seqnum. This is a very simple check that makes sure that the seqnums
+ * are strictly increasing, dropping anything that is out of the ordinary. We
+ * can only do this when the next_seqnum is known. Returns %FALSE when the
+ * packet should be dropped, sets @discont when the packet does not follow
+ * the previous one. */
+static gboolean
+gst_rtp_base_depayload_check_seqnum (GstRTPBaseDepayload * filter,
+    guint32 ssrc, guint16 seqnum, gboolean * discont)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  gint gap;
+
+  if (G_LIKELY (priv->next_seqnum != -1)) {
+    if (ssrc != priv->last_ssrc) {
+      GST_LOG_OBJECT (filter,
+          "New ssrc %u (current ssrc %u), sender restarted",
+          ssrc, priv->last_ssrc);
+      *discont = TRUE;
+    } else {
+      gap = gst_rtp_buffer_compare_seqnum (seqnum, priv->next_seqnum);
+
+      /* if we have no gap, all is fine */
+      if (G_UNLIKELY (gap != 0)) {
+        GST_LOG_OBJECT (filter, "got packet %u, expected %u, gap %d", seqnum,
+            priv->next_seqnum, gap);
+        if (gap < 0) {
+          /* seqnum > next_seqnum, we are missing some packets, this is always a
+           * DISCONT. */
+          GST_LOG_OBJECT (filter, "%d missing packets", gap);
+          *discont = TRUE;
+        } else {
+          /* seqnum < next_seqnum, we have seen this packet before or the sender
+           * could be restarted. If the packet is not too old, we throw it away as
+           * a duplicate, otherwise we mark discont and continue. 100 misordered
+           * packets is a good threshold. See also RFC 4737. */
+          if (gap < 100)
+            goto dropping;
+
+          GST_LOG_OBJECT (filter,
+              "%d > 100, packet too old, sender likely restarted", gap);
+          *discont = TRUE;
+        }
+      }
+    }
+  }
+  priv->next_seqnum = (seqnum + 1) & 0xffff;
+  priv->last_ssrc = ssrc;
+
+  return TRUE;
+
+dropping:
+  {
+    GST_WARNING_OBJECT (filter, "%d <= 100, dropping old packet", gap);
+    return FALSE;
+  }
+}
+
 /* takes ownership of the input buffer */
 static GstFlowReturn
 gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
@@ -361,7 +418,6 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
   guint16 seqnum;
   guint32 rtptime;
   gboolean discont, buf_discont;
-  gint gap;
   GstRTPBuffer rtp = { NULL };
 
   priv = filter->priv;
@@ -395,44 +451,8 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
       GST_TIME_FORMAT ", dts %" GST_TIME_FORMAT, buf_discont, seqnum, rtptime,
       GST_TIME_ARGS (priv->pts), GST_TIME_ARGS (priv->dts));
 
-  /* Check seqnum. This is a very simple check that makes sure that the seqnums
-   * are strictly increasing, dropping anything that is out of the ordinary. We
-   * can only do this when the next_seqnum is known. */
-  if (G_LIKELY (priv->next_seqnum != -1)) {
-    if (ssrc != priv->last_ssrc) {
-      GST_LOG_OBJECT (filter,
-          "New ssrc %u (current ssrc %u), sender restarted",
-          ssrc, priv->last_ssrc);
-      discont = TRUE;
-    } else {
-      gap = gst_rtp_buffer_compare_seqnum (seqnum, priv->next_seqnum);
-
-      /* if we have no gap, all is fine */
-      if (G_UNLIKELY (gap != 0)) {
-        GST_LOG_OBJECT (filter, "got packet %u, expected %u, gap %d", seqnum,
-            priv->next_seqnum, gap);
-        if (gap < 0) {
-          /* seqnum > next_seqnum, we are missing some packets, this is always a
-           * DISCONT. */
-          GST_LOG_OBJECT (filter, "%d missing packets", gap);
-          discont = TRUE;
-        } else {
-          /* seqnum < next_seqnum, we have seen this packet before or the sender
-           * could be restarted. If the packet is not too old, we throw it away as
-           * a duplicate, otherwise we mark discont and continue. 100 misordered
-           * packets is a good threshold. See also RFC 4737. */
-          if (gap < 100)
-            goto dropping;
-
-          GST_LOG_OBJECT (filter,
-              "%d > 100, packet too old, sender likely restarted", gap);
-          discont = TRUE;
-        }
-      }
-    }
-  }
-  priv->next_seqnum = (seqnum + 1) & 0xffff;
-  priv->last_ssrc = ssrc;
+  if (!gst_rtp_base_depayload_check_seqnum (filter, ssrc, seqnum, &discont))
+    goto dropping;
 
   if (G_UNLIKELY (discont)) {
     priv->discont = TRUE;
@@ -507,7 +527,6 @@ invalid_buffer:
 dropping:
   {
     gst_rtp_buffer_unmap (&rtp);
-    GST_WARNING_OBJECT (filter, "%d <= 100, dropping old packet", gap);
     gst_buffer_unref (in);
     return GST_FLOW_OK;
   }
@@ -538,6 +557,128 @@ gst_rtp_base_depayload_chain (GstPad * pad, GstObject * parent, GstBuffer * in)
   return flow_ret;
 }
 
+/* check all packets of @list and let the subclass process them in one go,
+ * takes ownership of @list */
+static GstFlowReturn
+gst_rtp_base_depayload_handle_list (GstRTPBaseDepayload * filter,
+    GstRTPBaseDepayloadClass * bclass, GstBufferList * list)
+{
+  GstRTPBaseDepayloadPrivate *priv;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBufferList *out_list;
+  gboolean first = TRUE;
+  guint i, len;
+
+  priv = filter->priv;
+
+  /* we must have a setcaps first */
+  if (G_UNLIKELY (!priv->negotiated))
+    goto not_negotiated;
+
+  list = gst_buffer_list_make_writable (list);
+  len = gst_buffer_list_length (list);
+
+  for (i = 0; i < len;) {
+    GstBuffer *buffer = gst_buffer_list_get (list, i);
+    GstRTPBuffer rtp = { NULL };
+    guint32 ssrc, rtptime;
+    guint16 seqnum;
+    gboolean discont;
+
+    /* only the header is needed for the checks */
+    if (G_UNLIKELY (!gst_rtp_buffer_map (buffer,
+                GST_MAP_READ | GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp))) {
+      GST_ELEMENT_WARNING (filter, STREAM, DECODE, (NULL),
+          ("Received invalid RTP payload, dropping"));
+      gst_buffer_list_remove (list, i, 1);
+      len--;
+      continue;
+    }
+    ssrc = gst_rtp_buffer_get_ssrc (&rtp);
+    seqnum = gst_rtp_buffer_get_seq (&rtp);
+    rtptime = gst_rtp_buffer_get_timestamp (&rtp);
+    gst_rtp_buffer_unmap (&rtp);
+
+    discont = GST_BUFFER_IS_DISCONT (buffer);
+
+    GST_LOG_OBJECT (filter, "list packet %u, discont %d, seqnum %u, "
+        "rtptime %u", i, discont, seqnum, rtptime);
+
+    if (!gst_rtp_base_depayload_check_seqnum (filter, ssrc, seqnum,
+            &discont)) {
+      gst_buffer_list_remove (list, i, 1);
+      len--;
+      continue;
+    }
+
+    priv->last_seqnum = seqnum;
+    priv->last_rtptime = rtptime;
+
+    if (G_UNLIKELY (discont)) {
+      /* the first output is only marked for a discont before the first
+       * packet, the subclass has to mark the output of later packets */
+      if (first)
+        priv->discont = TRUE;
+      /* mark the packet so that the subclass can throw away old data */
+      if (!GST_BUFFER_IS_DISCONT (buffer)) {
+        GST_LOG_OBJECT (filter, "mark DISCONT on packet %u", i);
+        if (gst_buffer_is_writable (buffer)) {
+          GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_DISCONT);
+        } else {
+          buffer = gst_buffer_copy (buffer);
+          GST_BUFFER_FLAG_SET (buffer, GST_BUFFER_FLAG_DISCONT);
+          gst_buffer_list_remove (list, i, 1);
+          gst_buffer_list_insert (list, i, buffer);
+        }
+      }
+    }
+
+    if (first) {
+      /* output without timestamps gets the ones of the first packet */
+      priv->pts = GST_BUFFER_PTS (buffer);
+      priv->dts = GST_BUFFER_DTS (buffer);
+      priv->duration = GST_BUFFER_DURATION (buffer);
+
+      /* prepare segment event if needed */
+      if (filter->need_newsegment) {
+        priv->segment_event = create_segment_event (filter, rtptime,
+            GST_BUFFER_PTS (buffer));
+        filter->need_newsegment = FALSE;
+      }
+      first = FALSE;
+    }
+    i++;
+  }
+
+  if (len > 0) {
+    out_list = bclass->process_rtp_packet_list (filter, list);
+
+    /* let's send it out to processing */
+    if (out_list)
+      ret = gst_rtp_base_depayload_push_list (filter, out_list);
+  }
+
+  gst_buffer_list_unref (list);
+
+  return ret;
+
+  /* ERRORS */
+not_negotiated:
+  {
+    /* this is not fatal but should be filtered earlier */
+    GST_ELEMENT_ERROR (filter, CORE, NEGOTIATION,
+        ("No RTP format was negotiated."),
+        ("Input buffers need to have RTP caps set on them. This is usually "
+            "achieved by setting the 'caps' property of the upstream source "
+            "element (often udpsrc or appsrc), or by putting a capsfilter "
+            "element before the depayloader and setting the 'caps' property "
+            "on that. Also see http://cgit.freedesktop.org/gstreamer/"
+            "gst-plugins-good/tree/gst/rtp/README"));
+    gst_buffer_list_unref (list);
+    return GST_FLOW_NOT_NEGOTIATED;
+  }
+}
+
 static GstFlowReturn
 gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
     GstBufferList * list)
@@ -552,6 +693,9 @@ gst_rtp_base_depayload_chain_list (GstPad * pad, GstObject * parent,
 
   bclass = GST_RTP_BASE_DEPAYLOAD_GET_CLASS (basedepay);
 
+  if (bclass->process_rtp_packet_list != NULL)
+    return gst_rtp_base_depayload_handle_list (basedepay, bclass, list);
+
   flow_ret = GST_FLOW_OK;
 
   /* chain each buffer in list individually */
@@ -70,6 +70,8 @@ struct _GstRTPBaseDepayload
  * @process: process incoming rtp packets
  * @packet_lost: signal the depayloader about packet loss
  * @handle_event: custom event handling
+ * @process_rtp_packet_list: Optional. Process all packets of an incoming
+ * buffer list at once and return the output as a #GstBufferList. Since 1.10
  *
  * Base class for audio RTP payloader.
  */
@@ -110,8 +112,26 @@ struct _GstRTPBaseDepayloadClass
    */
   GstBuffer * (*process_rtp_packet) (GstRTPBaseDepayload *base, GstRTPBuffer * rtp_buffer);
 
+  /* Optional. Called for incoming buffer lists instead of processing every
+   * packet separately. The base class checks the sequence numbers of all
+   * packets first: it drops invalid and duplicate packets from @list and
+   * sets the DISCONT flag on packets that don't follow the previous one,
+   * the subclass should carry it over to the output of those packets.
+   * Only the first output buffer gets the timestamp of the first packet in
+   * @list if it has no valid timestamp, the subclass must timestamp all
+   * other output buffers itself. The returned list is pushed out with one
+   * gst_rtp_base_depayload_push_list(), if this function returns %NULL,
+   * nothing is pushed out. @list remains owned by the base class.
+   *
+   * Without this function every packet of a list is handled as if it was
+   * pushed as a separate buffer.
+   *
+   * Since: 1.10
+   */
+  GstBufferList * (*process_rtp_packet_list) (GstRTPBaseDepayload *base, GstBufferList * list);
+
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING - 1];
+  gpointer _gst_reserved[GST_PADDING - 2];
 };
 
 GType gst_rtp_base_depayload_get_type (void);
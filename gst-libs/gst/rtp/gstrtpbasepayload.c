@@ -61,8 +61,240 @@ struct _GstRTPBasePayloadPrivate
 
   GstCaps *subclass_srccaps;
   GstCaps *sinkcaps;
+
+  GstAllocator *header_allocator;
+
+  gboolean batch_packets;
+  GThread *chain_thread;
+  GstBufferList *pending_list;
+};
+
+/* RTP header memory
+ *
+ * Headers for gst_rtp_base_payload_allocate_output_buffer() are carved out of
+ * slabs of RTP_HEADER_SLAB_SIZE memories that are allocated in one go. When
+ * the last reference to a header memory is dropped it goes back to the free
+ * list of its allocator instead of being freed. The slab is released when all
+ * of its memories have been freed, which happens after the payloader flushed
+ * the allocator in finalize. */
+#define RTP_HEADER_MEMORY_TYPE  "RTPHeaderMemory"
+/* fixed header with the maximum number of CSRCs */
+#define RTP_HEADER_MAX_SIZE     (12 + 15 * 4)
+#define RTP_HEADER_SLAB_SIZE    32
+
+typedef struct _RTPHeaderSlab RTPHeaderSlab;
+typedef struct _RTPHeaderMemory RTPHeaderMemory;
+
+struct _RTPHeaderMemory
+{
+  GstMemory mem;
+
+  RTPHeaderSlab *slab;          /* NULL for shared memory */
+  guint8 *data;
+  RTPHeaderMemory *next;        /* in the free list */
+};
+
+struct _RTPHeaderSlab
+{
+  gint refcount;
+  RTPHeaderMemory mems[RTP_HEADER_SLAB_SIZE];
+  guint8 data[RTP_HEADER_SLAB_SIZE][RTP_HEADER_MAX_SIZE];
 };
 
+#define IS_RTP_HEADER_MEMORY(mem) \
+    ((mem)->allocator != NULL && \
+     (mem)->allocator->mem_type == RTP_HEADER_MEMORY_TYPE)
+
+typedef struct
+{
+  GstAllocator parent;
+
+  GMutex lock;
+  gboolean flushing;
+  RTPHeaderMemory *free_list;
+} GstRTPHeaderAllocator;
+
+typedef struct
+{
+  GstAllocatorClass parent_class;
+} GstRTPHeaderAllocatorClass;
+
+static GType gst_rtp_header_allocator_get_type (void);
+
+G_DEFINE_TYPE (GstRTPHeaderAllocator, gst_rtp_header_allocator,
+    GST_TYPE_ALLOCATOR);
+
+static gboolean
+rtp_header_memory_dispose (GstMiniObject * obj)
+{
+  RTPHeaderMemory *mem = (RTPHeaderMemory *) obj;
+  GstRTPHeaderAllocator *alloc =
+      (GstRTPHeaderAllocator *) mem->mem.allocator;
+
+  /* only recycle memory that nobody changed the flags of */
+  if (mem->slab == NULL ||
+      GST_MINI_OBJECT_FLAGS (obj) != GST_MINI_OBJECT_FLAG_LOCKABLE)
+    return TRUE;
+
+  g_mutex_lock (&alloc->lock);
+  if (alloc->flushing) {
+    g_mutex_unlock (&alloc->lock);
+    return TRUE;
+  }
+  gst_memory_ref (GST_MEMORY_CAST (mem));
+  mem->next = alloc->free_list;
+  alloc->free_list = mem;
+  g_mutex_unlock (&alloc->lock);
+
+  return FALSE;
+}
+
+/* call with the lock */
+static void
+rtp_header_allocator_add_slab (GstRTPHeaderAllocator * alloc)
+{
+  RTPHeaderSlab *slab;
+  gint i;
+
+  slab = g_malloc (sizeof (RTPHeaderSlab));
+  slab->refcount = RTP_HEADER_SLAB_SIZE;
+
+  for (i = 0; i < RTP_HEADER_SLAB_SIZE; i++) {
+    RTPHeaderMemory *mem = &slab->mems[i];
+
+    gst_memory_init (GST_MEMORY_CAST (mem), 0, GST_ALLOCATOR_CAST (alloc),
+        NULL, RTP_HEADER_MAX_SIZE, 0, 0, RTP_HEADER_MAX_SIZE);
+    GST_MINI_OBJECT_CAST (mem)->dispose = rtp_header_memory_dispose;
+    mem->slab = slab;
+    mem->data = slab->data[i];
+    mem->next = alloc->free_list;
+    alloc->free_list = mem;
+  }
+}
+
+static GstMemory *
+rtp_header_allocator_acquire (GstRTPHeaderAllocator * alloc, gsize size)
+{
+  RTPHeaderMemory *mem;
+
+  g_mutex_lock (&alloc->lock);
+  if (G_UNLIKELY (alloc->free_list == NULL))
+    rtp_header_allocator_add_slab (alloc);
+  mem = alloc->free_list;
+  alloc->free_list = mem->next;
+  g_mutex_unlock (&alloc->lock);
+
+  mem->next = NULL;
+  mem->mem.offset = 0;
+  mem->mem.size = size;
+
+  return GST_MEMORY_CAST (mem);
+}
+
+/* stop recycling and free the unused memory, memory that is still in use
+ * is freed when it is released */
+static void
+rtp_header_allocator_flush (GstRTPHeaderAllocator * alloc)
+{
+  RTPHeaderMemory *list;
+
+  g_mutex_lock (&alloc->lock);
+  alloc->flushing = TRUE;
+  list = alloc->free_list;
+  alloc->free_list = NULL;
+  g_mutex_unlock (&alloc->lock);
+
+  while (list) {
+    RTPHeaderMemory *next = list->next;
+
+    gst_memory_unref (GST_MEMORY_CAST (list));
+    list = next;
+  }
+}
+
+static gpointer
+rtp_header_memory_map (GstMemory * mem, gsize maxsize, GstMapFlags flags)
+{
+  return ((RTPHeaderMemory *) mem)->data;
+}
+
+static void
+rtp_header_memory_unmap (GstMemory * mem)
+{
+}
+
+static GstMemory *
+rtp_header_memory_share (GstMemory * mem, gssize offset, gssize size)
+{
+  RTPHeaderMemory *sub;
+  GstMemory *parent;
+
+  if ((parent = mem->parent) == NULL)
+    parent = mem;
+
+  if (size == -1)
+    size = mem->size - offset;
+
+  sub = g_slice_new (RTPHeaderMemory);
+  gst_memory_init (GST_MEMORY_CAST (sub),
+      GST_MINI_OBJECT_FLAGS (parent) | GST_MINI_OBJECT_FLAG_LOCK_READONLY,
+      mem->allocator, parent, mem->maxsize, mem->align, mem->offset + offset,
+      size);
+  sub->slab = NULL;
+  sub->data = ((RTPHeaderMemory *) mem)->data;
+  sub->next = NULL;
+
+  return GST_MEMORY_CAST (sub);
+}
+
+static void
+rtp_header_allocator_free (GstAllocator * allocator, GstMemory * memory)
+{
+  RTPHeaderMemory *mem = (RTPHeaderMemory *) memory;
+
+  if (mem->slab == NULL)
+    g_slice_free (RTPHeaderMemory, mem);
+  else if (g_atomic_int_dec_and_test (&mem->slab->refcount))
+    g_free (mem->slab);
+}
+
+static void
+gst_rtp_header_allocator_finalize (GObject * object)
+{
+  GstRTPHeaderAllocator *alloc = (GstRTPHeaderAllocator *) object;
+
+  g_mutex_clear (&alloc->lock);
+
+  G_OBJECT_CLASS (gst_rtp_header_allocator_parent_class)->finalize (object);
+}
+
+static void
+gst_rtp_header_allocator_class_init (GstRTPHeaderAllocatorClass * klass)
+{
+  GObjectClass *gobject_class = (GObjectClass *) klass;
+  GstAllocatorClass *allocator_class = (GstAllocatorClass *) klass;
+
+  gobject_class->finalize = gst_rtp_header_allocator_finalize;
+
+  allocator_class->alloc = NULL;
+  allocator_class->free = rtp_header_allocator_free;
+}
+
+static void
+gst_rtp_header_allocator_init (GstRTPHeaderAllocator * alloc)
+{
+  GstAllocator *allocator = GST_ALLOCATOR_CAST (alloc);
+
+  allocator->mem_type = RTP_HEADER_MEMORY_TYPE;
+  allocator->mem_map = rtp_header_memory_map;
+  allocator->mem_unmap = rtp_header_memory_unmap;
+  allocator->mem_share = rtp_header_memory_share;
+
+  GST_OBJECT_FLAG_SET (alloc, GST_ALLOCATOR_FLAG_CUSTOM_ALLOC);
+
+  g_mutex_init (&alloc->lock);
+}
+
 /* RTPBasePayload signals and args */
 enum
 {
@@ -86,6 +318,7 @@ enum
 #define DEFAULT_PERFECT_RTPTIME         TRUE
 #define DEFAULT_PTIME_MULTIPLE          0
 #define DEFAULT_RUNNING_TIME            GST_CLOCK_TIME_NONE
+#define DEFAULT_BATCH_PACKETS           FALSE
 
 enum
 {
@@ -102,6 +335,7 @@ enum
   PROP_PERFECT_RTPTIME,
   PROP_PTIME_MULTIPLE,
   PROP_STATS,
+  PROP_BATCH_PACKETS,
   PROP_LAST
 };
 
@@ -137,6 +371,8 @@ static GstStateChangeReturn gst_rtp_base_payload_change_state (GstElement *
     element, GstStateChange transition);
 
 static gboolean gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload);
+static GstFlowReturn gst_rtp_base_payload_push_pending (GstRTPBasePayload *
+    payload);
 
 
 static GstElementClass *parent_class = NULL;
@@ -322,6 +558,32 @@ gst_rtp_base_payload_class_init (GstRTPBasePayloadClass * klass)
       g_param_spec_boxed ("stats", "Statistics", "Various statistics",
           GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTPBasePayload:batch-packets:
+   *
+   * Collect the packets that the subclass pushes with
+   * gst_rtp_base_payload_push() while handling one input buffer and push
+   * them downstream as one #GstBufferList when the subclass is done.
+   *
+   * The packets are also pushed before the payloader changes its caps, before
+   * packets sent with gst_rtp_base_payload_push_list() and before packets
+   * pushed from another thread. When the previous push to downstream
+   * failed, gst_rtp_base_payload_push() pushes the queued packets right away
+   * and returns the result.
+   *
+   * This is off by default. Subclasses that only push packets with
+   * gst_rtp_base_payload_push() from their handle_buffer function can
+   * enable it in their instance init function. Subclasses that push events
+   * or call gst_pad_push() on the source pad from handle_buffer must keep
+   * it disabled, as those would overtake the queued packets.
+   *
+   * Since: 1.10
+   **/
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_BATCH_PACKETS,
+      g_param_spec_boolean ("batch-packets", "Batch packets",
+          "Push the packets of one input buffer as a buffer list",
+          DEFAULT_BATCH_PACKETS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_rtp_base_payload_change_state;
 
   klass->get_caps = gst_rtp_base_payload_getcaps_default;
@@ -389,6 +651,10 @@ gst_rtp_base_payload_init (GstRTPBasePayload * rtpbasepayload, gpointer g_class)
 
   rtpbasepayload->priv->caps_max_ptime = DEFAULT_MAX_PTIME;
   rtpbasepayload->priv->prop_max_ptime = DEFAULT_MAX_PTIME;
+
+  priv->header_allocator =
+      g_object_new (gst_rtp_header_allocator_get_type (), NULL);
+  priv->batch_packets = DEFAULT_BATCH_PACKETS;
 }
 
 static void
@@ -406,6 +672,10 @@ gst_rtp_base_payload_finalize (GObject * object)
   gst_caps_replace (&rtpbasepayload->priv->subclass_srccaps, NULL);
   gst_caps_replace (&rtpbasepayload->priv->sinkcaps, NULL);
 
+  rtp_header_allocator_flush ((GstRTPHeaderAllocator *)
+      rtpbasepayload->priv->header_allocator);
+  gst_object_unref (rtpbasepayload->priv->header_allocator);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -659,7 +929,18 @@ gst_rtp_base_payload_chain (GstPad * pad, GstObject * parent,
   if (gst_pad_check_reconfigure (GST_RTP_BASE_PAYLOAD_SRCPAD (rtpbasepayload)))
     gst_rtp_base_payload_negotiate (rtpbasepayload);
 
+  rtpbasepayload->priv->chain_thread = g_thread_self ();
   ret = rtpbasepayload_class->handle_buffer (rtpbasepayload, buffer);
+  rtpbasepayload->priv->chain_thread = NULL;
+
+  /* push the packets the subclass produced for this buffer */
+  if (rtpbasepayload->priv->pending_list) {
+    GstFlowReturn pret;
+
+    pret = gst_rtp_base_payload_push_pending (rtpbasepayload);
+    if (ret == GST_FLOW_OK)
+      ret = pret;
+  }
 
   return ret;
 
@@ -1066,6 +1347,10 @@ gst_rtp_base_payload_negotiate (GstRTPBasePayload * payload)
 
   update_max_ptime (payload);
 
+  /* packets for the old caps go first */
+  if (payload->priv->pending_list)
+    gst_rtp_base_payload_push_pending (payload);
+
   res = gst_pad_set_caps (GST_RTP_BASE_PAYLOAD_SRCPAD (payload), srccaps);
   gst_caps_unref (srccaps);
   gst_caps_unref (templ);
@@ -1126,20 +1411,45 @@ find_timestamp (GstBuffer ** buffer, guint idx, gpointer user_data)
     return TRUE;
 }
 
+static inline void
+write_header (guint8 * hdr, HeaderData * data)
+{
+  hdr[1] = (hdr[1] & 0x80) | (data->pt & 0x7f);
+  GST_WRITE_UINT16_BE (hdr + 2, data->seqnum);
+  GST_WRITE_UINT32_BE (hdr + 4, data->rtptime);
+  GST_WRITE_UINT32_BE (hdr + 8, data->ssrc);
+}
+
 static gboolean
 set_headers (GstBuffer ** buffer, guint idx, gpointer user_data)
 {
   HeaderData *data = user_data;
-  GstRTPBuffer rtp = { NULL, };
+  GstMemory *mem;
+  GstMapInfo map;
 
-  if (!gst_rtp_buffer_map (*buffer, GST_MAP_WRITE, &rtp))
+  if (gst_buffer_n_memory (*buffer) == 0)
     goto map_failed;
 
-  gst_rtp_buffer_set_ssrc (&rtp, data->ssrc);
-  gst_rtp_buffer_set_payload_type (&rtp, data->pt);
-  gst_rtp_buffer_set_seq (&rtp, data->seqnum);
-  gst_rtp_buffer_set_timestamp (&rtp, data->rtptime);
-  gst_rtp_buffer_unmap (&rtp);
+  /* header memory from our allocator is always accessible, write it directly
+   * when nobody else can see it */
+  mem = gst_buffer_peek_memory (*buffer, 0);
+  if (IS_RTP_HEADER_MEMORY (mem) && mem->size >= GST_RTP_HEADER_LEN &&
+      GST_MINI_OBJECT_REFCOUNT_VALUE (mem) == 1 &&
+      !GST_MEMORY_IS_READONLY (mem) && gst_buffer_is_writable (*buffer)) {
+    write_header (((RTPHeaderMemory *) mem)->data + mem->offset, data);
+  } else {
+    /* the fields are all in the fixed header, which is in the first memory */
+    if (!gst_buffer_map_range (*buffer, 0, 1, &map, GST_MAP_READWRITE))
+      goto map_failed;
+
+    if (map.size < GST_RTP_HEADER_LEN ||
+        (map.data[0] & 0xc0) != (GST_RTP_VERSION << 6)) {
+      gst_buffer_unmap (*buffer, &map);
+      goto map_failed;
+    }
+    write_header (map.data, data);
+    gst_buffer_unmap (*buffer, &map);
+  }
 
   /* increment the seqnum for each buffer */
   data->seqnum++;
@@ -1302,12 +1612,18 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
   res = gst_rtp_base_payload_prepare_push (payload, list, TRUE);
 
   if (G_LIKELY (res == GST_FLOW_OK)) {
+    /* keep the order with the batched packets */
+    if (payload->priv->pending_list)
+      res = gst_rtp_base_payload_push_pending (payload);
     if (G_UNLIKELY (payload->priv->pending_segment)) {
       gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
       payload->priv->pending_segment = FALSE;
       payload->priv->delay_segment = FALSE;
     }
-    res = gst_pad_push_list (payload->srcpad, list);
+    if (res == GST_FLOW_OK)
+      res = gst_pad_push_list (payload->srcpad, list);
+    else
+      gst_buffer_list_unref (list);
   } else {
     gst_buffer_list_unref (list);
   }
@@ -1323,6 +1639,11 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
  * Push @buffer to the peer element of the payloader. The SSRC, payload type,
  * seqnum and timestamp of the RTP buffer will be updated first.
  *
+ * When #GstRTPBasePayload:batch-packets is enabled and this function is
+ * called while handling an input buffer, @buffer is queued and pushed
+ * together with the other packets for the input buffer in a
+ * #GstBufferList.
+ *
  * This function takes ownership of @buffer.
  *
  * Returns: a #GstFlowReturn.
@@ -1330,17 +1651,37 @@ gst_rtp_base_payload_push_list (GstRTPBasePayload * payload,
 GstFlowReturn
 gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
 {
+  GstRTPBasePayloadPrivate *priv = payload->priv;
   GstFlowReturn res;
 
   res = gst_rtp_base_payload_prepare_push (payload, buffer, FALSE);
 
-  if (G_LIKELY (res == GST_FLOW_OK)) {
+  if (G_LIKELY (res == GST_FLOW_OK) && priv->batch_packets &&
+      priv->chain_thread == g_thread_self ()) {
+    GST_OBJECT_LOCK (payload);
+    if (priv->pending_list == NULL)
+      priv->pending_list = gst_buffer_list_new_sized (16);
+    gst_buffer_list_add (priv->pending_list, buffer);
+    GST_OBJECT_UNLOCK (payload);
+
+    /* when the last push failed, push the batch now so that the subclass
+     * sees the current flow return of downstream and can stop */
+    if (G_UNLIKELY (gst_pad_get_last_flow_return (payload->srcpad) !=
+            GST_FLOW_OK))
+      res = gst_rtp_base_payload_push_pending (payload);
+  } else if (G_LIKELY (res == GST_FLOW_OK)) {
+    /* keep the order with the packets batched by the streaming thread */
+    if (priv->pending_list)
+      res = gst_rtp_base_payload_push_pending (payload);
     if (G_UNLIKELY (payload->priv->pending_segment)) {
       gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
       payload->priv->pending_segment = FALSE;
       payload->priv->delay_segment = FALSE;
     }
-    res = gst_pad_push (payload->srcpad, buffer);
+    if (res == GST_FLOW_OK)
+      res = gst_pad_push (payload->srcpad, buffer);
+    else
+      gst_buffer_unref (buffer);
   } else {
     gst_buffer_unref (buffer);
   }
@@ -1348,6 +1689,93 @@ gst_rtp_base_payload_push (GstRTPBasePayload * payload, GstBuffer * buffer)
   return res;
 }
 
+/* push the packets collected by gst_rtp_base_payload_push() */
+static GstFlowReturn
+gst_rtp_base_payload_push_pending (GstRTPBasePayload * payload)
+{
+  GstBufferList *list;
+
+  GST_OBJECT_LOCK (payload);
+  list = payload->priv->pending_list;
+  payload->priv->pending_list = NULL;
+  GST_OBJECT_UNLOCK (payload);
+
+  if (list == NULL)
+    return GST_FLOW_OK;
+
+  GST_LOG_OBJECT (payload, "pushing %u batched packets",
+      gst_buffer_list_length (list));
+
+  if (G_UNLIKELY (payload->priv->pending_segment)) {
+    gst_pad_push_event (payload->srcpad, payload->priv->pending_segment);
+    payload->priv->pending_segment = NULL;
+    payload->priv->delay_segment = FALSE;
+  }
+  return gst_pad_push_list (payload->srcpad, list);
+}
+
+/**
+ * gst_rtp_base_payload_allocate_output_buffer:
+ * @payload: a #GstRTPBasePayload
+ * @payload_len: the length of the payload
+ * @pad_len: the amount of padding
+ * @csrc_count: the number of CSRC entries
+ *
+ * Allocate a new #GstBuffer for an RTP packet of @payload. The RTP header is
+ * placed in its own memory, which is taken from a pool of the payloader
+ * and reused once the packet is freed. The SSRC, payload type, seqnum and
+ * timestamp of the header are filled in by gst_rtp_base_payload_push() and
+ * gst_rtp_base_payload_push_list() without mapping the buffer.
+ *
+ * When @payload_len or @pad_len is not 0, a second memory with room for the
+ * payload and the padding is added. Subclasses that append the payload data
+ * without copying should pass 0 for both.
+ *
+ * Returns: (transfer full): a newly allocated #GstBuffer
+ *
+ * Since: 1.10
+ */
+GstBuffer *
+gst_rtp_base_payload_allocate_output_buffer (GstRTPBasePayload * payload,
+    guint payload_len, guint8 pad_len, guint8 csrc_count)
+{
+  GstBuffer *buffer;
+  GstMemory *mem;
+  guint8 *hdr;
+  guint hdr_len, len;
+
+  g_return_val_if_fail (GST_IS_RTP_BASE_PAYLOAD (payload), NULL);
+  g_return_val_if_fail (csrc_count <= 15, NULL);
+
+  hdr_len = GST_RTP_HEADER_LEN + csrc_count * sizeof (guint32);
+
+  mem = rtp_header_allocator_acquire ((GstRTPHeaderAllocator *)
+      payload->priv->header_allocator, hdr_len);
+  hdr = ((RTPHeaderMemory *) mem)->data;
+
+  hdr[0] = (GST_RTP_VERSION << 6) | (pad_len ? 0x20 : 0) | csrc_count;
+  hdr[1] = payload->pt & 0x7f;
+  memset (hdr + 2, 0, hdr_len - 2);
+
+  buffer = gst_buffer_new ();
+  gst_buffer_append_memory (buffer, mem);
+
+  len = payload_len + pad_len;
+  if (len > 0) {
+    mem = gst_allocator_alloc (NULL, len, NULL);
+    if (pad_len) {
+      GstMapInfo map;
+
+      gst_memory_map (mem, &map, GST_MAP_WRITE);
+      map.data[len - 1] = pad_len;
+      gst_memory_unmap (mem, &map);
+    }
+    gst_buffer_append_memory (buffer, mem);
+  }
+
+  return buffer;
+}
+
 static GstStructure *
 gst_rtp_base_payload_create_stats (GstRTPBasePayload * rtpbasepayload)
 {
@@ -1418,6 +1846,9 @@ gst_rtp_base_payload_set_property (GObject * object, guint prop_id,
     case PROP_PTIME_MULTIPLE:
       rtpbasepayload->ptime_multiple = g_value_get_int64 (value);
       break;
+    case PROP_BATCH_PACKETS:
+      priv->batch_packets = g_value_get_boolean (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1481,6 +1912,9 @@ gst_rtp_base_payload_get_property (GObject * object, guint prop_id,
       g_value_take_boxed (value,
           gst_rtp_base_payload_create_stats (rtpbasepayload));
       break;
+    case PROP_BATCH_PACKETS:
+      g_value_set_boolean (value, priv->batch_packets);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1542,6 +1976,10 @@ gst_rtp_base_payload_change_state (GstElement * element,
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_event_replace (&rtpbasepayload->priv->pending_segment, NULL);
+      if (priv->pending_list) {
+        gst_buffer_list_unref (priv->pending_list);
+        priv->pending_list = NULL;
+      }
       break;
     default:
       break;
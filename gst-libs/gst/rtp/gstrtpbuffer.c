@@ -39,6 +39,10 @@
 
 #define GST_RTP_HEADER_LEN 12
 
+/* GstRTPBuffer state flags */
+#define RTP_STATE_HEADER_ONLY   (1 << 0)
+#define RTP_IS_HEADER_ONLY(rtp) (((rtp)->state & RTP_STATE_HEADER_ONLY) != 0)
+
 /* Note: we use bitfields here to make sure the compiler doesn't add padding
  * between fields on certain architectures; can't assume aligned access either
  */
@@ -310,6 +314,10 @@ gst_rtp_buffer_calc_payload_len (guint packet_len, guint8 pad_len,
  *
  * Map the contents of @buffer into @rtp.
  *
+ * With %GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY in @flags only the first memory
+ * of @buffer is mapped and only the fixed header and the CSRC list are
+ * checked. The extension, payload and padding can't be accessed then.
+ *
  * Returns: %TRUE if @buffer could be mapped.
  */
 gboolean
@@ -363,6 +371,20 @@ gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
 
   rtp->size[0] = header_len;
 
+  /* only the fixed header and the CSRCs were requested, they must be in the
+   * first memory then */
+  if (flags & GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY) {
+    if (G_UNLIKELY (size < header_len))
+      goto wrong_length;
+
+    rtp->data[1] = rtp->data[2] = rtp->data[3] = NULL;
+    rtp->size[1] = rtp->size[2] = rtp->size[3] = 0;
+    rtp->state = RTP_STATE_HEADER_ONLY;
+    rtp->buffer = buffer;
+
+    return TRUE;
+  }
+
   bufsize = gst_buffer_get_size (buffer);
 
   /* calc extension length when present. */
@@ -438,7 +460,7 @@ gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
     rtp->size[2] = 0;
   }
 
-  /* rtp->state = 0; *//* unused */
+  rtp->state = 0;
 
   return TRUE;
 
@@ -510,6 +532,7 @@ gst_rtp_buffer_unmap (GstRTPBuffer * rtp)
     rtp->data[i] = NULL;
     rtp->size[i] = 0;
   }
+  rtp->state = 0;
   rtp->buffer = NULL;
 }
 
@@ -569,6 +592,9 @@ gst_rtp_buffer_get_packet_len (GstRTPBuffer * rtp)
 guint
 gst_rtp_buffer_get_header_len (GstRTPBuffer * rtp)
 {
+  /* the extension length is not known */
+  g_return_val_if_fail (!RTP_IS_HEADER_ONLY (rtp), rtp->size[0]);
+
   return rtp->size[0] + rtp->size[1];
 }
 
@@ -702,6 +728,8 @@ gst_rtp_buffer_get_extension_data (GstRTPBuffer * rtp, guint16 * bits,
 {
   guint8 *pdata;
 
+  g_return_val_if_fail (!RTP_IS_HEADER_ONLY (rtp), FALSE);
+
   /* move to the extension */
   pdata = rtp->data[1];
   if (!pdata)
@@ -817,6 +845,8 @@ gst_rtp_buffer_set_extension_data (GstRTPBuffer * rtp, guint16 bits,
   guint8 *data;
   GstMemory *mem = NULL;
 
+  g_return_val_if_fail (!RTP_IS_HEADER_ONLY (rtp), FALSE);
+
   ensure_buffers (rtp);
 
   /* this is the size of the extension data we need */
@@ -1637,3 +1667,338 @@ gst_rtp_buffer_add_extension_twobytes_header (GstRTPBuffer * rtp,
 
   return TRUE;
 }
+
+static inline void
+extension_table_add (GstRTPExtensionTable * table, guint8 id, guint offset,
+    guint8 size)
+{
+  guint n = table->n_elements;
+
+  if (n == GST_RTP_EXTENSION_TABLE_SIZE) {
+    table->complete = FALSE;
+    return;
+  }
+
+  table->ids[id >> 5] |= 1U << (id & 31);
+  table->id[n] = id;
+  table->size[n] = size;
+  table->offset[n] = offset;
+  table->n_elements = n + 1;
+}
+
+/**
+ * gst_rtp_buffer_parse_extensions:
+ * @rtp: the RTP packet
+ * @table: (out caller-allocates): a #GstRTPExtensionTable
+ *
+ * Parses the RFC 5285 style header extension of @rtp, with a one byte or a
+ * two bytes header, in one pass and stores the position of each element in
+ * @table. Use gst_rtp_extension_table_get() to look up elements without
+ * walking the extension again for each of them.
+ *
+ * Returns: %TRUE if @rtp had a RFC 5285 style header extension.
+ *
+ * Since: 1.10
+ */
+gboolean
+gst_rtp_buffer_parse_extensions (GstRTPBuffer * rtp,
+    GstRTPExtensionTable * table)
+{
+  guint16 bits;
+  guint8 *pdata;
+  guint wordlen, bytelen;
+  guint offset = 0;
+
+  g_return_val_if_fail (rtp != NULL, FALSE);
+  g_return_val_if_fail (table != NULL, FALSE);
+
+  memset (table, 0, sizeof (GstRTPExtensionTable));
+  table->rtp = rtp;
+  table->complete = TRUE;
+
+  if (!gst_rtp_buffer_get_extension_data (rtp, &bits, (gpointer) & pdata,
+          &wordlen))
+    return FALSE;
+
+  table->data = pdata;
+  table->bits = bits;
+  bytelen = wordlen * 4;
+
+  /* same parsing as gst_rtp_buffer_get_extension_onebyte_header() and
+   * gst_rtp_buffer_get_extension_twobytes_header() */
+  if (bits == 0xBEDE) {
+    while (offset + 1 < bytelen) {
+      guint8 read_id, read_len;
+
+      read_id = GST_READ_UINT8 (pdata + offset) >> 4;
+      read_len = (GST_READ_UINT8 (pdata + offset) & 0x0F) + 1;
+      offset += 1;
+
+      /* ID 0 means its padding, skip */
+      if (read_id == 0)
+        continue;
+
+      /* ID 15 is special and means we should stop parsing */
+      if (read_id == 15)
+        break;
+
+      /* Ignore extension headers where the size does not fit */
+      if (offset + read_len > bytelen)
+        break;
+
+      extension_table_add (table, read_id, offset, read_len);
+      offset += read_len;
+    }
+  } else if (bits >> 4 == 0x100) {
+    while (offset + 2 < bytelen) {
+      guint8 read_id, read_len;
+
+      read_id = GST_READ_UINT8 (pdata + offset);
+      offset += 1;
+
+      if (read_id == 0)
+        continue;
+
+      read_len = GST_READ_UINT8 (pdata + offset);
+      offset += 1;
+
+      /* Ignore extension headers where the size does not fit */
+      if (offset + read_len > bytelen)
+        break;
+
+      extension_table_add (table, read_id, offset, read_len);
+      offset += read_len;
+    }
+  } else {
+    table->data = NULL;
+    return FALSE;
+  }
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_extension_table_get:
+ * @table: a #GstRTPExtensionTable
+ * @id: The ID of the header extension to be read
+ * @nth: Read the nth extension packet with the requested ID
+ * @data: (out) (array length=size) (element-type guint8) (transfer none):
+ *   location for data
+ * @size: (out): the size of the data in bytes
+ *
+ * Get the nth header extension element with @id from @table, which was
+ * filled by gst_rtp_buffer_parse_extensions().
+ *
+ * Returns: TRUE if the packet had the requested header extension
+ *
+ * Since: 1.10
+ */
+gboolean
+gst_rtp_extension_table_get (const GstRTPExtensionTable * table, guint8 id,
+    guint nth, gpointer * data, guint * size)
+{
+  guint i, count = 0;
+
+  g_return_val_if_fail (table != NULL, FALSE);
+
+  if (table->data == NULL)
+    return FALSE;
+
+  if (table->ids[id >> 5] & (1U << (id & 31))) {
+    for (i = 0; i < table->n_elements; i++) {
+      if (table->id[i] != id)
+        continue;
+
+      if (nth == count) {
+        if (data)
+          *data = table->data + table->offset[i];
+        if (size)
+          *size = table->size[i];
+
+        return TRUE;
+      }
+      count++;
+    }
+  }
+
+  /* the table could not hold all elements, look in the packet itself */
+  if (!table->complete) {
+    if (table->bits == 0xBEDE)
+      return id > 0 && id < 15 &&
+          gst_rtp_buffer_get_extension_onebyte_header (table->rtp, id, nth,
+          data, size);
+    else
+      return gst_rtp_buffer_get_extension_twobytes_header (table->rtp, NULL,
+          id, nth, data, size);
+  }
+
+  return FALSE;
+}
+
+/**
+ * gst_rtp_buffer_add_extension_onebyte_headers:
+ * @rtp: the RTP packet
+ * @elements: (array length=n_elements): the header extensions to add
+ * @n_elements: the number of @elements
+ *
+ * Adds several RFC 5285 header extensions with a one byte header to the end
+ * of the RTP header, like gst_rtp_buffer_add_extension_onebyte_header() does
+ * for one element. The existing extension is parsed and resized only once
+ * for all of @elements.
+ *
+ * Returns: %TRUE if the header extensions could be added
+ *
+ * Since: 1.10
+ */
+gboolean
+gst_rtp_buffer_add_extension_onebyte_headers (GstRTPBuffer * rtp,
+    const GstRTPExtensionElement * elements, guint n_elements)
+{
+  guint16 bits;
+  guint8 *pdata = 0;
+  guint wordlen;
+  gboolean has_bit;
+  guint extlen, offset = 0;
+  guint i;
+
+  g_return_val_if_fail (!RTP_IS_HEADER_ONLY (rtp), FALSE);
+  g_return_val_if_fail (elements != NULL || n_elements == 0, FALSE);
+  g_return_val_if_fail (gst_buffer_is_writable (rtp->buffer), FALSE);
+
+  extlen = 0;
+  for (i = 0; i < n_elements; i++) {
+    g_return_val_if_fail (elements[i].id > 0 && elements[i].id < 15, FALSE);
+    g_return_val_if_fail (elements[i].size >= 1 && elements[i].size <= 16,
+        FALSE);
+    extlen += elements[i].size + 1;
+    /* the extension length is counted in 16 bits */
+    if (extlen > G_MAXUINT16 * 4)
+      return FALSE;
+  }
+
+  if (n_elements == 0)
+    return TRUE;
+
+  has_bit = gst_rtp_buffer_get_extension_data (rtp, &bits,
+      (gpointer) & pdata, &wordlen);
+
+  if (has_bit) {
+    if (bits != 0xBEDE)
+      return FALSE;
+
+    offset = get_onebyte_header_end_offset (pdata, wordlen);
+    if (offset == 0)
+      return FALSE;
+  }
+
+  /* the required size of the new extension data */
+  extlen += offset;
+  if (extlen > G_MAXUINT16 * 4)
+    return FALSE;
+  /* calculate amount of words */
+  wordlen = extlen / 4 + ((extlen % 4) ? 1 : 0);
+
+  if (!gst_rtp_buffer_set_extension_data (rtp, 0xBEDE, wordlen))
+    return FALSE;
+  if (!gst_rtp_buffer_get_extension_data (rtp, &bits, (gpointer) & pdata,
+          &wordlen))
+    return FALSE;
+
+  pdata += offset;
+
+  for (i = 0; i < n_elements; i++) {
+    pdata[0] = (elements[i].id << 4) | (0x0F & (elements[i].size - 1));
+    memcpy (pdata + 1, elements[i].data, elements[i].size);
+    pdata += elements[i].size + 1;
+  }
+
+  if (extlen % 4)
+    memset (pdata, 0, 4 - (extlen % 4));
+
+  return TRUE;
+}
+
+/**
+ * gst_rtp_buffer_add_extension_twobytes_headers:
+ * @rtp: the RTP packet
+ * @appbits: Application specific bits
+ * @elements: (array length=n_elements): the header extensions to add
+ * @n_elements: the number of @elements
+ *
+ * Adds several RFC 5285 header extensions with a two bytes header to the end
+ * of the RTP header, like gst_rtp_buffer_add_extension_twobytes_header() does
+ * for one element. The existing extension is parsed and resized only once
+ * for all of @elements.
+ *
+ * Returns: %TRUE if the header extensions could be added
+ *
+ * Since: 1.10
+ */
+gboolean
+gst_rtp_buffer_add_extension_twobytes_headers (GstRTPBuffer * rtp,
+    guint8 appbits, const GstRTPExtensionElement * elements, guint n_elements)
+{
+  guint16 bits;
+  guint8 *pdata = 0;
+  guint wordlen;
+  gboolean has_bit;
+  guint extlen, offset = 0;
+  guint i;
+
+  g_return_val_if_fail ((appbits & 0xF0) == 0, FALSE);
+  g_return_val_if_fail (!RTP_IS_HEADER_ONLY (rtp), FALSE);
+  g_return_val_if_fail (elements != NULL || n_elements == 0, FALSE);
+  g_return_val_if_fail (gst_buffer_is_writable (rtp->buffer), FALSE);
+
+  extlen = 0;
+  for (i = 0; i < n_elements; i++) {
+    g_return_val_if_fail (elements[i].size < 256, FALSE);
+    extlen += elements[i].size + 2;
+    /* the extension length is counted in 16 bits */
+    if (extlen > G_MAXUINT16 * 4)
+      return FALSE;
+  }
+
+  if (n_elements == 0)
+    return TRUE;
+
+  has_bit = gst_rtp_buffer_get_extension_data (rtp, &bits,
+      (gpointer) & pdata, &wordlen);
+
+  if (has_bit) {
+    if (bits != ((0x100 << 4) | (appbits & 0x0f)))
+      return FALSE;
+
+    offset = get_twobytes_header_end_offset (pdata, wordlen);
+    if (offset == 0)
+      return FALSE;
+  }
+
+  /* the required size of the new extension data */
+  extlen += offset;
+  if (extlen > G_MAXUINT16 * 4)
+    return FALSE;
+  /* calculate amount of words */
+  wordlen = extlen / 4 + ((extlen % 4) ? 1 : 0);
+
+  if (!gst_rtp_buffer_set_extension_data (rtp,
+          (0x100 << 4) | (appbits & 0x0F), wordlen))
+    return FALSE;
+  if (!gst_rtp_buffer_get_extension_data (rtp, &bits, (gpointer) & pdata,
+          &wordlen))
+    return FALSE;
+
+  pdata += offset;
+
+  for (i = 0; i < n_elements; i++) {
+    pdata[0] = elements[i].id;
+    pdata[1] = elements[i].size;
+    memcpy (pdata + 2, elements[i].data, elements[i].size);
+    pdata += elements[i].size + 2;
+  }
+
+  if (extlen % 4)
+    memset (pdata, 0, 4 - (extlen % 4));
+
+  return TRUE;
+}
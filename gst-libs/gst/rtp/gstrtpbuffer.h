@@ -150,11 +150,89 @@ gboolean       gst_rtp_buffer_add_extension_twobytes_header (GstRTPBuffer *rtp,
                                                              gpointer data,
                                                              guint size);
 
+/**
+ * GST_RTP_EXTENSION_TABLE_SIZE:
+ *
+ * The number of header extension elements that a #GstRTPExtensionTable can
+ * hold.
+ *
+ * Since: 1.10
+ */
+#define GST_RTP_EXTENSION_TABLE_SIZE 16
+
+typedef struct _GstRTPExtensionTable GstRTPExtensionTable;
+
+/**
+ * GstRTPExtensionTable:
+ *
+ * The RFC 5285 header extension elements of a mapped RTP packet, as parsed by
+ * gst_rtp_buffer_parse_extensions(). The table points into the data of the
+ * #GstRTPBuffer and stays valid until the buffer is unmapped or its
+ * extension is modified.
+ * The size of the structure is made public to allow stack allocations.
+ *
+ * Since: 1.10
+ */
+struct _GstRTPExtensionTable
+{
+  /*< private >*/
+  GstRTPBuffer *rtp;
+  guint8       *data;
+  guint16       bits;
+  guint         n_elements;
+  gboolean      complete;
+  guint32       ids[8];
+  guint8        id[GST_RTP_EXTENSION_TABLE_SIZE];
+  guint8        size[GST_RTP_EXTENSION_TABLE_SIZE];
+  guint         offset[GST_RTP_EXTENSION_TABLE_SIZE];
+
+  gpointer _gst_reserved[GST_PADDING];
+};
+
+/**
+ * GstRTPExtensionElement:
+ * @id: the ID of the header extension
+ * @size: the size of @data in bytes
+ * @data: (array length=size) (element-type guint8): the data
+ *
+ * A header extension element to add with
+ * gst_rtp_buffer_add_extension_onebyte_headers() or
+ * gst_rtp_buffer_add_extension_twobytes_headers().
+ *
+ * Since: 1.10
+ */
+typedef struct {
+  guint8         id;
+  guint          size;
+  gconstpointer  data;
+} GstRTPExtensionElement;
+
+gboolean       gst_rtp_buffer_parse_extensions              (GstRTPBuffer *rtp,
+                                                             GstRTPExtensionTable *table);
+gboolean       gst_rtp_extension_table_get                  (const GstRTPExtensionTable *table,
+                                                             guint8 id,
+                                                             guint nth,
+                                                             gpointer * data,
+                                                             guint * size);
+
+gboolean       gst_rtp_buffer_add_extension_onebyte_headers (GstRTPBuffer *rtp,
+                                                             const GstRTPExtensionElement *elements,
+                                                             guint n_elements);
+gboolean       gst_rtp_buffer_add_extension_twobytes_headers (GstRTPBuffer *rtp,
+                                                             guint8 appbits,
+                                                             const GstRTPExtensionElement *elements,
+                                                             guint n_elements);
+
 /**
  * GstRTPBufferMapFlags:
  * @GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING: Skip mapping and validation of RTP
  *           padding and RTP pad count when present. Useful for buffers where
  *           the padding may be encrypted.
+ * @GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY: Only map and validate the fixed
+ *           header and the CSRC list, which must be in the first memory of
+ *           the buffer. The extension, payload and padding are not available.
+ *           Useful for inspecting the sequence number, timestamp or SSRC of
+ *           many packets. Since 1.10
  * @GST_RTP_BUFFER_MAP_FLAG_LAST: Offset to define more flags
  *
  * Additional mapping flags for gst_rtp_buffer_map().
@@ -163,6 +241,7 @@ gboolean       gst_rtp_buffer_add_extension_twobytes_header (GstRTPBuffer *rtp,
  */
 typedef enum {
   GST_RTP_BUFFER_MAP_FLAG_SKIP_PADDING = (GST_MAP_FLAG_LAST << 0),
+  GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY  = (GST_MAP_FLAG_LAST << 1),
   GST_RTP_BUFFER_MAP_FLAG_LAST         = (GST_MAP_FLAG_LAST << 8)
   /* 8 more flags possible afterwards */
 } GstRTPBufferMapFlags;
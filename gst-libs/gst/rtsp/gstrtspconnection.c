@@ -67,6 +67,7 @@
 #include <gio/gnetworking.h>
 
 #include "gstrtspconnection.h"
+#include "gstrtspmessageprivate.h"
 
 #ifdef IP_TOS
 union gst_sockaddr
@@ -141,6 +142,15 @@ struct _GstRTSPConnection
   gchar *initial_buffer;
   gsize initial_buffer_offset;
 
+  /* bytes read ahead in large chunks by
+   * gst_rtsp_connection_receive_data_list(), interleaved data is handed out
+   * as memory shared with @read_chunk */
+  GstMemory *read_chunk;
+  guint8 *read_data;
+  gsize read_size;
+  gsize read_off;
+  gsize read_end;
+
   gboolean remember_session_id; /* remember the session id or not */
 
   /* Session state */
@@ -176,6 +186,11 @@ enum
   STATE_LAST
 };
 
+/* the default size of the chunks we read ahead in */
+#define READ_CHUNK_SIZE (64 * 1024)
+
+#define HAS_READ_CHUNK_DATA(conn) ((conn)->read_off < (conn)->read_end)
+
 enum
 {
   READ_AHEAD_EOH = -1,          /* end of headers */
@@ -1210,8 +1225,357 @@ error:
   }
 }
 
+/* maximum amount of vectors we pass to a single vectored write */
+#define MAX_VECTORS 64
+
+/* A record of bytes to send. The vectors point to the bytes in @data, which
+ * are owned by the record, and to the mapped memory of @buffer or
+ * @buffer_list, which is kept by reference until the record is freed. For
+ * interleaved data, @data contains the '$' headers of the packets. When
+ * @borrowed is set, the vectors point to memory the record does not own. */
+typedef struct
+{
+  guint8 *data;
+  GstBuffer *buffer;
+  GstBufferList *buffer_list;
+  GstMapInfo *maps;
+  guint n_maps;
+  gboolean borrowed;
+
+  GOutputVector *vectors;
+  guint n_vectors;
+  GOutputVector inline_vectors[2];
+
+  /* the first vector that is not completely written and the amount of bytes
+   * of it that were written */
+  guint cur_vector;
+  gsize vector_off;
+  /* bytes left to write */
+  gsize size;
+
+  guint id;
+} GstRTSPRec;
+
+#define REC_IS_STARTED(rec) ((rec)->cur_vector > 0 || (rec)->vector_off > 0)
+
+static inline void
+gst_rtsp_rec_add_vector (GstRTSPRec * rec, gconstpointer data, gsize size)
+{
+  if (size == 0)
+    return;
+
+  rec->vectors[rec->n_vectors].buffer = data;
+  rec->vectors[rec->n_vectors].size = size;
+  rec->n_vectors++;
+  rec->size += size;
+}
+
+/* takes ownership of @data */
+static GstRTSPRec *
+gst_rtsp_rec_new (guint8 * data, gsize size)
+{
+  GstRTSPRec *rec;
+
+  rec = g_slice_new0 (GstRTSPRec);
+  rec->data = data;
+  rec->vectors = rec->inline_vectors;
+  gst_rtsp_rec_add_vector (rec, data, size);
+
+  return rec;
+}
+
+static void
+gst_rtsp_rec_free (gpointer data)
+{
+  GstRTSPRec *rec = data;
+  guint i;
+
+  for (i = 0; i < rec->n_maps; i++)
+    gst_memory_unmap (rec->maps[i].memory, &rec->maps[i]);
+  /* the vectors are allocated together with the maps */
+  g_free (rec->maps);
+  if (rec->buffer)
+    gst_buffer_unref (rec->buffer);
+  if (rec->buffer_list)
+    gst_buffer_list_unref (rec->buffer_list);
+  g_free (rec->data);
+  g_slice_free (GstRTSPRec, rec);
+}
+
+static void
+set_data_header (guint8 * header, guint8 channel, guint size)
+{
+  header[0] = '$';
+  header[1] = channel;
+  header[2] = (size >> 8) & 0xff;
+  header[3] = size & 0xff;
+}
+
+/* make a record for the data message @message, the body of @message is not
+ * copied */
+static GstRTSPRec *
+gst_rtsp_rec_new_message_data (GstRTSPMessage * message)
+{
+  GstRTSPRec *rec;
+  guint8 *header;
+
+  header = g_malloc (4);
+  set_data_header (header, message->type_data.data.channel,
+      message->body_size);
+
+  rec = gst_rtsp_rec_new (header, 4);
+  gst_rtsp_rec_add_vector (rec, message->body, message->body_size);
+  rec->borrowed = TRUE;
+
+  return rec;
+}
+
+/* make a record that sends @buffer or all buffers in @buffer_list as
+ * interleaved data on @channel. The memory of the buffers is mapped and
+ * referenced, not copied. */
+static GstRTSPRec *
+gst_rtsp_rec_new_buffers (guint8 channel, GstBuffer * buffer,
+    GstBufferList * buffer_list)
+{
+  GstRTSPRec *rec;
+  GstBuffer *buf;
+  guint i, j, n_buffers, n_mems = 0;
+
+  n_buffers = buffer_list ? gst_buffer_list_length (buffer_list) : 1;
+  for (i = 0; i < n_buffers; i++) {
+    buf = buffer_list ? gst_buffer_list_get (buffer_list, i) : buffer;
+
+    /* the length in the data header has only 16 bits */
+    if (G_UNLIKELY (gst_buffer_get_size (buf) > G_MAXUINT16))
+      return NULL;
+
+    n_mems += gst_buffer_n_memory (buf);
+  }
+
+  rec = g_slice_new0 (GstRTSPRec);
+  rec->data = g_malloc (4 * n_buffers);
+  rec->maps = g_malloc (n_mems * sizeof (GstMapInfo) +
+      (n_buffers + n_mems) * sizeof (GOutputVector));
+  rec->vectors = (GOutputVector *) (rec->maps + n_mems);
+  if (buffer_list)
+    rec->buffer_list = gst_buffer_list_ref (buffer_list);
+  else
+    rec->buffer = gst_buffer_ref (buffer);
+
+  for (i = 0; i < n_buffers; i++) {
+    guint8 *header = rec->data + 4 * i;
+    guint n;
+
+    buf = buffer_list ? gst_buffer_list_get (buffer_list, i) : buffer;
+
+    set_data_header (header, channel, gst_buffer_get_size (buf));
+    gst_rtsp_rec_add_vector (rec, header, 4);
+
+    n = gst_buffer_n_memory (buf);
+    for (j = 0; j < n; j++) {
+      GstMapInfo *map = &rec->maps[rec->n_maps];
+
+      if (!gst_memory_map (gst_buffer_peek_memory (buf, j), map,
+              GST_MAP_READ))
+        goto map_failed;
+      rec->n_maps++;
+
+      gst_rtsp_rec_add_vector (rec, map->data, map->size);
+    }
+  }
+  return rec;
+
+  /* ERRORS */
+map_failed:
+  {
+    GST_WARNING ("failed to map memory");
+    gst_rtsp_rec_free (rec);
+    return NULL;
+  }
+}
+
+/* copy the bytes of @rec that still need to be written into one chunk of
+ * owned memory and release the memory the vectors pointed to */
+static void
+gst_rtsp_rec_flatten (GstRTSPRec * rec)
+{
+  guint8 *data, *p;
+  guint i;
+
+  p = data = g_malloc (rec->size);
+  for (i = rec->cur_vector; i < rec->n_vectors; i++) {
+    gsize off = i == rec->cur_vector ? rec->vector_off : 0;
+
+    memcpy (p, (const guint8 *) rec->vectors[i].buffer + off,
+        rec->vectors[i].size - off);
+    p += rec->vectors[i].size - off;
+  }
+
+  for (i = 0; i < rec->n_maps; i++)
+    gst_memory_unmap (rec->maps[i].memory, &rec->maps[i]);
+  g_free (rec->maps);
+  rec->maps = NULL;
+  rec->n_maps = 0;
+  if (rec->buffer)
+    gst_buffer_unref (rec->buffer);
+  rec->buffer = NULL;
+  if (rec->buffer_list)
+    gst_buffer_list_unref (rec->buffer_list);
+  rec->buffer_list = NULL;
+  g_free (rec->data);
+  rec->data = data;
+  rec->borrowed = FALSE;
+
+  rec->vectors = rec->inline_vectors;
+  rec->vectors[0].buffer = data;
+  rec->vectors[0].size = rec->size;
+  rec->n_vectors = 1;
+  rec->cur_vector = 0;
+  rec->vector_off = 0;
+}
+
+/* fill @vectors with at most @max vectors of the unwritten bytes of @rec,
+ * returns the number of vectors */
+static guint
+gst_rtsp_rec_get_vectors (GstRTSPRec * rec, GOutputVector * vectors,
+    guint max)
+{
+  guint i, n = 0;
+
+  for (i = rec->cur_vector; i < rec->n_vectors && n < max; i++, n++)
+    vectors[n] = rec->vectors[i];
+
+  if (n > 0) {
+    vectors[0].buffer = (const guint8 *) vectors[0].buffer + rec->vector_off;
+    vectors[0].size -= rec->vector_off;
+  }
+  return n;
+}
+
+/* mark @written bytes of @rec as written, returns the amount of bytes that
+ * were not part of @rec */
+static gsize
+gst_rtsp_rec_advance (GstRTSPRec * rec, gsize written)
+{
+  gsize consumed;
+
+  consumed = MIN (written, rec->size);
+  rec->size -= consumed;
+  written -= consumed;
+
+  while (consumed > 0) {
+    gsize left = rec->vectors[rec->cur_vector].size - rec->vector_off;
+
+    if (consumed < left) {
+      rec->vector_off += consumed;
+      break;
+    }
+    consumed -= left;
+    rec->cur_vector++;
+    rec->vector_off = 0;
+  }
+  return written;
+}
+
+/* write @vectors to the output stream of @conn. Unless the output is
+ * encrypted, all vectors are passed to the kernel in one system call.
+ * @written is set to the amount of bytes written, which can be less than
+ * the total when #GST_RTSP_EINTR is returned for a non-blocking write. */
+static GstRTSPResult
+writev_bytes (GstRTSPConnection * conn, GOutputVector * vectors,
+    guint n_vectors, gsize * written, gboolean block)
+{
+  GstRTSPResult res;
+  guint i;
+
+  *written = 0;
+
+#if defined (G_OS_UNIX) && defined (MSG_DONTWAIT)
+  if (conn->write_socket != NULL && !G_IS_TLS_CONNECTION (conn->stream0) &&
+      !G_IS_TLS_CONNECTION (conn->stream1)) {
+    struct iovec iov[MAX_VECTORS];
+    struct msghdr msg;
+    GError *err = NULL;
+    gint fd;
+    gssize r;
+
+    g_assert (n_vectors <= MAX_VECTORS);
+
+    for (i = 0; i < n_vectors; i++) {
+      iov[i].iov_base = (gpointer) vectors[i].buffer;
+      iov[i].iov_len = vectors[i].size;
+    }
+    memset (&msg, 0, sizeof (msg));
+    fd = g_socket_get_fd (conn->write_socket);
+
+    i = 0;
+    while (i < n_vectors) {
+      msg.msg_iov = &iov[i];
+      msg.msg_iovlen = n_vectors - i;
+
+      r = sendmsg (fd, &msg, SEND_FLAGS | MSG_DONTWAIT);
+      if (G_UNLIKELY (r < 0)) {
+        if (errno == EINTR)
+          continue;
+        if (errno != EAGAIN && errno != EWOULDBLOCK)
+          goto send_error;
+        if (!block)
+          return GST_RTSP_EINTR;
+        if (!g_socket_condition_wait (conn->write_socket, G_IO_OUT,
+                conn->cancellable, &err))
+          goto wait_error;
+        continue;
+      }
+      *written += r;
+
+      /* skip the vectors that were completely written */
+      while (i < n_vectors && (gsize) r >= iov[i].iov_len) {
+        r -= iov[i].iov_len;
+        i++;
+      }
+      if (i < n_vectors) {
+        iov[i].iov_base = (guint8 *) iov[i].iov_base + r;
+        iov[i].iov_len -= r;
+      }
+    }
+    return GST_RTSP_OK;
+
+    /* ERRORS */
+  send_error:
+    {
+      GST_DEBUG ("sendmsg failed: %s", g_strerror (errno));
+      return GST_RTSP_ESYS;
+    }
+  wait_error:
+    {
+      GST_DEBUG ("%s", err->message);
+      if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+        res = GST_RTSP_EINTR;
+      else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT))
+        res = GST_RTSP_ETIMEOUT;
+      else
+        res = GST_RTSP_ESYS;
+      g_clear_error (&err);
+      return res;
+    }
+  }
+#endif
+
+  /* write the vectors one by one through the output stream */
+  for (i = 0; i < n_vectors; i++) {
+    guint off = 0;
+
+    res = write_bytes (conn->output_stream, vectors[i].buffer, &off,
+        vectors[i].size, block, conn->cancellable);
+    *written += off;
+    if (res != GST_RTSP_OK)
+      return res;
+  }
+  return GST_RTSP_OK;
+}
+
 static gint
-fill_raw_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
+read_raw_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
     gboolean block, GError ** err)
 {
   gint out = 0;
@@ -1256,6 +1620,24 @@ fill_raw_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
   return out;
 }
 
+static gint
+fill_raw_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
+    gboolean block, GError ** err)
+{
+  gint out;
+
+  /* bytes that were read ahead come before anything else */
+  if (G_UNLIKELY (HAS_READ_CHUNK_DATA (conn))) {
+    out = MIN (conn->read_end - conn->read_off, size);
+    memcpy (buffer, conn->read_data + conn->read_off, out);
+    conn->read_off += out;
+  } else {
+    out = read_raw_bytes (conn, buffer, size, block, err);
+  }
+
+  return out;
+}
+
 static gint
 fill_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
     gboolean block, GError ** err)
@@ -1299,6 +1681,27 @@ fill_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
   return out;
 }
 
+static GstRTSPResult
+read_error_result (gint r, GError ** err)
+{
+  if (G_UNLIKELY (r == 0))
+    return GST_RTSP_EEOF;
+
+  GST_DEBUG ("%s", (*err)->message);
+  if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
+    g_clear_error (err);
+    return GST_RTSP_EINTR;
+  } else if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
+    g_clear_error (err);
+    return GST_RTSP_EINTR;
+  } else if (g_error_matches (*err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
+    g_clear_error (err);
+    return GST_RTSP_ETIMEOUT;
+  }
+  g_clear_error (err);
+  return GST_RTSP_ESYS;
+}
+
 static GstRTSPResult
 read_bytes (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
     gboolean block)
@@ -1315,33 +1718,80 @@ read_bytes (GstRTSPConnection * conn, guint8 * buffer, guint * idx, guint size,
   while (left) {
     r = fill_bytes (conn, &buffer[*idx], left, block, &err);
     if (G_UNLIKELY (r <= 0))
-      goto error;
+      return read_error_result (r, &err);
 
     left -= r;
     *idx += r;
   }
   return GST_RTSP_OK;
+}
 
-  /* ERRORS */
-error:
-  {
-    if (G_UNLIKELY (r == 0))
-      return GST_RTSP_EEOF;
+static void
+release_read_chunk (GstRTSPConnection * conn)
+{
+  if (conn->read_chunk)
+    gst_memory_unref (conn->read_chunk);
+  conn->read_chunk = NULL;
+  conn->read_data = NULL;
+  conn->read_size = 0;
+  conn->read_off = 0;
+  conn->read_end = 0;
+}
 
-    GST_DEBUG ("%s", err->message);
-    if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_CANCELLED)) {
-      g_clear_error (&err);
-      return GST_RTSP_EINTR;
-    } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_WOULD_BLOCK)) {
-      g_clear_error (&err);
-      return GST_RTSP_EINTR;
-    } else if (g_error_matches (err, G_IO_ERROR, G_IO_ERROR_TIMED_OUT)) {
-      g_clear_error (&err);
-      return GST_RTSP_ETIMEOUT;
-    }
-    g_clear_error (&err);
-    return GST_RTSP_ESYS;
+/* make room for @size bytes, counting from the first unconsumed byte, in the
+ * read chunk */
+static void
+ensure_read_chunk (GstRTSPConnection * conn, gsize size)
+{
+  gsize left;
+
+  if (conn->read_chunk != NULL && conn->read_off + size <= conn->read_size)
+    return;
+
+  left = conn->read_end - conn->read_off;
+
+  if (conn->read_chunk != NULL && size <= conn->read_size &&
+      GST_MINI_OBJECT_REFCOUNT_VALUE (conn->read_chunk) == 1) {
+    /* nobody uses the data in the chunk anymore, we can reuse it */
+    memmove (conn->read_data, conn->read_data + conn->read_off, left);
+  } else {
+    gsize chunk_size = MAX (READ_CHUNK_SIZE, size);
+    guint8 *data;
+
+    /* the old chunk stays alive as long as buffers use its memory */
+    data = g_malloc (chunk_size);
+    if (left > 0)
+      memcpy (data, conn->read_data + conn->read_off, left);
+    release_read_chunk (conn);
+
+    conn->read_chunk = gst_memory_new_wrapped (GST_MEMORY_FLAG_READONLY, data,
+        chunk_size, 0, chunk_size, data, g_free);
+    conn->read_data = data;
+    conn->read_size = chunk_size;
+  }
+  conn->read_off = 0;
+  conn->read_end = left;
+}
+
+/* make sure there are at least @size unconsumed bytes in the read chunk,
+ * reading as much as is available up to the end of the chunk */
+static GstRTSPResult
+fill_read_chunk (GstRTSPConnection * conn, gsize size, gboolean block)
+{
+  GError *err = NULL;
+  gint r;
+
+  ensure_read_chunk (conn, size);
+
+  while (conn->read_end - conn->read_off < size) {
+    r = read_raw_bytes (conn, conn->read_data + conn->read_end,
+        conn->read_size - conn->read_end, block, &err);
+    if (G_UNLIKELY (r <= 0))
+      return read_error_result (r, &err);
+
+    conn->read_end += r;
   }
+  return GST_RTSP_OK;
 }
 
 /* The code below tries to handle clients using \r, \n or \r\n to indicate the
@@ -1499,16 +1949,11 @@ static GString *
 message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
 {
   GString *str = NULL;
+  gsize size;
 
-  str = g_string_new ("");
-
+  /* update the headers first so that the size of the string is known */
   switch (message->type) {
     case GST_RTSP_MESSAGE_REQUEST:
-      /* create request string, add CSeq */
-      g_string_append_printf (str, "%s %s RTSP/1.0\r\n"
-          "CSeq: %d\r\n",
-          gst_rtsp_method_as_text (message->type_data.request.method),
-          message->type_data.request.uri, conn->cseq++);
       /* add session id if we have one */
       if (conn->session_id[0] != '\0') {
         gst_rtsp_message_remove_header (message, GST_RTSP_HDR_SESSION, -1);
@@ -1518,6 +1963,52 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
       /* add any authentication headers */
       add_auth_header (conn, message);
       break;
+    case GST_RTSP_MESSAGE_HTTP_REQUEST:
+      /* add any authentication headers */
+      add_auth_header (conn, message);
+      break;
+    case GST_RTSP_MESSAGE_RESPONSE:
+    case GST_RTSP_MESSAGE_HTTP_RESPONSE:
+    case GST_RTSP_MESSAGE_DATA:
+      break;
+    default:
+      g_return_val_if_reached (NULL);
+      break;
+  }
+
+  if (message->type != GST_RTSP_MESSAGE_DATA) {
+    gchar date_string[100];
+
+    gen_date_string (date_string, sizeof (date_string));
+
+    /* add date header */
+    gst_rtsp_message_remove_header (message, GST_RTSP_HDR_DATE, -1);
+    gst_rtsp_message_add_header (message, GST_RTSP_HDR_DATE, date_string);
+  }
+
+  /* room for the start line, CSeq, Content-Length and the header end */
+  size = 128 + message->body_size;
+  if (message->type == GST_RTSP_MESSAGE_REQUEST ||
+      message->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
+    if (message->type_data.request.uri)
+      size += strlen (message->type_data.request.uri);
+  } else if (message->type != GST_RTSP_MESSAGE_DATA) {
+    if (message->type_data.response.reason)
+      size += strlen (message->type_data.response.reason);
+  }
+  if (message->type != GST_RTSP_MESSAGE_DATA)
+    size += __gst_rtsp_message_get_headers_size (message);
+
+  str = g_string_sized_new (size);
+
+  switch (message->type) {
+    case GST_RTSP_MESSAGE_REQUEST:
+      /* create request string, add CSeq */
+      g_string_append_printf (str, "%s %s RTSP/1.0\r\n"
+          "CSeq: %d\r\n",
+          gst_rtsp_method_as_text (message->type_data.request.method),
+          message->type_data.request.uri, conn->cseq++);
+      break;
     case GST_RTSP_MESSAGE_RESPONSE:
       /* create response string */
       g_string_append_printf (str, "RTSP/1.0 %d %s\r\n",
@@ -1529,8 +2020,6 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
           gst_rtsp_method_as_text (message->type_data.request.method),
           message->type_data.request.uri,
           gst_rtsp_version_as_text (message->type_data.request.version));
-      /* add any authentication headers */
-      add_auth_header (conn, message);
       break;
     case GST_RTSP_MESSAGE_HTTP_RESPONSE:
       /* create response string */
@@ -1556,32 +2045,20 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
       break;
     }
     default:
-      g_string_free (str, TRUE);
-      g_return_val_if_reached (NULL);
+      g_assert_not_reached ();
       break;
   }
 
   /* append headers and body */
   if (message->type != GST_RTSP_MESSAGE_DATA) {
-    gchar date_string[100];
-
-    gen_date_string (date_string, sizeof (date_string));
-
-    /* add date header */
-    gst_rtsp_message_remove_header (message, GST_RTSP_HDR_DATE, -1);
-    gst_rtsp_message_add_header (message, GST_RTSP_HDR_DATE, date_string);
-
     /* append headers */
     gst_rtsp_message_append_headers (message, str);
 
     /* append Content-Length and body if needed */
     if (message->body != NULL && message->body_size > 0) {
-      gchar *len;
-
-      len = g_strdup_printf ("%d", message->body_size);
-      g_string_append_printf (str, "%s: %s\r\n",
-          gst_rtsp_header_as_text (GST_RTSP_HDR_CONTENT_LENGTH), len);
-      g_free (len);
+      g_string_append_printf (str, "%s: %u\r\n",
+          gst_rtsp_header_as_text (GST_RTSP_HDR_CONTENT_LENGTH),
+          message->body_size);
       /* header ends here */
       g_string_append (str, "\r\n");
       str =
@@ -1596,6 +2073,44 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
   return str;
 }
 
+/* write all of @rec, blocking up to @timeout, and free it */
+static GstRTSPResult
+gst_rtsp_connection_send_rec (GstRTSPConnection * conn, GstRTSPRec * rec,
+    GTimeVal * timeout)
+{
+  GOutputVector vectors[MAX_VECTORS];
+  GstClockTime to;
+  GstRTSPResult res;
+
+  if (conn->tunneled) {
+    gchar *str;
+
+    /* tunneled data is base64 encoded, which needs all bytes in one chunk */
+    gst_rtsp_rec_flatten (rec);
+    str = g_base64_encode (rec->data, rec->size);
+    res = gst_rtsp_connection_write (conn, (guint8 *) str, strlen (str),
+        timeout);
+    g_free (str);
+  } else {
+    to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+
+    g_socket_set_timeout (conn->write_socket,
+        (to + GST_SECOND - 1) / GST_SECOND);
+    do {
+      guint n_vectors;
+      gsize written;
+
+      n_vectors = gst_rtsp_rec_get_vectors (rec, vectors, MAX_VECTORS);
+      res = writev_bytes (conn, vectors, n_vectors, &written, TRUE);
+      gst_rtsp_rec_advance (rec, written);
+    } while (res == GST_RTSP_OK && rec->size > 0);
+    g_socket_set_timeout (conn->write_socket, 0);
+  }
+  gst_rtsp_rec_free (rec);
+
+  return res;
+}
+
 /**
  * gst_rtsp_connection_send:
  * @conn: a #GstRTSPConnection
@@ -1622,6 +2137,14 @@ gst_rtsp_connection_send (GstRTSPConnection * conn, GstRTSPMessage * message,
   g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
 
+  /* write the header and body of data messages without copying the body */
+  if (message->type == GST_RTSP_MESSAGE_DATA) {
+    g_return_val_if_fail (conn->output_stream != NULL, GST_RTSP_EINVAL);
+
+    return gst_rtsp_connection_send_rec (conn,
+        gst_rtsp_rec_new_message_data (message), timeout);
+  }
+
   if (G_UNLIKELY (!(string = message_to_string (conn, message))))
     goto no_message;
 
@@ -1638,15 +2161,86 @@ gst_rtsp_connection_send (GstRTSPConnection * conn, GstRTSPMessage * message,
   /* write request */
   res = gst_rtsp_connection_write (conn, (guint8 *) str, len, timeout);
 
-  g_free (str);
+  g_free (str);
+
+  return res;
+
+no_message:
+  {
+    g_warning ("Wrong message");
+    return GST_RTSP_EINVAL;
+  }
+}
+
+/**
+ * gst_rtsp_connection_send_data:
+ * @conn: a #GstRTSPConnection
+ * @channel: the interleaved channel
+ * @buffer: (transfer none): the data to send
+ * @timeout: a timeout value or %NULL
+ *
+ * Attempt to send the contents of @buffer as interleaved data on @channel
+ * to the connected @conn, blocking up to the specified @timeout. The memory
+ * of @buffer is written directly, without copying it into a
+ * #GstRTSPMessage. @timeout can be %NULL, in which case this function might
+ * block forever.
+ *
+ * This function can be cancelled with gst_rtsp_connection_flush().
+ *
+ * Returns: #GST_RTSP_OK on success.
+ *
+ * Since: 1.10
+ */
+GstRTSPResult
+gst_rtsp_connection_send_data (GstRTSPConnection * conn, guint8 channel,
+    GstBuffer * buffer, GTimeVal * timeout)
+{
+  GstRTSPRec *rec;
+
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn->output_stream != NULL, GST_RTSP_EINVAL);
+
+  if (G_UNLIKELY (!(rec = gst_rtsp_rec_new_buffers (channel, buffer, NULL))))
+    return GST_RTSP_EINVAL;
+
+  return gst_rtsp_connection_send_rec (conn, rec, timeout);
+}
 
-  return res;
+/**
+ * gst_rtsp_connection_send_data_list:
+ * @conn: a #GstRTSPConnection
+ * @channel: the interleaved channel
+ * @list: (transfer none): the data to send
+ * @timeout: a timeout value or %NULL
+ *
+ * Attempt to send every buffer of @list as an interleaved data packet on
+ * @channel to the connected @conn, blocking up to the specified @timeout.
+ * The packets are written with as few system calls as possible and the
+ * memory of the buffers is not copied. @timeout can be %NULL, in which case
+ * this function might block forever.
+ *
+ * This function can be cancelled with gst_rtsp_connection_flush().
+ *
+ * Returns: #GST_RTSP_OK on success.
+ *
+ * Since: 1.10
+ */
+GstRTSPResult
+gst_rtsp_connection_send_data_list (GstRTSPConnection * conn, guint8 channel,
+    GstBufferList * list, GTimeVal * timeout)
+{
+  GstRTSPRec *rec;
 
-no_message:
-  {
-    g_warning ("Wrong message");
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (list), GST_RTSP_EINVAL);
+  g_return_val_if_fail (gst_buffer_list_length (list) > 0, GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn->output_stream != NULL, GST_RTSP_EINVAL);
+
+  if (G_UNLIKELY (!(rec = gst_rtsp_rec_new_buffers (channel, NULL, list))))
     return GST_RTSP_EINVAL;
-  }
+
+  return gst_rtsp_connection_send_rec (conn, rec, timeout);
 }
 
 static GstRTSPResult
@@ -2336,6 +2930,150 @@ cleanup:
   }
 }
 
+/**
+ * gst_rtsp_connection_receive_data_list:
+ * @conn: a #GstRTSPConnection
+ * @message: the message to read
+ * @list: (out) (transfer full): location for the interleaved data
+ * @timeout: a timeout value or %NULL
+ *
+ * Attempt to read the next message from the connected @conn, blocking up to
+ * the specified @timeout. @timeout can be %NULL, in which case this function
+ * might block forever.
+ *
+ * When the next message is interleaved data, @message is initialized as a
+ * data message for its channel and @list contains the data of that message
+ * and of all following data messages on the same channel that could be read
+ * along with it. The socket is read in large chunks and the buffers in @list
+ * share the memory of these chunks, so no memory is allocated or copied for
+ * the individual messages. The memory of the buffers is read-only.
+ *
+ * For any other message, @message contains the message as with
+ * gst_rtsp_connection_receive() and @list is set to %NULL.
+ *
+ * Bytes that were read ahead are returned by the next calls to this function
+ * and to gst_rtsp_connection_receive(). gst_rtsp_connection_poll() reports
+ * @conn as readable while there are such bytes.
+ *
+ * This function can be cancelled with gst_rtsp_connection_flush().
+ *
+ * Returns: #GST_RTSP_OK on success.
+ *
+ * Since: 1.10
+ */
+GstRTSPResult
+gst_rtsp_connection_receive_data_list (GstRTSPConnection * conn,
+    GstRTSPMessage * message, GstBufferList ** list, GTimeVal * timeout)
+{
+  GstRTSPResult res;
+  GstClockTime to;
+  guint8 *header;
+  guint8 channel = 0;
+  guint len;
+
+  g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (list != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
+
+  *list = NULL;
+
+  /* base64 encoded data can't be shared and the character the line parser
+   * looked ahead at is not in the chunk */
+  if (conn->ctxp != NULL || conn->read_ahead != 0)
+    goto receive_message;
+
+  /* configure timeout if any */
+  to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+
+  g_socket_set_timeout (conn->read_socket, (to + GST_SECOND - 1) / GST_SECOND);
+
+  /* skip the line endings between messages */
+  while (TRUE) {
+    res = fill_read_chunk (conn, 1, TRUE);
+    if (res != GST_RTSP_OK)
+      goto done;
+
+    if (conn->read_data[conn->read_off] != '\r' &&
+        conn->read_data[conn->read_off] != '\n')
+      break;
+    conn->read_off++;
+  }
+
+  if (conn->read_data[conn->read_off] != '$') {
+    g_socket_set_timeout (conn->read_socket, 0);
+    goto receive_message;
+  }
+
+  while (TRUE) {
+    GstBuffer *buffer;
+
+    if (*list == NULL) {
+      /* wait for the complete first message */
+      res = fill_read_chunk (conn, 4, TRUE);
+      if (res != GST_RTSP_OK)
+        goto done;
+
+      header = conn->read_data + conn->read_off;
+      channel = header[1];
+      len = (header[2] << 8) | header[3];
+
+      res = fill_read_chunk (conn, 4 + len, TRUE);
+      if (res != GST_RTSP_OK)
+        goto done;
+
+      *list = gst_buffer_list_new ();
+    } else {
+      gsize avail = conn->read_end - conn->read_off;
+
+      /* add the following messages on the same channel that are complete
+       * in the chunk already */
+      if (avail < 4)
+        break;
+
+      header = conn->read_data + conn->read_off;
+      if (header[0] != '$' || header[1] != channel)
+        break;
+
+      len = (header[2] << 8) | header[3];
+      if (avail < 4 + len)
+        break;
+    }
+
+    buffer = gst_buffer_new ();
+    if (len > 0)
+      gst_buffer_append_memory (buffer,
+          gst_memory_share (conn->read_chunk, conn->read_off + 4, len));
+    gst_buffer_list_add (*list, buffer);
+
+    conn->read_off += 4 + len;
+  }
+
+  res = gst_rtsp_message_init_data (message, channel);
+
+done:
+  g_socket_set_timeout (conn->read_socket, 0);
+
+  return res;
+
+receive_message:
+  {
+    res = gst_rtsp_connection_receive (conn, message, timeout);
+
+    if (res == GST_RTSP_OK && message->type == GST_RTSP_MESSAGE_DATA) {
+      guint8 *data;
+      guint size;
+
+      /* the body has a trailing '\0' that is not part of the data */
+      gst_rtsp_message_steal_body (message, &data, &size);
+      *list = gst_buffer_list_new_sized (1);
+      gst_buffer_list_add (*list, gst_buffer_new_wrapped_full (0, data, size,
+              0, size > 0 ? size - 1 : 0, data, g_free));
+    }
+    return res;
+  }
+}
+
 /**
  * gst_rtsp_connection_close:
  * @conn: a #GstRTSPConnection
@@ -2379,6 +3117,8 @@ gst_rtsp_connection_close (GstRTSPConnection * conn)
   conn->initial_buffer = NULL;
   conn->initial_buffer_offset = 0;
 
+  release_read_chunk (conn);
+
   conn->write_socket = NULL;
   conn->read_socket = NULL;
   conn->tunneled = FALSE;
@@ -2462,6 +3202,17 @@ gst_rtsp_connection_poll (GstRTSPConnection * conn, GstRTSPEvent events,
   g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (conn->write_socket != NULL, GST_RTSP_EINVAL);
 
+  /* bytes that were read ahead can be read right away */
+  if ((events & GST_RTSP_EV_READ) && HAS_READ_CHUNK_DATA (conn)) {
+    *revents = GST_RTSP_EV_READ;
+    if (events & GST_RTSP_EV_WRITE) {
+      condition = g_socket_condition_check (conn->write_socket, G_IO_OUT);
+      if ((condition & G_IO_OUT))
+        *revents |= GST_RTSP_EV_WRITE;
+    }
+    return GST_RTSP_OK;
+  }
+
   ctx = g_main_context_new ();
 
   /* configure timeout if any */
@@ -3045,6 +3796,16 @@ gst_rtsp_connection_do_tunnel (GstRTSPConnection * conn,
       conn->input_stream = conn2->input_stream;
       conn->control_stream = g_io_stream_get_input_stream (conn->stream0);
       conn2->output_stream = NULL;
+
+      /* and the bytes that were read ahead from it */
+      release_read_chunk (conn);
+      conn->read_chunk = conn2->read_chunk;
+      conn->read_data = conn2->read_data;
+      conn->read_size = conn2->read_size;
+      conn->read_off = conn2->read_off;
+      conn->read_end = conn2->read_end;
+      conn2->read_chunk = NULL;
+      release_read_chunk (conn2);
     } else {
       /* conn2 is the HTTP GET channel. take its socket and set it as write
        * socket in conn */
@@ -3130,13 +3891,6 @@ gst_rtsp_connection_get_remember_session_id (GstRTSPConnection * conn)
 #define WRITE_ERR   (G_IO_HUP | G_IO_ERR | G_IO_NVAL)
 #define WRITE_COND  (G_IO_OUT | WRITE_ERR)
 
-typedef struct
-{
-  guint8 *data;
-  guint size;
-  guint id;
-} GstRTSPRec;
-
 /* async functions */
 struct _GstRTSPWatch
 {
@@ -3158,10 +3912,6 @@ struct _GstRTSPWatch
   GMutex mutex;
   GQueue *messages;
   gsize messages_bytes;
-  guint8 *write_data;
-  guint write_off;
-  guint write_size;
-  guint write_id;
   gsize max_bytes;
   guint max_messages;
   GCond queue_not_full;
@@ -3181,7 +3931,8 @@ gst_rtsp_source_prepare (GSource * source, gint * timeout)
 {
   GstRTSPWatch *watch = (GstRTSPWatch *) source;
 
-  if (watch->conn->initial_buffer != NULL)
+  if (watch->conn->initial_buffer != NULL ||
+      HAS_READ_CHUNK_DATA (watch->conn))
     return TRUE;
 
   *timeout = (watch->conn->timeout * 1000);
@@ -3405,7 +4156,7 @@ gst_rtsp_source_dispatch (GSource * source, GSourceFunc callback G_GNUC_UNUSED,
   GstRTSPWatch *watch = (GstRTSPWatch *) source;
   GstRTSPConnection *conn = watch->conn;
 
-  if (conn->initial_buffer != NULL) {
+  if (conn->initial_buffer != NULL || HAS_READ_CHUNK_DATA (conn)) {
     gst_rtsp_source_dispatch_read (G_POLLABLE_INPUT_STREAM (conn->input_stream),
         watch);
   }
@@ -3418,6 +4169,9 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
 {
   GstRTSPResult res = GST_RTSP_ERROR;
   GstRTSPConnection *conn = watch->conn;
+  GOutputVector vectors[MAX_VECTORS];
+  GstRTSPRec *rec;
+  guint id = 0;
 
   /* if this connection was already closed, stop now */
   if (G_POLLABLE_OUTPUT_STREAM (conn->output_stream) != stream)
@@ -3425,67 +4179,74 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
 
   g_mutex_lock (&watch->mutex);
   do {
-    if (watch->write_data == NULL) {
-      GstRTSPRec *rec;
-
-      /* get a new message from the queue */
-      rec = g_queue_pop_tail (watch->messages);
-      if (rec == NULL) {
-        if (watch->writesrc) {
-          if (!g_source_is_destroyed ((GSource *) watch))
-            g_source_remove_child_source ((GSource *) watch, watch->writesrc);
-          g_source_unref (watch->writesrc);
-          watch->writesrc = NULL;
-          /* we create and add the write source again when we actually have
-           * something to write */
-
-          /* since write source is now removed we add read source on the write
-           * socket instead to be able to detect when client closes get channel
-           * in tunneled mode */
-          if (watch->conn->control_stream) {
-            watch->controlsrc =
-                g_pollable_input_stream_create_source (G_POLLABLE_INPUT_STREAM
-                (watch->conn->control_stream), NULL);
-            g_source_set_callback (watch->controlsrc,
-                (GSourceFunc) gst_rtsp_source_dispatch_read_get_channel, watch,
-                NULL);
-            g_source_add_child_source ((GSource *) watch, watch->controlsrc);
-          } else {
-            watch->controlsrc = NULL;
-          }
+    GQueue sent = G_QUEUE_INIT;
+    GList *walk;
+    guint n_vectors = 0;
+    gsize written;
+
+    if (watch->messages->length == 0) {
+      if (watch->writesrc) {
+        if (!g_source_is_destroyed ((GSource *) watch))
+          g_source_remove_child_source ((GSource *) watch, watch->writesrc);
+        g_source_unref (watch->writesrc);
+        watch->writesrc = NULL;
+        /* we create and add the write source again when we actually have
+         * something to write */
+
+        /* since write source is now removed we add read source on the write
+         * socket instead to be able to detect when client closes get channel
+         * in tunneled mode */
+        if (watch->conn->control_stream) {
+          watch->controlsrc =
+              g_pollable_input_stream_create_source (G_POLLABLE_INPUT_STREAM
+              (watch->conn->control_stream), NULL);
+          g_source_set_callback (watch->controlsrc,
+              (GSourceFunc) gst_rtsp_source_dispatch_read_get_channel, watch,
+              NULL);
+          g_source_add_child_source ((GSource *) watch, watch->controlsrc);
+        } else {
+          watch->controlsrc = NULL;
         }
-        break;
       }
+      break;
+    }
 
-      watch->messages_bytes -= rec->size;
+    /* collect the queued records, oldest first, so that they can be written
+     * with one vectored write */
+    for (walk = watch->messages->tail; walk && n_vectors < MAX_VECTORS;
+        walk = walk->prev) {
+      n_vectors += gst_rtsp_rec_get_vectors (walk->data, &vectors[n_vectors],
+          MAX_VECTORS - n_vectors);
+    }
 
-      watch->write_off = 0;
-      watch->write_data = rec->data;
-      watch->write_size = rec->size;
-      watch->write_id = rec->id;
+    res = writev_bytes (conn, vectors, n_vectors, &written, FALSE);
 
-      g_slice_free (GstRTSPRec, rec);
+    /* move the completely written records out of the queue */
+    watch->messages_bytes -= written;
+    while ((rec = g_queue_peek_tail (watch->messages))) {
+      written = gst_rtsp_rec_advance (rec, written);
+      if (rec->size > 0)
+        break;
+      g_queue_push_tail (&sent, g_queue_pop_tail (watch->messages));
     }
-
-    res = write_bytes (conn->output_stream, watch->write_data,
-        &watch->write_off, watch->write_size, FALSE, conn->cancellable);
+    id = rec != NULL ? rec->id : 0;
 
     if (!IS_BACKLOG_FULL (watch))
       g_cond_signal (&watch->queue_not_full);
     g_mutex_unlock (&watch->mutex);
 
+    while ((rec = g_queue_pop_head (&sent))) {
+      if (watch->funcs.message_sent)
+        watch->funcs.message_sent (watch, rec->id, watch->user_data);
+      gst_rtsp_rec_free (rec);
+    }
+
     if (res == GST_RTSP_EINTR)
       goto write_blocked;
-    else if (G_LIKELY (res == GST_RTSP_OK)) {
-      if (watch->funcs.message_sent)
-        watch->funcs.message_sent (watch, watch->write_id, watch->user_data);
-    } else {
+    else if (G_UNLIKELY (res != GST_RTSP_OK))
       goto write_error;
-    }
-    g_mutex_lock (&watch->mutex);
 
-    g_free (watch->write_data);
-    watch->write_data = NULL;
+    g_mutex_lock (&watch->mutex);
   } while (TRUE);
   g_mutex_unlock (&watch->mutex);
 
@@ -3500,8 +4261,7 @@ eof:
 write_error:
   {
     if (watch->funcs.error_full)
-      watch->funcs.error_full (watch, res, NULL,
-          watch->write_id, watch->user_data);
+      watch->funcs.error_full (watch, res, NULL, id, watch->user_data);
     else if (watch->funcs.error)
       watch->funcs.error (watch, res, watch->user_data);
 
@@ -3509,15 +4269,6 @@ write_error:
   }
 }
 
-static void
-gst_rtsp_rec_free (gpointer data)
-{
-  GstRTSPRec *rec = data;
-
-  g_free (rec->data);
-  g_slice_free (GstRTSPRec, rec);
-}
-
 static void
 gst_rtsp_source_finalize (GSource * source)
 {
@@ -3534,7 +4285,6 @@ gst_rtsp_source_finalize (GSource * source)
   watch->messages = NULL;
   watch->messages_bytes = 0;
 
-  g_free (watch->write_data);
   g_cond_clear (&watch->queue_not_full);
 
   if (watch->readsrc)
@@ -3750,73 +4500,45 @@ gst_rtsp_watch_get_send_backlog (GstRTSPWatch * watch,
   g_mutex_unlock (&watch->mutex);
 }
 
-/**
- * gst_rtsp_watch_write_data:
- * @watch: a #GstRTSPWatch
- * @data: (array length=size) (transfer full): the data to queue
- * @size: the size of @data
- * @id: (out) (allow-none): location for a message ID or %NULL
- *
- * Write @data using the connection of the @watch. If it cannot be sent
- * immediately, it will be queued for transmission in @watch. The contents of
- * @message will then be serialized and transmitted when the connection of the
- * @watch becomes writable. In case the @message is queued, the ID returned in
- * @id will be non-zero and used as the ID argument in the message_sent
- * callback.
- *
- * This function will take ownership of @data and g_free() it after use.
- *
- * If the amount of queued data exceeds the limits set with
- * gst_rtsp_watch_set_send_backlog(), this function will return
- * #GST_RTSP_ENOMEM.
- *
- * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
- * are reached. #GST_RTSP_EINTR when @watch was flushing.
- */
-GstRTSPResult
-gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
-    guint size, guint * id)
+static GstRTSPResult
+gst_rtsp_watch_queue_rec (GstRTSPWatch * watch, GstRTSPRec * rec, guint * id)
 {
   GstRTSPResult res;
-  GstRTSPRec *rec;
-  guint off = 0;
   GMainContext *context = NULL;
 
-  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (size != 0, GST_RTSP_EINVAL);
-
   g_mutex_lock (&watch->mutex);
   if (watch->flushing)
     goto flushing;
 
-  /* try to send the message synchronously first */
-  if (watch->messages->length == 0 && watch->write_data == NULL) {
-    res =
-        write_bytes (watch->conn->output_stream, data, &off, size,
-        FALSE, watch->conn->cancellable);
+  /* try to send the record synchronously first */
+  if (watch->messages->length == 0) {
+    GOutputVector vectors[MAX_VECTORS];
+
+    do {
+      guint n_vectors;
+      gsize written;
+
+      n_vectors = gst_rtsp_rec_get_vectors (rec, vectors, MAX_VECTORS);
+      res = writev_bytes (watch->conn, vectors, n_vectors, &written, FALSE);
+      gst_rtsp_rec_advance (rec, written);
+    } while (res == GST_RTSP_OK && rec->size > 0);
+
     if (res != GST_RTSP_EINTR) {
       if (id != NULL)
         *id = 0;
-      g_free ((gpointer) data);
+      gst_rtsp_rec_free (rec);
       goto done;
     }
   }
 
-  /* check limits */
-  if (IS_BACKLOG_FULL (watch))
+  /* check limits, a partially written record must always be queued or the
+   * stream would be corrupted */
+  if (!REC_IS_STARTED (rec) && IS_BACKLOG_FULL (watch))
     goto too_much_backlog;
 
-  /* make a record with the data and id for sending async */
-  rec = g_slice_new (GstRTSPRec);
-  if (off == 0) {
-    rec->data = (guint8 *) data;
-    rec->size = size;
-  } else {
-    rec->data = g_memdup (data + off, size - off);
-    rec->size = size - off;
-    g_free ((gpointer) data);
-  }
+  /* we can't keep pointers to memory we don't own */
+  if (rec->borrowed)
+    gst_rtsp_rec_flatten (rec);
 
   do {
     /* make sure rec->id is never 0 */
@@ -3864,7 +4586,7 @@ flushing:
   {
     GST_DEBUG ("we are flushing");
     g_mutex_unlock (&watch->mutex);
-    g_free ((gpointer) data);
+    gst_rtsp_rec_free (rec);
     return GST_RTSP_EINTR;
   }
 too_much_backlog:
@@ -3873,11 +4595,119 @@ too_much_backlog:
         G_GSIZE_FORMAT ", max_messages %u, current %u", watch->max_bytes,
         watch->messages_bytes, watch->max_messages, watch->messages->length);
     g_mutex_unlock (&watch->mutex);
-    g_free ((gpointer) data);
+    gst_rtsp_rec_free (rec);
     return GST_RTSP_ENOMEM;
   }
 }
 
+/**
+ * gst_rtsp_watch_write_data:
+ * @watch: a #GstRTSPWatch
+ * @data: (array length=size) (transfer full): the data to queue
+ * @size: the size of @data
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Write @data using the connection of the @watch. If it cannot be sent
+ * immediately, it will be queued for transmission in @watch. The contents of
+ * @message will then be serialized and transmitted when the connection of the
+ * @watch becomes writable. In case the @message is queued, the ID returned in
+ * @id will be non-zero and used as the ID argument in the message_sent
+ * callback.
+ *
+ * This function will take ownership of @data and g_free() it after use.
+ *
+ * If the amount of queued data exceeds the limits set with
+ * gst_rtsp_watch_set_send_backlog(), this function will return
+ * #GST_RTSP_ENOMEM.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ */
+GstRTSPResult
+gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
+    guint size, guint * id)
+{
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (size != 0, GST_RTSP_EINVAL);
+
+  return gst_rtsp_watch_queue_rec (watch,
+      gst_rtsp_rec_new ((guint8 *) data, size), id);
+}
+
+/**
+ * gst_rtsp_watch_send_data:
+ * @watch: a #GstRTSPWatch
+ * @channel: the interleaved channel
+ * @buffer: (transfer none): the data to send
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Send the contents of @buffer as interleaved data on @channel using the
+ * connection of the @watch. If it cannot be sent immediately, it will be
+ * queued for transmission in @watch and the ID returned in @id will be
+ * non-zero and used as the ID argument in the message_sent callback.
+ *
+ * The memory of @buffer is not copied, @buffer is kept by reference until
+ * it is sent. Queued data is written together with the other queued data in
+ * as few system calls as possible.
+ *
+ * If the amount of queued data exceeds the limits set with
+ * gst_rtsp_watch_set_send_backlog(), this function will return
+ * #GST_RTSP_ENOMEM.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ *
+ * Since: 1.10
+ */
+GstRTSPResult
+gst_rtsp_watch_send_data (GstRTSPWatch * watch, guint8 channel,
+    GstBuffer * buffer, guint * id)
+{
+  GstRTSPRec *rec;
+
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_RTSP_EINVAL);
+
+  if (G_UNLIKELY (!(rec = gst_rtsp_rec_new_buffers (channel, buffer, NULL))))
+    return GST_RTSP_EINVAL;
+
+  return gst_rtsp_watch_queue_rec (watch, rec, id);
+}
+
+/**
+ * gst_rtsp_watch_send_data_list:
+ * @watch: a #GstRTSPWatch
+ * @channel: the interleaved channel
+ * @list: (transfer none): the data to send
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Send every buffer of @list as an interleaved data packet on @channel
+ * using the connection of the @watch. This works like
+ * gst_rtsp_watch_send_data() but all packets share one message ID, the
+ * message_sent callback is called once after the last packet was sent.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ *
+ * Since: 1.10
+ */
+GstRTSPResult
+gst_rtsp_watch_send_data_list (GstRTSPWatch * watch, guint8 channel,
+    GstBufferList * list, guint * id)
+{
+  GstRTSPRec *rec;
+
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (list), GST_RTSP_EINVAL);
+  g_return_val_if_fail (gst_buffer_list_length (list) > 0, GST_RTSP_EINVAL);
+
+  if (G_UNLIKELY (!(rec = gst_rtsp_rec_new_buffers (channel, NULL, list))))
+    return GST_RTSP_EINVAL;
+
+  return gst_rtsp_watch_queue_rec (watch, rec, id);
+}
+
 /**
  * gst_rtsp_watch_send_message:
  * @watch: a #GstRTSPWatch
@@ -3897,17 +4727,23 @@ GstRTSPResult
 gst_rtsp_watch_send_message (GstRTSPWatch * watch, GstRTSPMessage * message,
     guint * id)
 {
+  GstRTSPRec *rec;
   GString *str;
   guint size;
 
   g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
 
-  /* make a record with the message as a string and id */
-  str = message_to_string (watch->conn, message);
-  size = str->len;
-  return gst_rtsp_watch_write_data (watch,
-      (guint8 *) g_string_free (str, FALSE), size, id);
+  if (message->type == GST_RTSP_MESSAGE_DATA) {
+    /* the body is only copied when the message needs to be queued */
+    rec = gst_rtsp_rec_new_message_data (message);
+  } else {
+    /* make a record with the message as a string and id */
+    str = message_to_string (watch->conn, message);
+    size = str->len;
+    rec = gst_rtsp_rec_new ((guint8 *) g_string_free (str, FALSE), size);
+  }
+  return gst_rtsp_watch_queue_rec (watch, rec, id);
 }
 
 /**
@@ -3997,8 +4833,24 @@ gst_rtsp_watch_set_flushing (GstRTSPWatch * watch, gboolean flushing)
   watch->flushing = flushing;
   g_cond_signal (&watch->queue_not_full);
   if (flushing) {
+    GstRTSPRec *rec;
+
+    /* keep the record that is partially written, the stream would be
+     * corrupted otherwise */
+    rec = g_queue_peek_tail (watch->messages);
+    if (rec != NULL && REC_IS_STARTED (rec))
+      g_queue_pop_tail (watch->messages);
+    else
+      rec = NULL;
+
     g_queue_foreach (watch->messages, (GFunc) gst_rtsp_rec_free, NULL);
     g_queue_clear (watch->messages);
+    watch->messages_bytes = 0;
+
+    if (rec != NULL) {
+      g_queue_push_head (watch->messages, rec);
+      watch->messages_bytes = rec->size;
+    }
   }
   g_mutex_unlock (&watch->mutex);
 }
@@ -95,6 +95,16 @@ GstRTSPResult      gst_rtsp_connection_send           (GstRTSPConnection *conn,
 GstRTSPResult      gst_rtsp_connection_receive        (GstRTSPConnection *conn, GstRTSPMessage *message,
                                                        GTimeVal *timeout);
 
+/* sending/receiving interleaved data */
+GstRTSPResult      gst_rtsp_connection_send_data      (GstRTSPConnection *conn, guint8 channel,
+                                                       GstBuffer *buffer, GTimeVal *timeout);
+GstRTSPResult      gst_rtsp_connection_send_data_list (GstRTSPConnection *conn, guint8 channel,
+                                                       GstBufferList *list, GTimeVal *timeout);
+GstRTSPResult      gst_rtsp_connection_receive_data_list (GstRTSPConnection *conn,
+                                                          GstRTSPMessage *message,
+                                                          GstBufferList **list,
+                                                          GTimeVal *timeout);
+
 /* status management */
 GstRTSPResult      gst_rtsp_connection_poll           (GstRTSPConnection *conn, GstRTSPEvent events,
                                                        GstRTSPEvent *revents, GTimeVal *timeout);
@@ -218,6 +228,14 @@ GstRTSPResult      gst_rtsp_watch_write_data         (GstRTSPWatch *watch,
 GstRTSPResult      gst_rtsp_watch_send_message       (GstRTSPWatch *watch,
                                                       GstRTSPMessage *message,
                                                       guint *id);
+GstRTSPResult      gst_rtsp_watch_send_data          (GstRTSPWatch *watch,
+                                                      guint8 channel,
+                                                      GstBuffer *buffer,
+                                                      guint *id);
+GstRTSPResult      gst_rtsp_watch_send_data_list     (GstRTSPWatch *watch,
+                                                      guint8 channel,
+                                                      GstBufferList *list,
+                                                      guint *id);
 GstRTSPResult      gst_rtsp_watch_wait_backlog       (GstRTSPWatch * watch,
                                                       GTimeVal *timeout);
 
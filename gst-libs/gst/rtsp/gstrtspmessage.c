@@ -54,14 +54,177 @@
 
 #include <gst/gstutils.h>
 #include "gstrtspmessage.h"
+#include "gstrtspmessageprivate.h"
 
 typedef struct _RTSPKeyValue
 {
   GstRTSPHeaderField field;
   gchar *value;
   gchar *custom_key;            /* custom header string (field is INVALID then) */
+  gboolean free_value;          /* value was not allocated from the arena */
 } RTSPKeyValue;
 
+/* the size of the arena blocks for the header values and custom names */
+#define ARENA_BLOCK_SIZE 1024
+
+typedef struct _RTSPArenaBlock RTSPArenaBlock;
+struct _RTSPArenaBlock
+{
+  RTSPArenaBlock *next;
+};
+
+/* Lookup table and string storage for the headers of a message, stored in
+ * the first reserved field of the message.
+ *
+ * @index contains the position + 1 in hdr_fields of the first header of
+ * each field, or 0 when there is none. Headers are appended far more often
+ * than they are removed, so the index is rebuilt after removals. Header
+ * values and custom names are copied into an arena that is freed together
+ * with the message. */
+typedef struct
+{
+  guint16 index[GST_RTSP_HDR_LAST];
+  gboolean index_overflow;
+
+  RTSPArenaBlock *blocks;
+  gchar *arena;
+  gsize arena_left;
+  gchar first_block[512];
+} RTSPHeaderTable;
+
+#define HEADER_TABLE(msg) ((RTSPHeaderTable *) (msg)->_gst_reserved[0])
+
+static void
+init_headers (GstRTSPMessage * msg)
+{
+  RTSPHeaderTable *table;
+
+  msg->hdr_fields =
+      g_array_sized_new (FALSE, FALSE, sizeof (RTSPKeyValue), 16);
+
+  table = g_new (RTSPHeaderTable, 1);
+  memset (table->index, 0, sizeof (table->index));
+  table->index_overflow = FALSE;
+  table->blocks = NULL;
+  table->arena = table->first_block;
+  table->arena_left = sizeof (table->first_block);
+  msg->_gst_reserved[0] = table;
+}
+
+static void
+free_headers (GstRTSPMessage * msg)
+{
+  RTSPHeaderTable *table = HEADER_TABLE (msg);
+
+  if (msg->hdr_fields != NULL) {
+    guint i;
+
+    for (i = 0; i < msg->hdr_fields->len; i++) {
+      RTSPKeyValue *keyval = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
+
+      if (keyval->free_value)
+        g_free (keyval->value);
+    }
+    g_array_free (msg->hdr_fields, TRUE);
+  }
+
+  if (table != NULL) {
+    while (table->blocks) {
+      RTSPArenaBlock *next = table->blocks->next;
+
+      g_free (table->blocks);
+      table->blocks = next;
+    }
+    g_free (table);
+  }
+}
+
+/* copy @str into the arena of @msg */
+static gchar *
+header_strdup (GstRTSPMessage * msg, const gchar * str)
+{
+  RTSPHeaderTable *table = HEADER_TABLE (msg);
+  gsize len = strlen (str) + 1;
+  gchar *res;
+
+  if (G_UNLIKELY (len > table->arena_left)) {
+    RTSPArenaBlock *block;
+    gsize size = MAX (ARENA_BLOCK_SIZE, len);
+
+    block = g_malloc (sizeof (RTSPArenaBlock) + size);
+    block->next = table->blocks;
+    table->blocks = block;
+    table->arena = (gchar *) (block + 1);
+    table->arena_left = size;
+  }
+
+  res = table->arena;
+  memcpy (res, str, len);
+  table->arena += len;
+  table->arena_left -= len;
+
+  return res;
+}
+
+static void
+append_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
+    gchar * value, gchar * custom_key, gboolean free_value)
+{
+  RTSPHeaderTable *table = HEADER_TABLE (msg);
+  RTSPKeyValue key_value;
+  guint pos = msg->hdr_fields->len;
+
+  key_value.field = field;
+  key_value.value = value;
+  key_value.custom_key = custom_key;
+  key_value.free_value = free_value;
+
+  g_array_append_val (msg->hdr_fields, key_value);
+
+  if ((guint) field < GST_RTSP_HDR_LAST && table->index[field] == 0) {
+    if (G_LIKELY (pos < G_MAXUINT16))
+      table->index[field] = pos + 1;
+    else
+      table->index_overflow = TRUE;
+  }
+}
+
+static void
+rebuild_index (GstRTSPMessage * msg)
+{
+  RTSPHeaderTable *table = HEADER_TABLE (msg);
+  guint i;
+
+  memset (table->index, 0, sizeof (table->index));
+  table->index_overflow = FALSE;
+
+  for (i = msg->hdr_fields->len; i > 0; i--) {
+    RTSPKeyValue *key_value =
+        &g_array_index (msg->hdr_fields, RTSPKeyValue, i - 1);
+
+    if ((guint) key_value->field >= GST_RTSP_HDR_LAST)
+      continue;
+
+    if (G_LIKELY (i <= G_MAXUINT16))
+      table->index[key_value->field] = i;
+    else
+      table->index_overflow = TRUE;
+  }
+}
+
+/* returns the position in hdr_fields where the search for headers with
+ * @field has to start, or -1 when there are no such headers */
+static gint
+find_first_header (const GstRTSPMessage * msg, GstRTSPHeaderField field)
+{
+  RTSPHeaderTable *table = HEADER_TABLE (msg);
+
+  if ((guint) field >= GST_RTSP_HDR_LAST || table->index_overflow)
+    return 0;
+
+  return (gint) table->index[field] - 1;
+}
+
 static void
 key_value_foreach (GArray * array, GFunc func, gpointer user_data)
 {
@@ -113,7 +276,7 @@ gst_rtsp_message_init (GstRTSPMessage * msg)
   gst_rtsp_message_unset (msg);
 
   msg->type = GST_RTSP_MESSAGE_INVALID;
-  msg->hdr_fields = g_array_new (FALSE, FALSE, sizeof (RTSPKeyValue));
+  init_headers (msg);
 
   return GST_RTSP_OK;
 }
@@ -185,7 +348,7 @@ gst_rtsp_message_init_request (GstRTSPMessage * msg, GstRTSPMethod method,
   msg->type_data.request.method = method;
   msg->type_data.request.uri = g_strdup (uri);
   msg->type_data.request.version = GST_RTSP_VERSION_1_0;
-  msg->hdr_fields = g_array_new (FALSE, FALSE, sizeof (RTSPKeyValue));
+  init_headers (msg);
 
   return GST_RTSP_OK;
 }
@@ -286,7 +449,7 @@ gst_rtsp_message_init_response (GstRTSPMessage * msg, GstRTSPStatusCode code,
   msg->type_data.response.code = code;
   msg->type_data.response.reason = g_strdup (reason);
   msg->type_data.response.version = GST_RTSP_VERSION_1_0;
-  msg->hdr_fields = g_array_new (FALSE, FALSE, sizeof (RTSPKeyValue));
+  init_headers (msg);
 
   if (request) {
     if (request->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
@@ -457,17 +620,7 @@ gst_rtsp_message_unset (GstRTSPMessage * msg)
       g_return_val_if_reached (GST_RTSP_EINVAL);
   }
 
-  if (msg->hdr_fields != NULL) {
-    guint i;
-
-    for (i = 0; i < msg->hdr_fields->len; i++) {
-      RTSPKeyValue *keyval = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
-
-      g_free (keyval->value);
-      g_free (keyval->custom_key);
-    }
-    g_array_free (msg->hdr_fields, TRUE);
-  }
+  free_headers (msg);
   g_free (msg->body);
 
   memset (msg, 0, sizeof (GstRTSPMessage));
@@ -512,16 +665,11 @@ GstRTSPResult
 gst_rtsp_message_take_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
     gchar * value)
 {
-  RTSPKeyValue key_value;
-
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (msg->hdr_fields != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (value != NULL, GST_RTSP_EINVAL);
 
-  key_value.field = field;
-  key_value.value = value;
-  key_value.custom_key = NULL;
-
-  g_array_append_val (msg->hdr_fields, key_value);
+  append_header (msg, field, value, NULL, TRUE);
 
   return GST_RTSP_OK;
 }
@@ -541,7 +689,13 @@ GstRTSPResult
 gst_rtsp_message_add_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
     const gchar * value)
 {
-  return gst_rtsp_message_take_header (msg, field, g_strdup (value));
+  g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (msg->hdr_fields != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (value != NULL, GST_RTSP_EINVAL);
+
+  append_header (msg, field, header_strdup (msg, value), NULL, FALSE);
+
+  return GST_RTSP_OK;
 }
 
 /**
@@ -560,16 +714,20 @@ gst_rtsp_message_remove_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
     gint indx)
 {
   GstRTSPResult res = GST_RTSP_ENOTIMPL;
-  guint i = 0;
+  gint i;
   gint cnt = 0;
 
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
 
-  while (i < msg->hdr_fields->len) {
+  if ((i = find_first_header (msg, field)) < 0)
+    return GST_RTSP_ENOTIMPL;
+
+  while (i < (gint) msg->hdr_fields->len) {
     RTSPKeyValue *key_value = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
 
     if (key_value->field == field && (indx == -1 || cnt++ == indx)) {
-      g_free (key_value->value);
+      if (key_value->free_value)
+        g_free (key_value->value);
       g_array_remove_index (msg->hdr_fields, i);
       res = GST_RTSP_OK;
       if (indx != -1)
@@ -578,6 +736,10 @@ gst_rtsp_message_remove_header (GstRTSPMessage * msg, GstRTSPHeaderField field,
       i++;
     }
   }
+
+  if (res == GST_RTSP_OK)
+    rebuild_index (msg);
+
   return res;
 }
 
@@ -598,7 +760,7 @@ GstRTSPResult
 gst_rtsp_message_get_header (const GstRTSPMessage * msg,
     GstRTSPHeaderField field, gchar ** value, gint indx)
 {
-  guint i;
+  gint i;
   gint cnt = 0;
 
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
@@ -607,7 +769,10 @@ gst_rtsp_message_get_header (const GstRTSPMessage * msg,
   if (msg->hdr_fields == NULL)
     return GST_RTSP_ENOTIMPL;
 
-  for (i = 0; i < msg->hdr_fields->len; i++) {
+  if ((i = find_first_header (msg, field)) < 0)
+    return GST_RTSP_ENOTIMPL;
+
+  for (; i < (gint) msg->hdr_fields->len; i++) {
     RTSPKeyValue *key_value = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
 
     if (key_value->field == field && cnt++ == indx) {
@@ -640,14 +805,18 @@ gst_rtsp_message_add_header_by_name (GstRTSPMessage * msg,
   GstRTSPHeaderField field;
 
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (msg->hdr_fields != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (header != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (value != NULL, GST_RTSP_EINVAL);
 
   field = gst_rtsp_find_header_field (header);
   if (field != GST_RTSP_HDR_INVALID)
-    return gst_rtsp_message_take_header (msg, field, g_strdup (value));
+    append_header (msg, field, header_strdup (msg, value), NULL, FALSE);
+  else
+    append_header (msg, GST_RTSP_HDR_INVALID, header_strdup (msg, value),
+        header_strdup (msg, header), FALSE);
 
-  return gst_rtsp_message_take_header_by_name (msg, header, g_strdup (value));
+  return GST_RTSP_OK;
 }
 
 /**
@@ -667,17 +836,13 @@ GstRTSPResult
 gst_rtsp_message_take_header_by_name (GstRTSPMessage * msg,
     const gchar * header, gchar * value)
 {
-  RTSPKeyValue key_value;
-
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (msg->hdr_fields != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (header != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (value != NULL, GST_RTSP_EINVAL);
 
-  key_value.field = GST_RTSP_HDR_INVALID;
-  key_value.value = value;
-  key_value.custom_key = g_strdup (header);
-
-  g_array_append_val (msg->hdr_fields, key_value);
+  append_header (msg, GST_RTSP_HDR_INVALID, value, header_strdup (msg, header),
+      TRUE);
 
   return GST_RTSP_OK;
 }
@@ -689,14 +854,17 @@ gst_rtsp_message_find_header_by_name (GstRTSPMessage * msg,
 {
   GstRTSPHeaderField field;
   gint cnt = 0;
-  guint i;
+  gint i;
 
   /* no header initialized, there are no headers */
   if (msg->hdr_fields == NULL)
     return -1;
 
   field = gst_rtsp_find_header_field (header);
-  for (i = 0; i < msg->hdr_fields->len; i++) {
+  if ((i = find_first_header (msg, field)) < 0)
+    return -1;
+
+  for (; i < (gint) msg->hdr_fields->len; i++) {
     RTSPKeyValue *key_val;
 
     key_val = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
@@ -746,9 +914,10 @@ gst_rtsp_message_remove_header_by_name (GstRTSPMessage * msg,
       break;
 
     kv = &g_array_index (msg->hdr_fields, RTSPKeyValue, pos);
-    g_free (kv->value);
-    g_free (kv->custom_key);
+    if (kv->free_value)
+      g_free (kv->value);
     g_array_remove_index (msg->hdr_fields, pos);
+    rebuild_index (msg);
     res = GST_RTSP_OK;
   } while (index < 0);
 
@@ -806,14 +975,21 @@ gst_rtsp_message_get_header_by_name (GstRTSPMessage * msg,
 GstRTSPResult
 gst_rtsp_message_append_headers (const GstRTSPMessage * msg, GString * str)
 {
+  gchar *p;
   guint i;
 
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (str != NULL, GST_RTSP_EINVAL);
 
+  /* grow @str once and copy the headers in */
+  i = str->len;
+  g_string_set_size (str, i + __gst_rtsp_message_get_headers_size (msg));
+  p = str->str + i;
+
   for (i = 0; i < msg->hdr_fields->len; i++) {
     RTSPKeyValue *key_value;
     const gchar *keystr;
+    gsize len;
 
     key_value = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
 
@@ -822,11 +998,47 @@ gst_rtsp_message_append_headers (const GstRTSPMessage * msg, GString * str)
     else
       keystr = gst_rtsp_header_as_text (key_value->field);
 
-    g_string_append_printf (str, "%s: %s\r\n", keystr, key_value->value);
+    len = strlen (keystr);
+    memcpy (p, keystr, len);
+    p += len;
+    *p++ = ':';
+    *p++ = ' ';
+    len = strlen (key_value->value);
+    memcpy (p, key_value->value, len);
+    p += len;
+    *p++ = '\r';
+    *p++ = '\n';
   }
   return GST_RTSP_OK;
 }
 
+/* the amount of bytes gst_rtsp_message_append_headers() appends */
+gsize
+__gst_rtsp_message_get_headers_size (const GstRTSPMessage * msg)
+{
+  gsize size = 0;
+  guint i;
+
+  if (msg->hdr_fields == NULL)
+    return 0;
+
+  for (i = 0; i < msg->hdr_fields->len; i++) {
+    RTSPKeyValue *key_value;
+    const gchar *keystr;
+
+    key_value = &g_array_index (msg->hdr_fields, RTSPKeyValue, i);
+
+    if (key_value->custom_key != NULL)
+      keystr = key_value->custom_key;
+    else
+      keystr = gst_rtsp_header_as_text (key_value->field);
+
+    /* "key: value\r\n" */
+    size += strlen (keystr) + strlen (key_value->value) + 4;
+  }
+  return size;
+}
+
 /**
  * gst_rtsp_message_set_body:
  * @msg: a #GstRTSPMessage
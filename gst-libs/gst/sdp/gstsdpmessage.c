@@ -446,6 +446,135 @@ gst_sdp_address_is_multicast (const gchar * nettype, const gchar * addrtype,
   return ret;
 }
 
+/* room for the type, the separators, the numbers and the line end of one
+ * line of SDP text */
+#define LINE_SIZE 32
+#define STR_SIZE(str) ((str) ? strlen (str) : 0)
+
+static gsize
+sdp_attributes_text_size (const GArray * attributes)
+{
+  gsize size = 0;
+  guint i;
+
+  for (i = 0; i < attributes->len; i++) {
+    const GstSDPAttribute *attr =
+        &g_array_index (attributes, GstSDPAttribute, i);
+
+    size += LINE_SIZE + STR_SIZE (attr->key) + STR_SIZE (attr->value);
+  }
+  return size;
+}
+
+/* an upper bound for the size of the text of @media */
+static gsize
+sdp_media_text_size (const GstSDPMedia * media)
+{
+  gsize size;
+  guint i;
+
+  size = LINE_SIZE + STR_SIZE (media->media) + STR_SIZE (media->proto);
+  for (i = 0; i < media->fmts->len; i++)
+    size += 1 + STR_SIZE (g_array_index (media->fmts, gchar *, i));
+
+  size += LINE_SIZE + STR_SIZE (media->information);
+
+  for (i = 0; i < media->connections->len; i++) {
+    const GstSDPConnection *conn =
+        &g_array_index (media->connections, GstSDPConnection, i);
+
+    size += LINE_SIZE + STR_SIZE (conn->nettype) + STR_SIZE (conn->addrtype) +
+        STR_SIZE (conn->address);
+  }
+
+  for (i = 0; i < media->bandwidths->len; i++)
+    size += LINE_SIZE + STR_SIZE (g_array_index (media->bandwidths,
+            GstSDPBandwidth, i).bwtype);
+
+  size += LINE_SIZE + STR_SIZE (media->key.type) + STR_SIZE (media->key.data);
+  size += sdp_attributes_text_size (media->attributes);
+
+  return size;
+}
+
+static void
+sdp_media_append_text (GString * lines, const GstSDPMedia * media)
+{
+  guint i;
+
+  if (media->media) {
+    g_string_append (lines, "m=");
+    g_string_append (lines, media->media);
+  }
+
+  g_string_append_printf (lines, " %u", media->port);
+
+  if (media->num_ports > 1)
+    g_string_append_printf (lines, "/%u", media->num_ports);
+
+  g_string_append_printf (lines, " %s", media->proto);
+
+  for (i = 0; i < gst_sdp_media_formats_len (media); i++) {
+    g_string_append_c (lines, ' ');
+    g_string_append (lines, gst_sdp_media_get_format (media, i));
+  }
+  g_string_append (lines, "\r\n");
+
+  if (media->information) {
+    g_string_append (lines, "i=");
+    g_string_append (lines, media->information);
+  }
+
+  for (i = 0; i < gst_sdp_media_connections_len (media); i++) {
+    const GstSDPConnection *conn = gst_sdp_media_get_connection (media, i);
+
+    if (conn->nettype && conn->addrtype && conn->address) {
+      g_string_append_printf (lines, "c=%s %s %s", conn->nettype,
+          conn->addrtype, conn->address);
+      if (gst_sdp_address_is_multicast (conn->nettype, conn->addrtype,
+              conn->address)) {
+        /* only add TTL for IP4 multicast */
+        if (strcmp (conn->addrtype, "IP4") == 0)
+          g_string_append_printf (lines, "/%u", conn->ttl);
+        if (conn->addr_number > 1)
+          g_string_append_printf (lines, "/%u", conn->addr_number);
+      }
+      g_string_append (lines, "\r\n");
+    }
+  }
+
+  for (i = 0; i < gst_sdp_media_bandwidths_len (media); i++) {
+    const GstSDPBandwidth *bandwidth = gst_sdp_media_get_bandwidth (media, i);
+
+    g_string_append_printf (lines, "b=%s:%u\r\n", bandwidth->bwtype,
+        bandwidth->bandwidth);
+  }
+
+  if (media->key.type) {
+    g_string_append (lines, "k=");
+    g_string_append (lines, media->key.type);
+    if (media->key.data) {
+      g_string_append_c (lines, ':');
+      g_string_append (lines, media->key.data);
+    }
+    g_string_append (lines, "\r\n");
+  }
+
+  for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
+    const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
+
+    if (attr->key) {
+      g_string_append (lines, "a=");
+      g_string_append (lines, attr->key);
+      if (attr->value && attr->value[0] != '\0') {
+        g_string_append_c (lines, ':');
+        g_string_append (lines, attr->value);
+      }
+      g_string_append (lines, "\r\n");
+    }
+  }
+}
+
 /**
  * gst_sdp_message_as_text:
  * @msg: a #GstSDPMessage
@@ -459,14 +588,55 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
 {
   /* change all vars so they match rfc? */
   GString *lines;
+  gsize size;
   guint i;
 
   g_return_val_if_fail (msg != NULL, NULL);
 
-  lines = g_string_new ("");
+  /* find the size of the text first so that it is written without
+   * reallocations */
+  size = 10 * LINE_SIZE + STR_SIZE (msg->version) +
+      STR_SIZE (msg->origin.username) + STR_SIZE (msg->origin.sess_id) +
+      STR_SIZE (msg->origin.sess_version) + STR_SIZE (msg->origin.nettype) +
+      STR_SIZE (msg->origin.addrtype) + STR_SIZE (msg->origin.addr) +
+      STR_SIZE (msg->session_name) + STR_SIZE (msg->information) +
+      STR_SIZE (msg->uri) + STR_SIZE (msg->connection.nettype) +
+      STR_SIZE (msg->connection.addrtype) + STR_SIZE (msg->connection.address) +
+      STR_SIZE (msg->key.type) + STR_SIZE (msg->key.data);
+  for (i = 0; i < msg->emails->len; i++)
+    size += LINE_SIZE + STR_SIZE (g_array_index (msg->emails, gchar *, i));
+  for (i = 0; i < msg->phones->len; i++)
+    size += LINE_SIZE + STR_SIZE (g_array_index (msg->phones, gchar *, i));
+  for (i = 0; i < msg->bandwidths->len; i++)
+    size += LINE_SIZE + STR_SIZE (g_array_index (msg->bandwidths,
+            GstSDPBandwidth, i).bwtype);
+  for (i = 0; i < msg->times->len; i++) {
+    const GstSDPTime *times = &g_array_index (msg->times, GstSDPTime, i);
+
+    size += 2 * LINE_SIZE + STR_SIZE (times->start) + STR_SIZE (times->stop);
+    if (times->repeat != NULL) {
+      guint j;
 
-  if (msg->version)
-    g_string_append_printf (lines, "v=%s\r\n", msg->version);
+      for (j = 0; j < times->repeat->len; j++)
+        size += 1 + STR_SIZE (g_array_index (times->repeat, gchar *, j));
+    }
+  }
+  for (i = 0; i < msg->zones->len; i++) {
+    const GstSDPZone *zone = &g_array_index (msg->zones, GstSDPZone, i);
+
+    size += 2 + STR_SIZE (zone->time) + STR_SIZE (zone->typed_time);
+  }
+  size += sdp_attributes_text_size (msg->attributes);
+  for (i = 0; i < msg->medias->len; i++)
+    size += sdp_media_text_size (&g_array_index (msg->medias, GstSDPMedia, i));
+
+  lines = g_string_sized_new (size);
+
+  if (msg->version) {
+    g_string_append (lines, "v=");
+    g_string_append (lines, msg->version);
+    g_string_append (lines, "\r\n");
+  }
 
   if (msg->origin.sess_id && msg->origin.sess_version && msg->origin.nettype &&
       msg->origin.addrtype && msg->origin.addr)
@@ -475,22 +645,35 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
         msg->origin.sess_version, msg->origin.nettype, msg->origin.addrtype,
         msg->origin.addr);
 
-  if (msg->session_name)
-    g_string_append_printf (lines, "s=%s\r\n", msg->session_name);
+  if (msg->session_name) {
+    g_string_append (lines, "s=");
+    g_string_append (lines, msg->session_name);
+    g_string_append (lines, "\r\n");
+  }
 
-  if (msg->information)
-    g_string_append_printf (lines, "i=%s\r\n", msg->information);
+  if (msg->information) {
+    g_string_append (lines, "i=");
+    g_string_append (lines, msg->information);
+    g_string_append (lines, "\r\n");
+  }
 
-  if (msg->uri)
-    g_string_append_printf (lines, "u=%s\r\n", msg->uri);
+  if (msg->uri) {
+    g_string_append (lines, "u=");
+    g_string_append (lines, msg->uri);
+    g_string_append (lines, "\r\n");
+  }
 
-  for (i = 0; i < gst_sdp_message_emails_len (msg); i++)
-    g_string_append_printf (lines, "e=%s\r\n",
-        gst_sdp_message_get_email (msg, i));
+  for (i = 0; i < gst_sdp_message_emails_len (msg); i++) {
+    g_string_append (lines, "e=");
+    g_string_append (lines, gst_sdp_message_get_email (msg, i));
+    g_string_append (lines, "\r\n");
+  }
 
-  for (i = 0; i < gst_sdp_message_phones_len (msg); i++)
-    g_string_append_printf (lines, "p=%s\r\n",
-        gst_sdp_message_get_phone (msg, i));
+  for (i = 0; i < gst_sdp_message_phones_len (msg); i++) {
+    g_string_append (lines, "p=");
+    g_string_append (lines, gst_sdp_message_get_phone (msg, i));
+    g_string_append (lines, "\r\n");
+  }
 
   if (msg->connection.nettype && msg->connection.addrtype &&
       msg->connection.address) {
@@ -504,7 +687,7 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
       if (msg->connection.addr_number > 1)
         g_string_append_printf (lines, "/%u", msg->connection.addr_number);
     }
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "\r\n");
   }
 
   for (i = 0; i < gst_sdp_message_bandwidths_len (msg); i++) {
@@ -515,7 +698,7 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
   }
 
   if (gst_sdp_message_times_len (msg) == 0) {
-    g_string_append_printf (lines, "t=0 0\r\n");
+    g_string_append (lines, "t=0 0\r\n");
   } else {
     for (i = 0; i < gst_sdp_message_times_len (msg); i++) {
       const GstSDPTime *times = gst_sdp_message_get_time (msg, i);
@@ -530,7 +713,7 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
         for (j = 1; j < times->repeat->len; j++)
           g_string_append_printf (lines, " %s",
               g_array_index (times->repeat, gchar *, j));
-        g_string_append_printf (lines, "\r\n");
+        g_string_append (lines, "\r\n");
       }
     }
   }
@@ -543,35 +726,36 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
       zone = gst_sdp_message_get_zone (msg, i);
       g_string_append_printf (lines, " %s %s", zone->time, zone->typed_time);
     }
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "\r\n");
   }
 
   if (msg->key.type) {
-    g_string_append_printf (lines, "k=%s", msg->key.type);
-    if (msg->key.data)
-      g_string_append_printf (lines, ":%s", msg->key.data);
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "k=");
+    g_string_append (lines, msg->key.type);
+    if (msg->key.data) {
+      g_string_append_c (lines, ':');
+      g_string_append (lines, msg->key.data);
+    }
+    g_string_append (lines, "\r\n");
   }
 
   for (i = 0; i < gst_sdp_message_attributes_len (msg); i++) {
     const GstSDPAttribute *attr = gst_sdp_message_get_attribute (msg, i);
 
     if (attr->key) {
-      g_string_append_printf (lines, "a=%s", attr->key);
-      if (attr->value)
-        g_string_append_printf (lines, ":%s", attr->value);
-      g_string_append_printf (lines, "\r\n");
+      g_string_append (lines, "a=");
+      g_string_append (lines, attr->key);
+      if (attr->value) {
+        g_string_append_c (lines, ':');
+        g_string_append (lines, attr->value);
+      }
+      g_string_append (lines, "\r\n");
     }
   }
 
-  for (i = 0; i < gst_sdp_message_medias_len (msg); i++) {
-    const GstSDPMedia *media = gst_sdp_message_get_media (msg, i);
-    gchar *sdp_media_str;
-
-    sdp_media_str = gst_sdp_media_as_text (media);
-    g_string_append_printf (lines, "%s", sdp_media_str);
-    g_free (sdp_media_str);
-  }
+  /* write the medias into the same string */
+  for (i = 0; i < gst_sdp_message_medias_len (msg); i++)
+    sdp_media_append_text (lines, gst_sdp_message_get_media (msg, i));
 
   return g_string_free (lines, FALSE);
 }
@@ -1891,71 +2075,11 @@ gchar *
 gst_sdp_media_as_text (const GstSDPMedia * media)
 {
   GString *lines;
-  guint i;
 
   g_return_val_if_fail (media != NULL, NULL);
 
-  lines = g_string_new ("");
-
-  if (media->media)
-    g_string_append_printf (lines, "m=%s", media->media);
-
-  g_string_append_printf (lines, " %u", media->port);
-
-  if (media->num_ports > 1)
-    g_string_append_printf (lines, "/%u", media->num_ports);
-
-  g_string_append_printf (lines, " %s", media->proto);
-
-  for (i = 0; i < gst_sdp_media_formats_len (media); i++)
-    g_string_append_printf (lines, " %s", gst_sdp_media_get_format (media, i));
-  g_string_append_printf (lines, "\r\n");
-
-  if (media->information)
-    g_string_append_printf (lines, "i=%s", media->information);
-
-  for (i = 0; i < gst_sdp_media_connections_len (media); i++) {
-    const GstSDPConnection *conn = gst_sdp_media_get_connection (media, i);
-
-    if (conn->nettype && conn->addrtype && conn->address) {
-      g_string_append_printf (lines, "c=%s %s %s", conn->nettype,
-          conn->addrtype, conn->address);
-      if (gst_sdp_address_is_multicast (conn->nettype, conn->addrtype,
-              conn->address)) {
-        /* only add TTL for IP4 multicast */
-        if (strcmp (conn->addrtype, "IP4") == 0)
-          g_string_append_printf (lines, "/%u", conn->ttl);
-        if (conn->addr_number > 1)
-          g_string_append_printf (lines, "/%u", conn->addr_number);
-      }
-      g_string_append_printf (lines, "\r\n");
-    }
-  }
-
-  for (i = 0; i < gst_sdp_media_bandwidths_len (media); i++) {
-    const GstSDPBandwidth *bandwidth = gst_sdp_media_get_bandwidth (media, i);
-
-    g_string_append_printf (lines, "b=%s:%u\r\n", bandwidth->bwtype,
-        bandwidth->bandwidth);
-  }
-
-  if (media->key.type) {
-    g_string_append_printf (lines, "k=%s", media->key.type);
-    if (media->key.data)
-      g_string_append_printf (lines, ":%s", media->key.data);
-    g_string_append_printf (lines, "\r\n");
-  }
-
-  for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
-    const GstSDPAttribute *attr = gst_sdp_media_get_attribute (media, i);
-
-    if (attr->key) {
-      g_string_append_printf (lines, "a=%s", attr->key);
-      if (attr->value && attr->value[0] != '\0')
-        g_string_append_printf (lines, ":%s", attr->value);
-      g_string_append_printf (lines, "\r\n");
-    }
-  }
+  lines = g_string_sized_new (sdp_media_text_size (media));
+  sdp_media_append_text (lines, media);
 
   return g_string_free (lines, FALSE);
 }
@@ -2758,6 +2882,24 @@ read_string (gchar * dest, guint size, gchar ** src)
     dest[idx] = '\0';
 }
 
+/* like read_string() but copies the string straight from @src into a newly
+ * allocated string */
+static gchar *
+read_string_dup (gchar ** src)
+{
+  gchar *start;
+
+  /* skip spaces */
+  while (g_ascii_isspace (**src))
+    (*src)++;
+
+  start = *src;
+  while (!g_ascii_isspace (**src) && **src != '\0')
+    (*src)++;
+
+  return g_strndup (start, *src - start);
+}
+
 static void
 read_string_del (gchar * dest, guint size, gchar del, gchar ** src)
 {
@@ -2797,7 +2939,7 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
   gchar *p = buffer;
 
 #define READ_STRING(field) \
-  do { read_string (str, sizeof (str), &p); REPLACE_STRING (field, str); } while (0)
+  do { FREE_STRING (field); (field) = read_string_dup (&p); } while (0)
 #define READ_UINT(field) \
   do { read_string (str, sizeof (str), &p); field = strtoul (str, NULL, 10); } while (0)
 
@@ -2919,8 +3061,9 @@ gst_sdp_parse_line (SDPContext * c, gchar type, gchar * buffer)
       }
       READ_STRING (nmedia.proto);
       do {
-        read_string (str, sizeof (str), &p);
-        gst_sdp_media_add_format (&nmedia, str);
+        gchar *fmt = read_string_dup (&p);
+
+        g_array_append_val (nmedia.fmts, fmt);
       } while (*p != '\0');
 
       gst_sdp_message_add_media (c->msg, &nmedia);
@@ -36,6 +36,42 @@ GstCaps *__gst_video_element_proxy_getcaps (GstElement * element, GstPad * sinkp
                                             GstPad * srcpad, GstCaps * initial_caps,
                                             GstCaps * filter);
 
+/* Blending utility functions */
+typedef struct {
+  gint refcount;
+
+  gint width, height;
+  gboolean dest_rgb;
+  gboolean premultiplied_alpha;
+
+  /* unpacked pixels, converted for the destination */
+  guint8 *pixels;
+
+  /* the runs of non-transparent pixels of line n are the [start, end)
+   * pairs in runs from lines[n] to lines[n + 1] */
+  gint *lines;
+  gint *runs;
+
+  /* free for the user */
+  guint seq_num;
+} GstVideoBlendCache;
+
+G_GNUC_INTERNAL
+GstVideoBlendCache * __gst_video_blend_cache_new  (GstVideoFrame * src,
+                                                   gboolean dest_rgb);
+
+G_GNUC_INTERNAL
+GstVideoBlendCache * __gst_video_blend_cache_ref  (GstVideoBlendCache * cache);
+
+G_GNUC_INTERNAL
+void                 __gst_video_blend_cache_unref (GstVideoBlendCache * cache);
+
+G_GNUC_INTERNAL
+gboolean             __gst_video_blend_cached     (GstVideoFrame * dest,
+                                                   GstVideoBlendCache * cache,
+                                                   gint x, gint y,
+                                                   gfloat global_alpha);
+
 G_END_DECLS
 
 #endif
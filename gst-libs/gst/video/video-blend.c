@@ -29,6 +29,7 @@
 
 #include "video-blend.h"
 #include "video-orc.h"
+#include "gstvideoutilsprivate.h"
 
 #include <string.h>
 
@@ -272,6 +273,132 @@ G_STMT_START { \
   cb = MIN(c, 255); \
 } G_STMT_END
 
+typedef void (*MatrixFunc) (guint8 * tmpline, guint width);
+
+/* picks the conversion of the overlay pixels to the color space of the
+ * destination, @src_premultiplied_alpha is updated when the conversion
+ * undoes the premultiplication */
+static MatrixFunc
+get_matrix (gboolean src_rgb, gboolean dest_rgb,
+    gboolean * src_premultiplied_alpha)
+{
+  if (src_rgb == dest_rgb)
+    return matrix_identity;
+
+  if (!src_rgb)
+    return matrix_yuv_to_rgb;
+
+  if (*src_premultiplied_alpha) {
+    *src_premultiplied_alpha = FALSE;
+    return matrix_prea_rgb_to_yuv;
+  }
+  return matrix_rgb_to_yuv;
+}
+
+/* blends @width unpacked pixels of @srcline over @destline */
+static void
+blend_line (guint8 * destline, const guint8 * srcline, gint width,
+    gboolean src_premultiplied_alpha, gboolean dest_premultiplied_alpha,
+    gfloat global_alpha)
+{
+  gint j, global_alpha_val;
+
+  global_alpha_val = 255.0 * global_alpha;
+
+#define BLENDLOOP(op, alpha_val)                                                        \
+  G_STMT_START {                                                                        \
+    for (j = 0; j < width * 4; j += 4) {                                                \
+      guint8 asrc, adst;                                                                \
+      gint final_alpha;                                                                 \
+                                                                                        \
+      asrc = srcline[j] * alpha_val / 255;                                              \
+      if (!asrc)                                                                        \
+        continue;                                                                       \
+                                                                                        \
+      adst = destline[j];                                                               \
+      final_alpha = asrc + adst * (255 - asrc) / 255;                                   \
+      destline[j] = final_alpha;                                                        \
+      if (final_alpha == 0)                                                             \
+        final_alpha = 1;                                                                \
+                                                                                        \
+      BLENDC (op, alpha_val, asrc, srcline[j + 1], adst, destline[j + 1], final_alpha); \
+      BLENDC (op, alpha_val, asrc, srcline[j + 2], adst, destline[j + 2], final_alpha); \
+      BLENDC (op, alpha_val, asrc, srcline[j + 3], adst, destline[j + 3], final_alpha); \
+    }                                                                                   \
+  } G_STMT_END
+
+  if (G_LIKELY (global_alpha == 1.0)) {
+    if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+      BLENDLOOP (OVER11, 255);
+    } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
+      BLENDLOOP (OVER01, 255);
+    } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
+      BLENDLOOP (OVER10, 255);
+    } else {
+      BLENDLOOP (OVER00, 255);
+    }
+  } else {
+    if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+      BLENDLOOP (OVER11, global_alpha_val);
+    } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
+      BLENDLOOP (OVER01, global_alpha_val);
+    } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
+      BLENDLOOP (OVER10, global_alpha_val);
+    } else {
+      BLENDLOOP (OVER00, global_alpha_val);
+    }
+  }
+
+#undef BLENDLOOP
+
+  /* FIXME
+   * #if G_BYTE_ORDER == LITTLE_ENDIAN
+   * video_orc_blend_little (destline, srcline, width);
+   * #else
+   * video_orc_blend_big (destline, srcline, width);
+   * #endif
+   */
+}
+
+/* clips the @src_width x @src_height overlay at @x, @y against the
+ * destination. Returns FALSE when nothing is visible. */
+static gboolean
+clip_overlay (gint dest_width, gint dest_height, gint * x, gint * y,
+    gint * src_xoff, gint * src_yoff, gint * src_width, gint * src_height)
+{
+  /* In case overlay is completely outside the video, dont render */
+  if (*x + *src_width <= 0 || *y + *src_height <= 0
+      || *x >= dest_width || *y >= dest_height)
+    return FALSE;
+
+  /* If we're here we know that the overlay image fully or
+   * partially overlaps with the video frame */
+
+  /* adjust src image for negative offsets */
+  *src_xoff = 0;
+  if (*x < 0) {
+    *src_xoff = -*x;
+    *src_width -= *src_xoff;
+    *x = 0;
+  }
+
+  *src_yoff = 0;
+  if (*y < 0) {
+    *src_yoff = -*y;
+    *src_height -= *src_yoff;
+    *y = 0;
+  }
+
+  /* adjust width/height to render (i.e. clip source image) if the source
+   * image extends beyond the right or bottom border of the video surface */
+  if (*x + *src_width > dest_width)
+    *src_width = dest_width - *x;
+
+  if (*y + *src_height > dest_height)
+    *src_height = dest_height - *y;
+
+  return TRUE;
+}
 
 /**
  * gst_video_blend:
@@ -288,18 +415,16 @@ gboolean
 gst_video_blend (GstVideoFrame * dest,
     GstVideoFrame * src, gint x, gint y, gfloat global_alpha)
 {
-  gint i, j, global_alpha_val, src_width, src_height, dest_width, dest_height;
+  gint i, src_width, src_height, dest_width, dest_height;
   gint src_xoff = 0, src_yoff = 0;
   guint8 *tmpdestline = NULL, *tmpsrcline = NULL;
   gboolean src_premultiplied_alpha, dest_premultiplied_alpha;
-  void (*matrix) (guint8 * tmpline, guint width);
+  MatrixFunc matrix;
   const GstVideoFormatInfo *sinfo, *dinfo, *dunpackinfo, *sunpackinfo;
 
   g_assert (dest != NULL);
   g_assert (src != NULL);
 
-  global_alpha_val = 255.0 * global_alpha;
-
   dest_premultiplied_alpha =
       GST_VIDEO_INFO_FLAGS (&dest->info) & GST_VIDEO_FLAG_PREMULTIPLIED_ALPHA;
   src_premultiplied_alpha =
@@ -316,11 +441,9 @@ gst_video_blend (GstVideoFrame * dest,
   GST_LOG ("blend src %dx%d onto dest %dx%d @ %d,%d", src_width, src_height,
       dest_width, dest_height, x, y);
 
-  /* In case overlay is completely outside the video, dont render */
-  if (x + src_width <= 0 || y + src_height <= 0
-      || x >= dest_width || y >= dest_height) {
+  if (!clip_overlay (dest_width, dest_height, &x, &y, &src_xoff, &src_yoff,
+          &src_width, &src_height))
     goto nothing_to_do;
-  }
 
   dinfo = gst_video_format_get_info (GST_VIDEO_FRAME_FORMAT (dest));
   sinfo = gst_video_format_get_info (GST_VIDEO_FRAME_FORMAT (src));
@@ -342,43 +465,8 @@ gst_video_blend (GstVideoFrame * dest,
   tmpdestline = g_malloc (sizeof (guint8) * (dest_width + 8) * 4);
   tmpsrcline = g_malloc (sizeof (guint8) * (src_width + 8) * 4);
 
-  matrix = matrix_identity;
-  if (GST_VIDEO_INFO_IS_RGB (&src->info) != GST_VIDEO_INFO_IS_RGB (&dest->info)) {
-    if (GST_VIDEO_INFO_IS_RGB (&src->info)) {
-      if (src_premultiplied_alpha) {
-        matrix = matrix_prea_rgb_to_yuv;
-        src_premultiplied_alpha = FALSE;
-      } else {
-        matrix = matrix_rgb_to_yuv;
-      }
-    } else {
-      matrix = matrix_yuv_to_rgb;
-    }
-  }
-
-  /* If we're here we know that the overlay image fully or
-   * partially overlaps with the video frame */
-
-  /* adjust src image for negative offsets */
-  if (x < 0) {
-    src_xoff = -x;
-    src_width -= src_xoff;
-    x = 0;
-  }
-
-  if (y < 0) {
-    src_yoff = -y;
-    src_height -= src_yoff;
-    y = 0;
-  }
-
-  /* adjust width/height to render (i.e. clip source image) if the source
-   * image extends beyond the right or bottom border of the video surface */
-  if (x + src_width > dest_width)
-    src_width = dest_width - x;
-
-  if (y + src_height > dest_height)
-    src_height = dest_height - y;
+  matrix = get_matrix (GST_VIDEO_INFO_IS_RGB (&src->info),
+      GST_VIDEO_INFO_IS_RGB (&dest->info), &src_premultiplied_alpha);
 
   /* Mainloop doing the needed conversions, and blending */
   for (i = y; i < y + src_height; i++, src_yoff++) {
@@ -388,67 +476,11 @@ gst_video_blend (GstVideoFrame * dest,
     sinfo->unpack_func (sinfo, 0, tmpsrcline, src->data, src->info.stride,
         src_xoff, src_yoff, src_width);
 
-    /* FIXME: use the x parameter of the unpack func once implemented */
-    tmpdestline += 4 * x;
-
     matrix (tmpsrcline, src_width);
 
-#define BLENDLOOP(op, alpha_val)                                                              \
-  G_STMT_START {                                                                              \
-    for (j = 0; j < src_width * 4; j += 4) {                                                  \
-      guint8 asrc, adst;                                                                      \
-      gint final_alpha;                                                                       \
-                                                                                              \
-      asrc = tmpsrcline[j] * alpha_val / 255;                                                 \
-      if (!asrc)                                                                              \
-        continue;                                                                             \
-                                                                                              \
-      adst = tmpdestline[j];                                                                  \
-      final_alpha = asrc + adst * (255 - asrc) / 255;                                         \
-      tmpdestline[j] = final_alpha;                                                           \
-      if (final_alpha == 0)                                                                   \
-        final_alpha = 1;                                                                      \
-                                                                                              \
-      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 1], adst, tmpdestline[j + 1], final_alpha); \
-      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 2], adst, tmpdestline[j + 2], final_alpha); \
-      BLENDC (op, alpha_val, asrc, tmpsrcline[j + 3], adst, tmpdestline[j + 3], final_alpha); \
-    }                                                                                         \
-  } G_STMT_END
-
-    if (G_LIKELY (global_alpha == 1.0)) {
-      if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER11, 255);
-      } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER01, 255);
-      } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-        BLENDLOOP (OVER10, 255);
-      } else {
-        BLENDLOOP (OVER00, 255);
-      }
-    } else {
-      if (src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER11, global_alpha_val);
-      } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
-        BLENDLOOP (OVER01, global_alpha_val);
-      } else if (src_premultiplied_alpha && !dest_premultiplied_alpha) {
-        BLENDLOOP (OVER10, global_alpha_val);
-      } else {
-        BLENDLOOP (OVER00, global_alpha_val);
-      }
-    }
-
-#undef BLENDLOOP
-
-    /* undo previous pointer adjustments to pass right pointer to g_free */
-    tmpdestline -= 4 * x;
-
-    /* FIXME
-     * #if G_BYTE_ORDER == LITTLE_ENDIAN
-     * video_orc_blend_little (tmpdestline, tmpsrcline, dest->width);
-     * #else
-     * video_orc_blend_big (tmpdestline, tmpsrcline, src->width);
-     * #endif
-     */
+    /* FIXME: use the x parameter of the unpack func once implemented */
+    blend_line (tmpdestline + 4 * x, tmpsrcline, src_width,
+        src_premultiplied_alpha, dest_premultiplied_alpha, global_alpha);
 
     dinfo->pack_func (dinfo, 0, tmpdestline, dest_width,
         dest->data, dest->info.stride, dest->info.chroma_site, i, dest_width);
@@ -477,3 +509,169 @@ nothing_to_do:
     return TRUE;
   }
 }
+
+/* Blend caches keep the overlay pixels converted to the color space of
+ * the destination, together with the runs of non-transparent pixels of
+ * each line, so that blending the same overlay again only needs to touch
+ * the destination lines and pixels that the overlay actually covers. */
+GstVideoBlendCache *
+__gst_video_blend_cache_new (GstVideoFrame * src, gboolean dest_rgb)
+{
+  GstVideoBlendCache *cache;
+  const GstVideoFormatInfo *sinfo;
+  MatrixFunc matrix;
+  GArray *runs;
+  guint8 *tmpline;
+  gint i, j, width, height;
+
+  sinfo = src->info.finfo;
+  g_return_val_if_fail (GST_VIDEO_FORMAT_INFO_BITS (gst_video_format_get_info
+          (sinfo->unpack_format)) == 8, NULL);
+
+  width = GST_VIDEO_FRAME_WIDTH (src);
+  height = GST_VIDEO_FRAME_HEIGHT (src);
+
+  cache = g_slice_new0 (GstVideoBlendCache);
+  cache->refcount = 1;
+  cache->width = width;
+  cache->height = height;
+  cache->dest_rgb = dest_rgb;
+  cache->premultiplied_alpha =
+      GST_VIDEO_INFO_FLAGS (&src->info) & GST_VIDEO_FLAG_PREMULTIPLIED_ALPHA;
+  cache->pixels = g_malloc (width * height * 4);
+  cache->lines = g_new (gint, height + 1);
+
+  matrix = get_matrix (GST_VIDEO_INFO_IS_RGB (&src->info), dest_rgb,
+      &cache->premultiplied_alpha);
+
+  tmpline = g_malloc (sizeof (guint8) * (width + 8) * 4);
+  runs = g_array_new (FALSE, FALSE, sizeof (gint));
+
+  for (i = 0; i < height; i++) {
+    guint8 *line = cache->pixels + i * width * 4;
+
+    sinfo->unpack_func (sinfo, 0, tmpline, src->data, src->info.stride, 0, i,
+        width);
+    matrix (tmpline, width);
+    memcpy (line, tmpline, width * 4);
+
+    cache->lines[i] = runs->len / 2;
+    for (j = 0; j < width; j++) {
+      gint start;
+
+      if (line[j * 4] == 0)
+        continue;
+
+      start = j;
+      while (j < width && line[j * 4] != 0)
+        j++;
+      g_array_append_val (runs, start);
+      g_array_append_val (runs, j);
+    }
+  }
+  cache->lines[height] = runs->len / 2;
+  cache->runs = (gint *) g_array_free (runs, FALSE);
+
+  g_free (tmpline);
+
+  return cache;
+}
+
+GstVideoBlendCache *
+__gst_video_blend_cache_ref (GstVideoBlendCache * cache)
+{
+  g_atomic_int_inc (&cache->refcount);
+
+  return cache;
+}
+
+void
+__gst_video_blend_cache_unref (GstVideoBlendCache * cache)
+{
+  if (!g_atomic_int_dec_and_test (&cache->refcount))
+    return;
+
+  g_free (cache->pixels);
+  g_free (cache->lines);
+  g_free (cache->runs);
+  g_slice_free (GstVideoBlendCache, cache);
+}
+
+/* like gst_video_blend() with the overlay pixels taken from @cache. The
+ * destination must be in the color space the cache was made for. */
+gboolean
+__gst_video_blend_cached (GstVideoFrame * dest, GstVideoBlendCache * cache,
+    gint x, gint y, gfloat global_alpha)
+{
+  gint i, k, src_width, src_height, dest_width, dest_height;
+  gint src_xoff, src_yoff;
+  guint8 *tmpdestline;
+  gboolean dest_premultiplied_alpha;
+  const GstVideoFormatInfo *dinfo, *dunpackinfo;
+
+  g_return_val_if_fail (cache->dest_rgb == GST_VIDEO_INFO_IS_RGB (&dest->info),
+      FALSE);
+
+  dest_premultiplied_alpha =
+      GST_VIDEO_INFO_FLAGS (&dest->info) & GST_VIDEO_FLAG_PREMULTIPLIED_ALPHA;
+
+  src_width = cache->width;
+  src_height = cache->height;
+
+  dest_width = GST_VIDEO_FRAME_WIDTH (dest);
+  dest_height = GST_VIDEO_FRAME_HEIGHT (dest);
+
+  ensure_debug_category ();
+
+  GST_LOG ("blend cached %dx%d onto dest %dx%d @ %d,%d", src_width,
+      src_height, dest_width, dest_height, x, y);
+
+  if (!clip_overlay (dest_width, dest_height, &x, &y, &src_xoff, &src_yoff,
+          &src_width, &src_height))
+    return TRUE;
+
+  dinfo = dest->info.finfo;
+  dunpackinfo = gst_video_format_get_info (dinfo->unpack_format);
+
+  if (dunpackinfo == NULL || GST_VIDEO_FORMAT_INFO_BITS (dunpackinfo) != 8) {
+    GST_FIXME ("video format %s not supported yet for blending",
+        gst_video_format_to_string (dinfo->unpack_format));
+    return FALSE;
+  }
+
+  tmpdestline = g_malloc (sizeof (guint8) * (dest_width + 8) * 4);
+
+  for (i = 0; i < src_height; i++) {
+    gint line = src_yoff + i;
+    const guint8 *srcline = cache->pixels + line * cache->width * 4;
+    gboolean unpacked = FALSE;
+
+    for (k = cache->lines[line]; k < cache->lines[line + 1]; k++) {
+      gint start = MAX (cache->runs[k * 2], src_xoff);
+      gint end = MIN (cache->runs[k * 2 + 1], src_xoff + src_width);
+
+      if (start >= end)
+        continue;
+
+      /* only touch the lines that have visible overlay pixels */
+      if (!unpacked) {
+        dinfo->unpack_func (dinfo, 0, tmpdestline, dest->data,
+            dest->info.stride, 0, y + i, dest_width);
+        unpacked = TRUE;
+      }
+
+      blend_line (tmpdestline + 4 * (x + start - src_xoff),
+          srcline + 4 * start, end - start, cache->premultiplied_alpha,
+          dest_premultiplied_alpha, global_alpha);
+    }
+
+    if (unpacked)
+      dinfo->pack_func (dinfo, 0, tmpdestline, dest_width,
+          dest->data, dest->info.stride, dest->info.chroma_site, y + i,
+          dest_width);
+  }
+
+  g_free (tmpdestline);
+
+  return TRUE;
+}
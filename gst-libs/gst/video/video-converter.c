@@ -299,6 +299,12 @@ struct _GstVideoConverter
   GstVideoScaler *fh_scaler[4];
   GstVideoScaler *fv_scaler[4];
   FastConvertFunc fconvert[4];
+  /* pyramid downscaling: number of 2x2 halving steps, the input size and
+   * scratch memory for the halved planes */
+  gint fhalve_steps[4];
+  gint fhalve_width[4];
+  gint fhalve_height[4];
+  guint8 *fhalve_data[4];
 };
 
 typedef gpointer (*GstLineCacheAllocLineFunc) (GstLineCache * cache, gint idx,
@@ -605,6 +611,7 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_RESAMPLER_METHOD GST_VIDEO_RESAMPLER_METHOD_CUBIC
 #define DEFAULT_OPT_CHROMA_RESAMPLER_METHOD GST_VIDEO_RESAMPLER_METHOD_LINEAR
 #define DEFAULT_OPT_RESAMPLER_TAPS 0
+#define DEFAULT_OPT_RESAMPLER_PYRAMID FALSE
 #define DEFAULT_OPT_DITHER_METHOD GST_VIDEO_DITHER_BAYER
 #define DEFAULT_OPT_DITHER_QUANTIZATION 1
 
@@ -632,6 +639,8 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
     DEFAULT_OPT_CHROMA_RESAMPLER_METHOD)
 #define GET_OPT_RESAMPLER_TAPS(c) get_opt_uint(c, \
     GST_VIDEO_CONVERTER_OPT_RESAMPLER_TAPS, DEFAULT_OPT_RESAMPLER_TAPS)
+#define GET_OPT_RESAMPLER_PYRAMID(c) get_opt_bool(c, \
+    GST_VIDEO_CONVERTER_OPT_RESAMPLER_PYRAMID, DEFAULT_OPT_RESAMPLER_PYRAMID)
 #define GET_OPT_DITHER_METHOD(c) get_opt_enum(c, \
     GST_VIDEO_CONVERTER_OPT_DITHER_METHOD, GST_TYPE_VIDEO_DITHER_METHOD, \
     DEFAULT_OPT_DITHER_METHOD)
@@ -2289,6 +2298,7 @@ gst_video_converter_free (GstVideoConverter * convert)
       gst_video_scaler_free (convert->fv_scaler[i]);
     if (convert->fh_scaler[i])
       gst_video_scaler_free (convert->fh_scaler[i]);
+    g_free (convert->fhalve_data[i]);
   }
   clear_matrix_data (&convert->to_RGB_matrix);
   clear_matrix_data (&convert->convert_matrix);
@@ -3691,6 +3701,272 @@ convert_I420_pack_ARGB (GstVideoConverter * convert, const GstVideoFrame * src,
 }
 #endif
 
+/* 10 bit fastpaths. 10 bit samples are kept in little endian 16 bit words
+ * like in the *_10LE formats. Reducing to 8 bits optionally uses a 2x2
+ * ordered dither, the results are the same as the generic path when the
+ * dither method is NONE. */
+static const guint8 dither_2x2[2][2] = {
+  {0, 2}, {3, 1}
+};
+
+static const guint8 dither_none[2] = { 0, 0 };
+
+static const guint8 *
+get_dither_10_8 (GstVideoConverter * convert, gint line)
+{
+  if (GET_OPT_DITHER_METHOD (convert) == GST_VIDEO_DITHER_NONE)
+    return dither_none;
+  return dither_2x2[line & 1];
+}
+
+/* @shift is the position of the samples in the 16 bit words and @xs the
+ * number of consecutive samples that get the same dither value */
+static void
+convert_line_u10_u8 (guint8 * d, const guint16 * s, gint n,
+    gint shift, gint xs, const guint8 * dither)
+{
+  gint i;
+
+  for (i = 0; i < n; i++) {
+    guint v = ((GUINT16_FROM_LE (s[i]) >> shift) & 0x3ff) +
+        dither[(i >> xs) & 1];
+
+    d[i] = MIN (v >> 2, 255);
+  }
+}
+
+static void
+convert_line_u8_u10 (guint16 * d, const guint8 * s, gint n,
+    gint shift)
+{
+  gint i;
+
+  for (i = 0; i < n; i++)
+    d[i] = GUINT16_TO_LE (((s[i] << 2) | (s[i] >> 6)) << shift);
+}
+
+static void
+convert_line_v210_planar (guint16 * dy, guint16 * du,
+    guint16 * dv, const guint8 * s, gint width)
+{
+  gint i, j;
+  guint16 t[12];
+
+  for (i = 0; i < width; i += 6) {
+    const guint8 *g = s + (i / 6) * 16;
+
+    for (j = 0; j < 4; j++) {
+      guint32 a = GST_READ_UINT32_LE (g + j * 4);
+
+      t[j * 3 + 0] = GUINT16_TO_LE (a & 0x3ff);
+      t[j * 3 + 1] = GUINT16_TO_LE ((a >> 10) & 0x3ff);
+      t[j * 3 + 2] = GUINT16_TO_LE ((a >> 20) & 0x3ff);
+    }
+    /* samples are ordered Cb Y Cr Y */
+    for (j = 0; j < MIN (6, width - i); j++) {
+      dy[i + j] = t[j * 2 + 1];
+      if ((j & 1) == 0) {
+        du[(i + j) / 2] = t[j * 2];
+        dv[(i + j) / 2] = t[j * 2 + 2];
+      }
+    }
+  }
+}
+
+static void
+convert_line_planar_v210 (guint8 * d, const guint16 * sy,
+    const guint16 * su, const guint16 * sv, gint width)
+{
+  gint i, j, n;
+  guint16 t[12];
+
+  for (i = 0; i < width; i += 6) {
+    guint8 *g = d + (i / 6) * 16;
+
+    /* a partial last group repeats the last pixels like pack_v210 */
+    n = MIN (6, width - i);
+    for (j = 0; j < 6; j++) {
+      gint x = i + MIN (j, n - 1);
+
+      t[j * 2 + 1] = GUINT16_FROM_LE (sy[x]) & 0x3ff;
+      if ((j & 1) == 0) {
+        t[j * 2] = GUINT16_FROM_LE (su[x / 2]) & 0x3ff;
+        t[j * 2 + 2] = GUINT16_FROM_LE (sv[x / 2]) & 0x3ff;
+      }
+    }
+    for (j = 0; j < 4; j++)
+      GST_WRITE_UINT32_LE (g + j * 4, t[j * 3] | (t[j * 3 + 1] << 10) |
+          (t[j * 3 + 2] << 20));
+  }
+}
+
+static void
+convert_v210_I422_10LE (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  gint i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++) {
+    convert_line_v210_planar (FRAME_GET_Y_LINE (dest, i),
+        FRAME_GET_U_LINE (dest, i), FRAME_GET_V_LINE (dest, i),
+        FRAME_GET_LINE (src, i), width);
+  }
+}
+
+static void
+convert_I422_10LE_v210 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  gint i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++) {
+    convert_line_planar_v210 (FRAME_GET_LINE (dest, i),
+        FRAME_GET_Y_LINE (src, i), FRAME_GET_U_LINE (src, i),
+        FRAME_GET_V_LINE (src, i), width);
+  }
+}
+
+static void
+convert_v210_UYVY (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint i, j;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gint cwidth = (width + 1) / 2;
+  guint16 *ty = convert->tmpline;
+  guint16 *tu = ty + width;
+  guint16 *tv = tu + cwidth;
+  guint8 *t8 = (guint8 *) (tv + cwidth);
+
+  for (i = 0; i < height; i++) {
+    const guint8 *dither = get_dither_10_8 (convert, i);
+    guint8 *d = FRAME_GET_LINE (dest, i);
+
+    convert_line_v210_planar (ty, tu, tv, FRAME_GET_LINE (src, i), width);
+    convert_line_u10_u8 (t8, ty, width, 0, 0, dither);
+    convert_line_u10_u8 (t8 + width, tu, 2 * cwidth, 0, 0, dither);
+
+    for (j = 0; j < cwidth; j++) {
+      d[j * 4 + 0] = t8[width + j];
+      d[j * 4 + 1] = t8[j * 2];
+      d[j * 4 + 2] = t8[width + cwidth + j];
+      if (j * 2 + 1 < width)
+        d[j * 4 + 3] = t8[j * 2 + 1];
+    }
+  }
+}
+
+static void
+convert_UYVY_v210 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint i, j;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  gint cwidth = (width + 1) / 2;
+  guint16 *ty = convert->tmpline;
+  guint16 *tu = ty + width;
+  guint16 *tv = tu + cwidth;
+  guint8 *t8 = (guint8 *) (tv + cwidth);
+
+  for (i = 0; i < height; i++) {
+    const guint8 *s = FRAME_GET_LINE (src, i);
+
+    for (j = 0; j < cwidth; j++) {
+      t8[width + j] = s[j * 4 + 0];
+      t8[j * 2] = s[j * 4 + 1];
+      t8[width + cwidth + j] = s[j * 4 + 2];
+      if (j * 2 + 1 < width)
+        t8[j * 2 + 1] = s[j * 4 + 3];
+    }
+    convert_line_u8_u10 (ty, t8, width + 2 * cwidth, 0);
+    convert_line_planar_v210 (FRAME_GET_LINE (dest, i), ty, tu, tv, width);
+  }
+}
+
+static void
+convert_P010_10LE_NV12 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  gint i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++)
+    convert_line_u10_u8 (FRAME_GET_PLANE_LINE (dest, 0, i),
+        FRAME_GET_PLANE_LINE (src, 0, i), width, 6, 0,
+        get_dither_10_8 (convert, i));
+
+  for (i = 0; i < (height + 1) / 2; i++)
+    convert_line_u10_u8 (FRAME_GET_PLANE_LINE (dest, 1, i),
+        FRAME_GET_PLANE_LINE (src, 1, i), GST_ROUND_UP_2 (width), 6, 1,
+        get_dither_10_8 (convert, i));
+}
+
+static void
+convert_NV12_P010_10LE (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  gint i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++)
+    convert_line_u8_u10 (FRAME_GET_PLANE_LINE (dest, 0, i),
+        FRAME_GET_PLANE_LINE (src, 0, i), width, 6);
+
+  for (i = 0; i < (height + 1) / 2; i++)
+    convert_line_u8_u10 (FRAME_GET_PLANE_LINE (dest, 1, i),
+        FRAME_GET_PLANE_LINE (src, 1, i), GST_ROUND_UP_2 (width), 6);
+}
+
+static void
+convert_I420_10LE_I420 (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  gint i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++)
+    convert_line_u10_u8 (FRAME_GET_Y_LINE (dest, i), FRAME_GET_Y_LINE (src, i),
+        width, 0, 0, get_dither_10_8 (convert, i));
+
+  for (i = 0; i < (height + 1) / 2; i++) {
+    const guint8 *dither = get_dither_10_8 (convert, i);
+
+    convert_line_u10_u8 (FRAME_GET_U_LINE (dest, i), FRAME_GET_U_LINE (src, i),
+        (width + 1) / 2, 0, 0, dither);
+    convert_line_u10_u8 (FRAME_GET_V_LINE (dest, i), FRAME_GET_V_LINE (src, i),
+        (width + 1) / 2, 0, 0, dither);
+  }
+}
+
+static void
+convert_I420_I420_10LE (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest)
+{
+  gint i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+
+  for (i = 0; i < height; i++)
+    convert_line_u8_u10 (FRAME_GET_Y_LINE (dest, i), FRAME_GET_Y_LINE (src, i),
+        width, 0);
+
+  for (i = 0; i < (height + 1) / 2; i++) {
+    convert_line_u8_u10 (FRAME_GET_U_LINE (dest, i), FRAME_GET_U_LINE (src, i),
+        (width + 1) / 2, 0);
+    convert_line_u8_u10 (FRAME_GET_V_LINE (dest, i), FRAME_GET_V_LINE (src, i),
+        (width + 1) / 2, 0);
+  }
+}
+
 static void
 memset_u24 (guint8 * data, guint8 col[3], unsigned int n)
 {
@@ -4001,6 +4277,44 @@ convert_plane_hv (GstVideoConverter * convert,
       d, FRAME_GET_PLANE_STRIDE (dest, plane), 0, 0, out_width, out_height);
 }
 
+/* first halve the plane a number of times with a 2x2 box filter, then
+ * scale the remaining part with the resampler */
+static void
+convert_plane_hv_pyramid (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest, gint plane)
+{
+  gint i, ss, width, height;
+  gint splane = convert->fsplane[plane];
+  guint8 *s, *d, *tmp;
+
+  s = FRAME_GET_PLANE_LINE (src, splane, convert->fin_y[splane]);
+  s += convert->fin_x[splane];
+  ss = FRAME_GET_PLANE_STRIDE (src, splane);
+
+  width = convert->fhalve_width[plane];
+  height = convert->fhalve_height[plane];
+  tmp = convert->fhalve_data[plane];
+
+  for (i = 0; i < convert->fhalve_steps[plane]; i++) {
+    width /= 2;
+    height /= 2;
+
+    video_orc_planar_chroma_444_420 (tmp, width, s, 2 * ss, s + ss, 2 * ss,
+        width, height);
+
+    s = tmp;
+    ss = width;
+    tmp += width * height;
+  }
+
+  d = FRAME_GET_PLANE_LINE (dest, plane, convert->fout_y[plane]);
+  d += convert->fout_x[plane];
+
+  gst_video_scaler_2d (convert->fh_scaler[plane], convert->fv_scaler[plane],
+      convert->fformat[plane], s, ss, d, FRAME_GET_PLANE_STRIDE (dest, plane),
+      0, 0, convert->fout_width[plane], convert->fout_height[plane]);
+}
+
 static void
 convert_scale_planes (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest)
@@ -4120,6 +4434,7 @@ setup_scale (GstVideoConverter * convert)
   int i, n_planes;
   gint method, cr_method, stride, in_width, in_height, out_width, out_height;
   guint taps;
+  gboolean pyramid;
   GstVideoInfo *in_info, *out_info;
   const GstVideoFormatInfo *in_finfo, *out_finfo;
   GstVideoFormat in_format, out_format;
@@ -4138,6 +4453,7 @@ setup_scale (GstVideoConverter * convert)
   else
     cr_method = GET_OPT_CHROMA_RESAMPLER_METHOD (convert);
   taps = GET_OPT_RESAMPLER_TAPS (convert);
+  pyramid = GET_OPT_RESAMPLER_PYRAMID (convert);
 
   in_format = GST_VIDEO_INFO_FORMAT (in_info);
   out_format = GST_VIDEO_INFO_FORMAT (out_info);
@@ -4349,6 +4665,27 @@ setup_scale (GstVideoConverter * convert)
             && resample_method == GST_VIDEO_RESAMPLER_METHOD_NEAREST) {
           convert->fconvert[i] = convert_plane_hv_double;
           GST_DEBUG ("plane %d: horizontal/vertical double", i);
+        } else if (pyramid && iw >= 4 * ow && ih >= 4 * oh && pstride == 1
+            && resample_method != GST_VIDEO_RESAMPLER_METHOD_NEAREST) {
+          gint steps = 0, size = 0;
+
+          /* halve until less than a factor of 2 is left */
+          while ((iw >> (steps + 1)) >= ow && (ih >> (steps + 1)) >= oh) {
+            steps++;
+            size += (iw >> steps) * (ih >> steps);
+          }
+          convert->fhalve_steps[i] = steps;
+          convert->fhalve_width[i] = iw;
+          convert->fhalve_height[i] = ih;
+          convert->fhalve_data[i] = g_malloc (size);
+
+          iw >>= steps;
+          ih >>= steps;
+          convert->fconvert[i] = convert_plane_hv_pyramid;
+          GST_DEBUG ("plane %d: %d halving steps, then %dx%d -> %dx%d", i,
+              steps, iw, ih, ow, oh);
+          need_v_scaler = ih != oh;
+          need_h_scaler = iw != ow;
         } else {
           convert->fconvert[i] = convert_plane_hv;
           GST_DEBUG ("plane %d: horizontal/vertical scale", i);
@@ -4806,6 +5143,24 @@ static const VideoTransform transforms[] = {
       TRUE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
   {GST_VIDEO_FORMAT_GRAY16_BE, GST_VIDEO_FORMAT_GRAY16_BE, TRUE, FALSE, FALSE,
       TRUE, TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
+
+  /* 10 bits */
+  {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_I422_10LE, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_v210_I422_10LE},
+  {GST_VIDEO_FORMAT_I422_10LE, GST_VIDEO_FORMAT_v210, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I422_10LE_v210},
+  {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_UYVY, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_v210_UYVY},
+  {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_FORMAT_v210, TRUE, FALSE, TRUE, FALSE,
+      FALSE, FALSE, FALSE, FALSE, 0, 0, convert_UYVY_v210},
+  {GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_P010_10LE_NV12},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_P010_10LE, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_P010_10LE},
+  {GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_10LE_I420},
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_I420_10LE, TRUE, FALSE, TRUE,
+      FALSE, FALSE, FALSE, FALSE, FALSE, 0, 0, convert_I420_I420_10LE},
 };
 
 static gboolean
@@ -4824,6 +5179,15 @@ video_converter_lookup_fastpath (GstVideoConverter * convert)
   if (GET_OPT_DITHER_QUANTIZATION (convert) != 1)
     return FALSE;
 
+  /* fastpaths that reduce the depth only do ordered dithering */
+  if (GST_VIDEO_FORMAT_INFO_DEPTH (convert->in_info.finfo, 0) >
+      GST_VIDEO_FORMAT_INFO_DEPTH (convert->out_info.finfo, 0)) {
+    GstVideoDitherMethod method = GET_OPT_DITHER_METHOD (convert);
+
+    if (method != GST_VIDEO_DITHER_NONE && method != GST_VIDEO_DITHER_BAYER)
+      return FALSE;
+  }
+
   /* we don't do gamma conversion in fastpath */
   in_transf = convert->in_info.colorimetry.transfer;
   out_transf = convert->out_info.colorimetry.transfer;
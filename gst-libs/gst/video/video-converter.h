@@ -48,6 +48,18 @@ G_BEGIN_DECLS
  */
 #define GST_VIDEO_CONVERTER_OPT_RESAMPLER_TAPS   "GstVideoConverter.resampler-taps"
 
+/**
+ * GST_VIDEO_CONVERTER_OPT_RESAMPLER_PYRAMID:
+ *
+ * #G_TYPE_BOOLEAN, when only scaling planar 8 bit formats down by a factor of
+ * 4 or more, first halve the planes with a cheap 2x2 box filter until less
+ * than a factor of 2 remains and let the resampler do the remaining part.
+ * Default %FALSE.
+ *
+ * Since: 1.10
+ */
+#define GST_VIDEO_CONVERTER_OPT_RESAMPLER_PYRAMID   "GstVideoConverter.resampler-pyramid"
+
 /**
  * GST_VIDEO_CONVERTER_OPT_DITHER_METHOD:
  *
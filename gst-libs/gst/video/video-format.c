@@ -86,6 +86,66 @@
 
 #define IS_ALIGNED(x,n) ((((guintptr)(x)&((n)-1))) == 0)
 
+/* The unpack functions of the 10 and 16 bit formats convert LINE_BLOCK
+ * pixels at a time through small arrays. The loops over a block have a
+ * constant trip count and no branches, so GCC vectorizes them at -O2 too,
+ * where its cost model rejects loops with an unknown trip count. The pixels
+ * after the last full block take the scalar path. Most pack functions are
+ * plain loops, blocks did not make them faster. */
+#define LINE_BLOCK 16
+
+/* interleaves a block of components into AYUV64 or ARGB64 pixels */
+static inline void
+store_block_u16 (guint16 * restrict d, const guint16 * restrict c0,
+    const guint16 * restrict c1, const guint16 * restrict c2,
+    const guint16 * restrict c3)
+{
+  gint j;
+
+  for (j = 0; j < LINE_BLOCK; j++) {
+    d[j * 4 + 0] = c0[j];
+    d[j * 4 + 1] = c1[j];
+    d[j * 4 + 2] = c2[j];
+    d[j * 4 + 3] = c3[j];
+  }
+}
+
+static inline void
+load_block_u16 (const guint16 * restrict s, guint16 * restrict c0,
+    guint16 * restrict c1, guint16 * restrict c2, guint16 * restrict c3)
+{
+  gint j;
+
+  for (j = 0; j < LINE_BLOCK; j++) {
+    c0[j] = s[j * 4 + 0];
+    c1[j] = s[j * 4 + 1];
+    c2[j] = s[j * 4 + 2];
+    c3[j] = s[j * 4 + 3];
+  }
+}
+
+/* repeats each of LINE_BLOCK / 2 chroma samples for a pixel pair */
+static inline void
+upsample_block_u16 (guint16 * restrict d, const guint16 * restrict s)
+{
+  gint j;
+
+  for (j = 0; j < LINE_BLOCK / 2; j++) {
+    d[j * 2 + 0] = s[j];
+    d[j * 2 + 1] = s[j];
+  }
+}
+
+/* expands 10 bit samples in the high bits of @c to 16 bits unless @mask is 0 */
+static inline void
+extend_block_u16 (guint16 * restrict c, gint n, guint16 mask)
+{
+  gint j;
+
+  for (j = 0; j < n; j++)
+    c[j] |= (c[j] >> 10) & mask;
+}
+
 #define PACK_420 GST_VIDEO_FORMAT_AYUV, unpack_planar_420, 1, pack_planar_420
 static void
 unpack_planar_420 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
@@ -442,95 +502,138 @@ pack_copy4 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
 }
 
 #define PACK_v210 GST_VIDEO_FORMAT_AYUV64, unpack_v210, 1, pack_v210
+/* splits @n little endian words into their three 10 bit fields, expanded to
+ * 16 bits */
+static inline void
+unpack_v210_words (const guint8 * restrict s, guint16 * restrict f0,
+    guint16 * restrict f1, guint16 * restrict f2, gint n, guint16 mask)
+{
+  gint j;
+
+  for (j = 0; j < n; j++) {
+    guint32 a = GST_READ_UINT32_LE (s + j * 4);
+
+    f0[j] = ((a >> 0) & 0x3ff) << 6;
+    f1[j] = ((a >> 10) & 0x3ff) << 6;
+    f2[j] = ((a >> 20) & 0x3ff) << 6;
+  }
+  extend_block_u16 (f0, n, mask);
+  extend_block_u16 (f1, n, mask);
+  extend_block_u16 (f2, n, mask);
+}
+
+/* stores the 6 pixels of the group whose 4 words were split into @f0, @f1
+ * and @f2, the words hold U0 Y0 V0, Y1 U2 Y2, V2 Y3 U4 and Y4 V4 Y5 */
+static inline void
+store_v210_group (guint16 * restrict d, const guint16 * restrict f0,
+    const guint16 * restrict f1, const guint16 * restrict f2)
+{
+  d[0] = 0xffff;
+  d[1] = f1[0];
+  d[2] = f0[0];
+  d[3] = f2[0];
+
+  d[4] = 0xffff;
+  d[5] = f0[1];
+  d[6] = f0[0];
+  d[7] = f2[0];
+
+  d[8] = 0xffff;
+  d[9] = f2[1];
+  d[10] = f1[1];
+  d[11] = f0[2];
+
+  d[12] = 0xffff;
+  d[13] = f1[2];
+  d[14] = f1[1];
+  d[15] = f0[2];
+
+  d[16] = 0xffff;
+  d[17] = f0[3];
+  d[18] = f2[2];
+  d[19] = f1[3];
+
+  d[20] = 0xffff;
+  d[21] = f2[3];
+  d[22] = f2[2];
+  d[23] = f1[3];
+}
+
 static void
 unpack_v210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
+  int i, g;
   const guint8 *restrict s = GET_LINE (y);
   guint16 *restrict d = dest;
-  guint32 a0, a1, a2, a3;
-  guint16 y0, y1, y2, y3, y4, y5;
-  guint16 u0, u2, u4;
-  guint16 v0, v2, v4;
+  guint16 mask;
+  guint16 f0[LINE_BLOCK], f1[LINE_BLOCK], f2[LINE_BLOCK];
+
+  mask = (flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE) ? 0 : 0xffff;
 
   /* FIXME */
   s += x * 2;
 
-  for (i = 0; i < width; i += 6) {
-    a0 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 0);
-    a1 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 4);
-    a2 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 8);
-    a3 = GST_READ_UINT32_LE (s + (i / 6) * 16 + 12);
-
-    u0 = ((a0 >> 0) & 0x3ff) << 6;
-    y0 = ((a0 >> 10) & 0x3ff) << 6;
-    v0 = ((a0 >> 20) & 0x3ff) << 6;
-    y1 = ((a1 >> 0) & 0x3ff) << 6;
-
-    u2 = ((a1 >> 10) & 0x3ff) << 6;
-    y2 = ((a1 >> 20) & 0x3ff) << 6;
-    v2 = ((a2 >> 0) & 0x3ff) << 6;
-    y3 = ((a2 >> 10) & 0x3ff) << 6;
-
-    u4 = ((a2 >> 20) & 0x3ff) << 6;
-    y4 = ((a3 >> 0) & 0x3ff) << 6;
-    v4 = ((a3 >> 10) & 0x3ff) << 6;
-    y5 = ((a3 >> 20) & 0x3ff) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      y0 |= (y0 >> 10);
-      y1 |= (y1 >> 10);
-      u0 |= (u0 >> 10);
-      v0 |= (v0 >> 10);
-
-      y2 |= (y2 >> 10);
-      y3 |= (y3 >> 10);
-      u2 |= (u2 >> 10);
-      v2 |= (v2 >> 10);
-
-      y4 |= (y4 >> 10);
-      y5 |= (y5 >> 10);
-      u4 |= (u4 >> 10);
-      v4 |= (v4 >> 10);
-    }
+  /* LINE_BLOCK words are LINE_BLOCK / 4 groups of 6 pixels */
+  for (i = 0; i + LINE_BLOCK / 4 * 6 <= width; i += LINE_BLOCK / 4 * 6) {
+    unpack_v210_words (s + (i / 6) * 16, f0, f1, f2, LINE_BLOCK, mask);
+    for (g = 0; g < LINE_BLOCK / 4; g++)
+      store_v210_group (d + 4 * (i + g * 6), f0 + g * 4, f1 + g * 4,
+          f2 + g * 4);
+  }
 
-    d[4 * (i + 0) + 0] = 0xffff;
-    d[4 * (i + 0) + 1] = y0;
-    d[4 * (i + 0) + 2] = u0;
-    d[4 * (i + 0) + 3] = v0;
+  for (; i < width - 5; i += 6) {
+    unpack_v210_words (s + (i / 6) * 16, f0, f1, f2, 4, mask);
+    store_v210_group (d + 4 * i, f0, f1, f2);
+  }
 
-    if (i < width - 1) {
-      d[4 * (i + 1) + 0] = 0xffff;
-      d[4 * (i + 1) + 1] = y1;
-      d[4 * (i + 1) + 2] = u0;
-      d[4 * (i + 1) + 3] = v0;
-    }
-    if (i < width - 2) {
-      d[4 * (i + 2) + 0] = 0xffff;
-      d[4 * (i + 2) + 1] = y2;
-      d[4 * (i + 2) + 2] = u2;
-      d[4 * (i + 2) + 3] = v2;
-    }
-    if (i < width - 3) {
-      d[4 * (i + 3) + 0] = 0xffff;
-      d[4 * (i + 3) + 1] = y3;
-      d[4 * (i + 3) + 2] = u2;
-      d[4 * (i + 3) + 3] = v2;
-    }
-    if (i < width - 4) {
-      d[4 * (i + 4) + 0] = 0xffff;
-      d[4 * (i + 4) + 1] = y4;
-      d[4 * (i + 4) + 2] = u4;
-      d[4 * (i + 4) + 3] = v4;
-    }
-    if (i < width - 5) {
-      d[4 * (i + 5) + 0] = 0xffff;
-      d[4 * (i + 5) + 1] = y5;
-      d[4 * (i + 5) + 2] = u4;
-      d[4 * (i + 5) + 3] = v4;
-    }
+  if (i < width) {
+    /* lines are padded to 48 pixels so the last group can always be read */
+    guint16 tmp[6 * 4];
+
+    unpack_v210_words (s + (i / 6) * 16, f0, f1, f2, 4, mask);
+    store_v210_group (tmp, f0, f1, f2);
+    memcpy (d + 4 * i, tmp, (width - i) * 4 * sizeof (guint16));
+  }
+}
+
+/* the inverse of store_v210_group(), the chroma of the odd pixels is
+ * dropped */
+static inline void
+load_v210_group (const guint16 * restrict s, guint16 * restrict f0,
+    guint16 * restrict f1, guint16 * restrict f2)
+{
+  f0[0] = s[4 * 0 + 2];
+  f1[0] = s[4 * 0 + 1];
+  f2[0] = s[4 * 0 + 3];
+
+  f0[1] = s[4 * 1 + 1];
+  f1[1] = s[4 * 2 + 2];
+  f2[1] = s[4 * 2 + 1];
+
+  f0[2] = s[4 * 2 + 3];
+  f1[2] = s[4 * 3 + 1];
+  f2[2] = s[4 * 4 + 2];
+
+  f0[3] = s[4 * 4 + 1];
+  f1[3] = s[4 * 4 + 3];
+  f2[3] = s[4 * 5 + 1];
+}
+
+/* the inverse of unpack_v210_words() */
+static inline void
+pack_v210_words (guint8 * restrict d, const guint16 * restrict f0,
+    const guint16 * restrict f1, const guint16 * restrict f2, gint n)
+{
+  gint j;
+
+  for (j = 0; j < n; j++) {
+    guint32 a;
+
+    a = (f0[j] >> 6) | ((f2[j] >> 6) << 20);
+    a |= (guint32) (f1[j] >> 6) << 10;
+    GST_WRITE_UINT32_LE (d + j * 4, a);
   }
 }
 
@@ -540,81 +643,36 @@ pack_v210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
+  int i, j, c, g;
   guint8 *restrict d = GET_LINE (y);
   const guint16 *restrict s = src;
-  guint32 a0, a1, a2, a3;
-  guint16 y0, y1, y2, y3, y4, y5;
-  guint16 u0, u1, u2;
-  guint16 v0, v1, v2;
-
-  for (i = 0; i < width - 5; i += 6) {
-    y0 = s[4 * (i + 0) + 1] >> 6;
-    y1 = s[4 * (i + 1) + 1] >> 6;
-    y2 = s[4 * (i + 2) + 1] >> 6;
-    y3 = s[4 * (i + 3) + 1] >> 6;
-    y4 = s[4 * (i + 4) + 1] >> 6;
-    y5 = s[4 * (i + 5) + 1] >> 6;
-
-    u0 = s[4 * (i + 0) + 2] >> 6;
-    u1 = s[4 * (i + 2) + 2] >> 6;
-    u2 = s[4 * (i + 4) + 2] >> 6;
-
-    v0 = s[4 * (i + 0) + 3] >> 6;
-    v1 = s[4 * (i + 2) + 3] >> 6;
-    v2 = s[4 * (i + 4) + 3] >> 6;
-
-    a0 = u0 | (y0 << 10) | (v0 << 20);
-    a1 = y1 | (u1 << 10) | (y2 << 20);
-    a2 = v1 | (y3 << 10) | (u2 << 20);
-    a3 = y4 | (v2 << 10) | (y5 << 20);
-
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 0, a0);
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 4, a1);
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 8, a2);
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 12, a3);
+  guint16 f0[LINE_BLOCK], f1[LINE_BLOCK], f2[LINE_BLOCK];
+
+  for (i = 0; i + LINE_BLOCK / 4 * 6 <= width; i += LINE_BLOCK / 4 * 6) {
+    for (g = 0; g < LINE_BLOCK / 4; g++)
+      load_v210_group (s + 4 * (i + g * 6), f0 + g * 4, f1 + g * 4,
+          f2 + g * 4);
+    pack_v210_words (d + (i / 6) * 16, f0, f1, f2, LINE_BLOCK);
+  }
+
+  for (; i < width - 5; i += 6) {
+    load_v210_group (s + 4 * i, f0, f1, f2);
+    pack_v210_words (d + (i / 6) * 16, f0, f1, f2, 4);
   }
-  if (i < width) {
-    y0 = s[4 * (i + 0) + 1] >> 6;
-    u0 = s[4 * (i + 0) + 2] >> 6;
-    v0 = s[4 * (i + 0) + 3] >> 6;
-    if (i < width - 1)
-      y1 = s[4 * (i + 1) + 1] >> 6;
-    else
-      y1 = y0;
-    if (i < width - 2) {
-      y2 = s[4 * (i + 2) + 1] >> 6;
-      u1 = s[4 * (i + 2) + 2] >> 6;
-      v1 = s[4 * (i + 2) + 3] >> 6;
-    } else {
-      y2 = y1;
-      u1 = u0;
-      v1 = v0;
-    }
-    if (i < width - 3)
-      y3 = s[4 * (i + 3) + 1] >> 6;
-    else
-      y3 = y2;
-    if (i < width - 4) {
-      y4 = s[4 * (i + 4) + 1] >> 6;
-      u2 = s[4 * (i + 4) + 2] >> 6;
-      v2 = s[4 * (i + 4) + 3] >> 6;
-    } else {
-      y4 = y3;
-      u2 = u1;
-      v2 = v1;
-    }
-    y5 = y4;
 
-    a0 = u0 | (y0 << 10) | (v0 << 20);
-    a1 = y1 | (u1 << 10) | (y2 << 20);
-    a2 = v1 | (y3 << 10) | (u2 << 20);
-    a3 = y4 | (v2 << 10) | (y5 << 20);
+  if (i < width) {
+    /* pad the last group with the luma of the last pixel and the chroma of
+     * the last even pixel */
+    guint16 tmp[6 * 4];
 
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 0, a0);
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 4, a1);
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 8, a2);
-    GST_WRITE_UINT32_LE (d + (i / 6) * 16 + 12, a3);
+    for (j = 0; j < 6; j++) {
+      c = MIN (i + j, width - 1);
+      tmp[j * 4 + 1] = s[4 * c + 1];
+      tmp[j * 4 + 2] = s[4 * (c & ~1) + 2];
+      tmp[j * 4 + 3] = s[4 * (c & ~1) + 3];
+    }
+    load_v210_group (tmp, f0, f1, f2);
+    pack_v210_words (d + (i / 6) * 16, f0, f1, f2, 4);
   }
 }
 
@@ -624,26 +682,49 @@ unpack_v216 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint8 *restrict s = GET_LINE (y);
+  int i, j, n;
+  const guint16 *restrict s = GET_LINE (y);
   guint16 *restrict d = dest;
 
-  s += (x & ~1) << 2;
-  if (x & 1) {
+  /* U Y0 V Y1 words per pixel pair */
+  s += (x & ~1) << 1;
+
+  /* an odd first pixel uses the chroma of the pair it belongs to */
+  if ((x & 1) && width > 0) {
     d[0] = 0xffff;
-    d[1] = GST_READ_UINT16_LE (s + 6);
-    d[2] = GST_READ_UINT16_LE (s + 0);
-    d[3] = GST_READ_UINT16_LE (s + 4);
-    s += 8;
+    d[1] = GUINT16_FROM_LE (s[3]);
+    d[2] = GUINT16_FROM_LE (s[0]);
+    d[3] = GUINT16_FROM_LE (s[2]);
+    s += 4;
     d += 4;
     width--;
   }
 
-  for (i = 0; i < width; i++) {
+  /* blocks of LINE_BLOCK pixel pairs */
+  n = width & ~(LINE_BLOCK * 2 - 1);
+  for (i = 0; i < n; i += LINE_BLOCK * 2) {
+    guint16 U[LINE_BLOCK], Y0[LINE_BLOCK], V[LINE_BLOCK], Y1[LINE_BLOCK];
+    guint16 *restrict b = d + i * 4;
+
+    load_block_u16 (s + i * 2, U, Y0, V, Y1);
+
+    for (j = 0; j < LINE_BLOCK; j++) {
+      b[j * 8 + 0] = 0xffff;
+      b[j * 8 + 1] = GUINT16_FROM_LE (Y0[j]);
+      b[j * 8 + 2] = GUINT16_FROM_LE (U[j]);
+      b[j * 8 + 3] = GUINT16_FROM_LE (V[j]);
+      b[j * 8 + 4] = 0xffff;
+      b[j * 8 + 5] = GUINT16_FROM_LE (Y1[j]);
+      b[j * 8 + 6] = GUINT16_FROM_LE (U[j]);
+      b[j * 8 + 7] = GUINT16_FROM_LE (V[j]);
+    }
+  }
+
+  for (; i < width; i++) {
     d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = GST_READ_UINT16_LE (s + i * 4 + 2);
-    d[i * 4 + 2] = GST_READ_UINT16_LE (s + (i >> 1) * 8 + 0);
-    d[i * 4 + 3] = GST_READ_UINT16_LE (s + (i >> 1) * 8 + 4);
+    d[i * 4 + 1] = GUINT16_FROM_LE (s[i * 2 + 1]);
+    d[i * 4 + 2] = GUINT16_FROM_LE (s[(i >> 1) * 4 + 0]);
+    d[i * 4 + 3] = GUINT16_FROM_LE (s[(i >> 1) * 4 + 2]);
   }
 }
 
@@ -654,20 +735,23 @@ pack_v216 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gint y, gint width)
 {
   int i;
-  guint8 *restrict d = GET_LINE (y);
+  guint16 *restrict d = GET_LINE (y);
   const guint16 *restrict s = src;
 
+  /* take the chroma of the first pixel of each pair */
   for (i = 0; i < width - 1; i += 2) {
-    GST_WRITE_UINT16_LE (d + i * 4 + 0, s[(i + 0) * 4 + 2]);
-    GST_WRITE_UINT16_LE (d + i * 4 + 2, s[(i + 0) * 4 + 1]);
-    GST_WRITE_UINT16_LE (d + i * 4 + 4, s[(i + 0) * 4 + 3]);
-    GST_WRITE_UINT16_LE (d + i * 4 + 6, s[(i + 1) * 4 + 1]);
+    d[i * 2 + 0] = GUINT16_TO_LE (s[i * 4 + 2]);
+    d[i * 2 + 1] = GUINT16_TO_LE (s[i * 4 + 1]);
+    d[i * 2 + 2] = GUINT16_TO_LE (s[i * 4 + 3]);
+    d[i * 2 + 3] = GUINT16_TO_LE (s[i * 4 + 5]);
   }
-  if (i == width - 1) {
-    GST_WRITE_UINT16_LE (d + i * 4 + 0, s[i * 4 + 2]);
-    GST_WRITE_UINT16_LE (d + i * 4 + 2, s[i * 4 + 1]);
-    GST_WRITE_UINT16_LE (d + i * 4 + 4, s[i * 4 + 3]);
-    GST_WRITE_UINT16_LE (d + i * 4 + 6, s[i * 4 + 1]);
+
+  /* an odd last pixel repeats its luma */
+  if (i < width) {
+    d[i * 2 + 0] = GUINT16_TO_LE (s[i * 4 + 2]);
+    d[i * 2 + 1] = GUINT16_TO_LE (s[i * 4 + 1]);
+    d[i * 2 + 2] = GUINT16_TO_LE (s[i * 4 + 3]);
+    d[i * 2 + 3] = GUINT16_TO_LE (s[i * 4 + 1]);
   }
 }
 
@@ -1627,6 +1711,36 @@ pack_NV24 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
 }
 
 #define PACK_UYVP GST_VIDEO_FORMAT_AYUV64, unpack_UYVP, 1, pack_UYVP
+/* unpacks one pair of pixels from 5 bytes */
+static inline void
+unpack_UYVP_pair (const guint8 * restrict s, guint16 * restrict d,
+    guint16 mask)
+{
+  guint16 y0, y1;
+  guint16 u0;
+  guint16 v0;
+
+  u0 = ((s[0] << 2) | (s[1] >> 6)) << 6;
+  y0 = (((s[1] & 0x3f) << 4) | (s[2] >> 4)) << 6;
+  v0 = (((s[2] & 0x0f) << 6) | (s[3] >> 2)) << 6;
+  y1 = (((s[3] & 0x03) << 8) | s[4]) << 6;
+
+  y0 |= (y0 >> 10) & mask;
+  y1 |= (y1 >> 10) & mask;
+  u0 |= (u0 >> 10) & mask;
+  v0 |= (v0 >> 10) & mask;
+
+  d[0] = 0xffff;
+  d[1] = y0;
+  d[2] = u0;
+  d[3] = v0;
+
+  d[4] = 0xffff;
+  d[5] = y1;
+  d[6] = u0;
+  d[7] = v0;
+}
+
 static void
 unpack_UYVP (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
@@ -1635,41 +1749,36 @@ unpack_UYVP (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
   int i;
   const guint8 *restrict s = GET_LINE (y);
   guint16 *restrict d = dest;
+  guint16 mask;
+
+  mask = (flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE) ? 0 : 0xffff;
 
   /* FIXME */
   s += x << 1;
 
-  for (i = 0; i < width; i += 2) {
-    guint16 y0, y1;
-    guint16 u0;
-    guint16 v0;
-
-    u0 = ((s[(i / 2) * 5 + 0] << 2) | (s[(i / 2) * 5 + 1] >> 6)) << 6;
-    y0 = (((s[(i / 2) * 5 + 1] & 0x3f) << 4) | (s[(i / 2) * 5 + 2] >> 4)) << 6;
-    v0 = (((s[(i / 2) * 5 + 2] & 0x0f) << 6) | (s[(i / 2) * 5 + 3] >> 2)) << 6;
-    y1 = (((s[(i / 2) * 5 + 3] & 0x03) << 8) | s[(i / 2) * 5 + 4]) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      y0 |= (y0 >> 10);
-      y1 |= (y1 >> 10);
-      u0 |= (u0 >> 10);
-      v0 |= (v0 >> 10);
-    }
+  for (i = 0; i < width - 1; i += 2)
+    unpack_UYVP_pair (s + (i / 2) * 5, d + i * 4, mask);
 
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = y0;
-    d[i * 4 + 2] = u0;
-    d[i * 4 + 3] = v0;
+  if (i < width) {
+    guint16 tmp[2 * 4];
 
-    if (i < width - 1) {
-      d[i * 4 + 4] = 0xffff;
-      d[i * 4 + 5] = y1;
-      d[i * 4 + 6] = u0;
-      d[i * 4 + 7] = v0;
-    }
+    unpack_UYVP_pair (s + (i / 2) * 5, tmp, mask);
+    memcpy (d + i * 4, tmp, 4 * sizeof (guint16));
   }
 }
 
+/* packs one pair of pixels into 5 bytes */
+static inline void
+pack_UYVP_pair (guint8 * restrict d, guint16 y0, guint16 y1, guint16 u0,
+    guint16 v0)
+{
+  d[0] = u0 >> 8;
+  d[1] = (u0 & 0xc0) | y0 >> 10;
+  d[2] = ((y0 & 0x3c0) >> 2) | (v0 >> 12);
+  d[3] = ((v0 & 0xfc0) >> 4) | (y1 >> 14);
+  d[4] = (y1 >> 6);
+}
+
 static void
 pack_UYVP (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gpointer src, gint sstride, gpointer data[GST_VIDEO_MAX_PLANES],
@@ -1680,26 +1789,14 @@ pack_UYVP (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
   guint8 *restrict d = GET_LINE (y);
   const guint16 *restrict s = src;
 
-  for (i = 0; i < width; i += 2) {
-    guint16 y0, y1;
-    guint16 u0;
-    guint16 v0;
-
-    y0 = s[4 * (i + 0) + 1];
-    if (i < width - 1)
-      y1 = s[4 * (i + 1) + 1];
-    else
-      y1 = y0;
-
-    u0 = s[4 * (i + 0) + 2];
-    v0 = s[4 * (i + 0) + 3];
+  for (i = 0; i < width - 1; i += 2)
+    pack_UYVP_pair (d + (i / 2) * 5, s[4 * i + 1], s[4 * (i + 1) + 1],
+        s[4 * i + 2], s[4 * i + 3]);
 
-    d[(i / 2) * 5 + 0] = u0 >> 8;
-    d[(i / 2) * 5 + 1] = (u0 & 0xc0) | y0 >> 10;
-    d[(i / 2) * 5 + 2] = ((y0 & 0x3c0) >> 2) | (v0 >> 12);
-    d[(i / 2) * 5 + 3] = ((v0 & 0xfc0) >> 4) | (y1 >> 14);
-    d[(i / 2) * 5 + 4] = (y1 >> 6);
-  }
+  /* an odd last pixel repeats its luma */
+  if (i < width)
+    pack_UYVP_pair (d + (i / 2) * 5, s[4 * i + 1], s[4 * i + 1],
+        s[4 * i + 2], s[4 * i + 3]);
 }
 
 #define PACK_A420 GST_VIDEO_FORMAT_AYUV, unpack_A420, 1, pack_A420
@@ -2081,24 +2178,44 @@ unpack_r210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint8 *restrict s = GET_LINE (y);
-  guint16 *restrict d = dest, R, G, B;
+  int i, j, n;
+  const guint32 *restrict s = GET_LINE (y);
+  guint16 *restrict d = dest, R, G, B, mask;
+  guint32 v;
 
-  s += x * 4;
+  mask = (flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE) ? 0 : 0xffff;
 
-  for (i = 0; i < width; i++) {
-    guint32 x = GST_READ_UINT32_BE (s + i * 4);
+  s += x;
+
+  n = width & ~(LINE_BLOCK - 1);
+  for (i = 0; i < n; i += LINE_BLOCK) {
+    guint16 A[LINE_BLOCK], CR[LINE_BLOCK], CG[LINE_BLOCK], CB[LINE_BLOCK];
 
-    R = ((x >> 14) & 0xffc0);
-    G = ((x >> 4) & 0xffc0);
-    B = ((x << 6) & 0xffc0);
+    for (j = 0; j < LINE_BLOCK; j++) {
+      v = GUINT32_FROM_BE (s[i + j]);
 
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      R |= (R >> 10);
-      G |= (G >> 10);
-      B |= (B >> 10);
+      A[j] = 0xffff;
+      CR[j] = ((v >> 14) & 0xffc0);
+      CG[j] = ((v >> 4) & 0xffc0);
+      CB[j] = ((v << 6) & 0xffc0);
     }
+    extend_block_u16 (CR, LINE_BLOCK, mask);
+    extend_block_u16 (CG, LINE_BLOCK, mask);
+    extend_block_u16 (CB, LINE_BLOCK, mask);
+
+    store_block_u16 (d + i * 4, A, CR, CG, CB);
+  }
+
+  for (; i < width; i++) {
+    v = GUINT32_FROM_BE (s[i]);
+
+    R = ((v >> 14) & 0xffc0);
+    G = ((v >> 4) & 0xffc0);
+    B = ((v << 6) & 0xffc0);
+
+    R |= (R >> 10) & mask;
+    G |= (G >> 10) & mask;
+    B |= (B >> 10) & mask;
 
     d[i * 4 + 0] = 0xffff;
     d[i * 4 + 1] = R;
@@ -2114,74 +2231,170 @@ pack_r210 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gint y, gint width)
 {
   int i;
-  guint8 *restrict d = GET_LINE (y);
+  guint32 *restrict d = GET_LINE (y);
   const guint16 *restrict s = src;
+  guint32 v;
 
   for (i = 0; i < width; i++) {
-    guint32 x = 0;
-    x |= (s[i * 4 + 1] & 0xffc0) << 14;
-    x |= (s[i * 4 + 2] & 0xffc0) << 4;
-    x |= (s[i * 4 + 3] & 0xffc0) >> 6;
-    GST_WRITE_UINT32_BE (d + i * 4, x);
+    v = (s[i * 4 + 1] & 0xffc0) << 14;
+    v |= (s[i * 4 + 2] & 0xffc0) << 4;
+    v |= (s[i * 4 + 3] & 0xffc0) >> 6;
+    d[i] = GUINT32_TO_BE (v);
   }
 }
 
-#define PACK_GBR_10LE GST_VIDEO_FORMAT_ARGB64, unpack_GBR_10LE, 1, pack_GBR_10LE
-static void
-unpack_GBR_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
-    gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
-    const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
+/* Helpers for the planar 10 bit formats. Samples are loaded as native 16 bit
+ * words and byte swapped when needed, the range extension is masked instead
+ * of testing the flags per pixel and an odd start pixel of subsampled
+ * formats is handled before the blocks so that they start on a chroma
+ * sample. All callers pass constants for @h_sub, @alpha and @be so each gets
+ * its own specialized copy. */
+#define READ_U16(v, be)  ((be) ? GUINT16_FROM_BE (v) : GUINT16_FROM_LE (v))
+#define WRITE_U16(v, be) ((be) ? GUINT16_TO_BE (v) : GUINT16_TO_LE (v))
+
+static inline guint16
+read_u10 (guint16 v, gboolean be, guint16 mask)
 {
-  int i;
-  const guint16 *sg = GET_G_LINE (y);
-  const guint16 *sb = GET_B_LINE (y);
-  const guint16 *sr = GET_R_LINE (y);
-  guint16 *d = dest, G, B, R;
+  v = READ_U16 (v, be) << 6;
 
-  sg += x;
-  sb += x;
-  sr += x;
+  return v | ((v >> 10) & mask);
+}
 
-  for (i = 0; i < width; i++) {
-    G = GST_READ_UINT16_LE (sg + i) << 6;
-    B = GST_READ_UINT16_LE (sb + i) << 6;
-    R = GST_READ_UINT16_LE (sr + i) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      R |= (R >> 10);
-      G |= (G >> 10);
-      B |= (B >> 10);
+static inline void
+unpack_planar_10 (guint16 * restrict d, const guint16 * restrict sa,
+    const guint16 * restrict s1, const guint16 * restrict s2,
+    const guint16 * restrict s3, gint x, gint width, gint h_sub,
+    gboolean alpha, gboolean be, GstVideoPackFlags flags)
+{
+  guint16 mask;
+  gint i, j, c, n;
+
+  mask = (flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE) ? 0 : 0xffff;
+
+  s1 += x;
+  s2 += x >> h_sub;
+  s3 += x >> h_sub;
+  if (alpha)
+    sa += x;
+
+  /* an odd first pixel uses the chroma of the pair it belongs to */
+  if ((x & h_sub) && width > 0) {
+    d[0] = alpha ? read_u10 (sa[0], be, mask) : 0xffff;
+    d[1] = read_u10 (s1[0], be, mask);
+    d[2] = read_u10 (s2[0], be, mask);
+    d[3] = read_u10 (s3[0], be, mask);
+    d += 4;
+    s1++;
+    s2++;
+    s3++;
+    if (alpha)
+      sa++;
+    width--;
+  }
+
+  n = width & ~(LINE_BLOCK - 1);
+  for (i = 0; i < n; i += LINE_BLOCK) {
+    guint16 A[LINE_BLOCK], C1[LINE_BLOCK], C2[LINE_BLOCK], C3[LINE_BLOCK];
+    guint16 T2[LINE_BLOCK / 2], T3[LINE_BLOCK / 2];
+
+    for (j = 0; j < LINE_BLOCK; j++)
+      C1[j] = read_u10 (s1[i + j], be, mask);
+
+    if (h_sub) {
+      for (j = 0; j < LINE_BLOCK / 2; j++) {
+        T2[j] = read_u10 (s2[i / 2 + j], be, mask);
+        T3[j] = read_u10 (s3[i / 2 + j], be, mask);
+      }
+      upsample_block_u16 (C2, T2);
+      upsample_block_u16 (C3, T3);
+    } else {
+      for (j = 0; j < LINE_BLOCK; j++) {
+        C2[j] = read_u10 (s2[i + j], be, mask);
+        C3[j] = read_u10 (s3[i + j], be, mask);
+      }
     }
 
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = R;
-    d[i * 4 + 2] = G;
-    d[i * 4 + 3] = B;
+    if (alpha) {
+      for (j = 0; j < LINE_BLOCK; j++)
+        A[j] = read_u10 (sa[i + j], be, mask);
+    } else {
+      for (j = 0; j < LINE_BLOCK; j++)
+        A[j] = 0xffff;
+    }
+
+    store_block_u16 (d + i * 4, A, C1, C2, C3);
+  }
+
+  for (; i < width; i++) {
+    c = i >> h_sub;
+
+    d[i * 4 + 0] = alpha ? read_u10 (sa[i], be, mask) : 0xffff;
+    d[i * 4 + 1] = read_u10 (s1[i], be, mask);
+    d[i * 4 + 2] = read_u10 (s2[c], be, mask);
+    d[i * 4 + 3] = read_u10 (s3[c], be, mask);
+  }
+}
+
+/* @chroma is FALSE for the lines of subsampled formats that don't have
+ * chroma */
+static inline void
+pack_planar_10 (const guint16 * restrict s, guint16 * restrict da,
+    guint16 * restrict d1, guint16 * restrict d2, guint16 * restrict d3,
+    gint width, gint h_sub, gboolean chroma, gboolean alpha, gboolean be)
+{
+  gint i;
+
+  if (chroma && h_sub) {
+    /* one pass over the pixel pairs, the chroma of the first pixel of each
+     * pair is kept */
+    for (i = 0; i < width / 2; i++) {
+      d1[i * 2 + 0] = WRITE_U16 (s[i * 8 + 1] >> 6, be);
+      d1[i * 2 + 1] = WRITE_U16 (s[i * 8 + 5] >> 6, be);
+      d2[i] = WRITE_U16 (s[i * 8 + 2] >> 6, be);
+      d3[i] = WRITE_U16 (s[i * 8 + 3] >> 6, be);
+    }
+    if (width & 1) {
+      i = width - 1;
+      d1[i] = WRITE_U16 (s[i * 4 + 1] >> 6, be);
+      d2[i / 2] = WRITE_U16 (s[i * 4 + 2] >> 6, be);
+      d3[i / 2] = WRITE_U16 (s[i * 4 + 3] >> 6, be);
+    }
+  } else {
+    for (i = 0; i < width; i++)
+      d1[i] = WRITE_U16 (s[i * 4 + 1] >> 6, be);
+
+    if (chroma) {
+      for (i = 0; i < width; i++) {
+        d2[i] = WRITE_U16 (s[i * 4 + 2] >> 6, be);
+        d3[i] = WRITE_U16 (s[i * 4 + 3] >> 6, be);
+      }
+    }
+  }
+
+  if (alpha) {
+    for (i = 0; i < width; i++)
+      da[i] = WRITE_U16 (s[i * 4 + 0] >> 6, be);
   }
 }
 
+#define PACK_GBR_10LE GST_VIDEO_FORMAT_ARGB64, unpack_GBR_10LE, 1, pack_GBR_10LE
+static void
+unpack_GBR_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
+    gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
+    const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
+{
+  unpack_planar_10 (dest, NULL, GET_R_LINE (y), GET_G_LINE (y),
+      GET_B_LINE (y), x, width, 0, FALSE, FALSE, flags);
+}
+
 static void
 pack_GBR_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gpointer src, gint sstride, gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict dg = GET_G_LINE (y);
-  guint16 *restrict db = GET_B_LINE (y);
-  guint16 *restrict dr = GET_R_LINE (y);
-  guint16 G, B, R;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width; i++) {
-    G = (s[i * 4 + 2]) >> 6;
-    B = (s[i * 4 + 3]) >> 6;
-    R = (s[i * 4 + 1]) >> 6;
-
-    GST_WRITE_UINT16_LE (dg + i, G);
-    GST_WRITE_UINT16_LE (db + i, B);
-    GST_WRITE_UINT16_LE (dr + i, R);
-  }
+  pack_planar_10 (src, NULL, GET_R_LINE (y), GET_G_LINE (y), GET_B_LINE (y),
+      width, 0, TRUE, FALSE, FALSE);
 }
 
 #define PACK_GBR_10BE GST_VIDEO_FORMAT_ARGB64, unpack_GBR_10BE, 1, pack_GBR_10BE
@@ -2190,32 +2403,8 @@ unpack_GBR_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sg = GET_G_LINE (y);
-  const guint16 *restrict sb = GET_B_LINE (y);
-  const guint16 *restrict sr = GET_R_LINE (y);
-  guint16 *restrict d = dest, G, B, R;
-
-  sg += x;
-  sb += x;
-  sr += x;
-
-  for (i = 0; i < width; i++) {
-    G = GST_READ_UINT16_BE (sg + i) << 6;
-    B = GST_READ_UINT16_BE (sb + i) << 6;
-    R = GST_READ_UINT16_BE (sr + i) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      R |= (R >> 10);
-      G |= (G >> 10);
-      B |= (B >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = R;
-    d[i * 4 + 2] = G;
-    d[i * 4 + 3] = B;
-  }
+  unpack_planar_10 (dest, NULL, GET_R_LINE (y), GET_G_LINE (y),
+      GET_B_LINE (y), x, width, 0, FALSE, TRUE, flags);
 }
 
 static void
@@ -2224,22 +2413,8 @@ pack_GBR_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict dg = GET_G_LINE (y);
-  guint16 *restrict db = GET_B_LINE (y);
-  guint16 *restrict dr = GET_R_LINE (y);
-  guint16 G, B, R;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width; i++) {
-    G = s[i * 4 + 2] >> 6;
-    B = s[i * 4 + 3] >> 6;
-    R = s[i * 4 + 1] >> 6;
-
-    GST_WRITE_UINT16_BE (dg + i, G);
-    GST_WRITE_UINT16_BE (db + i, B);
-    GST_WRITE_UINT16_BE (dr + i, R);
-  }
+  pack_planar_10 (src, NULL, GET_R_LINE (y), GET_G_LINE (y), GET_B_LINE (y),
+      width, 0, TRUE, FALSE, TRUE);
 }
 
 #define PACK_Y444_10LE GST_VIDEO_FORMAT_AYUV64, unpack_Y444_10LE, 1, pack_Y444_10LE
@@ -2248,32 +2423,8 @@ unpack_Y444_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  guint16 *restrict sy = GET_Y_LINE (y);
-  guint16 *restrict su = GET_U_LINE (y);
-  guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, Y, U, V;
-
-  sy += x;
-  su += x;
-  sv += x;
-
-  for (i = 0; i < width; i++) {
-    Y = GST_READ_UINT16_LE (sy + i) << 6;
-    U = GST_READ_UINT16_LE (su + i) << 6;
-    V = GST_READ_UINT16_LE (sv + i) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-  }
+  unpack_planar_10 (dest, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 0, FALSE, FALSE, flags);
 }
 
 static void
@@ -2282,22 +2433,8 @@ pack_Y444_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 Y, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width; i++) {
-    Y = (s[i * 4 + 1]) >> 6;
-    U = (s[i * 4 + 2]) >> 6;
-    V = (s[i * 4 + 3]) >> 6;
-
-    GST_WRITE_UINT16_LE (dy + i, Y);
-    GST_WRITE_UINT16_LE (du + i, U);
-    GST_WRITE_UINT16_LE (dv + i, V);
-  }
+  pack_planar_10 (src, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 0, TRUE, FALSE, FALSE);
 }
 
 #define PACK_Y444_10BE GST_VIDEO_FORMAT_AYUV64, unpack_Y444_10BE, 1, pack_Y444_10BE
@@ -2306,32 +2443,8 @@ unpack_Y444_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (y);
-  const guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, Y, U, V;
-
-  sy += x;
-  su += x;
-  sv += x;
-
-  for (i = 0; i < width; i++) {
-    Y = GST_READ_UINT16_BE (sy + i) << 6;
-    U = GST_READ_UINT16_BE (su + i) << 6;
-    V = GST_READ_UINT16_BE (sv + i) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-  }
+  unpack_planar_10 (dest, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 0, FALSE, TRUE, flags);
 }
 
 static void
@@ -2340,22 +2453,8 @@ pack_Y444_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 Y, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width; i++) {
-    Y = s[i * 4 + 1] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_BE (dy + i, Y);
-    GST_WRITE_UINT16_BE (du + i, U);
-    GST_WRITE_UINT16_BE (dv + i, V);
-  }
+  pack_planar_10 (src, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 0, TRUE, FALSE, TRUE);
 }
 
 #define PACK_I420_10LE GST_VIDEO_FORMAT_AYUV64, unpack_I420_10LE, 1, pack_I420_10LE
@@ -2364,40 +2463,11 @@ unpack_I420_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (uv);
-  const guint16 *restrict sv = GET_V_LINE (uv);
-  guint16 *restrict d = dest, Y, U, V;
-
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
 
-  for (i = 0; i < width; i++) {
-    Y = GST_READ_UINT16_LE (sy + i) << 6;
-    U = GST_READ_UINT16_LE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_LE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
-}
+  unpack_planar_10 (dest, NULL, GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), x, width, 1, FALSE, FALSE, flags);
+}
 
 static void
 pack_I420_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
@@ -2405,41 +2475,10 @@ pack_I420_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (uv);
-  guint16 *restrict dv = GET_V_LINE (uv);
-  guint16 Y0, Y1, U, V;
-  const guint16 *restrict s = src;
 
-  if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width - 1; i += 2) {
-      Y0 = s[i * 4 + 1] >> 6;
-      Y1 = s[i * 4 + 5] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_LE (dy + i + 0, Y0);
-      GST_WRITE_UINT16_LE (dy + i + 1, Y1);
-      GST_WRITE_UINT16_LE (du + (i >> 1), U);
-      GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-    }
-    if (i == width - 1) {
-      Y0 = s[i * 4 + 1] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_LE (dy + i, Y0);
-      GST_WRITE_UINT16_LE (du + (i >> 1), U);
-      GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-    }
-  } else {
-    for (i = 0; i < width; i++) {
-      Y0 = s[i * 4 + 1] >> 6;
-      GST_WRITE_UINT16_LE (dy + i, Y0);
-    }
-  }
+  pack_planar_10 (src, NULL, GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), width, 1, IS_CHROMA_LINE_420 (y, flags), FALSE, FALSE);
 }
 
 #define PACK_I420_10BE GST_VIDEO_FORMAT_AYUV64, unpack_I420_10BE, 1, pack_I420_10BE
@@ -2448,39 +2487,10 @@ unpack_I420_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (uv);
-  const guint16 *restrict sv = GET_V_LINE (uv);
-  guint16 *restrict d = dest, Y, U, V;
-
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
 
-  for (i = 0; i < width; i++) {
-    Y = GST_READ_UINT16_BE (sy + i) << 6;
-    U = GST_READ_UINT16_BE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_BE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, NULL, GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), x, width, 1, FALSE, TRUE, flags);
 }
 
 static void
@@ -2489,41 +2499,10 @@ pack_I420_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (uv);
-  guint16 *restrict dv = GET_V_LINE (uv);
-  guint16 Y0, Y1, U, V;
-  const guint16 *restrict s = src;
 
-  if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width - 1; i += 2) {
-      Y0 = s[i * 4 + 1] >> 6;
-      Y1 = s[i * 4 + 5] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_BE (dy + i + 0, Y0);
-      GST_WRITE_UINT16_BE (dy + i + 1, Y1);
-      GST_WRITE_UINT16_BE (du + (i >> 1), U);
-      GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-    }
-    if (i == width - 1) {
-      Y0 = s[i * 4 + 1] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_BE (dy + i, Y0);
-      GST_WRITE_UINT16_BE (du + (i >> 1), U);
-      GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-    }
-  } else {
-    for (i = 0; i < width; i++) {
-      Y0 = s[i * 4 + 1] >> 6;
-      GST_WRITE_UINT16_BE (dy + i, Y0);
-    }
-  }
+  pack_planar_10 (src, NULL, GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), width, 1, IS_CHROMA_LINE_420 (y, flags), FALSE, TRUE);
 }
 
 #define PACK_I422_10LE GST_VIDEO_FORMAT_AYUV64, unpack_I422_10LE, 1, pack_I422_10LE
@@ -2532,38 +2511,8 @@ unpack_I422_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (y);
-  const guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, Y, U, V;
-
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
-
-  for (i = 0; i < width; i++) {
-    Y = GST_READ_UINT16_LE (sy + i) << 6;
-    U = GST_READ_UINT16_LE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_LE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 1, FALSE, FALSE, flags);
 }
 
 static void
@@ -2572,33 +2521,8 @@ pack_I422_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 Y0, Y1, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width - 1; i += 2) {
-    Y0 = s[i * 4 + 1] >> 6;
-    Y1 = s[i * 4 + 5] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_LE (dy + i + 0, Y0);
-    GST_WRITE_UINT16_LE (dy + i + 1, Y1);
-    GST_WRITE_UINT16_LE (du + (i >> 1), U);
-    GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-  }
-  if (i == width - 1) {
-    Y0 = s[i * 4 + 1] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_LE (dy + i, Y0);
-    GST_WRITE_UINT16_LE (du + (i >> 1), U);
-    GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-  }
+  pack_planar_10 (src, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 1, TRUE, FALSE, FALSE);
 }
 
 #define PACK_I422_10BE GST_VIDEO_FORMAT_AYUV64, unpack_I422_10BE, 1, pack_I422_10BE
@@ -2607,38 +2531,8 @@ unpack_I422_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (y);
-  const guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, Y, U, V;
-
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
-
-  for (i = 0; i < width; i++) {
-    Y = GST_READ_UINT16_BE (sy + i) << 6;
-    U = GST_READ_UINT16_BE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_BE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 1, FALSE, TRUE, flags);
 }
 
 static void
@@ -2647,33 +2541,8 @@ pack_I422_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 Y0, Y1, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width - 1; i += 2) {
-    Y0 = s[i * 4 + 1] >> 6;
-    Y1 = s[i * 4 + 5] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_BE (dy + i + 0, Y0);
-    GST_WRITE_UINT16_BE (dy + i + 1, Y1);
-    GST_WRITE_UINT16_BE (du + (i >> 1), U);
-    GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-  }
-  if (i == width - 1) {
-    Y0 = s[i * 4 + 1] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_BE (dy + i, Y0);
-    GST_WRITE_UINT16_BE (du + (i >> 1), U);
-    GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-  }
+  pack_planar_10 (src, NULL, GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 1, TRUE, FALSE, TRUE);
 }
 
 #define PACK_A444_10LE GST_VIDEO_FORMAT_AYUV64, unpack_A444_10LE, 1, pack_A444_10LE
@@ -2682,36 +2551,8 @@ unpack_A444_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  guint16 *restrict sa = GET_A_LINE (y);
-  guint16 *restrict sy = GET_Y_LINE (y);
-  guint16 *restrict su = GET_U_LINE (y);
-  guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, A, Y, U, V;
-
-  sa += x;
-  sy += x;
-  su += x;
-  sv += x;
-
-  for (i = 0; i < width; i++) {
-    A = GST_READ_UINT16_LE (sa + i) << 6;
-    Y = GST_READ_UINT16_LE (sy + i) << 6;
-    U = GST_READ_UINT16_LE (su + i) << 6;
-    V = GST_READ_UINT16_LE (sv + i) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      A |= (A >> 10);
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = A;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-  }
+  unpack_planar_10 (dest, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 0, TRUE, FALSE, flags);
 }
 
 static void
@@ -2720,25 +2561,8 @@ pack_A444_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict da = GET_A_LINE (y);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 A, Y, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width; i++) {
-    A = (s[i * 4 + 0]) >> 6;
-    Y = (s[i * 4 + 1]) >> 6;
-    U = (s[i * 4 + 2]) >> 6;
-    V = (s[i * 4 + 3]) >> 6;
-
-    GST_WRITE_UINT16_LE (da + i, A);
-    GST_WRITE_UINT16_LE (dy + i, Y);
-    GST_WRITE_UINT16_LE (du + i, U);
-    GST_WRITE_UINT16_LE (dv + i, V);
-  }
+  pack_planar_10 (src, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 0, TRUE, TRUE, FALSE);
 }
 
 #define PACK_A444_10BE GST_VIDEO_FORMAT_AYUV64, unpack_A444_10BE, 1, pack_A444_10BE
@@ -2747,36 +2571,8 @@ unpack_A444_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sa = GET_A_LINE (y);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (y);
-  const guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, A, Y, U, V;
-
-  sa += x;
-  sy += x;
-  su += x;
-  sv += x;
-
-  for (i = 0; i < width; i++) {
-    A = GST_READ_UINT16_BE (sa + i) << 6;
-    Y = GST_READ_UINT16_BE (sy + i) << 6;
-    U = GST_READ_UINT16_BE (su + i) << 6;
-    V = GST_READ_UINT16_BE (sv + i) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      A |= (A >> 10);
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = A;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-  }
+  unpack_planar_10 (dest, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 0, TRUE, TRUE, flags);
 }
 
 static void
@@ -2785,25 +2581,8 @@ pack_A444_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict da = GET_A_LINE (y);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 A, Y, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width; i++) {
-    A = s[i * 4 + 0] >> 6;
-    Y = s[i * 4 + 1] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_BE (da + i, A);
-    GST_WRITE_UINT16_BE (dy + i, Y);
-    GST_WRITE_UINT16_BE (du + i, U);
-    GST_WRITE_UINT16_BE (dv + i, V);
-  }
+  pack_planar_10 (src, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 0, TRUE, TRUE, TRUE);
 }
 
 #define PACK_A420_10LE GST_VIDEO_FORMAT_AYUV64, unpack_A420_10LE, 1, pack_A420_10LE
@@ -2812,43 +2591,10 @@ unpack_A420_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  const guint16 *restrict sa = GET_A_LINE (y);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (uv);
-  const guint16 *restrict sv = GET_V_LINE (uv);
-  guint16 *restrict d = dest, A, Y, U, V;
 
-  sa += x;
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
-
-  for (i = 0; i < width; i++) {
-    A = GST_READ_UINT16_LE (sa + i) << 6;
-    Y = GST_READ_UINT16_LE (sy + i) << 6;
-    U = GST_READ_UINT16_LE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_LE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      A |= (A >> 10);
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = A;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), x, width, 1, TRUE, FALSE, flags);
 }
 
 static void
@@ -2857,50 +2603,10 @@ pack_A420_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  guint16 *restrict da = GET_A_LINE (y);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (uv);
-  guint16 *restrict dv = GET_V_LINE (uv);
-  guint16 A0, Y0, A1, Y1, U, V;
-  const guint16 *restrict s = src;
 
-  if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width - 1; i += 2) {
-      A0 = s[i * 4 + 0] >> 6;
-      Y0 = s[i * 4 + 1] >> 6;
-      A1 = s[i * 4 + 4] >> 6;
-      Y1 = s[i * 4 + 5] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_LE (da + i + 0, A0);
-      GST_WRITE_UINT16_LE (dy + i + 0, Y0);
-      GST_WRITE_UINT16_LE (da + i + 1, A1);
-      GST_WRITE_UINT16_LE (dy + i + 1, Y1);
-      GST_WRITE_UINT16_LE (du + (i >> 1), U);
-      GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-    }
-    if (i == width - 1) {
-      A0 = s[i * 4 + 0] >> 6;
-      Y0 = s[i * 4 + 1] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_LE (da + i, A0);
-      GST_WRITE_UINT16_LE (dy + i, Y0);
-      GST_WRITE_UINT16_LE (du + (i >> 1), U);
-      GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-    }
-  } else {
-    for (i = 0; i < width; i++) {
-      A0 = s[i * 4 + 0] >> 6;
-      Y0 = s[i * 4 + 1] >> 6;
-      GST_WRITE_UINT16_LE (da + i, A0);
-      GST_WRITE_UINT16_LE (dy + i, Y0);
-    }
-  }
+  pack_planar_10 (src, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), width, 1, IS_CHROMA_LINE_420 (y, flags), TRUE, FALSE);
 }
 
 #define PACK_A420_10BE GST_VIDEO_FORMAT_AYUV64, unpack_A420_10BE, 1, pack_A420_10BE
@@ -2909,43 +2615,10 @@ unpack_A420_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  const guint16 *restrict sa = GET_A_LINE (y);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (uv);
-  const guint16 *restrict sv = GET_V_LINE (uv);
-  guint16 *restrict d = dest, A, Y, U, V;
-
-  sa += x;
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
-
-  for (i = 0; i < width; i++) {
-    A = GST_READ_UINT16_BE (sa + i) << 6;
-    Y = GST_READ_UINT16_BE (sy + i) << 6;
-    U = GST_READ_UINT16_BE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_BE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      A |= (A >> 10);
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
 
-    d[i * 4 + 0] = A;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), x, width, 1, TRUE, TRUE, flags);
 }
 
 static void
@@ -2954,50 +2627,10 @@ pack_A420_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  guint16 *restrict da = GET_A_LINE (y);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (uv);
-  guint16 *restrict dv = GET_V_LINE (uv);
-  guint16 A0, Y0, A1, Y1, U, V;
-  const guint16 *restrict s = src;
 
-  if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width - 1; i += 2) {
-      A0 = s[i * 4 + 0] >> 6;
-      Y0 = s[i * 4 + 1] >> 6;
-      A1 = s[i * 4 + 4] >> 6;
-      Y1 = s[i * 4 + 5] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_BE (da + i + 0, A0);
-      GST_WRITE_UINT16_BE (dy + i + 0, Y0);
-      GST_WRITE_UINT16_BE (da + i + 1, A1);
-      GST_WRITE_UINT16_BE (dy + i + 1, Y1);
-      GST_WRITE_UINT16_BE (du + (i >> 1), U);
-      GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-    }
-    if (i == width - 1) {
-      A0 = s[i * 4 + 0] >> 6;
-      Y0 = s[i * 4 + 1] >> 6;
-      U = s[i * 4 + 2] >> 6;
-      V = s[i * 4 + 3] >> 6;
-
-      GST_WRITE_UINT16_BE (da + i, A0);
-      GST_WRITE_UINT16_BE (dy + i, Y0);
-      GST_WRITE_UINT16_BE (du + (i >> 1), U);
-      GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-    }
-  } else {
-    for (i = 0; i < width; i++) {
-      A0 = s[i * 4 + 0] >> 6;
-      Y0 = s[i * 4 + 1] >> 6;
-      GST_WRITE_UINT16_BE (da + i, A0);
-      GST_WRITE_UINT16_BE (dy + i, Y0);
-    }
-  }
+  pack_planar_10 (src, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (uv),
+      GET_V_LINE (uv), width, 1, IS_CHROMA_LINE_420 (y, flags), TRUE, TRUE);
 }
 
 #define PACK_A422_10LE GST_VIDEO_FORMAT_AYUV64, unpack_A422_10LE, 1, pack_A422_10LE
@@ -3006,42 +2639,8 @@ unpack_A422_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sa = GET_A_LINE (y);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (y);
-  const guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, A, Y, U, V;
-
-  sa += x;
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
-
-  for (i = 0; i < width; i++) {
-    A = GST_READ_UINT16_LE (sa + i) << 6;
-    Y = GST_READ_UINT16_LE (sy + i) << 6;
-    U = GST_READ_UINT16_LE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_LE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      A |= (A >> 10);
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = A;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 1, TRUE, FALSE, flags);
 }
 
 static void
@@ -3050,40 +2649,8 @@ pack_A422_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict da = GET_A_LINE (y);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 A0, Y0, A1, Y1, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width - 1; i += 2) {
-    A0 = s[i * 4 + 0] >> 6;
-    Y0 = s[i * 4 + 1] >> 6;
-    A1 = s[i * 4 + 4] >> 6;
-    Y1 = s[i * 4 + 5] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_LE (da + i + 0, A0);
-    GST_WRITE_UINT16_LE (dy + i + 0, Y0);
-    GST_WRITE_UINT16_LE (da + i + 1, A1);
-    GST_WRITE_UINT16_LE (dy + i + 1, Y1);
-    GST_WRITE_UINT16_LE (du + (i >> 1), U);
-    GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-  }
-  if (i == width - 1) {
-    A0 = s[i * 4 + 0] >> 6;
-    Y0 = s[i * 4 + 1] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_LE (da + i, A0);
-    GST_WRITE_UINT16_LE (dy + i, Y0);
-    GST_WRITE_UINT16_LE (du + (i >> 1), U);
-    GST_WRITE_UINT16_LE (dv + (i >> 1), V);
-  }
+  pack_planar_10 (src, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 1, TRUE, TRUE, FALSE);
 }
 
 #define PACK_A422_10BE GST_VIDEO_FORMAT_AYUV64, unpack_A422_10BE, 1, pack_A422_10BE
@@ -3092,42 +2659,8 @@ unpack_A422_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
-  const guint16 *restrict sa = GET_A_LINE (y);
-  const guint16 *restrict sy = GET_Y_LINE (y);
-  const guint16 *restrict su = GET_U_LINE (y);
-  const guint16 *restrict sv = GET_V_LINE (y);
-  guint16 *restrict d = dest, A, Y, U, V;
-
-  sa += x;
-  sy += x;
-  su += x >> 1;
-  sv += x >> 1;
-
-  for (i = 0; i < width; i++) {
-    A = GST_READ_UINT16_BE (sa + i) << 6;
-    Y = GST_READ_UINT16_BE (sy + i) << 6;
-    U = GST_READ_UINT16_BE (su + (i >> 1)) << 6;
-    V = GST_READ_UINT16_BE (sv + (i >> 1)) << 6;
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      A |= (A >> 10);
-      Y |= (Y >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 4 + 0] = A;
-    d[i * 4 + 1] = Y;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-
-    if (x & 1) {
-      x = 0;
-      su++;
-      sv++;
-    }
-  }
+  unpack_planar_10 (dest, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), x, width, 1, TRUE, TRUE, flags);
 }
 
 static void
@@ -3136,40 +2669,8 @@ pack_A422_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
-  guint16 *restrict da = GET_A_LINE (y);
-  guint16 *restrict dy = GET_Y_LINE (y);
-  guint16 *restrict du = GET_U_LINE (y);
-  guint16 *restrict dv = GET_V_LINE (y);
-  guint16 A0, Y0, A1, Y1, U, V;
-  const guint16 *restrict s = src;
-
-  for (i = 0; i < width - 1; i += 2) {
-    A0 = s[i * 4 + 0] >> 6;
-    Y0 = s[i * 4 + 1] >> 6;
-    A1 = s[i * 4 + 4] >> 6;
-    Y1 = s[i * 4 + 5] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_BE (da + i + 0, A0);
-    GST_WRITE_UINT16_BE (dy + i + 0, Y0);
-    GST_WRITE_UINT16_BE (da + i + 1, A1);
-    GST_WRITE_UINT16_BE (dy + i + 1, Y1);
-    GST_WRITE_UINT16_BE (du + (i >> 1), U);
-    GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-  }
-  if (i == width - 1) {
-    A0 = s[i * 4 + 0] >> 6;
-    Y0 = s[i * 4 + 1] >> 6;
-    U = s[i * 4 + 2] >> 6;
-    V = s[i * 4 + 3] >> 6;
-
-    GST_WRITE_UINT16_BE (da + i, A0);
-    GST_WRITE_UINT16_BE (dy + i, Y0);
-    GST_WRITE_UINT16_BE (du + (i >> 1), U);
-    GST_WRITE_UINT16_BE (dv + (i >> 1), V);
-  }
+  pack_planar_10 (src, GET_A_LINE (y), GET_Y_LINE (y), GET_U_LINE (y),
+      GET_V_LINE (y), width, 1, TRUE, TRUE, TRUE);
 }
 
 static void
@@ -3306,206 +2807,135 @@ pack_NV12_64Z32 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
   }
 }
 
-#define PACK_P010_10BE GST_VIDEO_FORMAT_AYUV64, unpack_P010_10BE, 1, pack_P010_10BE
-static void
-unpack_P010_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
-    gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
-    const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
+/* P010 is handled like the planar 10 bit formats, see unpack_planar_10(),
+ * except that the samples are stored in the high bits */
+static inline guint16
+read_p010 (guint16 v, gboolean be, guint16 mask)
 {
-  int i;
-  gint uv = GET_UV_420 (y, flags);
-  const guint16 *restrict sy = GET_PLANE_LINE (0, y);
-  const guint16 *restrict suv = GET_PLANE_LINE (1, uv);
-  guint16 *restrict d = dest, Y0, Y1, U, V;
+  v = READ_U16 (v, be);
+
+  return v | ((v >> 10) & mask);
+}
+
+static inline void
+unpack_P010 (guint16 * restrict d, const guint16 * restrict sy,
+    const guint16 * restrict suv, gint x, gint width, gboolean be,
+    GstVideoPackFlags flags)
+{
+  guint16 mask;
+  gint i, j, c, n;
+
+  mask = (flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE) ? 0 : 0xffff;
 
   sy += x;
   suv += (x & ~1);
 
-  if (x & 1) {
-    Y0 = GST_READ_UINT16_BE (sy);
-    U = GST_READ_UINT16_BE (suv);
-    V = GST_READ_UINT16_BE (suv + 1);
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y0 |= (Y0 >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
+  /* an odd first pixel uses the chroma of the pair it belongs to */
+  if ((x & 1) && width > 0) {
     d[0] = 0xffff;
-    d[1] = Y0;
-    d[2] = U;
-    d[3] = V;
-    width--;
+    d[1] = read_p010 (sy[0], be, mask);
+    d[2] = read_p010 (suv[0], be, mask);
+    d[3] = read_p010 (suv[1], be, mask);
     d += 4;
-    sy += 1;
+    sy++;
     suv += 2;
+    width--;
   }
 
-  for (i = 0; i < width / 2; i++) {
-    Y0 = GST_READ_UINT16_BE (sy + 2 * i);
-    Y1 = GST_READ_UINT16_BE (sy + 2 * i + 1);
-    U = GST_READ_UINT16_BE (suv + 2 * i);
-    V = GST_READ_UINT16_BE (suv + 2 * i + 1);
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y0 |= (Y0 >> 10);
-      Y1 |= (Y1 >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
+  n = width & ~(LINE_BLOCK - 1);
+  for (i = 0; i < n; i += LINE_BLOCK) {
+    guint16 Y[LINE_BLOCK], UV[LINE_BLOCK];
+    guint16 *restrict b = d + i * 4;
+
+    for (j = 0; j < LINE_BLOCK; j++) {
+      Y[j] = read_p010 (sy[i + j], be, mask);
+      UV[j] = read_p010 (suv[i + j], be, mask);
     }
 
-    d[i * 8 + 0] = 0xffff;
-    d[i * 8 + 1] = Y0;
-    d[i * 8 + 2] = U;
-    d[i * 8 + 3] = V;
-    d[i * 8 + 4] = 0xffff;
-    d[i * 8 + 5] = Y1;
-    d[i * 8 + 6] = U;
-    d[i * 8 + 7] = V;
+    /* both pixels of a pair share the UV sample pair */
+    for (j = 0; j < LINE_BLOCK / 2; j++) {
+      b[j * 8 + 0] = 0xffff;
+      b[j * 8 + 1] = Y[j * 2 + 0];
+      b[j * 8 + 2] = UV[j * 2 + 0];
+      b[j * 8 + 3] = UV[j * 2 + 1];
+      b[j * 8 + 4] = 0xffff;
+      b[j * 8 + 5] = Y[j * 2 + 1];
+      b[j * 8 + 6] = UV[j * 2 + 0];
+      b[j * 8 + 7] = UV[j * 2 + 1];
+    }
   }
 
-  if (width & 1) {
-    gint i = width - 1;
-
-    Y0 = GST_READ_UINT16_BE (sy + i);
-    U = GST_READ_UINT16_BE (suv + i);
-    V = GST_READ_UINT16_BE (suv + i + 1);
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y0 |= (Y0 >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
+  for (; i < width; i++) {
+    c = i & ~1;
 
     d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y0;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
+    d[i * 4 + 1] = read_p010 (sy[i], be, mask);
+    d[i * 4 + 2] = read_p010 (suv[c + 0], be, mask);
+    d[i * 4 + 3] = read_p010 (suv[c + 1], be, mask);
   }
 }
 
-static void
-pack_P010_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
-    const gpointer src, gint sstride, gpointer data[GST_VIDEO_MAX_PLANES],
-    const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
-    gint y, gint width)
+static inline void
+pack_P010 (const guint16 * restrict s, guint16 * restrict dy,
+    guint16 * restrict duv, gint width, gboolean chroma, gboolean be)
 {
-  int i;
-  gint uv = GET_UV_420 (y, flags);
-  guint16 *restrict dy = GET_PLANE_LINE (0, y);
-  guint16 *restrict duv = GET_PLANE_LINE (1, uv);
-  guint16 Y0, Y1, U, V;
-  const guint16 *restrict s = src;
+  gint i;
 
-  if (IS_CHROMA_LINE_420 (y, flags)) {
+  if (chroma) {
+    /* one pass over the pixel pairs, the chroma of the first pixel of each
+     * pair is kept */
     for (i = 0; i < width / 2; i++) {
-      Y0 = s[i * 8 + 1] & 0xffc0;
-      Y1 = s[i * 8 + 5] & 0xffc0;
-      U = s[i * 8 + 2] & 0xffc0;
-      V = s[i * 8 + 3] & 0xffc0;
-
-      GST_WRITE_UINT16_BE (dy + i * 2 + 0, Y0);
-      GST_WRITE_UINT16_BE (dy + i * 2 + 1, Y1);
-      GST_WRITE_UINT16_BE (duv + i * 2 + 0, U);
-      GST_WRITE_UINT16_BE (duv + i * 2 + 1, V);
+      dy[i * 2 + 0] = WRITE_U16 (s[i * 8 + 1] & 0xffc0, be);
+      dy[i * 2 + 1] = WRITE_U16 (s[i * 8 + 5] & 0xffc0, be);
+      duv[i * 2 + 0] = WRITE_U16 (s[i * 8 + 2] & 0xffc0, be);
+      duv[i * 2 + 1] = WRITE_U16 (s[i * 8 + 3] & 0xffc0, be);
     }
     if (width & 1) {
-      gint i = width - 1;
-
-      Y0 = s[i * 4 + 1] & 0xffc0;
-      U = s[i * 4 + 2] & 0xffc0;
-      V = s[i * 4 + 3] & 0xffc0;
-
-      GST_WRITE_UINT16_BE (dy + i, Y0);
-      GST_WRITE_UINT16_BE (duv + i + 0, U);
-      GST_WRITE_UINT16_BE (duv + i + 1, V);
+      i = width - 1;
+      dy[i] = WRITE_U16 (s[i * 4 + 1] & 0xffc0, be);
+      duv[i + 0] = WRITE_U16 (s[i * 4 + 2] & 0xffc0, be);
+      duv[i + 1] = WRITE_U16 (s[i * 4 + 3] & 0xffc0, be);
     }
   } else {
-    for (i = 0; i < width; i++) {
-      Y0 = s[i * 4 + 1] & 0xffc0;
-      GST_WRITE_UINT16_BE (dy + i, Y0);
-    }
+    for (i = 0; i < width; i++)
+      dy[i] = WRITE_U16 (s[i * 4 + 1] & 0xffc0, be);
   }
 }
 
-#define PACK_P010_10LE GST_VIDEO_FORMAT_AYUV64, unpack_P010_10LE, 1, pack_P010_10LE
+#define PACK_P010_10BE GST_VIDEO_FORMAT_AYUV64, unpack_P010_10BE, 1, pack_P010_10BE
 static void
-unpack_P010_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
+unpack_P010_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
     const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  const guint16 *restrict sy = GET_PLANE_LINE (0, y);
-  const guint16 *restrict suv = GET_PLANE_LINE (1, uv);
-  guint16 *restrict d = dest, Y0, Y1, U, V;
 
-  sy += x;
-  suv += (x & ~1);
-
-  if (x & 1) {
-    Y0 = GST_READ_UINT16_LE (sy);
-    U = GST_READ_UINT16_LE (suv);
-    V = GST_READ_UINT16_LE (suv + 1);
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y0 |= (Y0 >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[0] = 0xffff;
-    d[1] = Y0;
-    d[2] = U;
-    d[3] = V;
-    width--;
-    d += 4;
-    sy += 1;
-    suv += 2;
-  }
-
-  for (i = 0; i < width / 2; i++) {
-    Y0 = GST_READ_UINT16_LE (sy + 2 * i);
-    Y1 = GST_READ_UINT16_LE (sy + 2 * i + 1);
-    U = GST_READ_UINT16_LE (suv + 2 * i);
-    V = GST_READ_UINT16_LE (suv + 2 * i + 1);
-
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y0 |= (Y0 >> 10);
-      Y1 |= (Y1 >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
-
-    d[i * 8 + 0] = 0xffff;
-    d[i * 8 + 1] = Y0;
-    d[i * 8 + 2] = U;
-    d[i * 8 + 3] = V;
-    d[i * 8 + 4] = 0xffff;
-    d[i * 8 + 5] = Y1;
-    d[i * 8 + 6] = U;
-    d[i * 8 + 7] = V;
-  }
+  unpack_P010 (dest, GET_PLANE_LINE (0, y), GET_PLANE_LINE (1, uv), x, width,
+      TRUE, flags);
+}
 
-  if (width & 1) {
-    gint i = width - 1;
+static void
+pack_P010_10BE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
+    const gpointer src, gint sstride, gpointer data[GST_VIDEO_MAX_PLANES],
+    const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
+    gint y, gint width)
+{
+  gint uv = GET_UV_420 (y, flags);
 
-    Y0 = GST_READ_UINT16_LE (sy + i);
-    U = GST_READ_UINT16_LE (suv + i);
-    V = GST_READ_UINT16_LE (suv + i + 1);
+  pack_P010 (src, GET_PLANE_LINE (0, y), GET_PLANE_LINE (1, uv), width,
+      IS_CHROMA_LINE_420 (y, flags), TRUE);
+}
 
-    if (!(flags & GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE)) {
-      Y0 |= (Y0 >> 10);
-      U |= (U >> 10);
-      V |= (V >> 10);
-    }
+#define PACK_P010_10LE GST_VIDEO_FORMAT_AYUV64, unpack_P010_10LE, 1, pack_P010_10LE
+static void
+unpack_P010_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
+    gpointer dest, const gpointer data[GST_VIDEO_MAX_PLANES],
+    const gint stride[GST_VIDEO_MAX_PLANES], gint x, gint y, gint width)
+{
+  gint uv = GET_UV_420 (y, flags);
 
-    d[i * 4 + 0] = 0xffff;
-    d[i * 4 + 1] = Y0;
-    d[i * 4 + 2] = U;
-    d[i * 4 + 3] = V;
-  }
+  unpack_P010 (dest, GET_PLANE_LINE (0, y), GET_PLANE_LINE (1, uv), x, width,
+      FALSE, flags);
 }
 
 static void
@@ -3514,42 +2944,10 @@ pack_P010_10LE (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     const gint stride[GST_VIDEO_MAX_PLANES], GstVideoChromaSite chroma_site,
     gint y, gint width)
 {
-  int i;
   gint uv = GET_UV_420 (y, flags);
-  guint16 *restrict dy = GET_PLANE_LINE (0, y);
-  guint16 *restrict duv = GET_PLANE_LINE (1, uv);
-  guint16 Y0, Y1, U, V;
-  const guint16 *restrict s = src;
-
-  if (IS_CHROMA_LINE_420 (y, flags)) {
-    for (i = 0; i < width / 2; i++) {
-      Y0 = s[i * 8 + 1] & 0xffc0;
-      Y1 = s[i * 8 + 5] & 0xffc0;
-      U = s[i * 8 + 2] & 0xffc0;
-      V = s[i * 8 + 3] & 0xffc0;
-
-      GST_WRITE_UINT16_LE (dy + i * 2 + 0, Y0);
-      GST_WRITE_UINT16_LE (dy + i * 2 + 1, Y1);
-      GST_WRITE_UINT16_LE (duv + i * 2 + 0, U);
-      GST_WRITE_UINT16_LE (duv + i * 2 + 1, V);
-    }
-    if (width & 1) {
-      gint i = width - 1;
-
-      Y0 = s[i * 4 + 1] & 0xffc0;
-      U = s[i * 4 + 2] & 0xffc0;
-      V = s[i * 4 + 3] & 0xffc0;
 
-      GST_WRITE_UINT16_LE (dy + i, Y0);
-      GST_WRITE_UINT16_LE (duv + i + 0, U);
-      GST_WRITE_UINT16_LE (duv + i + 1, V);
-    }
-  } else {
-    for (i = 0; i < width; i++) {
-      Y0 = s[i * 4 + 1] & 0xffc0;
-      GST_WRITE_UINT16_LE (dy + i, Y0);
-    }
-  }
+  pack_P010 (src, GET_PLANE_LINE (0, y), GET_PLANE_LINE (1, uv), width,
+      IS_CHROMA_LINE_420 (y, flags), FALSE);
 }
 
 typedef struct
@@ -68,6 +68,7 @@
 #include "video-overlay-composition.h"
 #include "video-blend.h"
 #include "gstvideometa.h"
+#include "gstvideoutilsprivate.h"
 #include <string.h>
 
 struct _GstVideoOverlayComposition
@@ -144,6 +145,13 @@ struct _GstVideoOverlayRectangle
   GMutex lock;
 
   GList *scaled_rectangles;
+
+  /* GstVideoBlendCache for gst_video_overlay_composition_blend(), for the
+   * current render size, per destination color space */
+  GList *blend_caches;
+  /* like seq_num, but only changes when the pixel data changes and not
+   * with the global alpha. Keys the blend caches. */
+  guint pixels_seq_num;
 };
 
 #define GST_RECTANGLE_LOCK(rect)   g_mutex_lock(&rect->lock)
@@ -451,6 +459,75 @@ gst_video_overlay_rectangle_needs_scaling (GstVideoOverlayRectangle * r)
       GST_VIDEO_INFO_HEIGHT (&r->info) != r->render_height);
 }
 
+/* returns a ref to the blend cache of @rect for its current render size,
+ * making a new one if needed. Caches are dropped when the pixel data or the
+ * render size of the rectangle changes. */
+static GstVideoBlendCache *
+gst_video_overlay_rectangle_get_blend_cache (GstVideoOverlayRectangle * rect,
+    gboolean dest_rgb)
+{
+  GstVideoBlendCache *cache = NULL;
+  GstVideoInfo scaled_info;
+  GstVideoInfo *vinfo;
+  GstVideoFrame frame;
+  GstBuffer *pixels = NULL, *scaled;
+  GList *l, *next;
+  guint seq_num = 0;
+
+  GST_RECTANGLE_LOCK (rect);
+  for (l = rect->blend_caches; l != NULL; l = next) {
+    GstVideoBlendCache *c = l->data;
+
+    next = l->next;
+    if (c->seq_num != rect->pixels_seq_num || c->width != rect->render_width
+        || c->height != rect->render_height) {
+      __gst_video_blend_cache_unref (c);
+      rect->blend_caches = g_list_delete_link (rect->blend_caches, l);
+    } else if (cache == NULL && c->dest_rgb == dest_rgb) {
+      cache = __gst_video_blend_cache_ref (c);
+    }
+  }
+  if (cache == NULL) {
+    /* our ref keeps the pixels from being changed in place */
+    pixels = gst_buffer_ref (rect->pixels);
+    seq_num = rect->pixels_seq_num;
+  }
+  GST_RECTANGLE_UNLOCK (rect);
+
+  if (cache)
+    return cache;
+
+  if (gst_video_overlay_rectangle_needs_scaling (rect)) {
+    gst_video_blend_scale_linear_RGBA (&rect->info, pixels,
+        rect->render_height, rect->render_width, &scaled_info, &scaled);
+    gst_buffer_unref (pixels);
+    pixels = scaled;
+    vinfo = &scaled_info;
+  } else {
+    vinfo = &rect->info;
+  }
+
+  if (gst_video_frame_map (&frame, vinfo, pixels, GST_MAP_READ)) {
+    cache = __gst_video_blend_cache_new (&frame, dest_rgb);
+    gst_video_frame_unmap (&frame);
+  }
+  gst_buffer_unref (pixels);
+
+  if (cache == NULL)
+    return NULL;
+
+  GST_LOG ("rectangle %p: new blend cache %dx%d, rgb %d", rect, cache->width,
+      cache->height, dest_rgb);
+
+  cache->seq_num = seq_num;
+  GST_RECTANGLE_LOCK (rect);
+  rect->blend_caches = g_list_prepend (rect->blend_caches,
+      __gst_video_blend_cache_ref (cache));
+  GST_RECTANGLE_UNLOCK (rect);
+
+  return cache;
+}
+
 /**
  * gst_video_overlay_composition_blend:
  * @comp: a #GstVideoOverlayComposition
@@ -468,12 +545,9 @@ gboolean
 gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
     GstVideoFrame * video_buf)
 {
-  GstVideoInfo scaled_info;
-  GstVideoInfo *vinfo;
-  GstVideoFrame rectangle_frame;
   GstVideoFormat fmt;
-  GstBuffer *pixels = NULL;
   gboolean ret = TRUE;
+  gboolean dest_rgb;
   guint n, num;
   int w, h;
 
@@ -483,6 +557,7 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
   w = GST_VIDEO_FRAME_WIDTH (video_buf);
   h = GST_VIDEO_FRAME_HEIGHT (video_buf);
   fmt = GST_VIDEO_FRAME_FORMAT (video_buf);
+  dest_rgb = GST_VIDEO_INFO_IS_RGB (&video_buf->info);
 
   num = comp->num_rectangles;
   GST_LOG ("Blending composition %p with %u rectangles onto video buffer %p "
@@ -490,7 +565,7 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
 
   for (n = 0; n < num; ++n) {
     GstVideoOverlayRectangle *rect;
-    gboolean needs_scaling;
+    GstVideoBlendCache *cache;
 
     rect = comp->rectangles[n];
 
@@ -498,27 +573,20 @@ gst_video_overlay_composition_blend (GstVideoOverlayComposition * comp,
         GST_VIDEO_INFO_WIDTH (&rect->info), GST_VIDEO_INFO_HEIGHT (&rect->info),
         GST_VIDEO_INFO_FORMAT (&rect->info));
 
-    needs_scaling = gst_video_overlay_rectangle_needs_scaling (rect);
-    if (needs_scaling) {
-      gst_video_blend_scale_linear_RGBA (&rect->info, rect->pixels,
-          rect->render_height, rect->render_width, &scaled_info, &pixels);
-      vinfo = &scaled_info;
+    /* the converted and scaled pixels are kept in the rectangle so that
+     * blending the same rectangle again is cheap */
+    cache = gst_video_overlay_rectangle_get_blend_cache (rect, dest_rgb);
+    if (cache) {
+      ret = __gst_video_blend_cached (video_buf, cache, rect->x, rect->y,
+          rect->global_alpha);
+      __gst_video_blend_cache_unref (cache);
     } else {
-      pixels = gst_buffer_ref (rect->pixels);
-      vinfo = &rect->info;
+      ret = FALSE;
     }
 
-    gst_video_frame_map (&rectangle_frame, vinfo, pixels, GST_MAP_READ);
-
-    ret = gst_video_blend (video_buf, &rectangle_frame, rect->x, rect->y,
-        rect->global_alpha);
-    gst_video_frame_unmap (&rectangle_frame);
     if (!ret) {
       GST_WARNING ("Could not blend overlay rectangle onto video buffer");
     }
-
-    /* FIXME: should cache scaled pixels in the rectangle struct */
-    gst_buffer_unref (pixels);
   }
 
   return ret;
@@ -640,6 +708,9 @@ gst_video_overlay_rectangle_free (GstMiniObject * mini_obj)
         g_list_delete_link (rect->scaled_rectangles, rect->scaled_rectangles);
   }
 
+  g_list_free_full (rect->blend_caches,
+      (GDestroyNotify) __gst_video_blend_cache_unref);
+
   g_free (rect->initial_alpha);
   g_mutex_clear (&rect->lock);
 
@@ -749,6 +820,7 @@ gst_video_overlay_rectangle_new_raw (GstBuffer * pixels,
   rect->flags = flags;
 
   rect->seq_num = gst_video_overlay_get_seqnum ();
+  rect->pixels_seq_num = rect->seq_num;
 
   GST_LOG ("new rectangle %p: %ux%u => %ux%u @ %u,%u, seq_num %u, format %u, "
       "flags %x, pixels %p, global_alpha=%f", rect, width, height, render_width,
@@ -1035,6 +1107,7 @@ gst_video_overlay_rectangle_apply_global_alpha (GstVideoOverlayRectangle * rect,
   gst_video_frame_unmap (&frame);
 
   rect->applied_global_alpha = global_alpha;
+  rect->pixels_seq_num = gst_video_overlay_get_seqnum ();
 }
 
 static void
@@ -92,6 +92,9 @@ struct _GstVideoScaler
   gint in_y_offset;
   gint out_y_offset;
 
+  /* use the fused C kernels for 4, 6 and 8 taps */
+  gboolean fused;
+
   /* cached integer coefficients */
   gint16 *taps_s16;
   gint16 *taps_s16_4;
@@ -218,6 +221,11 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
 
   scale->method = method;
   scale->flags = flags;
+  scale->fused = FALSE;
+
+  if (options)
+    gst_structure_get_boolean (options, GST_VIDEO_SCALER_OPT_FUSED_TAPS,
+        &scale->fused);
 
   if (flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
     GstVideoResampler tresamp, bresamp;
@@ -439,6 +447,73 @@ make_s16_taps (GstVideoScaler * scale, gint n_elems, gint precision)
 
 #undef ACC_SCALE
 
+/* Fused multi-tap kernels. The ORC programs handle at most 3 or 4 taps per
+ * call and accumulate the remaining taps in a temporary line, which means
+ * another pass over the line for every extra tap. These do all taps in one
+ * pass. They are always called with a constant @n_taps so that the compiler
+ * unrolls the inner loop and vectorizes over the pixels.
+ *
+ * The arithmetic matches the ORC versions exactly: the 8 bit low quality
+ * path wraps around in 16 bits, the 16 bit path in 32 bits. */
+static inline void
+resample_v_taps_u8_lq (guint8 * d, const guint8 ** s, const gint16 * taps,
+    gint n_taps, gint count)
+{
+  gint i, j;
+
+  for (i = 0; i < count; i++) {
+    guint16 sum = 0;
+    gint16 w;
+
+    for (j = 0; j < n_taps; j++)
+      sum += (guint16) (s[j][i] * taps[j]);
+
+    w = (gint16) (guint16) (sum + SCALE_U8_LQ_ROUND);
+    w >>= SCALE_U8_LQ;
+    d[i] = CLAMP (w, 0, 255);
+  }
+}
+
+static inline void
+resample_v_taps_u16 (guint16 * d, const guint16 ** s, const gint16 * taps,
+    gint n_taps, gint count)
+{
+  gint i, j;
+
+  for (i = 0; i < count; i++) {
+    guint32 sum = 0;
+    gint32 l;
+
+    for (j = 0; j < n_taps; j++)
+      sum += (guint32) ((gint32) s[j][i] * taps[j]);
+
+    l = (gint32) (sum + (1 << SCALE_U16) - 1);
+    l >>= SCALE_U16;
+    d[i] = CLAMP (l, 0, 65535);
+  }
+}
+
+/* @pixels and @taps contain @n_taps blocks of @count elements, one for each
+ * tap, as prepared by video_scale_h_ntap_u16() */
+static inline void
+resample_h_taps_u16 (guint16 * d, const guint16 * pixels, const gint16 * taps,
+    gint n_taps, gint count)
+{
+  gint i, j;
+
+  for (i = 0; i < count; i++) {
+    guint32 sum = 0;
+    gint32 l;
+
+    for (j = 0; j < n_taps; j++)
+      sum += (guint32) ((gint32) pixels[j * count + i] * taps[j * count + i]);
+
+    l = (gint32) (sum + (1 << SCALE_U16) - 1);
+    l >>= SCALE_U16;
+    d[i] = CLAMP (l, 0, 65535);
+  }
+}
+
 static void
 video_scale_h_near_u8 (GstVideoScaler * scale,
     gpointer src, gpointer dest, guint dest_offset, guint width, guint n_elems)
@@ -800,17 +875,30 @@ video_scale_h_ntap_u16 (GstVideoScaler * scale,
   taps = scale->taps_s16_4;
   count = width * n_elems;
 
-  if (max_taps == 2) {
-    video_orc_resample_h_2tap_u16 (d, pixels, pixels + count, taps,
-        taps + count, count);
-  } else {
-    /* first pixels with first tap to t4 */
-    video_orc_resample_h_multaps_u16 (temp, pixels, taps, count);
-    /* add other pixels with other taps to t4 */
-    video_orc_resample_h_muladdtaps_u16 (temp, 0, pixels + count, count * 2,
-        taps + count, count * 2, count, max_taps - 1);
-    /* scale and write final result */
-    video_orc_resample_scaletaps_u16 (d, temp, count);
+  /* without the fused kernels, only 2 taps has its own ORC program */
+  switch (scale->fused || max_taps == 2 ? max_taps : 0) {
+    case 2:
+      video_orc_resample_h_2tap_u16 (d, pixels, pixels + count, taps,
+          taps + count, count);
+      break;
+    case 4:
+      resample_h_taps_u16 (d, pixels, taps, 4, count);
+      break;
+    case 6:
+      resample_h_taps_u16 (d, pixels, taps, 6, count);
+      break;
+    case 8:
+      resample_h_taps_u16 (d, pixels, taps, 8, count);
+      break;
+    default:
+      /* first pixels with first tap to t4 */
+      video_orc_resample_h_multaps_u16 (temp, pixels, taps, count);
+      /* add other pixels with other taps to t4 */
+      video_orc_resample_h_muladdtaps_u16 (temp, 0, pixels + count, count * 2,
+          taps + count, count * 2, count, max_taps - 1);
+      /* scale and write final result */
+      video_orc_resample_scaletaps_u16 (d, temp, count);
+      break;
   }
 }
 
@@ -1003,6 +1091,15 @@ video_scale_v_ntap_u8 (GstVideoScaler * scale,
   count = width * n_elems;
 
 #ifdef LQ
+  if (max_taps == 6 && scale->fused) {
+    const guint8 *s[6];
+
+    for (i = 0; i < 6; i++)
+      s[i] = srcs[i * src_inc];
+    resample_v_taps_u8_lq (d, s, taps, 6, count);
+    return;
+  }
+
   if (max_taps >= 4) {
     video_orc_resample_v_multaps4_u8_lq (temp, srcs[0], srcs[1 * src_inc],
         srcs[2 * src_inc], srcs[3 * src_inc], taps[0], taps[1], taps[2],
@@ -1086,6 +1183,27 @@ video_scale_v_ntap_u16 (GstVideoScaler * scale,
   temp = (gint32 *) scale->tmpline2;
   count = width * n_elems;
 
+  if (scale->fused && (max_taps == 4 || max_taps == 6 || max_taps == 8)) {
+    const guint16 *s[8];
+
+    for (i = 0; i < max_taps; i++)
+      s[i] = srcs[i * src_inc];
+
+    switch (max_taps) {
+      case 4:
+        resample_v_taps_u16 (d, s, taps, 4, count);
+        return;
+      case 6:
+        resample_v_taps_u16 (d, s, taps, 6, count);
+        return;
+      case 8:
+        resample_v_taps_u16 (d, s, taps, 8, count);
+        return;
+      default:
+        break;
+    }
+  }
+
   video_orc_resample_v_multaps_u16 (temp, srcs[0], taps[0], count);
   for (i = 1; i < max_taps; i++) {
     video_orc_resample_v_muladdtaps_u16 (temp, srcs[i * src_inc], taps[i],
@@ -1140,6 +1258,7 @@ gst_video_scaler_combine_packed_YUV (GstVideoScaler * y_scale,
 
   scale->method = y_scale->method;
   scale->flags = y_scale->flags;
+  scale->fused = y_scale->fused;
   scale->merged = TRUE;
 
   resampler = &scale->resampler;
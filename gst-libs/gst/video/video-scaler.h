@@ -36,6 +36,20 @@ G_BEGIN_DECLS
  */
 #define GST_VIDEO_SCALER_OPT_DITHER_METHOD   "GstVideoScaler.dither-method"
 
+/**
+ * GST_VIDEO_SCALER_OPT_FUSED_TAPS:
+ *
+ * #G_TYPE_BOOLEAN, use the single pass C kernels for 4, 6 and 8 tap
+ * filters instead of the ORC programs. Both produce identical output. The
+ * C kernels can be faster when ORC has no SIMD backend for the target or
+ * when the C code is built with auto-vectorization, the ORC programs are
+ * faster otherwise.
+ * Default is %FALSE.
+ *
+ * Since: 1.10
+ */
+#define GST_VIDEO_SCALER_OPT_FUSED_TAPS      "GstVideoScaler.fused-taps"
+
 /**
  * GstVideoScalerFlags:
  * @GST_VIDEO_SCALER_FLAG_NONE: no flags
@@ -891,6 +891,7 @@ gst_adder_init (GstAdder * adder)
   adder->padcount = 0;
 
   adder->filter_caps = NULL;
+  adder->mix_inputs = g_array_new (FALSE, FALSE, sizeof (GstAdderInput));
 
   /* keep track of the sinkpads requested */
   adder->collect = gst_collect_pads_new ();
@@ -916,6 +917,11 @@ gst_adder_dispose (GObject * object)
   gst_caps_replace (&adder->filter_caps, NULL);
   gst_caps_replace (&adder->current_caps, NULL);
 
+  if (adder->mix_inputs) {
+    g_array_free (adder->mix_inputs, TRUE);
+    adder->mix_inputs = NULL;
+  }
+
   if (adder->pending_events) {
     g_list_foreach (adder->pending_events, (GFunc) gst_event_unref, NULL);
     g_list_free (adder->pending_events);
@@ -1060,6 +1066,157 @@ gst_adder_do_clip (GstCollectPads * pads, GstCollectData * data,
   return GST_FLOW_OK;
 }
 
+/* the output buffer is mixed in blocks of this many bytes. Every input is
+ * added to a block before moving on to the next one, so that the block stays
+ * in the cache and the output is only streamed to memory once, no matter
+ * how many pads are mixed. Must be a multiple of the largest sample size. */
+#define MIX_BLOCK_SIZE 4096
+
+static void
+gst_adder_input_set_volume (GstAdderInput * input, GstAdderPad * pad)
+{
+  input->volume = pad->volume;
+  input->volume_i8 = pad->volume_i8;
+  input->volume_i16 = pad->volume_i16;
+  input->volume_i32 = pad->volume_i32;
+}
+
+/* scale @n_samples samples in @data with the volume of @input */
+static void
+gst_adder_apply_volume (GstAdder * adder, gpointer data,
+    const GstAdderInput * input, gint n_samples)
+{
+  switch (adder->info.finfo->format) {
+    case GST_AUDIO_FORMAT_U8:
+      adder_orc_volume_u8 (data, input->volume_i8, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_S8:
+      adder_orc_volume_s8 (data, input->volume_i8, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_U16:
+      adder_orc_volume_u16 (data, input->volume_i16, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_S16:
+      adder_orc_volume_s16 (data, input->volume_i16, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_U32:
+      adder_orc_volume_u32 (data, input->volume_i32, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      adder_orc_volume_s32 (data, input->volume_i32, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      adder_orc_volume_f32 (data, input->volume, n_samples);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      adder_orc_volume_f64 (data, input->volume, n_samples);
+      break;
+    default:
+      g_assert_not_reached ();
+      break;
+  }
+}
+
+/* add @n_samples samples from @src, scaled with the volume of @input, to
+ * @dest */
+static void
+gst_adder_add (GstAdder * adder, gpointer dest, gconstpointer src,
+    const GstAdderInput * input, gint n_samples)
+{
+  if (input->volume == 1.0) {
+    switch (adder->info.finfo->format) {
+      case GST_AUDIO_FORMAT_U8:
+        adder_orc_add_u8 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_S8:
+        adder_orc_add_s8 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_U16:
+        adder_orc_add_u16 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_S16:
+        adder_orc_add_s16 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_U32:
+        adder_orc_add_u32 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_S32:
+        adder_orc_add_s32 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_F32:
+        adder_orc_add_f32 (dest, src, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_F64:
+        adder_orc_add_f64 (dest, src, n_samples);
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  } else {
+    switch (adder->info.finfo->format) {
+      case GST_AUDIO_FORMAT_U8:
+        adder_orc_add_volume_u8 (dest, src, input->volume_i8, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_S8:
+        adder_orc_add_volume_s8 (dest, src, input->volume_i8, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_U16:
+        adder_orc_add_volume_u16 (dest, src, input->volume_i16, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_S16:
+        adder_orc_add_volume_s16 (dest, src, input->volume_i16, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_U32:
+        adder_orc_add_volume_u32 (dest, src, input->volume_i32, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_S32:
+        adder_orc_add_volume_s32 (dest, src, input->volume_i32, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_F32:
+        adder_orc_add_volume_f32 (dest, src, input->volume, n_samples);
+        break;
+      case GST_AUDIO_FORMAT_F64:
+        adder_orc_add_volume_f64 (dest, src, input->volume, n_samples);
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+  }
+}
+
+/* mix @n_inputs inputs into @out, which already contains the samples of
+ * @first. The output is processed in cache sized blocks so that it is only
+ * written once, with the volume of every input folded into the add. */
+static void
+gst_adder_mix (GstAdder * adder, guint8 * out, gsize size,
+    const GstAdderInput * first, const GstAdderInput * inputs, guint n_inputs)
+{
+  gsize offset, len;
+  gint bps;
+  guint i;
+
+  if (n_inputs == 0 && first->volume == 1.0)
+    return;
+
+  bps = GST_AUDIO_INFO_BPS (&adder->info);
+
+  GST_LOG_OBJECT (adder, "mixing %u inputs into %" G_GSIZE_FORMAT " bytes",
+      n_inputs + 1, size);
+
+  for (offset = 0; offset < size; offset += len) {
+    len = MIN (size - offset, MIX_BLOCK_SIZE);
+
+    if (first->volume != 1.0)
+      gst_adder_apply_volume (adder, out + offset, first, len / bps);
+
+    for (i = 0; i < n_inputs; i++)
+      gst_adder_add (adder, out + offset, inputs[i].map.data + offset,
+          &inputs[i], len / bps);
+  }
+}
+
 static GstFlowReturn
 gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 {
@@ -1084,6 +1241,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   GstFlowReturn ret;
   GstBuffer *outbuf = NULL, *gapbuf = NULL;
   GstMapInfo outmap = { NULL };
+  GstAdderInput first = { NULL, };
   guint outsize;
   gint64 next_offset;
   gint64 next_timestamp;
@@ -1253,149 +1411,54 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
       outbuf = gst_buffer_make_writable (inbuf);
       gst_buffer_map (outbuf, &outmap, GST_MAP_READWRITE);
 
-      if (pad->volume != 1.0) {
-        switch (adder->info.finfo->format) {
-          case GST_AUDIO_FORMAT_U8:
-            adder_orc_volume_u8 ((gpointer) outmap.data, pad->volume_i8,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S8:
-            adder_orc_volume_s8 ((gpointer) outmap.data, pad->volume_i8,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_U16:
-            adder_orc_volume_u16 ((gpointer) outmap.data, pad->volume_i16,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S16:
-            adder_orc_volume_s16 ((gpointer) outmap.data, pad->volume_i16,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_U32:
-            adder_orc_volume_u32 ((gpointer) outmap.data, pad->volume_i32,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_S32:
-            adder_orc_volume_s32 ((gpointer) outmap.data, pad->volume_i32,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_F32:
-            adder_orc_volume_f32 ((gpointer) outmap.data, pad->volume,
-                outmap.size / bps);
-            break;
-          case GST_AUDIO_FORMAT_F64:
-            adder_orc_volume_f64 ((gpointer) outmap.data, pad->volume,
-                outmap.size / bps);
-            break;
-          default:
-            g_assert_not_reached ();
-            break;
-        }
-      }
+      /* the output buffer itself is the first input of the mix */
+      first.buffer = NULL;
+      first.map = outmap;
+      gst_adder_input_set_volume (&first, pad);
     } else {
       if (!is_gap) {
-        /* we had a previous output buffer, mix this non-GAP buffer */
-        GstMapInfo inmap;
+        /* we had a previous output buffer, queue this non-GAP buffer for
+         * mixing once all pads are collected */
+        GstAdderInput input;
 
-        gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
+        gst_buffer_map (inbuf, &input.map, GST_MAP_READ);
 
         /* all buffers should have outsize, there are no short buffers because we
          * asked for the max size above */
-        g_assert (inmap.size == outmap.size);
-
-        GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes"
-            " from data %p", collect_data, inmap.size, inmap.data);
-
-        /* further buffers, need to add them */
-        if (pad->volume == 1.0) {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        } else {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_volume_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_volume_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_volume_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_volume_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_volume_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_volume_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_volume_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_volume_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        }
-        gst_buffer_unmap (inbuf, &inmap);
+        g_assert (input.map.size == outmap.size);
+
+        GST_LOG_OBJECT (adder, "channel %p: queueing %" G_GSIZE_FORMAT " bytes"
+            " from data %p", collect_data, input.map.size, input.map.data);
+
+        input.buffer = inbuf;
+        gst_adder_input_set_volume (&input, pad);
+        g_array_append_val (adder->mix_inputs, input);
       } else {
         /* skip gap buffer */
         GST_LOG_OBJECT (adder, "channel %p: skipping GAP buffer", collect_data);
+        gst_buffer_unref (inbuf);
       }
-      gst_buffer_unref (inbuf);
     }
     GST_OBJECT_UNLOCK (pad);
   }
 
-  if (outbuf)
+  if (outbuf) {
+    guint i;
+
+    gst_adder_mix (adder, outmap.data, outmap.size, &first,
+        (GstAdderInput *) adder->mix_inputs->data, adder->mix_inputs->len);
+
+    for (i = 0; i < adder->mix_inputs->len; i++) {
+      GstAdderInput *input =
+          &g_array_index (adder->mix_inputs, GstAdderInput, i);
+
+      gst_buffer_unmap (input->buffer, &input->map);
+      gst_buffer_unref (input->buffer);
+    }
+    g_array_set_size (adder->mix_inputs, 0);
+
     gst_buffer_unmap (outbuf, &outmap);
+  }
 
   if (is_eos)
     goto eos;
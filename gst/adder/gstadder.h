@@ -41,6 +41,8 @@ typedef struct _GstAdderClass        GstAdderClass;
 typedef struct _GstAdderPad GstAdderPad;
 typedef struct _GstAdderPadClass GstAdderPadClass;
 
+typedef struct _GstAdderInput GstAdderInput;
+
 /**
  * GstAdder:
  *
@@ -76,6 +78,9 @@ struct _GstAdder {
   
   gboolean send_stream_start;
   gboolean send_caps;
+
+  /* inputs mixed into the current output buffer, GstAdderInput */
+  GArray *mix_inputs;
 };
 
 struct _GstAdderClass {
@@ -107,6 +112,18 @@ struct _GstAdderPadClass {
 
 GType gst_adder_pad_get_type (void);
 
+/* a mapped input buffer with the volume of its pad at the time it was
+ * collected */
+struct _GstAdderInput {
+  GstBuffer *buffer;
+  GstMapInfo map;
+
+  gdouble volume;
+  gint volume_i32;
+  gint volume_i16;
+  gint volume_i8;
+};
+
 G_END_DECLS
 
 
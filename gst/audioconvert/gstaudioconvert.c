@@ -119,7 +119,7 @@ G_DEFINE_TYPE_WITH_CODE (GstAudioConvert, gst_audio_convert,
 
 #define STATIC_CAPS \
 GST_STATIC_CAPS (GST_AUDIO_CAPS_MAKE (GST_AUDIO_FORMATS_ALL) \
-    ", layout = (string) interleaved")
+    ", layout = (string) { interleaved, non-interleaved }")
 
 static GstStaticPadTemplate gst_audio_convert_src_template =
 GST_STATIC_PAD_TEMPLATE ("src",
@@ -255,7 +255,7 @@ gst_audio_convert_caps_remove_format_info (GstCaps * caps, gboolean channels)
       continue;
 
     st = gst_structure_copy (st);
-    gst_structure_remove_field (st, "format");
+    gst_structure_remove_fields (st, "format", "layout", NULL);
 
     /* Only remove the channels and channel-mask for non-NONE layouts */
     if (gst_structure_get (st, "channel-mask", GST_TYPE_BITMASK, &channel_mask,
@@ -339,6 +339,22 @@ find_suitable_mask (guint64 mask, gint n_chans)
   return 0;
 }
 
+/* keep the layout of the input when the output allows it, changing it costs
+ * an extra (de)interleave step */
+static void
+gst_audio_convert_fixate_layout (GstBaseTransform * base, GstStructure * ins,
+    GstStructure * outs)
+{
+  const gchar *in_layout;
+
+  in_layout = gst_structure_get_string (ins, "layout");
+  if (!in_layout)
+    return;
+
+  if (gst_structure_has_field (outs, "layout"))
+    gst_structure_fixate_field_string (outs, "layout", in_layout);
+}
+
 static void
 gst_audio_convert_fixate_format (GstBaseTransform * base, GstStructure * ins,
     GstStructure * outs)
@@ -630,6 +646,7 @@ gst_audio_convert_fixate_caps (GstBaseTransform * base,
 
   gst_audio_convert_fixate_channels (base, ins, outs);
   gst_audio_convert_fixate_format (base, ins, outs);
+  gst_audio_convert_fixate_layout (base, ins, outs);
 
   /* fixate remaining */
   result = gst_caps_fixate (result);
@@ -737,8 +754,12 @@ gst_audio_convert_transform (GstBaseTransform * base, GstBuffer * inbuf,
     flags |= GST_AUDIO_CONVERTER_FLAG_IN_WRITABLE;
 
   if (!GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP)) {
-    gpointer in[1] = { srcmap.data };
-    gpointer out[1] = { dstmap.data };
+    gpointer *in, *out;
+
+    in = g_newa (gpointer, this->in_info.channels);
+    out = g_newa (gpointer, this->out_info.channels);
+    gst_audio_info_fill_planes (&this->in_info, srcmap.data, samples, in);
+    gst_audio_info_fill_planes (&this->out_info, dstmap.data, samples, out);
 
     if (!gst_audio_converter_samples (this->convert, flags,
             in, samples, out, samples))
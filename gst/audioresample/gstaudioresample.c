@@ -525,7 +525,7 @@ static void
 gst_audio_resample_dump_drain (GstAudioResample * resample, guint history_len)
 {
   gsize out_len, outsize;
-  gpointer out[1];
+  gpointer *out, data;
 
   out_len =
       gst_audio_converter_get_out_frames (resample->converter, history_len);
@@ -534,10 +534,12 @@ gst_audio_resample_dump_drain (GstAudioResample * resample, guint history_len)
 
   outsize = out_len * resample->out.bpf;
 
-  out[0] = g_malloc (outsize);
+  data = g_malloc (outsize);
+  out = g_newa (gpointer, resample->out.channels);
+  gst_audio_info_fill_planes (&resample->out, data, out_len, out);
   gst_audio_converter_samples (resample->converter, 0, NULL, history_len,
       out, out_len);
-  g_free (out[0]);
+  g_free (data);
 }
 
 static void
@@ -548,7 +550,7 @@ gst_audio_resample_push_drain (GstAudioResample * resample, guint history_len)
   gint outsize;
   gsize out_len;
   GstMapInfo map;
-  gpointer out[1];
+  gpointer *out;
 
   g_assert (resample->converter != NULL);
 
@@ -566,7 +568,8 @@ gst_audio_resample_push_drain (GstAudioResample * resample, guint history_len)
 
   gst_buffer_map (outbuf, &map, GST_MAP_WRITE);
 
-  out[0] = map.data;
+  out = g_newa (gpointer, resample->out.channels);
+  gst_audio_info_fill_planes (&resample->out, map.data, out_len, out);
   gst_audio_converter_samples (resample->converter, 0, NULL, history_len,
       out, out_len);
 
@@ -770,15 +773,18 @@ gst_audio_resample_process (GstAudioResample * resample, GstBuffer * inbuf,
     }
     {
       /* process */
-      gpointer in[1], out[1];
+      gpointer *in, *out;
       GstAudioConverterFlags flags;
 
       flags = 0;
       if (inbuf_writable)
         flags |= GST_AUDIO_CONVERTER_FLAG_IN_WRITABLE;
 
-      in[0] = in_map.data;
-      out[0] = out_map.data;
+      in = g_newa (gpointer, resample->in.channels);
+      out = g_newa (gpointer, resample->out.channels);
+      gst_audio_info_fill_planes (&resample->in, in_map.data, in_len, in);
+      gst_audio_info_fill_planes (&resample->out, out_map.data, out_len,
+          out);
       gst_audio_converter_samples (resample->converter, flags, in, in_len,
           out, out_len);
     }
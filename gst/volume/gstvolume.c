@@ -158,6 +158,18 @@ static void volume_process_int8_clamp (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_int8_clamp (GstVolume * self,
     gpointer bytes, gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_constant_double (GstVolume * self,
+    gpointer bytes, gdouble vol, guint n_bytes);
+static void volume_process_constant_float (GstVolume * self,
+    gpointer bytes, gdouble vol, guint n_bytes);
+static void volume_process_constant_int32 (GstVolume * self,
+    gpointer bytes, gdouble vol, guint n_bytes);
+static void volume_process_constant_int24 (GstVolume * self,
+    gpointer bytes, gdouble vol, guint n_bytes);
+static void volume_process_constant_int16 (GstVolume * self,
+    gpointer bytes, gdouble vol, guint n_bytes);
+static void volume_process_constant_int8 (GstVolume * self,
+    gpointer bytes, gdouble vol, guint n_bytes);
 
 
 /* helper functions */
@@ -169,6 +181,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
 
   self->process = NULL;
   self->process_controlled = NULL;
+  self->process_constant = NULL;
 
   format = GST_AUDIO_INFO_FORMAT (info);
 
@@ -184,6 +197,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int32;
       }
       self->process_controlled = volume_process_controlled_int32_clamp;
+      self->process_constant = volume_process_constant_int32;
       break;
     case GST_AUDIO_FORMAT_S24:
       /* only clamp if the gain is greater than 1.0 */
@@ -193,6 +207,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int24;
       }
       self->process_controlled = volume_process_controlled_int24_clamp;
+      self->process_constant = volume_process_constant_int24;
       break;
     case GST_AUDIO_FORMAT_S16:
       /* only clamp if the gain is greater than 1.0 */
@@ -202,6 +217,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int16;
       }
       self->process_controlled = volume_process_controlled_int16_clamp;
+      self->process_constant = volume_process_constant_int16;
       break;
     case GST_AUDIO_FORMAT_S8:
       /* only clamp if the gain is greater than 1.0 */
@@ -211,14 +227,17 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int8;
       }
       self->process_controlled = volume_process_controlled_int8_clamp;
+      self->process_constant = volume_process_constant_int8;
       break;
     case GST_AUDIO_FORMAT_F32:
       self->process = volume_process_float;
       self->process_controlled = volume_process_controlled_float;
+      self->process_constant = volume_process_constant_float;
       break;
     case GST_AUDIO_FORMAT_F64:
       self->process = volume_process_double;
       self->process_controlled = volume_process_controlled_double;
+      self->process_constant = volume_process_constant_double;
       break;
     default:
       break;
@@ -350,6 +369,25 @@ gst_volume_init (GstVolume * self)
   gst_base_transform_set_gap_aware (GST_BASE_TRANSFORM (self), TRUE);
 }
 
+/* The ORC kernels for controlled volumes take one volume per frame and
+ * handle 1 and, for some formats, 2 channels. For other channel counts the
+ * volume of each frame is repeated for all of its samples, in place, and the
+ * 1 channel kernel is run over all samples. @volume must have room for
+ * @num_samples * @channels values. */
+static void
+volume_expand_volumes (gdouble * volume, guint num_samples, guint channels)
+{
+  guint i, j;
+  gdouble vol;
+
+  /* going backwards never overwrites a volume that is still needed */
+  for (i = num_samples; i > 0; i--) {
+    vol = volume[i - 1];
+    for (j = 0; j < channels; j++)
+      volume[(i - 1) * channels + j] = vol;
+  }
+}
+
 static void
 volume_process_double (GstVolume * self, gpointer bytes, guint n_bytes)
 {
@@ -365,18 +403,13 @@ volume_process_controlled_double (GstVolume * self, gpointer bytes,
 {
   gdouble *data = (gdouble *) bytes;
   guint num_samples = n_bytes / (sizeof (gdouble) * channels);
-  guint i, j;
-  gdouble vol;
 
   if (channels == 1) {
     volume_orc_process_controlled_f64_1ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        *data++ *= vol;
-      }
-    }
+    volume_expand_volumes (volume, num_samples, channels);
+    volume_orc_process_controlled_f64_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -395,20 +428,15 @@ volume_process_controlled_float (GstVolume * self, gpointer bytes,
 {
   gfloat *data = (gfloat *) bytes;
   guint num_samples = n_bytes / (sizeof (gfloat) * channels);
-  guint i, j;
-  gdouble vol;
 
   if (channels == 1) {
     volume_orc_process_controlled_f32_1ch (data, volume, num_samples);
   } else if (channels == 2) {
     volume_orc_process_controlled_f32_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        *data++ *= vol;
-      }
-    }
+    volume_expand_volumes (volume, num_samples, channels);
+    volume_orc_process_controlled_f32_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -440,20 +468,14 @@ volume_process_controlled_int32_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint32 *data = (gint32 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint32) * channels);
-  gdouble vol, val;
 
   if (channels == 1) {
     volume_orc_process_controlled_int32_1ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint32) CLAMP (val, VOLUME_MIN_INT32, VOLUME_MAX_INT32);
-      }
-    }
+    volume_expand_volumes (volume, num_samples, channels);
+    volume_orc_process_controlled_int32_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -532,6 +554,7 @@ volume_process_controlled_int24_clamp (GstVolume * self, gpointer bytes,
   guint num_samples = n_bytes / (sizeof (gint8) * 3 * channels);
   gdouble vol, val;
 
+  /* there are no ORC kernels for packed 24 bit samples */
   for (i = 0; i < num_samples; i++) {
     vol = *volume++;
     for (j = 0; j < channels; j++) {
@@ -571,22 +594,16 @@ volume_process_controlled_int16_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint16 *data = (gint16 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint16) * channels);
-  gdouble vol, val;
 
   if (channels == 1) {
     volume_orc_process_controlled_int16_1ch (data, volume, num_samples);
   } else if (channels == 2) {
     volume_orc_process_controlled_int16_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint16) CLAMP (val, VOLUME_MIN_INT16, VOLUME_MAX_INT16);
-      }
-    }
+    volume_expand_volumes (volume, num_samples, channels);
+    volume_orc_process_controlled_int16_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
@@ -619,25 +636,104 @@ volume_process_controlled_int8_clamp (GstVolume * self, gpointer bytes,
     gdouble * volume, guint channels, guint n_bytes)
 {
   gint8 *data = (gint8 *) bytes;
-  guint i, j;
   guint num_samples = n_bytes / (sizeof (gint8) * channels);
-  gdouble val, vol;
 
   if (channels == 1) {
     volume_orc_process_controlled_int8_1ch (data, volume, num_samples);
   } else if (channels == 2) {
     volume_orc_process_controlled_int8_2ch (data, volume, num_samples);
   } else {
-    for (i = 0; i < num_samples; i++) {
-      vol = *volume++;
-      for (j = 0; j < channels; j++) {
-        val = *data * vol;
-        *data++ = (gint8) CLAMP (val, VOLUME_MIN_INT8, VOLUME_MAX_INT8);
-      }
-    }
+    volume_expand_volumes (volume, num_samples, channels);
+    volume_orc_process_controlled_int8_1ch (data, volume,
+        num_samples * channels);
   }
 }
 
+/* Automation that currently holds its value produces the same volume for
+ * every sample of the buffer. Such buffers are processed like a fixed volume
+ * with the vectorised kernels instead of going through the volume array. */
+
+static gboolean
+volume_detect_constant (const gdouble * volumes, guint n, gdouble * vol)
+{
+  guint i;
+
+  if (n == 0)
+    return FALSE;
+
+  /* ramps and curves differ at the second sample already */
+  for (i = 1; i < n; i++)
+    if (volumes[i] != volumes[0])
+      return FALSE;
+
+  *vol = volumes[0];
+
+  return TRUE;
+}
+
+static void
+volume_process_constant_double (GstVolume * self, gpointer bytes,
+    gdouble vol, guint n_bytes)
+{
+  volume_orc_scalarmultiply_f64_ns ((gdouble *) bytes, vol,
+      n_bytes / sizeof (gdouble));
+}
+
+static void
+volume_process_constant_float (GstVolume * self, gpointer bytes, gdouble vol,
+    guint n_bytes)
+{
+  volume_orc_scalarmultiply_f32_ns ((gfloat *) bytes, vol,
+      n_bytes / sizeof (gfloat));
+}
+
+static void
+volume_process_constant_int32 (GstVolume * self, gpointer bytes, gdouble vol,
+    guint n_bytes)
+{
+  volume_orc_process_int32_clamp ((gint32 *) bytes,
+      (gint) (vol * (gdouble) VOLUME_UNITY_INT32), n_bytes / sizeof (gint32));
+}
+
+static void
+volume_process_constant_int24 (GstVolume * self, gpointer bytes, gdouble vol,
+    guint n_bytes)
+{
+  gint8 *data = (gint8 *) bytes;        /* treat the data as a byte stream */
+  guint i, num_samples;
+  guint32 samp;
+  gint64 val;
+  gint64 vol_i24 = (gint64) (vol * (gdouble) VOLUME_UNITY_INT24);
+
+  num_samples = n_bytes / (sizeof (gint8) * 3);
+  for (i = 0; i < num_samples; i++) {
+    samp = get_unaligned_i24 (data);
+
+    val = (gint32) samp;
+    val = (vol_i24 * val) >> VOLUME_UNITY_INT24_BIT_SHIFT;
+    samp = (guint32) CLAMP (val, VOLUME_MIN_INT24, VOLUME_MAX_INT24);
+
+    /* write the value back into the stream */
+    write_unaligned_u24 (data, samp);
+  }
+}
+
+static void
+volume_process_constant_int16 (GstVolume * self, gpointer bytes, gdouble vol,
+    guint n_bytes)
+{
+  volume_orc_process_int16_clamp ((gint16 *) bytes,
+      (gint) (vol * (gdouble) VOLUME_UNITY_INT16), n_bytes / sizeof (gint16));
+}
+
+static void
+volume_process_constant_int8 (GstVolume * self, gpointer bytes, gdouble vol,
+    guint n_bytes)
+{
+  volume_orc_process_int8_clamp ((gint8 *) bytes,
+      (gint) (vol * (gdouble) VOLUME_UNITY_INT8), n_bytes / sizeof (gint8));
+}
+
 /* GstBaseTransform vmethod implementations */
 
 /* get notified of caps and plug in the correct process function */
@@ -749,15 +845,19 @@ volume_transform_ip (GstBaseTransform * base, GstBuffer * outbuf)
       GstClockTime interval = gst_util_uint64_scale_int (1, GST_SECOND, rate);
       gboolean have_mutes = FALSE;
       gboolean have_volumes = FALSE;
+      gdouble vol;
 
       if (self->mutes_count < nsamples && mute_cb) {
         self->mutes = g_realloc (self->mutes, sizeof (gboolean) * nsamples);
         self->mutes_count = nsamples;
       }
 
-      if (self->volumes_count < nsamples) {
-        self->volumes = g_realloc (self->volumes, sizeof (gdouble) * nsamples);
-        self->volumes_count = nsamples;
+      /* process_controlled may expand the volumes to one per sample of
+       * every channel */
+      if (self->volumes_count < nsamples * channels) {
+        self->volumes =
+            g_realloc (self->volumes, sizeof (gdouble) * nsamples * channels);
+        self->volumes_count = nsamples * channels;
       }
 
       if (volume_cb && self->volumes) {
@@ -783,8 +883,20 @@ volume_transform_ip (GstBaseTransform * base, GstBuffer * outbuf)
         self->mutes_count = 0;
       }
 
-      self->process_controlled (self, map.data, self->volumes, channels,
-          map.size);
+      if (volume_detect_constant (self->volumes, nsamples, &vol)) {
+        GST_LOG_OBJECT (self, "constant volume %f", vol);
+
+        if (vol == 1.0) {
+          /* unity gain, nothing to do */
+        } else if (vol == 0.0) {
+          orc_memset (map.data, 0, map.size);
+        } else {
+          self->process_constant (self, map.data, vol, map.size);
+        }
+      } else {
+        self->process_controlled (self, map.data, self->volumes, channels,
+            map.size);
+      }
 
       goto done;
     } else if (volume_cb) {
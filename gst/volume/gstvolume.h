@@ -56,6 +56,7 @@ struct _GstVolume {
 
   void (*process)(GstVolume*, gpointer, guint);
   void (*process_controlled)(GstVolume*, gpointer, gdouble *, guint, guint);
+  void (*process_constant)(GstVolume*, gpointer, gdouble, guint);
 
   gboolean mute;
   gfloat volume;
@@ -29,6 +29,7 @@
 #endif
 
 #include <unistd.h>
+#include <math.h>
 
 #include <gst/check/gstcheck.h>
 #include <gst/check/gstconsistencychecker.h>
@@ -1256,6 +1257,139 @@ GST_START_TEST (test_flush_start_flush_stop)
 
 GST_END_TEST;
 
+/* builds n_inputs square wave sources feeding an adder that produces stereo
+ * F32, every odd pad has its volume set to 0.5 */
+static GstElement *
+setup_mix_pipeline (guint n_inputs, gint num_buffers, GstElement ** sink)
+{
+  GstElement *bin, *adder, *src;
+  GstCaps *caps;
+  GstPad *srcpad, *sinkpad;
+  guint i;
+
+  bin = gst_pipeline_new ("pipeline");
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (F32),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 48000, "channels", G_TYPE_INT, 2, NULL);
+
+  adder = gst_element_factory_make ("adder", "adder");
+  g_object_set (adder, "caps", caps, NULL);
+  gst_caps_unref (caps);
+
+  *sink = gst_element_factory_make ("fakesink", "sink");
+  gst_bin_add_many (GST_BIN (bin), adder, *sink, NULL);
+  fail_unless (gst_element_link (adder, *sink));
+
+  for (i = 0; i < n_inputs; i++) {
+    src = gst_element_factory_make ("audiotestsrc", NULL);
+    /* more than one mixing block per buffer */
+    g_object_set (src, "wave", 1, "volume", 0.01, "samplesperbuffer", 4096,
+        "num-buffers", num_buffers, NULL);
+    gst_bin_add (GST_BIN (bin), src);
+
+    sinkpad = gst_element_get_request_pad (adder, "sink_%u");
+    fail_if (sinkpad == NULL, NULL);
+    if (i % 2 == 1)
+      g_object_set (sinkpad, "volume", 0.5, NULL);
+
+    srcpad = gst_element_get_static_pad (src, "src");
+    fail_unless_equals_int (gst_pad_link (srcpad, sinkpad), GST_PAD_LINK_OK);
+    gst_object_unref (srcpad);
+    gst_object_unref (sinkpad);
+  }
+
+  return bin;
+}
+
+static void
+run_mix_pipeline (GstElement * bin)
+{
+  GstStateChangeReturn state_res;
+  GstMessage *msg;
+  GstBus *bus;
+
+  state_res = gst_element_set_state (bin, GST_STATE_PLAYING);
+  ck_assert_int_ne (state_res, GST_STATE_CHANGE_FAILURE);
+
+  bus = gst_element_get_bus (bin);
+  msg = gst_bus_timed_pop_filtered (bus, GST_CLOCK_TIME_NONE,
+      GST_MESSAGE_EOS | GST_MESSAGE_ERROR);
+  fail_unless_equals_int (GST_MESSAGE_TYPE (msg), GST_MESSAGE_EOS);
+  gst_message_unref (msg);
+  gst_object_unref (bus);
+
+  gst_element_set_state (bin, GST_STATE_NULL);
+}
+
+/* check that mixing many pads with different volumes sums all of them */
+GST_START_TEST (test_mix_many_pads)
+{
+  GstElement *bin, *sink;
+  GstMapInfo map;
+  const gfloat *samples;
+  gdouble expected;
+  gsize i, n_samples;
+
+  bin = setup_mix_pipeline (17, 2, &sink);
+  g_object_set (sink, "signal-handoffs", TRUE, NULL);
+  g_signal_connect (sink, "handoff", (GCallback) handoff_buffer_cb, NULL);
+
+  run_mix_pipeline (bin);
+
+  /* 9 pads at volume 1.0 and 8 at 0.5 */
+  expected = 0.01 * (9 + 8 * 0.5);
+
+  fail_unless (handoff_buffer != NULL);
+  gst_buffer_map (handoff_buffer, &map, GST_MAP_READ);
+  samples = (const gfloat *) map.data;
+  n_samples = map.size / sizeof (gfloat);
+  fail_unless_equals_int (n_samples, 4096 * 2);
+  for (i = 0; i < n_samples; i++)
+    fail_unless (fabs (fabs (samples[i]) - expected) < 1e-5,
+        "sample %" G_GSIZE_FORMAT ": %f != %f", i, fabs (samples[i]),
+        expected);
+  gst_buffer_unmap (handoff_buffer, &map);
+  gst_buffer_replace (&handoff_buffer, NULL);
+
+  gst_object_unref (bin);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define MIX_BENCHMARK_BUFFERS 4
+
+GST_START_TEST (test_mix_benchmark)
+{
+  static const guint n_inputs[] = { 2, 4, 8, 16, 32, 64 };
+  GstElement *bin, *sink;
+  GTimer *timer;
+  gdouble elapsed;
+  guint i;
+
+  timer = g_timer_new ();
+
+  GST_DEBUG ("inputs\tms/buffer\tms/buffer/input");
+
+  for (i = 0; i < G_N_ELEMENTS (n_inputs); i++) {
+    bin = setup_mix_pipeline (n_inputs[i], MIX_BENCHMARK_BUFFERS, &sink);
+
+    g_timer_start (timer);
+    run_mix_pipeline (bin);
+    elapsed = g_timer_elapsed (timer, NULL) * 1000.0 / MIX_BENCHMARK_BUFFERS;
+
+    GST_DEBUG ("%u\t%f\t%f", n_inputs[i], elapsed, elapsed / n_inputs[i]);
+
+    gst_object_unref (bin);
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 adder_suite (void)
@@ -1277,6 +1411,8 @@ adder_suite (void)
   tcase_add_test (tc_chain, test_duration_unknown_overrides);
   tcase_add_test (tc_chain, test_loop);
   tcase_add_test (tc_chain, test_flush_start_flush_stop);
+  tcase_add_test (tc_chain, test_mix_many_pads);
+  tcase_add_test (tc_chain, test_mix_benchmark);
 
   /* Use a longer timeout */
 #ifdef HAVE_VALGRIND
@@ -1620,6 +1620,121 @@ GST_START_TEST (test_gap_buffers)
 
 GST_END_TEST;
 
+/* returns a newly allocated caps */
+static GstCaps *
+get_layout_caps (GstAudioFormat fmt, guint channels, GstAudioLayout layout)
+{
+  GstCaps *caps;
+  GstAudioInfo info;
+
+  gst_audio_info_init (&info);
+  gst_audio_info_set_format (&info, fmt, GST_AUDIO_DEF_RATE, channels, NULL);
+  info.layout = layout;
+
+  caps = gst_audio_info_to_caps (&info);
+  fail_unless (caps != NULL);
+
+  return caps;
+}
+
+#define PLANAR GST_AUDIO_LAYOUT_NON_INTERLEAVED
+#define INTERLEAVED GST_AUDIO_LAYOUT_INTERLEAVED
+
+GST_START_TEST (test_non_interleaved)
+{
+  /* planar to interleaved and back */
+  {
+    gint16 in[] = { 1, 2, 3, 10, 20, 30 };
+    gint16 out[] = { 1, 10, 2, 20, 3, 30 };
+
+    RUN_CONVERSION ("int16 planar to interleaved",
+        in, get_layout_caps (GST_AUDIO_FORMAT_S16, 2, PLANAR),
+        out, get_layout_caps (GST_AUDIO_FORMAT_S16, 2, INTERLEAVED));
+    RUN_CONVERSION ("int16 interleaved to planar",
+        out, get_layout_caps (GST_AUDIO_FORMAT_S16, 2, INTERLEAVED),
+        in, get_layout_caps (GST_AUDIO_FORMAT_S16, 2, PLANAR));
+  }
+  /* format conversion on the planes */
+  {
+    gint16 in[] = { 16384, -16384, 8192, 0 };
+    gfloat out[] = { 0.5, -0.5, 0.25, 0.0 };
+
+    RUN_CONVERSION ("int16 planar to float32 planar",
+        in, get_layout_caps (GST_AUDIO_FORMAT_S16, 2, PLANAR),
+        out, get_layout_caps (GST_AUDIO_FORMAT_F32, 2, PLANAR));
+  }
+  /* channel mixing on the planes */
+  {
+    gint16 in[] = { 16384, 1024, -256, 1024 };
+    gint16 out[] = { 8064, 1024 };
+
+    RUN_CONVERSION ("int16 planar stereo to mono",
+        in, get_layout_caps (GST_AUDIO_FORMAT_S16, 2, PLANAR),
+        out, get_layout_caps (GST_AUDIO_FORMAT_S16, 1, PLANAR));
+  }
+  {
+    gfloat in[] = { 0.25, 0.5 };
+    gfloat out[] = { 0.25, 0.5, 0.25, 0.5 };
+
+    RUN_CONVERSION ("float32 mono to planar stereo",
+        in, get_layout_caps (GST_AUDIO_FORMAT_F32, 1, INTERLEAVED),
+        out, get_layout_caps (GST_AUDIO_FORMAT_F32, 2, PLANAR));
+  }
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_preserve_layout)
+{
+  static GstStaticPadTemplate sinktemplate = GST_STATIC_PAD_TEMPLATE ("sink",
+      GST_PAD_SINK,
+      GST_PAD_ALWAYS,
+      GST_STATIC_CAPS ("audio/x-raw, format = (string) " GST_AUDIO_NE (F32)
+          ", layout = (string) { interleaved, non-interleaved }")
+      );
+  static GstStaticPadTemplate srctemplate = GST_STATIC_PAD_TEMPLATE ("src",
+      GST_PAD_SRC,
+      GST_PAD_ALWAYS,
+      GST_STATIC_CAPS (CONVERT_CAPS_TEMPLATE_STRING)
+      );
+  static const GstAudioLayout layouts[] = { PLANAR, INTERLEAVED };
+  GstStructure *structure;
+  GstElement *audioconvert;
+  GstCaps *incaps, *convert_outcaps;
+  guint i;
+
+  audioconvert = gst_check_setup_element ("audioconvert");
+  mysrcpad = gst_check_setup_src_pad (audioconvert, &srctemplate);
+  mysinkpad = gst_check_setup_sink_pad (audioconvert, &sinktemplate);
+
+  gst_pad_set_active (mysrcpad, TRUE);
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  fail_unless (gst_element_set_state (audioconvert,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  /* the format has to change, the layout should stay the same */
+  for (i = 0; i < G_N_ELEMENTS (layouts); i++) {
+    incaps = get_layout_caps (GST_AUDIO_FORMAT_S16, 2, layouts[i]);
+    gst_pad_set_caps (mysrcpad, incaps);
+
+    convert_outcaps = gst_pad_get_current_caps (mysinkpad);
+    structure = gst_caps_get_structure (convert_outcaps, 0);
+    fail_unless_equals_string (gst_structure_get_string (structure, "format"),
+        GST_AUDIO_NE (F32));
+    fail_unless_equals_string (gst_structure_get_string (structure, "layout"),
+        layouts[i] == PLANAR ? "non-interleaved" : "interleaved");
+
+    gst_caps_unref (convert_outcaps);
+    gst_caps_unref (incaps);
+  }
+
+  cleanup_audioconvert (audioconvert);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 audioconvert_suite (void)
@@ -1639,6 +1754,8 @@ audioconvert_suite (void)
   tcase_add_test (tc_chain, test_convert_undefined_multichannel);
   tcase_add_test (tc_chain, test_preserve_width);
   tcase_add_test (tc_chain, test_gap_buffers);
+  tcase_add_test (tc_chain, test_non_interleaved);
+  tcase_add_test (tc_chain, test_preserve_layout);
 
   return s;
 }
@@ -24,6 +24,7 @@
 
 #include <gst/base/gstbasetransform.h>
 #include <gst/check/gstcheck.h>
+#include <gst/audio/audio.h>
 #include <gst/audio/streamvolume.h>
 #include <gst/controller/gstinterpolationcontrolsource.h>
 #include <gst/controller/gstdirectcontrolbinding.h>
@@ -1862,6 +1863,204 @@ GST_START_TEST (test_controller_defaults_at_ts0)
 
 GST_END_TEST;
 
+/* linear automation should be applied sample accurately over the buffer */
+GST_START_TEST (test_controller_ramp)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstMapInfo map;
+  GstSegment seg;
+  gint16 *data;
+  gint i;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume),
+      gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs));
+
+  /* ramp from 0.0 to 1.0 (0.1 in controller range) over 100 samples */
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0, 0.0);
+  gst_timed_value_control_source_set (tvcs,
+      gst_util_uint64_scale_int (100, GST_SECOND, 44100), 0.1);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  inbuffer = gst_buffer_new_and_alloc (100 * sizeof (gint16));
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  data = (gint16 *) map.data;
+  for (i = 0; i < 100; i++)
+    data[i] = 10000;
+  gst_buffer_unmap (inbuffer, &map);
+
+  caps = gst_caps_from_string (VOLUME_CAPS_STRING_S16);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  GST_BUFFER_TIMESTAMP (inbuffer) = 0;
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  fail_if ((outbuffer = (GstBuffer *) buffers->data) == NULL);
+
+  gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+  data = (gint16 *) map.data;
+  for (i = 0; i < 100; i++)
+    fail_unless (ABS (data[i] - 100 * i) <= 2, "sample %d: %d != %d", i,
+        data[i], 100 * i);
+  gst_buffer_unmap (outbuffer, &map);
+
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_END_TEST;
+
+/* with more channels than the controlled kernels handle, every sample of a
+ * frame should get the volume of the frame */
+GST_START_TEST (test_controller_ramp_multichannel)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstMapInfo map;
+  GstSegment seg;
+  gint16 *data;
+  gint i, j;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume),
+      gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs));
+
+  /* ramp from 0.0 to 1.0 (0.1 in controller range) over 100 frames */
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0, 0.0);
+  gst_timed_value_control_source_set (tvcs,
+      gst_util_uint64_scale_int (100, GST_SECOND, 44100), 0.1);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  inbuffer = gst_buffer_new_and_alloc (100 * 6 * sizeof (gint16));
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  data = (gint16 *) map.data;
+  for (i = 0; i < 100; i++)
+    for (j = 0; j < 6; j++)
+      data[i * 6 + j] = (j % 2) ? -10000 : 10000;
+  gst_buffer_unmap (inbuffer, &map);
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (S16),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 44100, "channels", G_TYPE_INT, 6, NULL);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  GST_BUFFER_TIMESTAMP (inbuffer) = 0;
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  fail_if ((outbuffer = (GstBuffer *) buffers->data) == NULL);
+
+  gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+  data = (gint16 *) map.data;
+  for (i = 0; i < 100; i++) {
+    for (j = 0; j < 6; j++) {
+      gint expected = (j % 2) ? -100 * i : 100 * i;
+
+      fail_unless (ABS (data[i * 6 + j] - expected) <= 2,
+          "frame %d channel %d: %d != %d", i, j, data[i * 6 + j], expected);
+    }
+  }
+  gst_buffer_unmap (outbuffer, &map);
+
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_END_TEST;
+
+/* automation that holds its value should behave like a fixed volume */
+GST_START_TEST (test_controller_constant)
+{
+  GstControlSource *cs;
+  GstTimedValueControlSource *tvcs;
+  GstElement *volume;
+  GstBuffer *inbuffer, *outbuffer;
+  GstCaps *caps;
+  GstMapInfo map;
+  GstSegment seg;
+  gfloat *data;
+  gint i;
+
+  volume = setup_volume ();
+
+  cs = gst_interpolation_control_source_new ();
+  g_object_set (cs, "mode", GST_INTERPOLATION_MODE_LINEAR, NULL);
+  gst_object_add_control_binding (GST_OBJECT_CAST (volume),
+      gst_direct_control_binding_new (GST_OBJECT_CAST (volume), "volume", cs));
+
+  tvcs = (GstTimedValueControlSource *) cs;
+  gst_timed_value_control_source_set (tvcs, 0, 0.05);
+
+  fail_unless (gst_element_set_state (volume,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  inbuffer = gst_buffer_new_and_alloc (3 * 64 * sizeof (gfloat));
+  gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+  data = (gfloat *) map.data;
+  for (i = 0; i < 3 * 64; i++)
+    data[i] = (i % 2) ? 0.5 : -0.25;
+  gst_buffer_unmap (inbuffer, &map);
+
+  caps = gst_caps_new_simple ("audio/x-raw",
+      "format", G_TYPE_STRING, GST_AUDIO_NE (F32),
+      "layout", G_TYPE_STRING, "interleaved",
+      "rate", G_TYPE_INT, 44100, "channels", G_TYPE_INT, 3, NULL);
+  gst_check_setup_events (mysrcpad, volume, caps, GST_FORMAT_TIME);
+  GST_BUFFER_TIMESTAMP (inbuffer) = 0;
+  gst_caps_unref (caps);
+
+  gst_segment_init (&seg, GST_FORMAT_TIME);
+  fail_unless (gst_pad_push_event (mysrcpad,
+          gst_event_new_segment (&seg)) == TRUE);
+
+  fail_unless (gst_pad_push (mysrcpad, inbuffer) == GST_FLOW_OK);
+  fail_unless_equals_int (g_list_length (buffers), 1);
+  fail_if ((outbuffer = (GstBuffer *) buffers->data) == NULL);
+
+  gst_buffer_map (outbuffer, &map, GST_MAP_READ);
+  data = (gfloat *) map.data;
+  for (i = 0; i < 3 * 64; i++)
+    fail_unless_equals_float (data[i], (i % 2) ? 0.25 : -0.125);
+  gst_buffer_unmap (outbuffer, &map);
+
+  gst_object_unref (cs);
+  cleanup_volume (volume);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 volume_suite (void)
@@ -1906,6 +2105,9 @@ volume_suite (void)
   tcase_add_test (tc_chain, test_controller_usability);
   tcase_add_test (tc_chain, test_controller_processing);
   tcase_add_test (tc_chain, test_controller_defaults_at_ts0);
+  tcase_add_test (tc_chain, test_controller_ramp);
+  tcase_add_test (tc_chain, test_controller_ramp_multichannel);
+  tcase_add_test (tc_chain, test_controller_constant);
 
   return s;
 }
@@ -21,8 +21,10 @@
  */
 
 #include <unistd.h>
+#include <math.h>
 
 #include <gst/check/gstcheck.h>
+#include <gst/audio/audio.h>
 
 #include <vorbis/codec.h>
 #include <vorbis/vorbisenc.h>
@@ -298,6 +300,160 @@ GST_START_TEST (test_empty_vorbis_packet)
 
 GST_END_TEST;
 
+/* encodes a short stereo stream with a sine on the left channel and silence
+ * on the right one, returns the header and audio packets as buffers */
+static GList *
+_create_stereo_stream (void)
+{
+  GList *packets = NULL;
+  ogg_packet header, header_comm, header_code, packet;
+  float **vorbis_buffer;
+  gint i;
+
+  vorbis_info_init (&vi);
+  vorbis_encode_init_vbr (&vi, 2, 44100, 0.5);
+  vorbis_analysis_init (&vd, &vi);
+  vorbis_block_init (&vd, &vb);
+  vorbis_comment_init (&vc);
+  vorbis_analysis_headerout (&vd, &vc, &header, &header_comm, &header_code);
+
+  packets = g_list_append (packets, gst_buffer_new_wrapped (g_memdup
+          (header.packet, header.bytes), header.bytes));
+  packets = g_list_append (packets, gst_buffer_new_wrapped (g_memdup
+          (header_comm.packet, header_comm.bytes), header_comm.bytes));
+  packets = g_list_append (packets, gst_buffer_new_wrapped (g_memdup
+          (header_code.packet, header_code.bytes), header_code.bytes));
+
+  vorbis_buffer = vorbis_analysis_buffer (&vd, 8192);
+  for (i = 0; i < 8192; ++i) {
+    vorbis_buffer[0][i] = 0.5 * sin (2 * G_PI * 440 * i / 44100.0);
+    vorbis_buffer[1][i] = 0.0;
+  }
+  vorbis_analysis_wrote (&vd, 8192);
+  vorbis_analysis_wrote (&vd, 0);
+
+  while (vorbis_analysis_blockout (&vd, &vb) == 1) {
+    vorbis_analysis (&vb, NULL);
+    vorbis_bitrate_addblock (&vb);
+    while (vorbis_bitrate_flushpacket (&vd, &packet)) {
+      packets = g_list_append (packets, gst_buffer_new_wrapped (g_memdup
+              (packet.packet, packet.bytes), packet.bytes));
+    }
+  }
+
+  vorbis_comment_clear (&vc);
+  vorbis_block_clear (&vb);
+  vorbis_dsp_clear (&vd);
+  vorbis_info_clear (&vi);
+
+  return packets;
+}
+
+static GstElement *
+setup_vorbisdec_with_sink_caps (const gchar * sink_caps)
+{
+  GstStaticPadTemplate template = GST_STATIC_PAD_TEMPLATE ("sink",
+      GST_PAD_SINK, GST_PAD_ALWAYS, GST_STATIC_CAPS_ANY);
+  GstElement *vorbisdec;
+  GstCaps *caps;
+
+  template.static_caps.string = sink_caps;
+
+  vorbisdec = gst_check_setup_element ("vorbisdec");
+  mysrcpad = gst_check_setup_src_pad (vorbisdec, &srctemplate);
+  mysinkpad = gst_check_setup_sink_pad (vorbisdec, &template);
+  gst_pad_set_active (mysrcpad, TRUE);
+
+  caps = gst_caps_new_empty_simple ("audio/x-vorbis");
+  gst_check_setup_events (mysrcpad, vorbisdec, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  gst_pad_set_active (mysinkpad, TRUE);
+
+  fail_unless_equals_int (gst_element_set_state (vorbisdec, GST_STATE_PLAYING),
+      GST_STATE_CHANGE_SUCCESS);
+
+  return vorbisdec;
+}
+
+static void
+push_stereo_stream (void)
+{
+  GList *packets, *l;
+
+  packets = _create_stereo_stream ();
+  for (l = packets; l; l = l->next)
+    fail_unless_equals_int (gst_pad_push (mysrcpad, l->data), GST_FLOW_OK);
+  g_list_free (packets);
+  fail_unless (gst_pad_push_event (mysrcpad, gst_event_new_eos ()));
+  fail_unless (g_list_length (buffers) > 0);
+}
+
+GST_START_TEST (test_non_interleaved)
+{
+  GstElement *vorbisdec;
+  GstAudioInfo info;
+  GstCaps *caps;
+  GList *l;
+  gdouble energy[2] = { 0.0, 0.0 };
+
+  vorbisdec =
+      setup_vorbisdec_with_sink_caps
+      ("audio/x-raw, layout = (string) non-interleaved");
+  push_stereo_stream ();
+
+  caps = gst_pad_get_current_caps (mysinkpad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_audio_info_from_caps (&info, caps));
+  gst_caps_unref (caps);
+  fail_unless_equals_int (GST_AUDIO_INFO_LAYOUT (&info),
+      GST_AUDIO_LAYOUT_NON_INTERLEAVED);
+  fail_unless_equals_int (GST_AUDIO_INFO_CHANNELS (&info), 2);
+
+  /* all the signal has to end up in the first plane */
+  for (l = buffers; l; l = l->next) {
+    GstMapInfo map;
+    const gfloat *data;
+    gsize i, frames;
+
+    gst_buffer_map (l->data, &map, GST_MAP_READ);
+    data = (const gfloat *) map.data;
+    frames = map.size / GST_AUDIO_INFO_BPF (&info);
+    for (i = 0; i < frames; i++) {
+      energy[0] += data[i] * data[i];
+      energy[1] += data[frames + i] * data[frames + i];
+    }
+    gst_buffer_unmap (l->data, &map);
+  }
+  fail_unless (energy[0] > 100 * energy[1]);
+
+  gst_check_drop_buffers ();
+  cleanup_vorbisdec (vorbisdec);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_downmix)
+{
+  GstElement *vorbisdec;
+  GstAudioInfo info;
+  GstCaps *caps;
+
+  vorbisdec = setup_vorbisdec_with_sink_caps ("audio/x-raw, channels = 1");
+  push_stereo_stream ();
+
+  caps = gst_pad_get_current_caps (mysinkpad);
+  fail_unless (caps != NULL);
+  fail_unless (gst_audio_info_from_caps (&info, caps));
+  gst_caps_unref (caps);
+  fail_unless_equals_int (GST_AUDIO_INFO_CHANNELS (&info), 1);
+
+  gst_check_drop_buffers ();
+  cleanup_vorbisdec (vorbisdec);
+}
+
+GST_END_TEST;
+
 static Suite *
 vorbisdec_suite (void)
 {
@@ -307,6 +463,8 @@ vorbisdec_suite (void)
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, test_identification_header);
   tcase_add_test (tc_chain, test_empty_vorbis_packet);
+  tcase_add_test (tc_chain, test_non_interleaved);
+  tcase_add_test (tc_chain, test_downmix);
 
   return s;
 }
@@ -26,9 +26,11 @@
 #endif
 
 #include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
 
 #include <gst/audio/audio.h>
 #include <string.h>
+#include <math.h>
 
 GST_START_TEST (test_buffer_clipping_time)
 {
@@ -612,6 +614,430 @@ GST_START_TEST (test_fill_silence)
 
 GST_END_TEST;
 
+GST_START_TEST (test_quantize_dither)
+{
+  GstAudioDitherMethod dither;
+  GstAudioNoiseShapingMethod ns;
+  GstAudioQuantize *quant;
+  gint32 in[2 * 1024], out[2 * 1024];
+  gpointer inp[1], outp[1];
+  const guint quantizer = 1 << 16;
+  gint i, j;
+
+  for (i = 0; i < 2 * 1024; i++)
+    in[i] = (gint32) (sin (i / 20.0) * (G_MAXINT32 / 4));
+  inp[0] = in;
+  outp[0] = out;
+
+  for (dither = GST_AUDIO_DITHER_NONE; dither <= GST_AUDIO_DITHER_TPDF_HF;
+      dither++) {
+    for (ns = GST_AUDIO_NOISE_SHAPING_NONE; ns <= GST_AUDIO_NOISE_SHAPING_HIGH;
+        ns++) {
+      quant = gst_audio_quantize_new (dither, ns, 0, GST_AUDIO_FORMAT_S32, 2,
+          quantizer);
+      fail_unless (quant != NULL);
+
+      /* run a few times to exercise the error and random state */
+      for (j = 0; j < 4; j++) {
+        gst_audio_quantize_samples (quant, inp, outp, 1024);
+
+        for (i = 0; i < 2 * 1024; i++) {
+          fail_unless ((out[i] & (quantizer - 1)) == 0,
+              "dither %d, ns %d: sample %d not quantized", dither, ns, i);
+          fail_unless (ABS ((gint64) out[i] - in[i]) <= 32 * quantizer,
+              "dither %d, ns %d: sample %d too far off", dither, ns, i);
+        }
+      }
+      gst_audio_quantize_free (quant);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* minimal ringbuffer that is driven by the test with
+ * gst_audio_ring_buffer_advance() */
+typedef GstAudioRingBuffer GstTestRingBuffer;
+typedef GstAudioRingBufferClass GstTestRingBufferClass;
+
+static GType gst_test_ring_buffer_get_type (void);
+G_DEFINE_TYPE (GstTestRingBuffer, gst_test_ring_buffer,
+    GST_TYPE_AUDIO_RING_BUFFER);
+
+static gboolean
+gst_test_ring_buffer_acquire (GstAudioRingBuffer * buf,
+    GstAudioRingBufferSpec * spec)
+{
+  buf->size = spec->segsize * spec->segtotal;
+  buf->memory = g_malloc0 (buf->size);
+  return TRUE;
+}
+
+static gboolean
+gst_test_ring_buffer_release (GstAudioRingBuffer * buf)
+{
+  g_free (buf->memory);
+  buf->memory = NULL;
+  return TRUE;
+}
+
+static gboolean
+gst_test_ring_buffer_start (GstAudioRingBuffer * buf)
+{
+  return TRUE;
+}
+
+static void
+gst_test_ring_buffer_class_init (GstTestRingBufferClass * klass)
+{
+  klass->acquire = gst_test_ring_buffer_acquire;
+  klass->release = gst_test_ring_buffer_release;
+  klass->start = gst_test_ring_buffer_start;
+  klass->stop = gst_test_ring_buffer_start;
+}
+
+static void
+gst_test_ring_buffer_init (GstTestRingBuffer * buf)
+{
+}
+
+static guint64
+sum_histogram (const GstStructure * s, const gchar * field)
+{
+  const GValue *array;
+  guint64 sum = 0;
+  guint i;
+
+  array = gst_structure_get_value (s, field);
+  fail_unless (array != NULL);
+  for (i = 0; i < gst_value_array_get_size (array); i++)
+    sum += g_value_get_uint64 (gst_value_array_get_value (array, i));
+
+  return sum;
+}
+
+GST_START_TEST (test_ring_buffer_stats)
+{
+  GstAudioRingBuffer *buf;
+  GstStructure *s;
+  gint16 data[200] = { 0, };
+  guint64 sample, underruns;
+  gint accum;
+
+  buf = g_object_new (gst_test_ring_buffer_get_type (), NULL);
+  fail_unless (gst_audio_ring_buffer_open_device (buf));
+
+  gst_audio_info_set_format (&buf->spec.info, GST_AUDIO_FORMAT_S16, 44100, 1,
+      NULL);
+  buf->spec.type = GST_AUDIO_RING_BUFFER_FORMAT_TYPE_RAW;
+  buf->spec.segsize = sizeof (data);
+  buf->spec.segtotal = 4;
+  buf->spec.seglatency = -1;
+  fail_unless (gst_audio_ring_buffer_acquire (buf, &buf->spec));
+
+  fail_if (gst_audio_ring_buffer_get_stats_enabled (buf));
+  gst_audio_ring_buffer_set_stats_enabled (buf, TRUE);
+  fail_unless (gst_audio_ring_buffer_get_stats_enabled (buf));
+
+  gst_audio_ring_buffer_set_flushing (buf, FALSE);
+  gst_audio_ring_buffer_may_start (buf, TRUE);
+  fail_unless (gst_audio_ring_buffer_start (buf));
+
+  /* write the first segment while the ringbuffer is empty */
+  sample = 0;
+  accum = 0;
+  fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+          (guint8 *) data, 200, 200, &accum), 200);
+
+  /* the device plays two segments, the second one was never written and the
+   * writer is now too late for it */
+  gst_audio_ring_buffer_advance (buf, 1);
+  gst_audio_ring_buffer_advance (buf, 1);
+  fail_unless_equals_int (gst_audio_ring_buffer_commit (buf, &sample,
+          (guint8 *) data, 200, 200, &accum), 200);
+
+  s = gst_audio_ring_buffer_get_stats (buf);
+  fail_unless (gst_structure_get_uint64 (s, "underruns", &underruns));
+  fail_unless_equals_uint64 (underruns, 1);
+  fail_unless_equals_uint64 (sum_histogram (s, "fill-histogram"), 1);
+  fail_unless_equals_uint64 (sum_histogram (s, "callback-histogram"), 1);
+  gst_structure_free (s);
+
+  gst_audio_ring_buffer_reset_stats (buf);
+  s = gst_audio_ring_buffer_get_stats (buf);
+  fail_unless (gst_structure_get_uint64 (s, "underruns", &underruns));
+  fail_unless_equals_uint64 (underruns, 0);
+  fail_unless_equals_uint64 (sum_histogram (s, "fill-histogram"), 0);
+  gst_structure_free (s);
+
+  fail_unless (gst_audio_ring_buffer_stop (buf));
+  fail_unless (gst_audio_ring_buffer_release (buf));
+  fail_unless (gst_audio_ring_buffer_close_device (buf));
+  gst_object_unref (buf);
+}
+
+GST_END_TEST;
+
+/* ringbuffer that doesn't play anything but records where the sink wrote
+ * its samples */
+typedef struct
+{
+  GstAudioRingBuffer parent;
+
+  guint64 next_sample;
+  guint64 written;
+  guint commits;
+  guint jumps;
+} GstRecordRingBuffer;
+typedef GstAudioRingBufferClass GstRecordRingBufferClass;
+
+static GType gst_record_ring_buffer_get_type (void);
+G_DEFINE_TYPE (GstRecordRingBuffer, gst_record_ring_buffer,
+    gst_test_ring_buffer_get_type ());
+
+static guint
+gst_record_ring_buffer_commit (GstAudioRingBuffer * buf, guint64 * sample,
+    guint8 * data, gint in_samples, gint out_samples, gint * accum)
+{
+  GstRecordRingBuffer *rec = (GstRecordRingBuffer *) buf;
+
+  if (rec->commits > 0 && *sample != rec->next_sample)
+    rec->jumps++;
+  rec->commits++;
+  rec->written += in_samples;
+
+  *sample += ABS (out_samples);
+  rec->next_sample = *sample;
+
+  return in_samples;
+}
+
+static void
+gst_record_ring_buffer_class_init (GstRecordRingBufferClass * klass)
+{
+  klass->commit = gst_record_ring_buffer_commit;
+}
+
+static void
+gst_record_ring_buffer_init (GstRecordRingBuffer * buf)
+{
+}
+
+typedef GstAudioBaseSink GstTestAudioSink;
+typedef GstAudioBaseSinkClass GstTestAudioSinkClass;
+
+static GType gst_test_audio_sink_get_type (void);
+G_DEFINE_TYPE (GstTestAudioSink, gst_test_audio_sink,
+    GST_TYPE_AUDIO_BASE_SINK);
+
+static GstAudioRingBuffer *
+gst_test_audio_sink_create_ringbuffer (GstAudioBaseSink * sink)
+{
+  return g_object_new (gst_record_ring_buffer_get_type (), NULL);
+}
+
+static void
+gst_test_audio_sink_class_init (GstTestAudioSinkClass * klass)
+{
+  GstElementClass *element_class = GST_ELEMENT_CLASS (klass);
+
+  static GstStaticPadTemplate sink_templ = GST_STATIC_PAD_TEMPLATE ("sink",
+      GST_PAD_SINK, GST_PAD_ALWAYS,
+      GST_STATIC_CAPS ("audio/x-raw"));
+
+  gst_element_class_add_static_pad_template (element_class, &sink_templ);
+  gst_element_class_set_metadata (element_class,
+      "AudioSinkTester", "Sink/Audio", "yep", "me");
+
+  klass->create_ringbuffer = gst_test_audio_sink_create_ringbuffer;
+}
+
+static void
+gst_test_audio_sink_init (GstTestAudioSink * sink)
+{
+}
+
+#define SLAVE_RATE     8000
+#define SLAVE_SAMPLES  800
+#define SLAVE_BUFFERS  600
+/* the master clock wants the samples 1000ppm slower than they come in */
+#define SLAVE_DRIFT    1000
+
+GST_START_TEST (test_audio_base_sink_resample_slaving)
+{
+  GstHarness *h;
+  GstElement *sink;
+  GstRecordRingBuffer *rec;
+  GstStructure *s;
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint64 resyncs, start_written = 0;
+  gdouble ppm;
+  guint i, j;
+
+  sink = g_object_new (gst_test_audio_sink_get_type (), NULL);
+  g_object_set (sink, "async", FALSE, "slave-method",
+      GST_AUDIO_BASE_SINK_SLAVE_RESAMPLE, NULL);
+
+  /* the test clock is the master, the clock of the sink never advances */
+  h = gst_harness_new_with_element (sink, "sink", NULL);
+  gst_harness_use_testclock (h);
+  gst_harness_set_src_caps_str (h, "audio/x-raw, format=(string)"
+      GST_AUDIO_NE (S16) ", layout=(string)interleaved, rate=(int)8000, "
+      "channels=(int)1");
+  rec = (GstRecordRingBuffer *) GST_AUDIO_BASE_SINK (sink)->ringbuffer;
+
+  for (i = 0; i < SLAVE_BUFFERS; i++) {
+    guint64 offset = (guint64) i * SLAVE_SAMPLES;
+    gint16 *samples;
+
+    buf = gst_buffer_new_allocate (NULL, SLAVE_SAMPLES * sizeof (gint16),
+        NULL);
+    gst_buffer_map (buf, &map, GST_MAP_WRITE);
+    samples = (gint16 *) map.data;
+    for (j = 0; j < SLAVE_SAMPLES; j++)
+      samples[j] = (gint16) (sin ((offset + j) / 10.0) * 16000);
+    gst_buffer_unmap (buf, &map);
+
+    /* the timestamps place the buffers a bit further apart than their
+     * duration, the sink has to produce more samples to follow them */
+    GST_BUFFER_PTS (buf) = gst_util_uint64_scale (offset,
+        (1000000 + SLAVE_DRIFT) * GST_SECOND, (guint64) SLAVE_RATE * 1000000);
+    GST_BUFFER_DURATION (buf) = gst_util_uint64_scale (SLAVE_SAMPLES,
+        GST_SECOND, SLAVE_RATE);
+
+    /* measure the rate over the last 10 seconds */
+    if (i == SLAVE_BUFFERS - 100)
+      start_written = rec->written;
+
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+
+  /* all samples were written right after each other, the drift controller
+   * kept the error small enough to never resync */
+  fail_unless (rec->commits > 0);
+  fail_unless_equals_int (rec->jumps, 0);
+  g_object_get (sink, "stats", &s, NULL);
+  fail_unless (gst_structure_get_uint64 (s, "resyncs", &resyncs));
+  fail_unless_equals_uint64 (resyncs, 0);
+  gst_structure_free (s);
+
+  /* and the samples were resampled to follow the master clock */
+  ppm = (rec->written - start_written) * 1000000.0 / (100 * SLAVE_SAMPLES);
+  ppm -= 1000000;
+  fail_unless (ppm > SLAVE_DRIFT / 2 && ppm < SLAVE_DRIFT * 2,
+      "unexpected rate correction of %f ppm", ppm);
+
+  gst_harness_teardown (h);
+  gst_object_unref (sink);
+}
+
+GST_END_TEST;
+
+static GstClockTime
+query_min_latency (GstElement * sink)
+{
+  GstQuery *query;
+  GstClockTime min;
+  gboolean live;
+
+  query = gst_query_new_latency ();
+  fail_unless (gst_element_query (sink, query));
+  gst_query_parse_latency (query, &live, &min, NULL);
+  fail_unless (live);
+  gst_query_unref (query);
+
+  return min;
+}
+
+static void
+push_silence (GstHarness * h, guint i)
+{
+  GstBuffer *buf;
+
+  buf = gst_buffer_new_allocate (NULL, SLAVE_SAMPLES * sizeof (gint16), NULL);
+  gst_buffer_memset (buf, 0, 0, SLAVE_SAMPLES * sizeof (gint16));
+  GST_BUFFER_PTS (buf) = gst_util_uint64_scale (i * SLAVE_SAMPLES, GST_SECOND,
+      SLAVE_RATE);
+  GST_BUFFER_DURATION (buf) = gst_util_uint64_scale (SLAVE_SAMPLES,
+      GST_SECOND, SLAVE_RATE);
+
+  fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+}
+
+GST_START_TEST (test_audio_base_sink_adaptive_latency)
+{
+  GstHarness *h;
+  GstElement *sink;
+  GstRecordRingBuffer *rec;
+  GstStructure *s;
+  GstMessage *msg;
+  GstBus *bus;
+  guint64 resyncs;
+  guint i;
+
+  /* 20 segments of 10ms */
+  sink = g_object_new (gst_test_audio_sink_get_type (), NULL);
+  g_object_set (sink, "async", FALSE, "adaptive-latency", TRUE,
+      "buffer-time", (gint64) 200000, "latency-time", (gint64) 10000, NULL);
+  bus = gst_bus_new ();
+  gst_element_set_bus (sink, bus);
+
+  h = gst_harness_new_with_element (sink, "sink", NULL);
+  gst_harness_use_testclock (h);
+  gst_harness_set_upstream_latency (h, 0);
+  gst_harness_set_src_caps_str (h, "audio/x-raw, format=(string)"
+      GST_AUDIO_NE (S16) ", layout=(string)interleaved, rate=(int)8000, "
+      "channels=(int)1");
+  rec = (GstRecordRingBuffer *) GST_AUDIO_BASE_SINK (sink)->ringbuffer;
+
+  /* we start with two segments */
+  fail_unless_equals_uint64 (query_min_latency (sink), 20 * GST_MSECOND);
+  push_silence (h, 0);
+
+  /* the device gets ahead of the samples, we grow by two segments */
+  gst_audio_ring_buffer_advance (GST_AUDIO_RING_BUFFER (rec), 20);
+  push_silence (h, 1);
+  msg = gst_bus_pop_filtered (bus, GST_MESSAGE_LATENCY);
+  fail_unless (msg != NULL);
+  gst_message_unref (msg);
+  fail_unless_equals_uint64 (query_min_latency (sink), 40 * GST_MSECOND);
+
+  /* the pipeline picks up the new latency, we were late for the device so
+   * the samples are moved 320 samples later at once */
+  gst_element_send_event (sink, gst_event_new_latency (40 * GST_MSECOND));
+  push_silence (h, 2);
+  fail_unless_equals_int (rec->jumps, 1);
+  fail_unless_equals_uint64 (rec->next_sample, 3 * SLAVE_SAMPLES + 320);
+
+  /* a lower latency moves the samples 160 samples earlier, one sample every
+   * 2000 samples without jumping */
+  gst_element_send_event (sink, gst_event_new_latency (20 * GST_MSECOND));
+  for (i = 3; i < 203; i++)
+    push_silence (h, i);
+  fail_unless_equals_uint64 (rec->next_sample, 203 * SLAVE_SAMPLES + 240);
+  for (; i < 410; i++)
+    push_silence (h, i);
+
+  fail_unless_equals_int (rec->jumps, 1);
+  fail_unless_equals_uint64 (rec->next_sample, 410 * SLAVE_SAMPLES + 160);
+  g_object_get (sink, "stats", &s, NULL);
+  fail_unless (gst_structure_get_uint64 (s, "resyncs", &resyncs));
+  fail_unless_equals_uint64 (resyncs, 0);
+  gst_structure_free (s);
+
+  /* without adaptive latency we use the whole ringbuffer again */
+  g_object_set (sink, "adaptive-latency", FALSE, NULL);
+  fail_unless_equals_uint64 (query_min_latency (sink), 200 * GST_MSECOND);
+
+  gst_harness_teardown (h);
+  gst_element_set_bus (sink, NULL);
+  gst_object_unref (bus);
+  gst_object_unref (sink);
+}
+
+GST_END_TEST;
+
 static Suite *
 audio_suite (void)
 {
@@ -626,6 +1052,10 @@ audio_suite (void)
   tcase_add_test (tc_chain, test_multichannel_checks);
   tcase_add_test (tc_chain, test_multichannel_reorder);
   tcase_add_test (tc_chain, test_fill_silence);
+  tcase_add_test (tc_chain, test_quantize_dither);
+  tcase_add_test (tc_chain, test_ring_buffer_stats);
+  tcase_add_test (tc_chain, test_audio_base_sink_resample_slaving);
+  tcase_add_test (tc_chain, test_audio_base_sink_adaptive_latency);
 
   return s;
 }
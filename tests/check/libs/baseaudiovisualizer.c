@@ -23,6 +23,7 @@
 
 #include <gst/check/gstcheck.h>
 #include <gst/pbutils/gstaudiovisualizer.h>
+#include <gst/pbutils/pbutils-enumtypes.h>
 #include <string.h>
 
 /* dummy subclass for testing */
@@ -36,6 +37,8 @@ typedef struct _GstTestScopeClass GstTestScopeClass;
 struct _GstTestScope
 {
   GstAudioVisualizer parent;
+
+  guint frames;
 };
 
 struct _GstTestScopeClass
@@ -65,10 +68,27 @@ static GType gst_test_scope_get_type (void);
 
 G_DEFINE_TYPE (GstTestScope, gst_test_scope, GST_TYPE_AUDIO_VISUALIZER);
 
+/* draws a single grey pixel in the top left corner of the first frame, the
+ * shader then fades it out over the following frames */
+static gboolean
+gst_test_scope_render (GstAudioVisualizer * base, GstBuffer * audio,
+    GstVideoFrame * video)
+{
+  GstTestScope *scope = GST_TEST_SCOPE (base);
+
+  if (scope->frames++ == 0) {
+    guint32 *pixel = GST_VIDEO_FRAME_PLANE_DATA (video, 0);
+
+    *pixel = 0x00808080;
+  }
+  return TRUE;
+}
+
 static void
 gst_test_scope_class_init (GstTestScopeClass * g_class)
 {
   GstElementClass *element_class = GST_ELEMENT_CLASS (g_class);
+  GstAudioVisualizerClass *scope_class = GST_AUDIO_VISUALIZER_CLASS (g_class);
 
   gst_element_class_set_static_metadata (element_class, "test scope",
       "Visualization",
@@ -78,6 +98,8 @@ gst_test_scope_class_init (GstTestScopeClass * g_class)
       &gst_test_scope_src_template);
   gst_element_class_add_static_pad_template (element_class,
       &gst_test_scope_sink_template);
+
+  scope_class->render = GST_DEBUG_FUNCPTR (gst_test_scope_render);
 }
 
 static void
@@ -154,6 +176,148 @@ GST_START_TEST (count_in_out)
 
 GST_END_TEST;
 
+static GstElement *
+setup_shader_scope (gint shader, gint width, gint height, GstPad ** srcpad)
+{
+  GstElement *elem;
+  GstPadTemplate *templ;
+  GstPad *sinkpad;
+  GstCaps *caps;
+
+  elem = gst_check_setup_element ("testscope");
+  g_object_set (elem, "shader", shader, "shade-amount", 0x00102030, NULL);
+
+  caps = gst_caps_new_simple ("video/x-raw",
+      "format", G_TYPE_STRING, "xRGB",
+      "width", G_TYPE_INT, width, "height", G_TYPE_INT, height,
+      "framerate", GST_TYPE_FRACTION, 30, 1, NULL);
+  templ = gst_pad_template_new ("sink", GST_PAD_SINK, GST_PAD_ALWAYS, caps);
+  gst_caps_unref (caps);
+
+  *srcpad = gst_check_setup_src_pad (elem, &srctemplate);
+  sinkpad = gst_check_setup_sink_pad_from_template (elem, templ);
+  gst_object_unref (templ);
+  gst_pad_set_active (*srcpad, TRUE);
+  gst_pad_set_active (sinkpad, TRUE);
+
+  fail_unless (gst_element_set_state (elem,
+          GST_STATE_PLAYING) == GST_STATE_CHANGE_SUCCESS,
+      "could not set to playing");
+
+  caps = gst_caps_from_string (CAPS);
+  gst_check_setup_events (*srcpad, elem, caps, GST_FORMAT_TIME);
+  gst_caps_unref (caps);
+
+  return elem;
+}
+
+static void
+cleanup_shader_scope (GstElement * elem, GstPad * srcpad)
+{
+  g_list_foreach (buffers, (GFunc) gst_mini_object_unref, NULL);
+  g_list_free (buffers);
+  buffers = NULL;
+
+  gst_pad_set_active (srcpad, FALSE);
+  gst_pad_set_active (GST_PAD_PEER (srcpad), FALSE);
+  gst_check_teardown_src_pad (elem);
+  gst_check_teardown_sink_pad (elem);
+  gst_check_teardown_element (elem);
+}
+
+/* pushes audio for @n_frames video frames */
+static void
+push_shader_frames (GstPad * srcpad, guint n_frames)
+{
+  GstBuffer *buffer;
+
+  buffer = gst_buffer_new_and_alloc ((44100 / 30) * n_frames * 2 *
+      sizeof (gint16));
+  gst_buffer_memset (buffer, 0, 0, gst_buffer_get_size (buffer));
+  fail_unless (gst_pad_push (srcpad, buffer) == GST_FLOW_OK);
+}
+
+static guint32
+get_first_pixel (GstBuffer * buffer)
+{
+  guint32 pixel;
+
+  gst_buffer_extract (buffer, 0, &pixel, sizeof (pixel));
+  return pixel;
+}
+
+GST_START_TEST (test_shader_fade)
+{
+  GstElement *elem;
+  GstPad *srcpad;
+
+  elem = setup_shader_scope (GST_AUDIO_VISUALIZER_SHADER_FADE, 320, 240,
+      &srcpad);
+
+  push_shader_frames (srcpad, 4);
+  fail_unless_equals_int (g_list_length (buffers), 4);
+
+  /* each frame fades the previous one by 0x10 red, 0x20 green and 0x30 blue,
+   * saturating at zero */
+  fail_unless_equals_int (get_first_pixel (g_list_nth_data (buffers, 0)),
+      0x00808080);
+  fail_unless_equals_int (get_first_pixel (g_list_nth_data (buffers, 1)),
+      0x00706050);
+  fail_unless_equals_int (get_first_pixel (g_list_nth_data (buffers, 2)),
+      0x00604020);
+  fail_unless_equals_int (get_first_pixel (g_list_nth_data (buffers, 3)),
+      0x00502000);
+
+  cleanup_shader_scope (elem, srcpad);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define SHADER_BENCHMARK_FRAMES 3
+
+GST_START_TEST (test_shader_benchmark)
+{
+  static const gint sizes[][2] = {
+    {320, 240}, {640, 480}, {1280, 720}, {1920, 1080}
+  };
+  GEnumClass *shaders;
+  GstElement *elem;
+  GstPad *srcpad;
+  GTimer *timer;
+  gdouble elapsed;
+  guint i, j;
+
+  shaders = g_type_class_ref (GST_TYPE_AUDIO_VISUALIZER_SHADER);
+  timer = g_timer_new ();
+
+  GST_DEBUG ("shader\tresolution\tms/frame");
+
+  for (i = 0; i < shaders->n_values; i++) {
+    for (j = 0; j < G_N_ELEMENTS (sizes); j++) {
+      elem = setup_shader_scope (shaders->values[i].value, sizes[j][0],
+          sizes[j][1], &srcpad);
+
+      g_timer_start (timer);
+      push_shader_frames (srcpad, SHADER_BENCHMARK_FRAMES);
+      elapsed = g_timer_elapsed (timer, NULL) * 1000.0 /
+          SHADER_BENCHMARK_FRAMES;
+
+      fail_unless_equals_int (g_list_length (buffers),
+          SHADER_BENCHMARK_FRAMES);
+      GST_DEBUG ("%s\t%dx%d\t%f", shaders->values[i].value_nick,
+          sizes[j][0], sizes[j][1], elapsed);
+
+      cleanup_shader_scope (elem, srcpad);
+    }
+  }
+
+  g_timer_destroy (timer);
+  g_type_class_unref (shaders);
+}
+
+GST_END_TEST;
+
 static void
 baseaudiovisualizer_init (void)
 {
@@ -170,6 +334,8 @@ baseaudiovisualizer_suite (void)
   tcase_add_checked_fixture (tc_chain, baseaudiovisualizer_init, NULL);
 
   tcase_add_test (tc_chain, count_in_out);
+  tcase_add_test (tc_chain, test_shader_fade);
+  tcase_add_test (tc_chain, test_shader_benchmark);
 
   return s;
 }
@@ -521,6 +521,209 @@ GST_START_TEST (test_f64_22050hz)
 
 GST_END_TEST;
 
+GST_START_TEST (test_f32_batch)
+{
+  gint i, j;
+  gfloat *in, *res;
+  GstFFTF32Complex *out, *ref;
+  GstFFTF32 *ctx, *ctx2, *ictx;
+
+  in = g_new (gfloat, 3 * 2048);
+  res = g_new (gfloat, 3 * 2048);
+  out = g_new (GstFFTF32Complex, 3 * 1025);
+  ref = g_new (GstFFTF32Complex, 1025);
+
+  /* both instances share the same plan */
+  ctx = gst_fft_f32_new (2048, FALSE);
+  ctx2 = gst_fft_f32_new (2048, FALSE);
+  ictx = gst_fft_f32_new (2048, TRUE);
+
+  for (j = 0; j < 3; j++)
+    for (i = 0; i < 2048; i++)
+      in[j * 2048 + i] = sin (2.0 * G_PI * (j + 1) * 1000.0 * i / 44100.0);
+
+  gst_fft_f32_fft_batch (ctx, in, out, 3);
+
+  for (j = 0; j < 3; j++) {
+    gst_fft_f32_fft (ctx2, in + j * 2048, ref);
+    for (i = 0; i < 1025; i++) {
+      fail_unless_equals_float (out[j * 1025 + i].r, ref[i].r);
+      fail_unless_equals_float (out[j * 1025 + i].i, ref[i].i);
+    }
+  }
+
+  gst_fft_f32_inverse_fft_batch (ictx, out, res, 3);
+
+  for (i = 0; i < 3 * 2048; i++)
+    fail_unless (fabs (res[i] / 2048.0 - in[i]) < 1e-4);
+
+  gst_fft_f32_free (ctx);
+  gst_fft_f32_free (ctx2);
+  gst_fft_f32_free (ictx);
+  g_free (in);
+  g_free (res);
+  g_free (out);
+  g_free (ref);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_s16_batch)
+{
+  gint i, j;
+  gint16 *in, *res, *ires;
+  GstFFTS16Complex *out, *ref;
+  GstFFTS16 *ctx, *ctx2, *ictx, *ictx2;
+
+  in = g_new (gint16, 3 * 2048);
+  res = g_new (gint16, 3 * 2048);
+  ires = g_new (gint16, 2048);
+  out = g_new (GstFFTS16Complex, 3 * 1025);
+  ref = g_new (GstFFTS16Complex, 1025);
+
+  ctx = gst_fft_s16_new (2048, FALSE);
+  ctx2 = gst_fft_s16_new (2048, FALSE);
+  ictx = gst_fft_s16_new (2048, TRUE);
+  ictx2 = gst_fft_s16_new (2048, TRUE);
+
+  for (j = 0; j < 3; j++)
+    for (i = 0; i < 2048; i++)
+      in[j * 2048 + i] =
+          16384 * sin (2.0 * G_PI * (j + 1) * 1000.0 * i / 44100.0);
+
+  gst_fft_s16_fft_batch (ctx, in, out, 3);
+
+  /* fixed point results must be identical to single transforms */
+  for (j = 0; j < 3; j++) {
+    gst_fft_s16_fft (ctx2, in + j * 2048, ref);
+    for (i = 0; i < 1025; i++) {
+      fail_unless_equals_int (out[j * 1025 + i].r, ref[i].r);
+      fail_unless_equals_int (out[j * 1025 + i].i, ref[i].i);
+    }
+  }
+
+  gst_fft_s16_inverse_fft_batch (ictx, out, res, 3);
+
+  for (j = 0; j < 3; j++) {
+    gst_fft_s16_inverse_fft (ictx2, out + j * 1025, ires);
+    for (i = 0; i < 2048; i++)
+      fail_unless_equals_int (res[j * 2048 + i], ires[i]);
+  }
+
+  gst_fft_s16_free (ctx);
+  gst_fft_s16_free (ctx2);
+  gst_fft_s16_free (ictx);
+  gst_fft_s16_free (ictx2);
+  g_free (in);
+  g_free (res);
+  g_free (ires);
+  g_free (out);
+  g_free (ref);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_s32_batch)
+{
+  gint i, j;
+  gint32 *in, *res, *ires;
+  GstFFTS32Complex *out, *ref;
+  GstFFTS32 *ctx, *ctx2, *ictx, *ictx2;
+
+  in = g_new (gint32, 3 * 2048);
+  res = g_new (gint32, 3 * 2048);
+  ires = g_new (gint32, 2048);
+  out = g_new (GstFFTS32Complex, 3 * 1025);
+  ref = g_new (GstFFTS32Complex, 1025);
+
+  ctx = gst_fft_s32_new (2048, FALSE);
+  ctx2 = gst_fft_s32_new (2048, FALSE);
+  ictx = gst_fft_s32_new (2048, TRUE);
+  ictx2 = gst_fft_s32_new (2048, TRUE);
+
+  for (j = 0; j < 3; j++)
+    for (i = 0; i < 2048; i++)
+      in[j * 2048 + i] =
+          268435456 * sin (2.0 * G_PI * (j + 1) * 1000.0 * i / 44100.0);
+
+  gst_fft_s32_fft_batch (ctx, in, out, 3);
+
+  /* fixed point results must be identical to single transforms */
+  for (j = 0; j < 3; j++) {
+    gst_fft_s32_fft (ctx2, in + j * 2048, ref);
+    for (i = 0; i < 1025; i++) {
+      fail_unless_equals_int (out[j * 1025 + i].r, ref[i].r);
+      fail_unless_equals_int (out[j * 1025 + i].i, ref[i].i);
+    }
+  }
+
+  gst_fft_s32_inverse_fft_batch (ictx, out, res, 3);
+
+  for (j = 0; j < 3; j++) {
+    gst_fft_s32_inverse_fft (ictx2, out + j * 1025, ires);
+    for (i = 0; i < 2048; i++)
+      fail_unless_equals_int (res[j * 2048 + i], ires[i]);
+  }
+
+  gst_fft_s32_free (ctx);
+  gst_fft_s32_free (ctx2);
+  gst_fft_s32_free (ictx);
+  gst_fft_s32_free (ictx2);
+  g_free (in);
+  g_free (res);
+  g_free (ires);
+  g_free (out);
+  g_free (ref);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_f64_batch)
+{
+  gint i, j;
+  gdouble *in, *res;
+  GstFFTF64Complex *out, *ref;
+  GstFFTF64 *ctx, *ctx2, *ictx;
+
+  in = g_new (gdouble, 3 * 2048);
+  res = g_new (gdouble, 3 * 2048);
+  out = g_new (GstFFTF64Complex, 3 * 1025);
+  ref = g_new (GstFFTF64Complex, 1025);
+
+  ctx = gst_fft_f64_new (2048, FALSE);
+  ctx2 = gst_fft_f64_new (2048, FALSE);
+  ictx = gst_fft_f64_new (2048, TRUE);
+
+  for (j = 0; j < 3; j++)
+    for (i = 0; i < 2048; i++)
+      in[j * 2048 + i] = sin (2.0 * G_PI * (j + 1) * 1000.0 * i / 44100.0);
+
+  gst_fft_f64_fft_batch (ctx, in, out, 3);
+
+  for (j = 0; j < 3; j++) {
+    gst_fft_f64_fft (ctx2, in + j * 2048, ref);
+    for (i = 0; i < 1025; i++) {
+      fail_unless_equals_float (out[j * 1025 + i].r, ref[i].r);
+      fail_unless_equals_float (out[j * 1025 + i].i, ref[i].i);
+    }
+  }
+
+  gst_fft_f64_inverse_fft_batch (ictx, out, res, 3);
+
+  for (i = 0; i < 3 * 2048; i++)
+    fail_unless (fabs (res[i] / 2048.0 - in[i]) < 1e-9);
+
+  gst_fft_f64_free (ctx);
+  gst_fft_f64_free (ctx2);
+  gst_fft_f64_free (ictx);
+  g_free (in);
+  g_free (res);
+  g_free (out);
+  g_free (ref);
+}
+
+GST_END_TEST;
+
 static Suite *
 fft_suite (void)
 {
@@ -541,6 +744,10 @@ fft_suite (void)
   tcase_add_test (tc_chain, test_f64_0hz);
   tcase_add_test (tc_chain, test_f64_11025hz);
   tcase_add_test (tc_chain, test_f64_22050hz);
+  tcase_add_test (tc_chain, test_s16_batch);
+  tcase_add_test (tc_chain, test_s32_batch);
+  tcase_add_test (tc_chain, test_f32_batch);
+  tcase_add_test (tc_chain, test_f64_batch);
 
   return s;
 }
@@ -201,6 +201,62 @@ GST_START_TEST (test_rtp_buffer_validate_padding)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtp_buffer_map_header_only)
+{
+  GstBuffer *buf;
+  GstMemory *mem;
+  guint8 packet_with_padding[] = {
+    0xa0, 0x60, 0x6c, 0x49, 0x58, 0xab, 0xaa, 0x65, 0x65, 0x2e, 0xaf, 0xce,
+    0x68, 0xce, 0x3c, 0x80, 0x00, 0x00, 0x00, 0xff
+  };
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+
+  /* header and payload in separate memories, with invalid padding */
+  buf = gst_buffer_new ();
+  mem = gst_allocator_alloc (NULL, 12, NULL);
+  gst_buffer_append_memory (buf, mem);
+  mem = gst_allocator_alloc (NULL, sizeof (packet_with_padding) - 12, NULL);
+  gst_buffer_append_memory (buf, mem);
+  gst_buffer_fill (buf, 0, packet_with_padding, sizeof (packet_with_padding));
+
+  fail_if (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+
+  memset (&rtp, 0, sizeof (rtp));
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ |
+          GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+  fail_unless (rtp.map[0].memory == gst_buffer_peek_memory (buf, 0));
+  fail_unless (rtp.map[1].memory == NULL);
+  fail_unless (rtp.map[2].memory == NULL);
+  fail_unless (rtp.map[3].memory == NULL);
+  fail_unless_equals_int (gst_rtp_buffer_get_version (&rtp), 2);
+  fail_unless (gst_rtp_buffer_get_padding (&rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_type (&rtp), 0x60);
+  fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), 0x6c49);
+  fail_unless_equals_int (gst_rtp_buffer_get_timestamp (&rtp), 0x58abaa65);
+  fail_unless_equals_int (gst_rtp_buffer_get_ssrc (&rtp), 0x652eafce);
+  fail_unless_equals_int (gst_rtp_buffer_get_csrc_count (&rtp), 0);
+  gst_rtp_buffer_unmap (&rtp);
+
+  /* the CSRCs must be in the first memory */
+  gst_buffer_memset (buf, 0, 0x82, 1);
+  fail_if (gst_rtp_buffer_map (buf, GST_MAP_READ |
+          GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+  gst_buffer_unref (buf);
+
+  buf = gst_buffer_new_and_alloc (sizeof (packet_with_padding));
+  gst_buffer_fill (buf, 0, packet_with_padding, sizeof (packet_with_padding));
+  gst_buffer_memset (buf, 0, 0x82, 1);
+  memset (&rtp, 0, sizeof (rtp));
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ |
+          GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_csrc_count (&rtp), 2);
+  fail_unless_equals_int (gst_rtp_buffer_get_csrc (&rtp, 1), 0x000000ff);
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+}
+
+GST_END_TEST;
+
 #if 0
 GST_START_TEST (test_rtp_buffer_list)
 {
@@ -1137,6 +1193,93 @@ GST_START_TEST (test_rtcp_buffer_app)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtcp_buffer_compound)
+{
+  GstBuffer *buf;
+  GstRTCPBuffer rtcp = GST_RTCP_BUFFER_INIT;
+  GstRTCPPacket packet;
+  guint i;
+
+  fail_unless ((buf = gst_rtcp_buffer_new (1400)) != NULL);
+  gst_rtcp_buffer_map (buf, GST_MAP_READWRITE, &rtcp);
+
+  /* SR, a NACK and a PLI per media source, SDES and BYE */
+  fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_SR, &packet));
+  gst_rtcp_packet_sr_set_sender_info (&packet, 0x44556677,
+      G_GUINT64_CONSTANT (1), 0x11111111, 101, 123456);
+  for (i = 0; i < 20; i++) {
+    fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_RTPFB,
+            &packet));
+    gst_rtcp_packet_fb_set_type (&packet, GST_RTCP_RTPFB_TYPE_NACK);
+    gst_rtcp_packet_fb_set_sender_ssrc (&packet, 0x44556677);
+    gst_rtcp_packet_fb_set_media_ssrc (&packet, i);
+    fail_unless (gst_rtcp_packet_fb_set_fci_length (&packet, 1));
+    GST_WRITE_UINT32_BE (gst_rtcp_packet_fb_get_fci (&packet), i << 16);
+
+    fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_PSFB,
+            &packet));
+    gst_rtcp_packet_fb_set_type (&packet, GST_RTCP_PSFB_TYPE_PLI);
+    gst_rtcp_packet_fb_set_sender_ssrc (&packet, 0x44556677);
+    gst_rtcp_packet_fb_set_media_ssrc (&packet, i);
+  }
+  fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_SDES, &packet));
+  fail_unless (gst_rtcp_packet_sdes_add_item (&packet, 0x44556677));
+  fail_unless (gst_rtcp_packet_sdes_add_entry (&packet, GST_RTCP_SDES_CNAME,
+          4, (const guint8 *) "peer"));
+  fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_BYE, &packet));
+  fail_unless (gst_rtcp_packet_bye_add_ssrc (&packet, 0x44556677));
+
+  fail_unless_equals_int (gst_rtcp_buffer_get_packet_count (&rtcp), 43);
+
+  /* remove the first NACK, the next packet goes after the BYE */
+  fail_unless (gst_rtcp_buffer_get_first_packet (&rtcp, &packet));
+  fail_unless (gst_rtcp_packet_move_to_next (&packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_RTPFB);
+  fail_unless (gst_rtcp_packet_remove (&packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_PSFB);
+  fail_unless_equals_int (gst_rtcp_buffer_get_packet_count (&rtcp), 42);
+
+  fail_unless (gst_rtcp_buffer_add_packet (&rtcp, GST_RTCP_TYPE_APP, &packet));
+  gst_rtcp_packet_app_set_name (&packet, "Test");
+  fail_unless_equals_int (gst_rtcp_buffer_get_packet_count (&rtcp), 43);
+
+  gst_rtcp_buffer_unmap (&rtcp);
+
+  fail_unless (gst_rtcp_buffer_validate (buf));
+
+  /* read it back */
+  gst_rtcp_buffer_map (buf, GST_MAP_READ, &rtcp);
+  fail_unless_equals_int (gst_rtcp_buffer_get_packet_count (&rtcp), 43);
+
+  fail_unless (gst_rtcp_buffer_get_first_packet (&rtcp, &packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_SR);
+  fail_unless (gst_rtcp_packet_move_to_next (&packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_PSFB);
+  fail_unless_equals_int (gst_rtcp_packet_fb_get_media_ssrc (&packet), 0);
+  for (i = 1; i < 20; i++) {
+    fail_unless (gst_rtcp_packet_move_to_next (&packet));
+    fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_RTPFB);
+    fail_unless_equals_int (gst_rtcp_packet_fb_get_media_ssrc (&packet), i);
+    fail_unless_equals_int (GST_READ_UINT32_BE (gst_rtcp_packet_fb_get_fci
+            (&packet)), i << 16);
+    fail_unless (gst_rtcp_packet_move_to_next (&packet));
+    fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_PSFB);
+    fail_unless_equals_int (gst_rtcp_packet_fb_get_media_ssrc (&packet), i);
+  }
+  fail_unless (gst_rtcp_packet_move_to_next (&packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_SDES);
+  fail_unless (gst_rtcp_packet_move_to_next (&packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_BYE);
+  fail_unless (gst_rtcp_packet_move_to_next (&packet));
+  fail_unless (gst_rtcp_packet_get_type (&packet) == GST_RTCP_TYPE_APP);
+  fail_if (gst_rtcp_packet_move_to_next (&packet));
+
+  gst_rtcp_buffer_unmap (&rtcp);
+  gst_buffer_unref (buf);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtp_ntp64_extension)
 {
   GstBuffer *buf;
@@ -1336,6 +1479,177 @@ GST_START_TEST (test_rtp_buffer_get_payload_bytes)
 GST_END_TEST;
 
 
+GST_START_TEST (test_rtp_buffer_extension_table)
+{
+  GstBuffer *buf;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstRTPExtensionTable table;
+  GstRTPExtensionElement elements[3];
+  guint8 abs_send_time[3] = { 0x12, 0x34, 0x56 };
+  guint8 transport_cc[2] = { 0x01, 0x02 };
+  guint8 audio_level[1] = { 0x7f };
+  guint8 many[20];
+  gpointer data;
+  guint size, i;
+
+  /* no extension */
+  buf = gst_rtp_buffer_new_allocate (4, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_READWRITE, &rtp);
+  fail_if (gst_rtp_buffer_parse_extensions (&rtp, &table));
+  fail_if (gst_rtp_extension_table_get (&table, 1, 0, &data, &size));
+
+  /* one byte header, added in one go after an existing element */
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_header (&rtp, 5,
+          audio_level, 1));
+  elements[0].id = 3;
+  elements[0].size = 3;
+  elements[0].data = abs_send_time;
+  elements[1].id = 4;
+  elements[1].size = 2;
+  elements[1].data = transport_cc;
+  elements[2].id = 5;
+  elements[2].size = 1;
+  elements[2].data = audio_level;
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_headers (&rtp, elements,
+          3));
+
+  fail_unless (gst_rtp_buffer_parse_extensions (&rtp, &table));
+  fail_unless (gst_rtp_extension_table_get (&table, 3, 0, &data, &size));
+  fail_unless_equals_int (size, 3);
+  fail_unless (memcmp (data, abs_send_time, 3) == 0);
+  fail_unless (gst_rtp_extension_table_get (&table, 4, 0, &data, &size));
+  fail_unless_equals_int (size, 2);
+  fail_unless (memcmp (data, transport_cc, 2) == 0);
+  fail_unless (gst_rtp_extension_table_get (&table, 5, 1, &data, &size));
+  fail_unless_equals_int (size, 1);
+  fail_if (gst_rtp_extension_table_get (&table, 5, 2, &data, &size));
+  fail_if (gst_rtp_extension_table_get (&table, 6, 0, &data, &size));
+
+  /* same result as the lookups that parse the extension themselves */
+  for (i = 1; i < 15; i++) {
+    gpointer data2;
+    guint size2;
+    gboolean res;
+
+    res = gst_rtp_buffer_get_extension_onebyte_header (&rtp, i, 0, &data2,
+        &size2);
+    fail_unless_equals_int (gst_rtp_extension_table_get (&table, i, 0, &data,
+            &size), res);
+    if (res) {
+      fail_unless (data == data2);
+      fail_unless_equals_int (size, size2);
+    }
+  }
+
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+
+  /* two bytes header with more elements than fit in the table */
+  buf = gst_rtp_buffer_new_allocate (4, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_READWRITE, &rtp);
+
+  for (i = 0; i < G_N_ELEMENTS (many); i++) {
+    many[i] = i;
+    fail_unless (gst_rtp_buffer_add_extension_twobytes_header (&rtp, 0x5,
+            i + 1, &many[i], 1));
+  }
+  fail_unless (gst_rtp_buffer_parse_extensions (&rtp, &table));
+  for (i = 0; i < G_N_ELEMENTS (many); i++) {
+    fail_unless (gst_rtp_extension_table_get (&table, i + 1, 0, &data, &size));
+    fail_unless_equals_int (size, 1);
+    fail_unless_equals_int (*(guint8 *) data, i);
+  }
+  fail_if (gst_rtp_extension_table_get (&table, 100, 0, &data, &size));
+
+  /* appbits must match */
+  fail_if (gst_rtp_buffer_add_extension_twobytes_headers (&rtp, 0x6, elements,
+          1));
+  fail_unless (gst_rtp_buffer_add_extension_twobytes_headers (&rtp, 0x5,
+          elements, 2));
+  fail_unless (gst_rtp_buffer_get_extension_twobytes_header (&rtp, NULL, 4, 0,
+          &data, &size));
+  fail_unless_equals_int (size, 2);
+  fail_unless (memcmp (data, transport_cc, 2) == 0);
+
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtp_buffer_add_extension_headers_too_long)
+{
+  GstBuffer *buf;
+  GstRTPBuffer rtp = GST_RTP_BUFFER_INIT;
+  GstRTPExtensionElement *elements;
+  guint8 payload[255] = { 0, };
+  guint8 level = 0x7f;
+  gpointer data;
+  guint size, i;
+
+  /* the extension length is counted in 16 bits of words, so at most
+   * 65535 * 4 bytes of elements fit */
+  elements = g_new0 (GstRTPExtensionElement, 15421);
+  for (i = 0; i < 15421; i++) {
+    elements[i].id = 1;
+    elements[i].size = 16;
+    elements[i].data = payload;
+  }
+
+  buf = gst_rtp_buffer_new_allocate (4, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_READWRITE, &rtp);
+
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_header (&rtp, 5,
+          &level, 1));
+  /* 15420 * 17 bytes and the existing element need 65536 words */
+  fail_if (gst_rtp_buffer_add_extension_onebyte_headers (&rtp, elements,
+          15420));
+  fail_if (gst_rtp_buffer_add_extension_onebyte_headers (&rtp, elements,
+          15421));
+  fail_unless (gst_rtp_buffer_add_extension_onebyte_headers (&rtp, elements,
+          15419));
+  fail_unless (gst_rtp_buffer_get_extension_onebyte_header (&rtp, 5, 0, &data,
+          &size));
+  fail_unless_equals_int (size, 1);
+  fail_unless_equals_int (*(guint8 *) data, 0x7f);
+
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+
+  /* 1021 * 257 bytes need 65600 words */
+  for (i = 0; i < 1021; i++)
+    elements[i].size = 255;
+
+  buf = gst_rtp_buffer_new_allocate (4, 0, 0);
+  gst_rtp_buffer_map (buf, GST_MAP_READWRITE, &rtp);
+
+  fail_if (gst_rtp_buffer_add_extension_twobytes_headers (&rtp, 0, elements,
+          1021));
+  fail_if (gst_rtp_buffer_get_extension (&rtp));
+  fail_unless (gst_rtp_buffer_add_extension_twobytes_headers (&rtp, 0, elements,
+          1020));
+  fail_unless (gst_rtp_buffer_get_extension_twobytes_header (&rtp, NULL, 1,
+          1019, &data, &size));
+  fail_unless_equals_int (size, 255);
+
+  gst_rtp_buffer_unmap (&rtp);
+
+  /* a header only map has no extension data to write to */
+  memset (&rtp, 0, sizeof (rtp));
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READWRITE |
+          GST_RTP_BUFFER_MAP_FLAG_HEADER_ONLY, &rtp));
+  ASSERT_CRITICAL (fail_if (gst_rtp_buffer_add_extension_onebyte_headers
+          (&rtp, elements, 1)));
+  ASSERT_CRITICAL (fail_if (gst_rtp_buffer_add_extension_twobytes_headers
+          (&rtp, 0, elements, 1)));
+  gst_rtp_buffer_unmap (&rtp);
+  gst_buffer_unref (buf);
+
+  g_free (elements);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtp_buffer_empty_payload)
 {
   GstRTPBuffer rtp = { NULL };
@@ -1363,6 +1677,7 @@ rtp_suite (void)
   tcase_add_test (tc_chain, test_rtp_buffer);
   tcase_add_test (tc_chain, test_rtp_buffer_validate_corrupt);
   tcase_add_test (tc_chain, test_rtp_buffer_validate_padding);
+  tcase_add_test (tc_chain, test_rtp_buffer_map_header_only);
   tcase_add_test (tc_chain, test_rtp_buffer_set_extension_data);
   //tcase_add_test (tc_chain, test_rtp_buffer_list_set_extension);
   tcase_add_test (tc_chain, test_rtp_seqnum_compare);
@@ -1379,12 +1694,15 @@ rtp_suite (void)
   tcase_add_test (tc_chain, test_rtcp_validate_reduced_with_padding);
   tcase_add_test (tc_chain, test_rtcp_buffer_profile_specific_extension);
   tcase_add_test (tc_chain, test_rtcp_buffer_app);
+  tcase_add_test (tc_chain, test_rtcp_buffer_compound);
 
   tcase_add_test (tc_chain, test_rtp_ntp64_extension);
   tcase_add_test (tc_chain, test_rtp_ntp56_extension);
 
   tcase_add_test (tc_chain, test_rtp_buffer_get_payload_bytes);
   tcase_add_test (tc_chain, test_rtp_buffer_get_extension_bytes);
+  tcase_add_test (tc_chain, test_rtp_buffer_extension_table);
+  tcase_add_test (tc_chain, test_rtp_buffer_add_extension_headers_too_long);
   tcase_add_test (tc_chain, test_rtp_buffer_empty_payload);
 
   //tcase_add_test (tc_chain, test_rtp_buffer_list);
@@ -1228,6 +1228,81 @@ GST_START_TEST (rtp_base_depayload_clock_base_test)
   destroy_depayloader (state);
 }
 
+GST_END_TEST
+/* push a buffer list to a depayloader that processes lists. the subclass is
+ * called once with the packets that passed the checks: the invalid and the
+ * old packet are dropped and the packet after the gap is marked DISCONT.
+ */
+static GstBuffer *
+create_rtp_packet (GstClockTime pts, guint32 rtptime, guint16 seq)
+{
+  GstBuffer *buf = gst_rtp_buffer_new_allocate (0, 0, 0);
+  GstRTPBuffer rtp = { NULL };
+
+  GST_BUFFER_PTS (buf) = pts;
+  gst_rtp_buffer_map (buf, GST_MAP_WRITE, &rtp);
+  gst_rtp_buffer_set_timestamp (&rtp, rtptime);
+  gst_rtp_buffer_set_seq (&rtp, seq);
+  gst_rtp_buffer_unmap (&rtp);
+
+  return buf;
+}
+
+GST_START_TEST (rtp_base_depayload_process_list_test)
+{
+  GstRTPBaseDepayloadClass *klass;
+  GstBufferList *list;
+  State *state;
+
+  klass = g_type_class_ref (GST_TYPE_RTP_DUMMY_DEPAY);
+  klass->process_rtp_packet_list = gst_rtp_dummy_depay_process_list;
+  process_list_calls = 0;
+
+  state = create_depayloader ("application/x-rtp", NULL);
+
+  set_state (state, GST_STATE_PLAYING);
+
+  list = gst_buffer_list_new ();
+  gst_buffer_list_add (list, create_rtp_packet (0 * GST_SECOND,
+          0x43214321, 0x4242));
+  gst_buffer_list_add (list, gst_buffer_new_allocate (NULL, 0, NULL));
+  gst_buffer_list_add (list, create_rtp_packet (1 * GST_SECOND,
+          0x43214321 + 1 * DEFAULT_CLOCK_RATE, 0x4242 + 1));
+  gst_buffer_list_add (list, create_rtp_packet (2 * GST_SECOND,
+          0x43214321 + 2 * DEFAULT_CLOCK_RATE, 0x4242 - 1));
+  gst_buffer_list_add (list, create_rtp_packet (3 * GST_SECOND,
+          0x43214321 + 3 * DEFAULT_CLOCK_RATE, 0x4242 + 3));
+  fail_unless_equals_int (gst_pad_push_list (state->srcpad, list),
+      GST_FLOW_OK);
+
+  set_state (state, GST_STATE_NULL);
+
+  fail_unless_equals_int (process_list_calls, 1);
+
+  validate_buffers_received (3);
+
+  validate_buffer (0, "pts", 0 * GST_SECOND, "discont", FALSE, NULL);
+
+  validate_buffer (1, "pts", 1 * GST_SECOND, "discont", FALSE, NULL);
+
+  validate_buffer (2, "pts", 3 * GST_SECOND, "discont", TRUE, NULL);
+
+  validate_events_received (3);
+
+  validate_event (0, "stream-start", NULL);
+
+  validate_event (1, "caps", "media-type", "application/x-rtp", NULL);
+
+  validate_event (2, "segment",
+      "time", G_GUINT64_CONSTANT (0),
+      "start", G_GUINT64_CONSTANT (0), "stop", G_MAXUINT64, NULL);
+
+  destroy_depayloader (state);
+
+  klass->process_rtp_packet_list = NULL;
+  g_type_class_unref (klass);
+}
+
 GST_END_TEST static Suite *
 rtp_basepayloading_suite (void)
 {
@@ -1255,6 +1330,7 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_depayload_play_scale_test);
   tcase_add_test (tc_chain, rtp_base_depayload_play_speed_test);
   tcase_add_test (tc_chain, rtp_base_depayload_clock_base_test);
+  tcase_add_test (tc_chain, rtp_base_depayload_process_list_test);
 
   return s;
 }
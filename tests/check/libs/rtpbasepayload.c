@@ -20,8 +20,10 @@
 
 #include <gst/gst.h>
 #include <gst/check/gstcheck.h>
+#include <gst/check/gstharness.h>
 #include <gst/rtp/gstrtpbuffer.h>
 #include <gst/rtp/gstrtpbasepayload.h>
+#include <gst/rtp/gstrtpbaseaudiopayload.h>
 
 #define DEFAULT_CLOCK_RATE (42)
 #define BUFFER_BEFORE_LIST (10)
@@ -1842,6 +1844,383 @@ GST_START_TEST (rtp_base_payload_max_framerate_attribute)
 
 GST_END_TEST;
 
+/* allocate a packet with the header from the payloader pool and push it. the
+ * base class fills in the header fields like for any other packet and the
+ * header memory is reused for the next packet once the first is freed.
+ */
+GST_START_TEST (rtp_base_payload_allocate_output_buffer_test)
+{
+  GstRTPBuffer rtp = { NULL };
+  GstRTPBasePayload *pay;
+  State *state;
+  GstBuffer *buf;
+  GstMemory *mem;
+  guint32 rtptime;
+  guint16 seq;
+
+  state = create_payloader ("application/x-rtp", &sinktmpl,
+      "perfect-rtptime", FALSE, "ssrc", 0x4242, NULL);
+  pay = GST_RTP_BASE_PAYLOAD (state->element);
+
+  set_state (state, GST_STATE_PLAYING);
+
+  push_buffer (state, "pts", 0 * GST_SECOND, NULL);
+
+  buf = gst_rtp_base_payload_allocate_output_buffer (pay, 4, 2, 1);
+  fail_unless_equals_int (gst_buffer_n_memory (buf), 2);
+  fail_unless_equals_int (gst_buffer_get_size (buf), 12 + 4 + 4 + 2);
+  fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_csrc_count (&rtp), 1);
+  fail_unless (gst_rtp_buffer_get_padding (&rtp));
+  fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 4);
+  gst_rtp_buffer_unmap (&rtp);
+
+  mem = gst_buffer_peek_memory (buf, 0);
+  GST_BUFFER_PTS (buf) = 1 * GST_SECOND;
+  fail_unless_equals_int (gst_rtp_base_payload_push (pay, buf), GST_FLOW_OK);
+
+  set_state (state, GST_STATE_NULL);
+
+  validate_buffers_received (2);
+
+  get_buffer_field (0, "rtptime", &rtptime, "seq", &seq, NULL);
+
+  validate_buffer (1,
+      "pts", 1 * GST_SECOND,
+      "rtptime", rtptime + 1 * DEFAULT_CLOCK_RATE, "seq", seq + 1,
+      "ssrc", 0x4242, "payload-type", 96, NULL);
+
+  gst_check_drop_buffers ();
+
+  buf = gst_rtp_base_payload_allocate_output_buffer (pay, 0, 0, 0);
+  fail_unless_equals_int (gst_buffer_n_memory (buf), 1);
+  fail_unless_equals_int (gst_buffer_get_size (buf), 12);
+  fail_unless (gst_buffer_peek_memory (buf, 0) == mem);
+  gst_buffer_unref (buf);
+
+  destroy_payloader (state);
+}
+
+GST_END_TEST;
+
+/* GstRtpDummyAudioPay, sample based with one byte per sample */
+
+#define DUMMY_AUDIO_CLOCK_RATE (8000)
+/* 100 samples */
+#define DUMMY_AUDIO_PTIME (12500 * GST_USECOND)
+
+#define GST_TYPE_RTP_DUMMY_AUDIO_PAY \
+  (gst_rtp_dummy_audio_pay_get_type())
+
+typedef struct _GstRtpDummyAudioPay GstRtpDummyAudioPay;
+typedef struct _GstRtpDummyAudioPayClass GstRtpDummyAudioPayClass;
+
+struct _GstRtpDummyAudioPay
+{
+  GstRTPBaseAudioPayload payload;
+};
+
+struct _GstRtpDummyAudioPayClass
+{
+  GstRTPBaseAudioPayloadClass parent_class;
+};
+
+GType gst_rtp_dummy_audio_pay_get_type (void);
+
+G_DEFINE_TYPE (GstRtpDummyAudioPay, gst_rtp_dummy_audio_pay,
+    GST_TYPE_RTP_BASE_AUDIO_PAYLOAD);
+
+static gboolean
+gst_rtp_dummy_audio_pay_set_caps (GstRTPBasePayload * pay, GstCaps * caps)
+{
+  return gst_rtp_base_payload_set_outcaps (pay, NULL);
+}
+
+static void
+gst_rtp_dummy_audio_pay_class_init (GstRtpDummyAudioPayClass * klass)
+{
+  GstElementClass *gstelement_class;
+  GstRTPBasePayloadClass *gstrtpbasepayload_class;
+
+  gstelement_class = GST_ELEMENT_CLASS (klass);
+  gstrtpbasepayload_class = GST_RTP_BASE_PAYLOAD_CLASS (klass);
+
+  gst_element_class_add_static_pad_template (gstelement_class,
+      &gst_rtp_dummy_pay_sink_template);
+  gst_element_class_add_static_pad_template (gstelement_class,
+      &gst_rtp_dummy_pay_src_template);
+
+  gstrtpbasepayload_class->set_caps = gst_rtp_dummy_audio_pay_set_caps;
+}
+
+static void
+gst_rtp_dummy_audio_pay_init (GstRtpDummyAudioPay * pay)
+{
+  GstRTPBaseAudioPayload *audiopay = GST_RTP_BASE_AUDIO_PAYLOAD (pay);
+
+  gst_rtp_base_payload_set_options (GST_RTP_BASE_PAYLOAD (pay), "audio",
+      TRUE, "L8", DUMMY_AUDIO_CLOCK_RATE);
+  gst_rtp_base_audio_payload_set_sample_based (audiopay);
+  gst_rtp_base_audio_payload_set_sample_options (audiopay, 1);
+}
+
+/* every packet carries exactly DUMMY_AUDIO_PTIME of audio */
+static GstHarness *
+create_audio_payloader (const gchar * property, ...)
+{
+  GstElement *element;
+  GstHarness *h;
+  va_list var_args;
+
+  element = g_object_new (GST_TYPE_RTP_DUMMY_AUDIO_PAY,
+      "min-ptime", (gint64) DUMMY_AUDIO_PTIME,
+      "max-ptime", (gint64) DUMMY_AUDIO_PTIME, NULL);
+
+  va_start (var_args, property);
+  g_object_set_valist (G_OBJECT (element), property, var_args);
+  va_end (var_args);
+
+  h = gst_harness_new_with_element (element, "sink", "src");
+  gst_object_unref (element);
+
+  gst_harness_set_src_caps_str (h, "audio/x-raw, format=(string)U8, "
+      "rate=(int)8000, channels=(int)1, layout=(string)interleaved");
+
+  return h;
+}
+
+/* @size samples starting at sample @start, each sample holds the low byte
+ * of its position */
+static GstBuffer *
+create_audio_buffer (guint start, guint size)
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  guint i;
+
+  buf = gst_buffer_new_and_alloc (size);
+  gst_buffer_map (buf, &map, GST_MAP_WRITE);
+  for (i = 0; i < size; i++)
+    map.data[i] = start + i;
+  gst_buffer_unmap (buf, &map);
+
+  GST_BUFFER_PTS (buf) = gst_util_uint64_scale_int (start, GST_SECOND,
+      DUMMY_AUDIO_CLOCK_RATE);
+  GST_BUFFER_DURATION (buf) = gst_util_uint64_scale_int (size, GST_SECOND,
+      DUMMY_AUDIO_CLOCK_RATE);
+
+  return buf;
+}
+
+static GstPadProbeReturn
+count_pushes_probe (GstPad * pad, GstPadProbeInfo * info, gpointer user_data)
+{
+  guint *counts = user_data;
+
+  if (GST_PAD_PROBE_INFO_TYPE (info) & GST_PAD_PROBE_TYPE_BUFFER_LIST)
+    counts[1]++;
+  else
+    counts[0]++;
+
+  return GST_PAD_PROBE_OK;
+}
+
+GST_START_TEST (rtp_base_audio_payload_no_copy_test)
+{
+  GstBuffer *in[2], *buf;
+  guint8 *data[2];
+  GstMapInfo map;
+  GstHarness *h;
+  guint i, m, offset;
+
+  h = create_audio_payloader (NULL);
+
+  /* 300 samples give 3 packets, the second one takes 50 samples from each
+   * input buffer */
+  for (i = 0; i < 2; i++) {
+    in[i] = create_audio_buffer (i * 150, 150);
+    gst_buffer_map (in[i], &map, GST_MAP_READ);
+    data[i] = map.data;
+    gst_buffer_unmap (in[i], &map);
+    fail_unless_equals_int (gst_harness_push (h, in[i]), GST_FLOW_OK);
+  }
+
+  fail_unless_equals_int (gst_harness_buffers_received (h), 3);
+
+  for (i = 0; i < 3; i++) {
+    buf = gst_harness_pull (h);
+    fail_unless_equals_int (gst_buffer_get_size (buf), 12 + 100);
+    /* the header and one memory per input buffer */
+    fail_unless_equals_int (gst_buffer_n_memory (buf), i == 1 ? 3 : 2);
+
+    /* the payload memories point into the input buffers */
+    offset = i * 100;
+    for (m = 1; m < gst_buffer_n_memory (buf); m++) {
+      GstMemory *mem = gst_buffer_peek_memory (buf, m);
+
+      fail_unless (gst_memory_map (mem, &map, GST_MAP_READ));
+      fail_unless (map.data == data[offset / 150] + offset % 150);
+      offset += map.size;
+      gst_memory_unmap (mem, &map);
+    }
+    fail_unless_equals_int (offset, (i + 1) * 100);
+
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (rtp_base_audio_payload_buffer_list_test)
+{
+  static const guint sizes[] = { 250, 150, 100, 250 };
+  GstRTPBuffer rtp = { NULL };
+  guint counts[2] = { 0, 0 };
+  guint32 rtptime = 0;
+  guint16 seq = 0;
+  GstHarness *h;
+  GstBuffer *buf;
+  GstPad *srcpad;
+  guint i, start;
+
+  h = create_audio_payloader ("buffer-list", TRUE, NULL);
+
+  srcpad = gst_element_get_static_pad (h->element, "src");
+  gst_pad_add_probe (srcpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      count_pushes_probe, counts, NULL);
+  gst_object_unref (srcpad);
+
+  /* the third buffer is exactly one packet and takes the fast path */
+  start = 0;
+  for (i = 0; i < G_N_ELEMENTS (sizes); i++) {
+    fail_unless_equals_int (gst_harness_push (h,
+            create_audio_buffer (start, sizes[i])), GST_FLOW_OK);
+    start += sizes[i];
+
+    /* one list for all packets of an input buffer */
+    fail_unless_equals_int (counts[1], i + 1);
+    fail_unless_equals_int (counts[0], 0);
+  }
+
+  fail_unless_equals_int (gst_harness_buffers_received (h), 7);
+
+  for (i = 0; i < 7; i++) {
+    buf = gst_harness_pull (h);
+
+    fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+    if (i == 0) {
+      seq = gst_rtp_buffer_get_seq (&rtp);
+      rtptime = gst_rtp_buffer_get_timestamp (&rtp);
+    }
+    fail_unless_equals_int (gst_rtp_buffer_get_seq (&rtp), (guint16) (seq + i));
+    fail_unless_equals_uint64 (gst_rtp_buffer_get_timestamp (&rtp),
+        (guint32) (rtptime + i * 100));
+    fail_unless_equals_int (gst_rtp_buffer_get_payload_len (&rtp), 100);
+    fail_if (gst_rtp_buffer_get_marker (&rtp));
+    gst_rtp_buffer_unmap (&rtp);
+
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buf), i * DUMMY_AUDIO_PTIME);
+
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (rtp_base_audio_payload_discont_marker_test)
+{
+  static const guint starts[] = { 0, 800, 900 };
+  GstRTPBuffer rtp = { NULL };
+  GstHarness *h;
+  GstBuffer *buf;
+  guint i;
+
+  h = create_audio_payloader (NULL);
+
+  /* the second buffer comes after a gap */
+  for (i = 0; i < G_N_ELEMENTS (starts); i++) {
+    buf = create_audio_buffer (starts[i], 100);
+    if (i == 1)
+      GST_BUFFER_FLAG_SET (buf, GST_BUFFER_FLAG_DISCONT);
+    fail_unless_equals_int (gst_harness_push (h, buf), GST_FLOW_OK);
+  }
+
+  fail_unless_equals_int (gst_harness_buffers_received (h), 3);
+
+  for (i = 0; i < G_N_ELEMENTS (starts); i++) {
+    buf = gst_harness_pull (h);
+
+    fail_unless_equals_uint64 (GST_BUFFER_PTS (buf),
+        gst_util_uint64_scale_int (starts[i], GST_SECOND,
+            DUMMY_AUDIO_CLOCK_RATE));
+    fail_unless_equals_int (! !GST_BUFFER_FLAG_IS_SET (buf,
+            GST_BUFFER_FLAG_DISCONT), i == 1);
+
+    fail_unless (gst_rtp_buffer_map (buf, GST_MAP_READ, &rtp));
+    fail_unless_equals_int (gst_rtp_buffer_get_marker (&rtp), i == 1);
+    gst_rtp_buffer_unmap (&rtp);
+
+    gst_buffer_unref (buf);
+  }
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (rtp_base_payload_batch_packets_test)
+{
+  static const guint sizes[] = { 250, 150, 300, 200 };
+  guint counts[2] = { 0, 0 };
+  GstHarness *h;
+  GstPad *srcpad;
+  guint i, start;
+
+  h = create_audio_payloader ("batch-packets", TRUE, NULL);
+
+  srcpad = gst_element_get_static_pad (h->element, "src");
+  gst_pad_add_probe (srcpad,
+      GST_PAD_PROBE_TYPE_BUFFER | GST_PAD_PROBE_TYPE_BUFFER_LIST,
+      count_pushes_probe, counts, NULL);
+  gst_object_unref (srcpad);
+
+  /* the packets that the subclass pushes one by one arrive in one list per
+   * input buffer */
+  start = 0;
+  for (i = 0; i < 2; i++) {
+    fail_unless_equals_int (gst_harness_push (h,
+            create_audio_buffer (start, sizes[i])), GST_FLOW_OK);
+    start += sizes[i];
+
+    fail_unless_equals_int (counts[1], i + 1);
+    fail_unless_equals_int (counts[0], 0);
+  }
+  fail_unless_equals_int (gst_harness_buffers_received (h), 4);
+
+  /* the flow return of the batch reaches upstream */
+  gst_pad_set_active (h->sinkpad, FALSE);
+  fail_unless_equals_int (gst_harness_push (h,
+          create_audio_buffer (start, sizes[2])), GST_FLOW_FLUSHING);
+  start += sizes[2];
+  fail_unless_equals_int (counts[1], 3);
+
+  /* after a failed push every packet goes downstream right away so that the
+   * subclass gets the flow return */
+  fail_unless_equals_int (gst_harness_push (h,
+          create_audio_buffer (start, sizes[3])), GST_FLOW_FLUSHING);
+  fail_unless_equals_int (counts[1], 5);
+  fail_unless_equals_int (counts[0], 0);
+
+  gst_harness_teardown (h);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtp_basepayloading_suite (void)
 {
@@ -1879,6 +2258,14 @@ rtp_basepayloading_suite (void)
   tcase_add_test (tc_chain, rtp_base_payload_framerate_attribute);
   tcase_add_test (tc_chain, rtp_base_payload_max_framerate_attribute);
 
+  tcase_add_test (tc_chain, rtp_base_payload_allocate_output_buffer_test);
+
+  tcase_add_test (tc_chain, rtp_base_audio_payload_no_copy_test);
+  tcase_add_test (tc_chain, rtp_base_audio_payload_buffer_list_test);
+  tcase_add_test (tc_chain, rtp_base_audio_payload_discont_marker_test);
+
+  tcase_add_test (tc_chain, rtp_base_payload_batch_packets_test);
+
   return s;
 }
 
@@ -652,6 +652,100 @@ GST_START_TEST (test_rtsp_message)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtsp_message_headers)
+{
+  GstRTSPMessage *msg;
+  GstRTSPResult res;
+  GString *str;
+  gchar *val = NULL;
+  gchar *long_value;
+  gint i;
+
+  res = gst_rtsp_message_new_response (&msg, GST_RTSP_STS_OK, NULL, NULL);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+
+  /* enough headers and values to overflow the first arena block */
+  for (i = 0; i < 200; i++) {
+    gchar *name = g_strdup_printf ("X-Header-%d", i);
+    gchar *value = g_strdup_printf ("value-%d", i);
+
+    res = gst_rtsp_message_add_header_by_name (msg, name, value);
+    fail_unless_equals_int (res, GST_RTSP_OK);
+    res = gst_rtsp_message_add_header (msg, GST_RTSP_HDR_SERVER, value);
+    fail_unless_equals_int (res, GST_RTSP_OK);
+    g_free (name);
+    g_free (value);
+  }
+  long_value = g_strnfill (4000, 'x');
+  res = gst_rtsp_message_add_header (msg, GST_RTSP_HDR_CSEQ, long_value);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  res = gst_rtsp_message_take_header (msg, GST_RTSP_HDR_SESSION,
+      g_strdup ("session"));
+  fail_unless_equals_int (res, GST_RTSP_OK);
+
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_CSEQ, &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, long_value);
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SERVER, &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, "value-0");
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SERVER, &val, 199);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, "value-199");
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SERVER, &val, 200);
+  fail_unless_equals_int (res, GST_RTSP_ENOTIMPL);
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_DATE, &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_ENOTIMPL);
+  res = gst_rtsp_message_get_header_by_name (msg, "x-header-150", &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, "value-150");
+  res = gst_rtsp_message_get_header_by_name (msg, "Server", &val, 1);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, "value-1");
+
+  /* removing the first header of a field moves the lookup to the next one */
+  res = gst_rtsp_message_remove_header (msg, GST_RTSP_HDR_SERVER, 0);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SERVER, &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, "value-1");
+  res = gst_rtsp_message_remove_header_by_name (msg, "X-Header-0", -1);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SESSION, &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (val, "session");
+  res = gst_rtsp_message_remove_header (msg, GST_RTSP_HDR_SERVER, -1);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  res = gst_rtsp_message_get_header (msg, GST_RTSP_HDR_SERVER, &val, 0);
+  fail_unless_equals_int (res, GST_RTSP_ENOTIMPL);
+  res = gst_rtsp_message_remove_header (msg, GST_RTSP_HDR_CSEQ, -1);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  res = gst_rtsp_message_remove_header_by_name (msg, "X-Header-2", -1);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+
+  for (i = 3; i < 200; i++) {
+    gchar *name = g_strdup_printf ("X-Header-%d", i);
+
+    res = gst_rtsp_message_remove_header_by_name (msg, name, -1);
+    fail_unless_equals_int (res, GST_RTSP_OK);
+    g_free (name);
+  }
+
+  /* serialised in insertion order */
+  str = g_string_new ("start\r\n");
+  res = gst_rtsp_message_append_headers (msg, str);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+  fail_unless_equals_string (str->str,
+      "start\r\nX-Header-1: value-1\r\nSession: session\r\n");
+  g_string_free (str, TRUE);
+
+  g_free (long_value);
+  res = gst_rtsp_message_free (msg);
+  fail_unless_equals_int (res, GST_RTSP_OK);
+}
+
+GST_END_TEST;
+
 static Suite *
 rtsp_suite (void)
 {
@@ -668,6 +762,7 @@ rtsp_suite (void)
   tcase_add_test (tc_chain, test_rtsp_range_clock);
   tcase_add_test (tc_chain, test_rtsp_range_convert);
   tcase_add_test (tc_chain, test_rtsp_message);
+  tcase_add_test (tc_chain, test_rtsp_message_headers);
 
   return s;
 }
@@ -603,6 +603,195 @@ GST_START_TEST (test_rtspconnection_send_receive)
 
 GST_END_TEST;
 
+GST_START_TEST (test_rtspconnection_send_data)
+{
+  GSocketConnection *input_conn = NULL;
+  GSocketConnection *output_conn = NULL;
+  GSocket *input_sock;
+  GSocket *output_sock;
+  GstRTSPConnection *rtsp_output_conn;
+  GstRTSPConnection *rtsp_input_conn;
+  GstRTSPWatch *watch;
+  GstRTSPMessage *msg;
+  GstBufferList *list;
+  GstBuffer *buf;
+  guint8 *recv_body;
+  guint recv_body_len;
+  guint8 channel;
+  guint i;
+
+  create_connection (&input_conn, &output_conn);
+  input_sock = g_socket_connection_get_socket (input_conn);
+  fail_unless (input_sock != NULL);
+  output_sock = g_socket_connection_get_socket (output_conn);
+  fail_unless (output_sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (input_sock, "127.0.0.1",
+          4444, NULL, &rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_input_conn != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (output_sock, "127.0.0.1",
+          4444, NULL, &rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_output_conn != NULL);
+
+  /* a list of packets made of several memories each, like RTP packets with
+   * the header and payload in separate memory */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 10; i++) {
+    buf = gst_buffer_new_allocate (NULL, 12, NULL);
+    gst_buffer_memset (buf, 0, i, 12);
+    gst_buffer_append_memory (buf, gst_allocator_alloc (NULL, 100 * i, NULL));
+    gst_buffer_memset (buf, 12, 0x80 + i, 100 * i);
+    gst_buffer_list_add (list, buf);
+  }
+
+  fail_unless (gst_rtsp_connection_send_data (rtsp_output_conn, 3,
+          gst_buffer_list_get (list, 1), NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_send_data_list (rtsp_output_conn, 4, list,
+          NULL) == GST_RTSP_OK);
+
+  watch = gst_rtsp_watch_new (rtsp_output_conn, &watch_funcs, NULL, NULL);
+  fail_unless (watch != NULL);
+  fail_unless (gst_rtsp_watch_attach (watch, NULL) > 0);
+  fail_unless (gst_rtsp_watch_send_data_list (watch, 5, list,
+          NULL) == GST_RTSP_OK);
+
+  /* receive the data messages and make sure they are correct */
+  for (i = 0; i < 21; i++) {
+    guint expected = i == 0 ? 1 : (i - 1) % 10;
+
+    fail_unless (gst_rtsp_message_new (&msg) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_connection_receive (rtsp_input_conn, msg,
+            NULL) == GST_RTSP_OK);
+    fail_unless (gst_rtsp_message_get_type (msg) == GST_RTSP_MESSAGE_DATA);
+    fail_unless (gst_rtsp_message_parse_data (msg, &channel) == GST_RTSP_OK);
+    fail_unless_equals_int (channel, i == 0 ? 3 : i <= 10 ? 4 : 5);
+    fail_unless (gst_rtsp_message_get_body (msg, &recv_body,
+            &recv_body_len) == GST_RTSP_OK);
+    /* RTSPConnection adds an extra byte for the trailing '\0' */
+    fail_unless_equals_int (recv_body_len, 12 + 100 * expected + 1);
+    fail_unless (gst_buffer_memcmp (gst_buffer_list_get (list, expected), 0,
+            recv_body, recv_body_len - 1) == 0);
+    fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+  }
+
+  gst_buffer_list_unref (list);
+  g_source_destroy ((GSource *) watch);
+  gst_rtsp_watch_unref (watch);
+
+  fail_unless (gst_rtsp_connection_close (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_close (rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_output_conn) == GST_RTSP_OK);
+
+  g_object_unref (input_conn);
+  g_object_unref (output_conn);
+}
+
+GST_END_TEST;
+
+GST_START_TEST (test_rtspconnection_receive_data_list)
+{
+  GSocketConnection *input_conn = NULL;
+  GSocketConnection *output_conn = NULL;
+  GSocket *input_sock;
+  GSocket *output_sock;
+  GstRTSPConnection *rtsp_output_conn;
+  GstRTSPConnection *rtsp_input_conn;
+  GstRTSPMessage *msg;
+  GstRTSPMessage recv_msg = { 0 };
+  GstBufferList *list, *recv_list;
+  GstBuffer *buf;
+  guint8 channel;
+  guint i, n_received;
+
+  create_connection (&input_conn, &output_conn);
+  input_sock = g_socket_connection_get_socket (input_conn);
+  fail_unless (input_sock != NULL);
+  output_sock = g_socket_connection_get_socket (output_conn);
+  fail_unless (output_sock != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (input_sock, "127.0.0.1",
+          4444, NULL, &rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_input_conn != NULL);
+
+  fail_unless (gst_rtsp_connection_create_from_socket (output_sock, "127.0.0.1",
+          4444, NULL, &rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (rtsp_output_conn != NULL);
+
+  /* 20 packets on channel 0 and one on channel 1, followed by a request */
+  list = gst_buffer_list_new ();
+  for (i = 0; i < 20; i++) {
+    buf = gst_buffer_new_allocate (NULL, 1000 + i, NULL);
+    gst_buffer_memset (buf, 0, i, 1000 + i);
+    gst_buffer_list_add (list, buf);
+  }
+  fail_unless (gst_rtsp_connection_send_data_list (rtsp_output_conn, 0, list,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_send_data (rtsp_output_conn, 1,
+          gst_buffer_list_get (list, 5), NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_new_request (&msg, GST_RTSP_OPTIONS,
+          "example.org") == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_send (rtsp_output_conn, msg,
+          NULL) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_message_free (msg) == GST_RTSP_OK);
+
+  /* the packets on channel 0 can arrive in several lists */
+  n_received = 0;
+  while (n_received < 20) {
+    fail_unless (gst_rtsp_connection_receive_data_list (rtsp_input_conn,
+            &recv_msg, &recv_list, NULL) == GST_RTSP_OK);
+    fail_unless (recv_list != NULL);
+    fail_unless (gst_rtsp_message_parse_data (&recv_msg,
+            &channel) == GST_RTSP_OK);
+    fail_unless_equals_int (channel, 0);
+
+    for (i = 0; i < gst_buffer_list_length (recv_list); i++) {
+      GstBuffer *recv_buf = gst_buffer_list_get (recv_list, i);
+      GstMapInfo map;
+
+      fail_unless (n_received < 20);
+      buf = gst_buffer_list_get (list, n_received);
+      fail_unless (gst_buffer_map (recv_buf, &map, GST_MAP_READ));
+      fail_unless_equals_int (map.size, gst_buffer_get_size (buf));
+      fail_unless (gst_buffer_memcmp (buf, 0, map.data, map.size) == 0);
+      gst_buffer_unmap (recv_buf, &map);
+      n_received++;
+    }
+    gst_buffer_list_unref (recv_list);
+  }
+  fail_unless_equals_int (n_received, 20);
+
+  fail_unless (gst_rtsp_connection_receive_data_list (rtsp_input_conn,
+          &recv_msg, &recv_list, NULL) == GST_RTSP_OK);
+  fail_unless (recv_list != NULL);
+  fail_unless_equals_int (gst_buffer_list_length (recv_list), 1);
+  fail_unless (gst_rtsp_message_parse_data (&recv_msg,
+          &channel) == GST_RTSP_OK);
+  fail_unless_equals_int (channel, 1);
+  gst_buffer_list_unref (recv_list);
+
+  /* the request was read along with the data but is parsed as usual */
+  fail_unless (gst_rtsp_connection_receive_data_list (rtsp_input_conn,
+          &recv_msg, &recv_list, NULL) == GST_RTSP_OK);
+  fail_unless (recv_list == NULL);
+  fail_unless (gst_rtsp_message_get_type (&recv_msg) ==
+      GST_RTSP_MESSAGE_REQUEST);
+  gst_rtsp_message_unset (&recv_msg);
+
+  gst_buffer_list_unref (list);
+
+  fail_unless (gst_rtsp_connection_close (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_input_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_close (rtsp_output_conn) == GST_RTSP_OK);
+  fail_unless (gst_rtsp_connection_free (rtsp_output_conn) == GST_RTSP_OK);
+
+  g_object_unref (input_conn);
+  g_object_unref (output_conn);
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_rtspconnection_send_receive_check_headers)
 {
   GSocketConnection *input_conn = NULL;
@@ -873,6 +1062,8 @@ rtspconnection_suite (void)
   tcase_add_test (tc_chain, test_rtspconnection_tunnel_setup_post_first);
   tcase_add_test (tc_chain, test_rtspconnection_send_receive);
   tcase_add_test (tc_chain, test_rtspconnection_send_receive_check_headers);
+  tcase_add_test (tc_chain, test_rtspconnection_send_data);
+  tcase_add_test (tc_chain, test_rtspconnection_receive_data_list);
   tcase_add_test (tc_chain, test_rtspconnection_connect);
   tcase_add_test (tc_chain, test_rtspconnection_poll);
   tcase_add_test (tc_chain, test_rtspconnection_backlog);
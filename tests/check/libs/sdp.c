@@ -24,6 +24,8 @@
 
 #include <gst/check/gstcheck.h>
 
+#include <string.h>
+
 /*
  * test_sdp.c - gst-kurento-plugins
  *
@@ -147,6 +149,37 @@ GST_START_TEST (copy)
   g_free (message_str);
 }
 
+GST_END_TEST
+GST_START_TEST (as_text)
+{
+  GstSDPMessage *message;
+  GstSDPMedia *media;
+  gchar *message_str, *media_str, *value;
+
+  gst_sdp_message_new (&message);
+  gst_sdp_message_parse_buffer ((guint8 *) sdp, strlen (sdp), message);
+
+  message_str = gst_sdp_message_as_text (message);
+  fail_unless_equals_string (message_str, sdp);
+  g_free (message_str);
+
+  media_str = gst_sdp_media_as_text (gst_sdp_message_get_media (message, 1));
+  fail_unless_equals_string (media_str, "m=video 6565 RTP/AVP 98\r\n"
+      "a=rtpmap:98 VP8/90000\r\n" "a=sendrecv\r\n");
+  g_free (media_str);
+
+  /* long values are written completely */
+  value = g_strnfill (10000, 'x');
+  media = (GstSDPMedia *) gst_sdp_message_get_media (message, 0);
+  gst_sdp_media_add_attribute (media, "fmtp", value);
+  media_str = gst_sdp_media_as_text (media);
+  fail_unless (strstr (media_str, value) != NULL);
+  g_free (media_str);
+  g_free (value);
+
+  gst_sdp_message_free (message);
+}
+
 GST_END_TEST
 GST_START_TEST (modify)
 {
@@ -296,6 +329,45 @@ GST_START_TEST (media_from_caps)
   gst_sdp_message_free (message);
 }
 
+GST_END_TEST
+GST_START_TEST (parse_long_fields)
+{
+  GstSDPMessage *message;
+  const GstSDPMedia *media;
+  const GstSDPConnection *conn;
+  gchar *address, *fmt, *text;
+  guint len = 9000;
+
+  /* fields longer than 8 KiB must not be truncated */
+  address = g_strnfill (len, 'a');
+  fmt = g_strnfill (len, 'f');
+  text = g_strdup_printf ("v=0\r\n"
+      "o=- 123 456 IN IP4 127.0.0.1\r\n"
+      "s=long fields\r\n"
+      "c=IN IP6 %s\r\n"
+      "m=audio 5000 RTP/AVP 96 %s\r\n", address, fmt);
+
+  gst_sdp_message_new (&message);
+  fail_unless_equals_int (gst_sdp_message_parse_buffer ((guint8 *) text,
+          strlen (text), message), GST_SDP_OK);
+
+  conn = gst_sdp_message_get_connection (message);
+  fail_unless_equals_string (conn->addrtype, "IP6");
+  fail_unless_equals_string (conn->address, address);
+
+  fail_unless_equals_int (gst_sdp_message_medias_len (message), 1);
+  media = gst_sdp_message_get_media (message, 0);
+  fail_unless_equals_int (gst_sdp_media_get_port (media), 5000);
+  fail_unless_equals_int (gst_sdp_media_formats_len (media), 2);
+  fail_unless_equals_string (gst_sdp_media_get_format (media, 0), "96");
+  fail_unless_equals_string (gst_sdp_media_get_format (media, 1), fmt);
+
+  gst_sdp_message_free (message);
+  g_free (text);
+  g_free (fmt);
+  g_free (address);
+}
+
 GST_END_TEST
 /*
  * End of test cases
@@ -308,10 +380,12 @@ sdp_suite (void)
 
   suite_add_tcase (s, tc_chain);
   tcase_add_test (tc_chain, copy);
+  tcase_add_test (tc_chain, as_text);
   tcase_add_test (tc_chain, boxed);
   tcase_add_test (tc_chain, modify);
   tcase_add_test (tc_chain, caps_from_media);
   tcase_add_test (tc_chain, media_from_caps);
+  tcase_add_test (tc_chain, parse_long_fields);
 
   return s;
 }
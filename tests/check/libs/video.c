@@ -2031,6 +2031,276 @@ GST_END_TEST;
 #undef HEIGHT
 #undef TIME
 
+/* reads the raw sample of component @c of pixel @x,@y of a frame where each
+ * sample is stored in its own 16 bits word */
+static guint
+read_sample_16 (GstVideoFrame * frame, gint c, gint x, gint y)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint8 *p;
+  guint v;
+
+  p = GST_VIDEO_FRAME_COMP_DATA (frame, c);
+  p += GST_VIDEO_FRAME_COMP_STRIDE (frame, c) *
+      (y >> GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c));
+  p += GST_VIDEO_FRAME_COMP_PSTRIDE (frame, c) *
+      (x >> GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c));
+
+  v = GST_VIDEO_FORMAT_INFO_IS_LE (finfo) ? GST_READ_UINT16_LE (p) :
+      GST_READ_UINT16_BE (p);
+
+  return (v >> GST_VIDEO_FORMAT_INFO_SHIFT (finfo, c)) &
+      ((1 << GST_VIDEO_FORMAT_INFO_DEPTH (finfo, c)) - 1);
+}
+
+static void
+write_sample_16 (GstVideoFrame * frame, gint c, gint x, gint y, guint v)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint8 *p;
+
+  p = GST_VIDEO_FRAME_COMP_DATA (frame, c);
+  p += GST_VIDEO_FRAME_COMP_STRIDE (frame, c) *
+      (y >> GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c));
+  p += GST_VIDEO_FRAME_COMP_PSTRIDE (frame, c) *
+      (x >> GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c));
+
+  v <<= GST_VIDEO_FORMAT_INFO_SHIFT (finfo, c);
+  if (GST_VIDEO_FORMAT_INFO_IS_LE (finfo))
+    GST_WRITE_UINT16_LE (p, v);
+  else
+    GST_WRITE_UINT16_BE (p, v);
+}
+
+/* sample @k of the 12 samples in the 16 bytes group of pixel @x */
+static guint
+read_sample_v210 (GstVideoFrame * frame, gint k, gint x, gint y)
+{
+  guint8 *p;
+
+  p = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  p += GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0) * y + (x / 6) * 16;
+
+  return (GST_READ_UINT32_LE (p + (k / 3) * 4) >> ((k % 3) * 10)) & 0x3ff;
+}
+
+/* the reference unpacking of one pixel to 16 bits AYUV64 or ARGB64 */
+static void
+unpack_pixel_reference (GstVideoFrame * frame, gint x, gint y,
+    gboolean truncate, guint16 * d)
+{
+  const GstVideoFormatInfo *finfo = frame->info.finfo;
+  guint8 *line, *p;
+  guint32 w;
+  guint v[4];
+  gint c;
+
+  v[3] = 0;
+  line = GST_VIDEO_FRAME_PLANE_DATA (frame, 0);
+  line += GST_VIDEO_FRAME_PLANE_STRIDE (frame, 0) * y;
+
+  switch (GST_VIDEO_FRAME_FORMAT (frame)) {
+    case GST_VIDEO_FORMAT_v210:
+      v[0] = read_sample_v210 (frame, 2 * (x % 6) + 1, x, y);
+      v[1] = read_sample_v210 (frame, 4 * ((x % 6) / 2), x, y);
+      v[2] = read_sample_v210 (frame, 4 * ((x % 6) / 2) + 2, x, y);
+      break;
+    case GST_VIDEO_FORMAT_UYVP:
+      p = line + (x / 2) * 5;
+      v[1] = (p[0] << 2) | (p[1] >> 6);
+      v[2] = ((p[2] & 0x0f) << 6) | (p[3] >> 2);
+      if (x & 1)
+        v[0] = ((p[3] & 0x03) << 8) | p[4];
+      else
+        v[0] = ((p[1] & 0x3f) << 4) | (p[2] >> 4);
+      break;
+    case GST_VIDEO_FORMAT_r210:
+      w = GST_READ_UINT32_BE (line + x * 4);
+      v[0] = (w >> 20) & 0x3ff;
+      v[1] = (w >> 10) & 0x3ff;
+      v[2] = w & 0x3ff;
+      break;
+    case GST_VIDEO_FORMAT_v216:
+      /* 16 bits samples, no range extension */
+      p = line + (x / 2) * 8;
+      d[0] = 0xffff;
+      d[1] = GST_READ_UINT16_LE (p + 2 + (x & 1) * 4);
+      d[2] = GST_READ_UINT16_LE (p);
+      d[3] = GST_READ_UINT16_LE (p + 4);
+      return;
+    default:
+      for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++)
+        v[c] = read_sample_16 (frame, c, x, y);
+      break;
+  }
+
+  /* AYUV64 and ARGB64 have alpha first */
+  for (c = 0; c < 4; c++) {
+    guint16 val = v[c] << 6;
+
+    if (!truncate)
+      val |= val >> 10;
+    d[(c + 1) & 3] = val;
+  }
+  if (GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo) < 4)
+    d[0] = 0xffff;
+}
+
+GST_START_TEST (test_video_pack_unpack_high_depth)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_P010_10LE,
+    GST_VIDEO_FORMAT_P010_10BE, GST_VIDEO_FORMAT_I420_10LE,
+    GST_VIDEO_FORMAT_I420_10BE, GST_VIDEO_FORMAT_I422_10LE,
+    GST_VIDEO_FORMAT_I422_10BE, GST_VIDEO_FORMAT_Y444_10LE,
+    GST_VIDEO_FORMAT_Y444_10BE, GST_VIDEO_FORMAT_GBR_10LE,
+    GST_VIDEO_FORMAT_GBR_10BE, GST_VIDEO_FORMAT_A420_10LE,
+    GST_VIDEO_FORMAT_A420_10BE, GST_VIDEO_FORMAT_A422_10LE,
+    GST_VIDEO_FORMAT_A422_10BE, GST_VIDEO_FORMAT_A444_10LE,
+    GST_VIDEO_FORMAT_A444_10BE, GST_VIDEO_FORMAT_UYVP, GST_VIDEO_FORMAT_r210,
+    GST_VIDEO_FORMAT_v216
+  };
+  GTimer *timer;
+  guint i;
+
+#define WIDTH 1920
+#define HEIGHT 4
+/* set to something larger to do benchmarks */
+#define TIME 0.001
+
+  timer = g_timer_new ();
+
+  GST_DEBUG ("format\tunpack lines/sec\tpack lines/sec");
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    const GstVideoFormatInfo *finfo;
+    GstVideoInfo info;
+    GstVideoFrame frame;
+    GstBuffer *buffer;
+    guint16 *line, expected[4];
+    gpointer saved;
+    gint x, y, c, k, width, count;
+    gdouble elapsed, unpack_sec, pack_sec;
+
+    finfo = gst_video_format_get_info (formats[i]);
+    fail_unless (finfo != NULL);
+
+    gst_video_info_set_format (&info, formats[i], WIDTH, HEIGHT);
+    buffer = gst_buffer_new_and_alloc (info.size);
+    gst_buffer_memset (buffer, 0, 0, -1);
+    gst_video_frame_map (&frame, &info, buffer, GST_MAP_READWRITE);
+
+    /* fill with random samples, the padding bits stay 0 */
+    if (formats[i] == GST_VIDEO_FORMAT_v210 ||
+        formats[i] == GST_VIDEO_FORMAT_r210) {
+      for (y = 0; y < HEIGHT; y++) {
+        guint8 *p = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0) +
+            GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0) * y;
+
+        for (x = 0; x < GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0); x += 4) {
+          if (formats[i] == GST_VIDEO_FORMAT_r210)
+            GST_WRITE_UINT32_BE (p + x, g_random_int () & 0x3fffffff);
+          else
+            GST_WRITE_UINT32_LE (p + x, g_random_int () & 0x3fffffff);
+        }
+      }
+    } else if (formats[i] == GST_VIDEO_FORMAT_UYVP ||
+        formats[i] == GST_VIDEO_FORMAT_v216) {
+      /* these have no padding bits */
+      for (y = 0; y < HEIGHT; y++) {
+        guint8 *p = GST_VIDEO_FRAME_PLANE_DATA (&frame, 0) +
+            GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0) * y;
+
+        for (x = 0; x < GST_VIDEO_FRAME_PLANE_STRIDE (&frame, 0); x++)
+          p[x] = g_random_int_range (0, 256);
+      }
+    } else {
+      for (y = 0; y < HEIGHT; y++)
+        for (x = 0; x < WIDTH; x++)
+          for (c = 0; c < GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo); c++)
+            write_sample_16 (&frame, c, x, y, g_random_int () & 0x3ff);
+    }
+
+    line = g_new0 (guint16, WIDTH * 4);
+
+    /* unpack at different offsets and widths, v210 and UYVP can only be
+     * unpacked from the start of the line */
+    for (y = 0; y < HEIGHT; y++) {
+      for (k = 0; k < 2; k++) {
+        GstVideoPackFlags flags =
+            k ? GST_VIDEO_PACK_FLAG_TRUNCATE_RANGE : GST_VIDEO_PACK_FLAG_NONE;
+
+        for (x = 0; x < 5; x++) {
+          if (x > 0 && (formats[i] == GST_VIDEO_FORMAT_v210 ||
+                  formats[i] == GST_VIDEO_FORMAT_UYVP))
+            break;
+
+          for (width = 1; width < 40; width++) {
+            gint j;
+
+            finfo->unpack_func (finfo, flags, line, frame.data,
+                frame.info.stride, x, y, width);
+
+            for (j = 0; j < width; j++) {
+              unpack_pixel_reference (&frame, x + j, y, k, expected);
+              if (memcmp (line + j * 4, expected, sizeof (expected)) != 0) {
+                GST_ERROR ("%s: x %d y %d width %d pixel %d flags %d",
+                    finfo->name, x, y, width, j, flags);
+                fail ("unpack mismatch");
+              }
+            }
+          }
+        }
+      }
+    }
+
+    /* packing back the unpacked lines must restore the frame */
+    saved = g_memdup (frame.map[0].data, frame.map[0].size);
+    for (y = 0; y < HEIGHT; y++) {
+      finfo->unpack_func (finfo, GST_VIDEO_PACK_FLAG_NONE, line, frame.data,
+          frame.info.stride, 0, y, WIDTH);
+      finfo->pack_func (finfo, GST_VIDEO_PACK_FLAG_NONE, line, 0, frame.data,
+          frame.info.stride, frame.info.chroma_site, y, WIDTH);
+    }
+    fail_unless (memcmp (frame.map[0].data, saved, frame.map[0].size) == 0,
+        "%s: pack does not restore the unpacked frame", finfo->name);
+    g_free (saved);
+
+    count = 0;
+    g_timer_start (timer);
+    do {
+      finfo->unpack_func (finfo, GST_VIDEO_PACK_FLAG_NONE, line, frame.data,
+          frame.info.stride, 0, count % HEIGHT, WIDTH);
+      count++;
+      elapsed = g_timer_elapsed (timer, NULL);
+    } while (elapsed < TIME);
+    unpack_sec = count / elapsed;
+
+    count = 0;
+    g_timer_start (timer);
+    do {
+      finfo->pack_func (finfo, GST_VIDEO_PACK_FLAG_NONE, line, 0, frame.data,
+          frame.info.stride, frame.info.chroma_site, count % HEIGHT, WIDTH);
+      count++;
+      elapsed = g_timer_elapsed (timer, NULL);
+    } while (elapsed < TIME);
+    pack_sec = count / elapsed;
+
+    GST_DEBUG ("%s\t%f\t%f", finfo->name, unpack_sec, pack_sec);
+
+    g_free (line);
+    gst_video_frame_unmap (&frame);
+    gst_buffer_unref (buffer);
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+#undef WIDTH
+#undef HEIGHT
+#undef TIME
+
 #define WIDTH 320
 #define HEIGHT 240
 #define TIME 0.1
@@ -2137,6 +2407,223 @@ GST_START_TEST (test_video_scaler)
 
 GST_END_TEST;
 
+/* scale a flat image with the given number of taps in both directions, the
+ * result has to stay flat */
+static void
+check_scaler_flat (GstVideoFormat format, guint n_taps, guint in_size,
+    guint out_size)
+{
+  GstVideoScaler *hscale, *vscale;
+  const GstVideoFormatInfo *finfo;
+  guint8 *src, *dest;
+  gint pstride, i;
+  gsize size;
+
+  finfo = gst_video_format_get_info (format);
+  pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, 0);
+
+  hscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, n_taps, in_size, out_size, NULL);
+  vscale = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+      GST_VIDEO_SCALER_FLAG_NONE, n_taps, in_size, out_size, NULL);
+  fail_unless_equals_int (gst_video_scaler_get_max_taps (vscale), n_taps);
+
+  src = g_malloc (in_size * in_size * pstride);
+  if (pstride == 1)
+    memset (src, 100, in_size * in_size);
+  else
+    for (i = 0; i < in_size * in_size * pstride / 2; i++)
+      ((guint16 *) src)[i] = 10000;
+
+  size = out_size * out_size * pstride;
+  dest = g_malloc0 (size);
+
+  gst_video_scaler_2d (hscale, vscale, format, src, in_size * pstride,
+      dest, out_size * pstride, 0, 0, out_size, out_size);
+
+  if (pstride == 1) {
+    for (i = 0; i < size; i++)
+      fail_unless (ABS (dest[i] - 100) <= 1, "%s %u taps: %d at %d",
+          gst_video_format_to_string (format), n_taps, dest[i], i);
+  } else {
+    for (i = 0; i < size / 2; i++)
+      fail_unless (ABS (((guint16 *) dest)[i] - 10000) <= 1,
+          "%s %u taps: %d at %d", gst_video_format_to_string (format), n_taps,
+          ((guint16 *) dest)[i], i);
+  }
+
+  g_free (src);
+  g_free (dest);
+  gst_video_scaler_free (hscale);
+  gst_video_scaler_free (vscale);
+}
+
+GST_START_TEST (test_video_scaler_taps)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_RGBA, GST_VIDEO_FORMAT_GRAY16_LE,
+    GST_VIDEO_FORMAT_ARGB64
+  };
+  guint i, n_taps;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    for (n_taps = 2; n_taps <= 10; n_taps++) {
+      check_scaler_flat (formats[i], n_taps, 64, 24);
+      check_scaler_flat (formats[i], n_taps, 24, 64);
+    }
+  }
+}
+
+GST_END_TEST;
+
+/* scale random data with the fused 4/6/8 tap kernels and with the ORC
+ * programs, both have to produce exactly the same output */
+static void
+check_scaler_fused (GRand * rand, GstVideoFormat format, guint n_taps,
+    guint in_size, guint out_size)
+{
+  GstVideoScaler *hscale[2], *vscale[2];
+  const GstVideoFormatInfo *finfo;
+  GstStructure *options;
+  guint8 *src, *dest[2];
+  gint pstride, i;
+  gsize size;
+
+  finfo = gst_video_format_get_info (format);
+  pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, 0);
+
+  options = gst_structure_new_empty ("GstVideoScaler");
+  for (i = 0; i < 2; i++) {
+    gst_structure_set (options, GST_VIDEO_SCALER_OPT_FUSED_TAPS,
+        G_TYPE_BOOLEAN, i == 0, NULL);
+    hscale[i] = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+        GST_VIDEO_SCALER_FLAG_NONE, n_taps, in_size, out_size, options);
+    vscale[i] = gst_video_scaler_new (GST_VIDEO_RESAMPLER_METHOD_LANCZOS,
+        GST_VIDEO_SCALER_FLAG_NONE, n_taps, in_size, out_size, options);
+  }
+  gst_structure_free (options);
+  fail_unless_equals_int (gst_video_scaler_get_max_taps (vscale[0]), n_taps);
+
+  src = g_malloc (in_size * in_size * pstride);
+  for (i = 0; i < in_size * in_size * pstride; i++)
+    src[i] = g_rand_int_range (rand, 0, 256);
+
+  size = out_size * out_size * pstride;
+  for (i = 0; i < 2; i++) {
+    dest[i] = g_malloc0 (size);
+    gst_video_scaler_2d (hscale[i], vscale[i], format, src, in_size * pstride,
+        dest[i], out_size * pstride, 0, 0, out_size, out_size);
+  }
+
+  fail_unless (memcmp (dest[0], dest[1], size) == 0, "%s %u taps %u->%u",
+      gst_video_format_to_string (format), n_taps, in_size, out_size);
+
+  g_free (src);
+  for (i = 0; i < 2; i++) {
+    g_free (dest[i]);
+    gst_video_scaler_free (hscale[i]);
+    gst_video_scaler_free (vscale[i]);
+  }
+}
+
+GST_START_TEST (test_video_scaler_fused)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_RGBA, GST_VIDEO_FORMAT_GRAY16_LE,
+    GST_VIDEO_FORMAT_ARGB64
+  };
+  GRand *rand;
+  guint i, n_taps;
+
+  rand = g_rand_new_with_seed (0x5ca1e);
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    for (n_taps = 4; n_taps <= 8; n_taps += 2) {
+      check_scaler_fused (rand, formats[i], n_taps, 64, 24);
+      check_scaler_fused (rand, formats[i], n_taps, 24, 64);
+    }
+  }
+
+  g_rand_free (rand);
+}
+
+GST_END_TEST;
+
+/* set to something larger to do benchmarks */
+#define SCALER_BENCHMARK_TIME 0.001
+
+GST_START_TEST (test_video_scaler_benchmark)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_GRAY8, GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_NV12,
+    GST_VIDEO_FORMAT_RGB, GST_VIDEO_FORMAT_RGBA, GST_VIDEO_FORMAT_GRAY16_LE,
+    GST_VIDEO_FORMAT_ARGB64
+  };
+  static const gdouble factors[] = { 0.25, 0.5, 0.75, 1.5, 2.0 };
+  GstVideoResamplerMethod method;
+  GTimer *timer;
+  guint i, j;
+
+  timer = g_timer_new ();
+
+  GST_DEBUG ("format\tmethod\tfactor\tframes/sec");
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    GstVideoInfo ininfo, outinfo;
+    GstVideoFrame inframe, outframe;
+    GstBuffer *inbuffer, *outbuffer;
+
+    gst_video_info_set_format (&ininfo, formats[i], 640, 480);
+    inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+    gst_buffer_memset (inbuffer, 0, 0x80, -1);
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+    for (method = GST_VIDEO_RESAMPLER_METHOD_NEAREST;
+        method <= GST_VIDEO_RESAMPLER_METHOD_LANCZOS; method++) {
+      for (j = 0; j < G_N_ELEMENTS (factors); j++) {
+        GstVideoConverter *convert;
+        gdouble elapsed;
+        gint count;
+
+        gst_video_info_set_format (&outinfo, formats[i],
+            GST_ROUND_UP_4 ((gint) (640 * factors[j])),
+            GST_ROUND_UP_4 ((gint) (480 * factors[j])));
+        outbuffer = gst_buffer_new_and_alloc (outinfo.size);
+        gst_video_frame_map (&outframe, &outinfo, outbuffer, GST_MAP_WRITE);
+
+        convert = gst_video_converter_new (&ininfo, &outinfo,
+            gst_structure_new ("options",
+                GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+                GST_TYPE_VIDEO_RESAMPLER_METHOD, method, NULL));
+
+        /* warmup */
+        gst_video_converter_frame (convert, &inframe, &outframe);
+
+        count = 0;
+        g_timer_start (timer);
+        do {
+          gst_video_converter_frame (convert, &inframe, &outframe);
+          count++;
+          elapsed = g_timer_elapsed (timer, NULL);
+        } while (elapsed < SCALER_BENCHMARK_TIME);
+
+        GST_DEBUG ("%s\t%d\t%f\t%f", gst_video_format_to_string (formats[i]),
+            method, factors[j], count / elapsed);
+
+        gst_video_converter_free (convert);
+        gst_video_frame_unmap (&outframe);
+        gst_buffer_unref (outbuffer);
+      }
+    }
+    gst_video_frame_unmap (&inframe);
+    gst_buffer_unref (inbuffer);
+  }
+
+  g_timer_destroy (timer);
+}
+
+GST_END_TEST;
+
 #define WIDTH 320
 #define HEIGHT 240
 #define TIME 0.01
@@ -2387,6 +2874,164 @@ GST_START_TEST (test_video_convert)
 
 GST_END_TEST;
 
+static void
+convert_pyramid_frame (GstVideoFrame * inframe, GstVideoFrame * outframe,
+    gboolean pyramid)
+{
+  GstVideoConverter *convert;
+
+  convert = gst_video_converter_new (&inframe->info, &outframe->info,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_RESAMPLER_PYRAMID, G_TYPE_BOOLEAN, pyramid,
+          NULL));
+  gst_video_converter_frame (convert, inframe, outframe);
+  gst_video_converter_free (convert);
+}
+
+GST_START_TEST (test_video_convert_pyramid)
+{
+  GstVideoInfo ininfo, outinfo;
+  GstVideoFrame inframe, outframe1, outframe2;
+  GstBuffer *inbuffer, *outbuffer1, *outbuffer2;
+  gint i, x, y;
+
+  gst_video_info_set_format (&ininfo, GST_VIDEO_FORMAT_I420, 1280, 720);
+  inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+  gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_WRITE);
+
+  /* smooth gradients in all planes */
+  for (i = 0; i < 3; i++) {
+    for (y = 0; y < GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, i); y++) {
+      guint8 *line = GST_VIDEO_FRAME_COMP_DATA (&inframe, i) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&inframe, i);
+
+      for (x = 0; x < GST_VIDEO_FRAME_COMP_WIDTH (&inframe, i); x++)
+        line[x] = (x * 255 / GST_VIDEO_FRAME_COMP_WIDTH (&inframe, i) +
+            y * 255 / GST_VIDEO_FRAME_COMP_HEIGHT (&inframe, i)) / 2;
+    }
+  }
+
+  gst_video_info_set_format (&outinfo, GST_VIDEO_FORMAT_I420, 96, 54);
+  outbuffer1 = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&outframe1, &outinfo, outbuffer1, GST_MAP_WRITE);
+  outbuffer2 = gst_buffer_new_and_alloc (outinfo.size);
+  gst_video_frame_map (&outframe2, &outinfo, outbuffer2, GST_MAP_WRITE);
+
+  convert_pyramid_frame (&inframe, &outframe1, FALSE);
+  convert_pyramid_frame (&inframe, &outframe2, TRUE);
+
+  /* the pyramid has to stay close to the direct filter, the edges are left
+   * out because the filters clamp there in a different way */
+  for (i = 0; i < 3; i++) {
+    for (y = 1; y < GST_VIDEO_FRAME_COMP_HEIGHT (&outframe1, i) - 1; y++) {
+      guint8 *l1 = GST_VIDEO_FRAME_COMP_DATA (&outframe1, i) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&outframe1, i);
+      guint8 *l2 = GST_VIDEO_FRAME_COMP_DATA (&outframe2, i) +
+          y * GST_VIDEO_FRAME_COMP_STRIDE (&outframe2, i);
+
+      for (x = 1; x < GST_VIDEO_FRAME_COMP_WIDTH (&outframe1, i) - 1; x++)
+        fail_unless (ABS (l1[x] - l2[x]) <= 3,
+            "comp %d at %d,%d: %d != %d", i, x, y, l1[x], l2[x]);
+    }
+  }
+
+  gst_video_frame_unmap (&outframe2);
+  gst_buffer_unref (outbuffer2);
+  gst_video_frame_unmap (&outframe1);
+  gst_buffer_unref (outbuffer1);
+  gst_video_frame_unmap (&inframe);
+  gst_buffer_unref (inbuffer);
+}
+
+GST_END_TEST;
+
+static void
+convert_10bit_frame (GstVideoFrame * inframe, GstVideoFrame * outframe,
+    GstVideoDitherMethod method, gboolean fastpath)
+{
+  GstVideoConverter *convert;
+
+  /* a target quantization other than 1 disables the fastpaths, it has no
+   * effect without dithering */
+  convert = gst_video_converter_new (&inframe->info, &outframe->info,
+      gst_structure_new ("options",
+          GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+          GST_TYPE_VIDEO_DITHER_METHOD, method,
+          GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, G_TYPE_UINT,
+          fastpath ? 1 : 2, NULL));
+  gst_video_converter_frame (convert, inframe, outframe);
+  gst_video_converter_free (convert);
+}
+
+GST_START_TEST (test_video_convert_10bit)
+{
+  static const GstVideoFormat formats[][2] = {
+    {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_I422_10LE},
+    {GST_VIDEO_FORMAT_I422_10LE, GST_VIDEO_FORMAT_v210},
+    {GST_VIDEO_FORMAT_v210, GST_VIDEO_FORMAT_UYVY},
+    {GST_VIDEO_FORMAT_UYVY, GST_VIDEO_FORMAT_v210},
+    {GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_NV12},
+    {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_P010_10LE},
+    {GST_VIDEO_FORMAT_I420_10LE, GST_VIDEO_FORMAT_I420},
+    {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_I420_10LE},
+  };
+  guint i;
+
+  for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+    GstVideoInfo ininfo, outinfo;
+    GstVideoFrame inframe, outframe1, outframe2;
+    GstBuffer *inbuffer, *outbuffer1, *outbuffer2;
+    GstMapInfo map;
+    gsize k;
+
+    /* the width is not a multiple of the 6 pixels v210 groups */
+    gst_video_info_set_format (&ininfo, formats[i][0], 1280, 720);
+    inbuffer = gst_buffer_new_and_alloc (ininfo.size);
+    gst_buffer_map (inbuffer, &map, GST_MAP_WRITE);
+    for (k = 0; k < map.size; k++)
+      map.data[k] = g_random_int ();
+    gst_buffer_unmap (inbuffer, &map);
+    gst_video_frame_map (&inframe, &ininfo, inbuffer, GST_MAP_READ);
+
+    gst_video_info_set_format (&outinfo, formats[i][1], 1280, 720);
+    outbuffer1 = gst_buffer_new_and_alloc (outinfo.size);
+    gst_buffer_memset (outbuffer1, 0, 0, -1);
+    gst_video_frame_map (&outframe1, &outinfo, outbuffer1, GST_MAP_READWRITE);
+    outbuffer2 = gst_buffer_new_and_alloc (outinfo.size);
+    gst_buffer_memset (outbuffer2, 0, 0, -1);
+    gst_video_frame_map (&outframe2, &outinfo, outbuffer2, GST_MAP_READWRITE);
+
+    /* without dithering the fastpath must match the generic path */
+    convert_10bit_frame (&inframe, &outframe1, GST_VIDEO_DITHER_NONE, FALSE);
+    convert_10bit_frame (&inframe, &outframe2, GST_VIDEO_DITHER_NONE, TRUE);
+    fail_unless (memcmp (outframe1.map[0].data, outframe2.map[0].data,
+            outinfo.size) == 0, "%s -> %s differs from the generic path",
+        gst_video_format_to_string (formats[i][0]),
+        gst_video_format_to_string (formats[i][1]));
+
+    /* dithering to 8 bits only changes the samples by one step */
+    if (GST_VIDEO_FORMAT_INFO_DEPTH (outinfo.finfo, 0) == 8) {
+      convert_10bit_frame (&inframe, &outframe2, GST_VIDEO_DITHER_BAYER, TRUE);
+      for (k = 0; k < outinfo.size; k++) {
+        gint diff = outframe2.map[0].data[k] - outframe1.map[0].data[k];
+
+        fail_unless (diff == 0 || diff == 1, "%s -> %s: %d at %"
+            G_GSIZE_FORMAT, gst_video_format_to_string (formats[i][0]),
+            gst_video_format_to_string (formats[i][1]), diff, k);
+      }
+    }
+
+    gst_video_frame_unmap (&outframe2);
+    gst_buffer_unref (outbuffer2);
+    gst_video_frame_unmap (&outframe1);
+    gst_buffer_unref (outbuffer1);
+    gst_video_frame_unmap (&inframe);
+    gst_buffer_unref (inbuffer);
+  }
+}
+
+GST_END_TEST;
+
 GST_START_TEST (test_video_transfer)
 {
   gint i, j;
@@ -2688,6 +3333,134 @@ GST_START_TEST (test_overlay_composition_over_transparency)
 
 GST_END_TEST;
 
+static void
+blend_reference (GstVideoFrame * frame, GstVideoOverlayRectangle * rect,
+    GstBuffer * pixels)
+{
+  GstVideoFrame overlay_frame;
+  GstVideoInfo info, scaled_info;
+  GstVideoMeta *vmeta;
+  GstBuffer *scaled;
+  gint x, y;
+  guint w, h;
+
+  vmeta = gst_buffer_get_video_meta (pixels);
+  gst_video_info_set_format (&info, vmeta->format, vmeta->width,
+      vmeta->height);
+  gst_video_overlay_rectangle_get_render_rectangle (rect, &x, &y, &w, &h);
+
+  if (w != vmeta->width || h != vmeta->height) {
+    gst_video_blend_scale_linear_RGBA (&info, pixels, h, w, &scaled_info,
+        &scaled);
+    info = scaled_info;
+  } else {
+    scaled = gst_buffer_ref (pixels);
+  }
+
+  gst_video_frame_map (&overlay_frame, &info, scaled, GST_MAP_READ);
+  fail_unless (gst_video_blend (frame, &overlay_frame, x, y,
+          gst_video_overlay_rectangle_get_global_alpha (rect)));
+  gst_video_frame_unmap (&overlay_frame);
+  gst_buffer_unref (scaled);
+}
+
+GST_START_TEST (test_overlay_composition_blend_cached)
+{
+  static const GstVideoFormat formats[] = {
+    GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_YUY2, GST_VIDEO_FORMAT_BGRx
+  };
+  GstVideoOverlayComposition *comp;
+  GstVideoOverlayRectangle *rect;
+  GstBuffer *pixels, *rect_pixels;
+  GstMapInfo map;
+  guint i, k, pass;
+  gint x, y;
+
+  /* a mostly transparent overlay with a few bars, like subtitles */
+  pixels = gst_buffer_new_and_alloc (200 * 100 * 4);
+  gst_buffer_map (pixels, &map, GST_MAP_WRITE);
+  memset (map.data, 0, map.size);
+  for (y = 0; y < 100; y++) {
+    if ((y / 10) % 3 != 1)
+      continue;
+    for (x = 20 + y % 7; x < 180; x++) {
+      guint8 *p = map.data + (y * 200 + x) * 4;
+
+      p[0] = g_random_int ();
+      p[1] = g_random_int ();
+      p[2] = g_random_int ();
+      p[3] = (x & 16) ? 0xff : 0x80;
+    }
+  }
+  gst_buffer_unmap (pixels, &map);
+  gst_buffer_add_video_meta (pixels, GST_VIDEO_FRAME_FLAG_NONE,
+      GST_VIDEO_OVERLAY_COMPOSITION_FORMAT_RGB, 200, 100);
+
+  rect = gst_video_overlay_rectangle_new_raw (pixels, -20, 30, 200, 100,
+      GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+  comp = gst_video_overlay_composition_new (rect);
+  /* the composition holds the only ref so the rectangle stays writable */
+  gst_video_overlay_rectangle_unref (rect);
+  rect_pixels = pixels;
+
+  for (pass = 0; pass < 5; pass++) {
+    if (pass == 1) {
+      gst_video_overlay_rectangle_set_render_rectangle (rect, 200, 180, 300,
+          150);
+    } else if (pass == 2) {
+      gst_video_overlay_rectangle_set_global_alpha (rect, 0.5);
+    } else if (pass == 3) {
+      /* back to the original size, with another global alpha */
+      gst_video_overlay_rectangle_set_render_rectangle (rect, -20, 30, 200,
+          100);
+      gst_video_overlay_rectangle_set_global_alpha (rect, 0.25);
+    } else if (pass == 4) {
+      /* applies the global alpha to the pixels of the rectangle */
+      rect_pixels = gst_video_overlay_rectangle_get_pixels_unscaled_raw (rect,
+          GST_VIDEO_OVERLAY_FORMAT_FLAG_NONE);
+      fail_unless (rect_pixels != NULL);
+    }
+
+    for (i = 0; i < G_N_ELEMENTS (formats); i++) {
+      GstVideoInfo info;
+      GstVideoFrame ref_frame, frame;
+      GstBuffer *orig, *ref_buf, *buf;
+
+      gst_video_info_set_format (&info, formats[i], 320, 240);
+      orig = gst_buffer_new_and_alloc (info.size);
+      gst_buffer_map (orig, &map, GST_MAP_WRITE);
+      for (k = 0; k < map.size; k++)
+        map.data[k] = g_random_int ();
+      gst_buffer_unmap (orig, &map);
+
+      ref_buf = gst_buffer_copy_deep (orig);
+      gst_video_frame_map (&ref_frame, &info, ref_buf, GST_MAP_READWRITE);
+      blend_reference (&ref_frame, rect, rect_pixels);
+
+      /* the second blend uses the cached overlay */
+      for (k = 0; k < 2; k++) {
+        buf = gst_buffer_copy_deep (orig);
+        gst_video_frame_map (&frame, &info, buf, GST_MAP_READWRITE);
+        fail_unless (gst_video_overlay_composition_blend (comp, &frame));
+        fail_unless (memcmp (frame.map[0].data, ref_frame.map[0].data,
+                info.size) == 0, "%s: blend %u in pass %u differs",
+            gst_video_format_to_string (formats[i]), k, pass);
+        gst_video_frame_unmap (&frame);
+        gst_buffer_unref (buf);
+      }
+
+      gst_video_frame_unmap (&ref_frame);
+      gst_buffer_unref (ref_buf);
+      gst_buffer_unref (orig);
+    }
+  }
+
+  gst_video_overlay_composition_unref (comp);
+  gst_buffer_unref (pixels);
+}
+
+GST_END_TEST;
+
 
 static Suite *
 video_suite (void)
@@ -2714,15 +3487,22 @@ video_suite (void)
   tcase_add_test (tc_chain, test_overlay_composition_premultiplied_alpha);
   tcase_add_test (tc_chain, test_overlay_composition_global_alpha);
   tcase_add_test (tc_chain, test_video_pack_unpack2);
+  tcase_add_test (tc_chain, test_video_pack_unpack_high_depth);
   tcase_add_test (tc_chain, test_video_chroma);
   tcase_add_test (tc_chain, test_video_scaler);
+  tcase_add_test (tc_chain, test_video_scaler_taps);
+  tcase_add_test (tc_chain, test_video_scaler_fused);
+  tcase_add_test (tc_chain, test_video_scaler_benchmark);
   tcase_add_test (tc_chain, test_video_color_convert);
   tcase_add_test (tc_chain, test_video_size_convert);
   tcase_add_test (tc_chain, test_video_convert);
+  tcase_add_test (tc_chain, test_video_convert_pyramid);
+  tcase_add_test (tc_chain, test_video_convert_10bit);
   tcase_add_test (tc_chain, test_video_transfer);
   tcase_add_test (tc_chain, test_overlay_blend);
   tcase_add_test (tc_chain, test_video_center_rect);
   tcase_add_test (tc_chain, test_overlay_composition_over_transparency);
+  tcase_add_test (tc_chain, test_overlay_composition_blend_cached);
 
   return s;
 }